@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_bbox.sql
+ * Microbenchmark of the computation of the bounding box when constructing
+ * temporal sequences.
+ *
+ * For each cardinality, the arrays of instants are built once and the
+ * sequences are then constructed `repeat` times. The construction time is
+ * dominated by the validation of the instants and the computation of the
+ * bounding box, so that comparing the results obtained with two builds of
+ * the extension shows the effect of changes in the bounding box kernels.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_bbox();
+ * SELECT * FROM benchmark_bbox(ARRAY[1000, 1000000], 3);
+ * @endcode
+ */
+
+/**
+ * Measure the time needed for constructing temporal sequences
+ *
+ * @param[in] cards Numbers of instants of the sequences
+ * @param[in] repeat Number of constructions for each cardinality
+ */
+DROP FUNCTION IF EXISTS benchmark_bbox;
+CREATE FUNCTION benchmark_bbox(cards int[] DEFAULT
+  ARRAY[1000, 10000, 100000, 1000000], repeat int DEFAULT 5)
+  RETURNS TABLE(temptype text, card int, total_ms float,
+    ns_per_instant float) AS $$
+DECLARE
+  starttime timestamptz;
+  floatinsts tfloat[];
+  geominsts tgeompoint[];
+  geom3dinsts tgeompoint[];
+  geoginsts tgeogpoint[];
+  size bigint;
+BEGIN
+  FOREACH card IN ARRAY cards
+  LOOP
+    SELECT array_agg(tfloat_inst(random() * 100,
+      '2000-01-01'::timestamptz + i * interval '1 sec') ORDER BY i)
+    INTO floatinsts FROM generate_series(1, card) i;
+    SELECT array_agg(tgeompoint_inst(ST_Point(random() * 100, random() * 100),
+      '2000-01-01'::timestamptz + i * interval '1 sec') ORDER BY i)
+    INTO geominsts FROM generate_series(1, card) i;
+    SELECT array_agg(tgeompoint_inst(ST_MakePoint(random() * 100,
+      random() * 100, random() * 100),
+      '2000-01-01'::timestamptz + i * interval '1 sec') ORDER BY i)
+    INTO geom3dinsts FROM generate_series(1, card) i;
+    SELECT array_agg(tgeogpoint_inst(ST_Point(random() * 10, random() * 10)::geography,
+      '2000-01-01'::timestamptz + i * interval '1 sec') ORDER BY i)
+    INTO geoginsts FROM generate_series(1, card) i;
+
+    FOREACH temptype IN ARRAY ARRAY['tfloat', 'tgeompoint', 'tgeompoint 3D',
+      'tgeompoint instant set', 'tgeogpoint instant set']
+    LOOP
+      starttime = clock_timestamp();
+      FOR j IN 1..repeat
+      LOOP
+        size = CASE temptype
+          WHEN 'tfloat' THEN memSize(tfloat_seq(floatinsts))
+          WHEN 'tgeompoint' THEN memSize(tgeompoint_seq(geominsts))
+          WHEN 'tgeompoint 3D' THEN memSize(tgeompoint_seq(geom3dinsts))
+          WHEN 'tgeompoint instant set' THEN memSize(tgeompoint_instset(geominsts))
+          ELSE memSize(tgeogpoint_instset(geoginsts)) END;
+      END LOOP;
+      total_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+      ns_per_instant = total_ms * 1e6 / (card::float * repeat);
+      RETURN NEXT;
+    END LOOP;
+  END LOOP;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_tagg.sql
+ * Microbenchmark of temporal aggregates over ordered and shuffled input.
+ *
+ * The aggregate state appends the values that start after the last value
+ * of the state without searching the state, so that aggregating rows
+ * ordered by time should be faster than aggregating the same rows in
+ * random order. Parallel aggregation is disabled during the benchmark so
+ * that the order of the input is preserved.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_tcount();
+ * SELECT * FROM benchmark_tcount(1000000);
+ * @endcode
+ */
+
+/**
+ * Measure the time needed for computing the temporal count of instants
+ * and of overlapping sequences in time order and in random order
+ *
+ * @param[in] card Number of rows aggregated
+ */
+DROP FUNCTION IF EXISTS benchmark_tcount;
+CREATE FUNCTION benchmark_tcount(card int DEFAULT 10000000)
+  RETURNS TABLE(agg text, input text, total_ms float) AS $$
+DECLARE
+  starttime timestamptz;
+  count int;
+BEGIN
+  PERFORM set_config('max_parallel_workers_per_gather', '0', true);
+  DROP TABLE IF EXISTS tbl_benchmark_tagg;
+  CREATE TEMPORARY TABLE tbl_benchmark_tagg AS
+  SELECT i, random() AS r,
+    tint_inst(i, timestamptz '2000-01-01' + i * interval '1 sec') AS inst,
+    tint_seq(ARRAY[
+      tint_inst(i, timestamptz '2000-01-01' + i * interval '1 sec'),
+      tint_inst(i, timestamptz '2000-01-01' + (i + 1) * interval '1 sec')],
+      true, false) AS seq
+  FROM generate_series(1, card) i;
+
+  FOREACH input IN ARRAY ARRAY['ordered', 'shuffled']
+  LOOP
+    agg = 'tcount(instant)';
+    starttime = clock_timestamp();
+    IF input = 'ordered' THEN
+      SELECT numInstants(tcount(inst ORDER BY i)) INTO count
+      FROM tbl_benchmark_tagg;
+    ELSE
+      SELECT numInstants(tcount(inst ORDER BY r)) INTO count
+      FROM tbl_benchmark_tagg;
+    END IF;
+    total_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+
+    agg = 'tcount(sequence)';
+    starttime = clock_timestamp();
+    IF input = 'ordered' THEN
+      SELECT numInstants(tcount(seq ORDER BY i)) INTO count
+      FROM tbl_benchmark_tagg;
+    ELSE
+      SELECT numInstants(tcount(seq ORDER BY r)) INTO count
+      FROM tbl_benchmark_tagg;
+    END IF;
+    total_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+  END LOOP;
+
+  DROP TABLE tbl_benchmark_tagg;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_brin.sql
+ * Benchmark of the build and scan times of BRIN indexes compared to GiST
+ * indexes on append-only tables of temporal points ordered by time.
+ *
+ * A table of trips is generated with each trip starting one second after the
+ * previous one, so that the physical order of the table follows time as in
+ * ingestion tables. Then, for each index type, the index is built, its size
+ * is measured, and `repeat` queries with a time window and with a
+ * spatiotemporal window are executed with sequential scans disabled.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_brin();
+ * SELECT * FROM benchmark_brin(10000000, 3);
+ * @endcode
+ */
+
+/**
+ * Measure the build time, size, and scan time of GiST and BRIN indexes
+ *
+ * @param[in] ntrips Number of trips in the table
+ * @param[in] repeat Number of executions of each query
+ */
+DROP FUNCTION IF EXISTS benchmark_brin;
+CREATE FUNCTION benchmark_brin(ntrips int DEFAULT 1000000,
+  repeat int DEFAULT 5)
+  RETURNS TABLE(indextype text, query text, build_ms float, size_mb float,
+    scan_ms float, count bigint) AS $$
+DECLARE
+  starttime timestamptz;
+  endtime timestamptz;
+  buildtime float;
+  indexsize float;
+  queries text[] = ARRAY[
+    'temp && period ''[2000-01-02, 2000-01-02 01:00]''',
+    'temp && stbox ''STBOX T((0,0,2000-01-02),(100,100,2000-01-02 01:00))''',
+    'temp && stbox ''STBOX((0,0),(100,100))'''];
+  names text[] = ARRAY['period', 'stbox xt', 'stbox x'];
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_brin;
+  CREATE TABLE tbl_benchmark_brin AS
+  SELECT k, tgeompoint_seq(array_agg(tgeompoint_inst(
+    ST_Point(x + i * 10, y + i * 10),
+    '2000-01-01'::timestamptz + k * interval '1 sec' + i * interval '1 min')
+    ORDER BY i)) AS temp
+  FROM (SELECT k, random() * 10000 AS x, random() * 10000 AS y
+    FROM generate_series(1, ntrips) k) t, generate_series(0, 9) i
+  GROUP BY k, x, y ORDER BY k;
+  ANALYZE tbl_benchmark_brin;
+  PERFORM set_config('enable_seqscan', 'off', true);
+
+  FOREACH indextype IN ARRAY ARRAY['gist', 'brin']
+  LOOP
+    starttime = clock_timestamp();
+    EXECUTE format('CREATE INDEX tbl_benchmark_brin_idx ON tbl_benchmark_brin '
+      'USING %s(temp)', indextype);
+    endtime = clock_timestamp();
+    buildtime = EXTRACT(epoch FROM endtime - starttime) * 1000;
+    indexsize = pg_relation_size('tbl_benchmark_brin_idx') / 1048576.0;
+    FOR i IN 1..array_length(queries, 1)
+    LOOP
+      query = names[i];
+      build_ms = buildtime;
+      size_mb = indexsize;
+      starttime = clock_timestamp();
+      FOR j IN 1..repeat
+      LOOP
+        EXECUTE format('SELECT COUNT(*) FROM tbl_benchmark_brin WHERE %s',
+          queries[i]) INTO count;
+      END LOOP;
+      scan_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000 /
+        repeat;
+      RETURN NEXT;
+    END LOOP;
+    DROP INDEX tbl_benchmark_brin_idx;
+  END LOOP;
+  DROP TABLE tbl_benchmark_brin;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_compression.sql
+ * Size and throughput benchmark of the columnar and compressed storage of
+ * temporal points.
+ *
+ * The trips mimic BerlinMOD GPS traces: vehicles report their position every
+ * `period` seconds with a jitter of up to `jitter` milliseconds, and move at
+ * a speed of up to `maxspeed` meters per second in a projected coordinate
+ * system. Each storage is materialized in a table, and the benchmark reports
+ * the total size of the column, the compression ratio with respect to the
+ * default storage, and the time needed to scan the column while unpacking the
+ * values. Example of use:
+ * @code
+ * SELECT * FROM benchmark_tpoint_compression(1000, 720);
+ * @endcode
+ */
+
+/**
+ * Generate a trip of a vehicle sampled at near-regular intervals
+ *
+ * @param[in] card Number of instants
+ * @param[in] starttime Start timestamp
+ * @param[in] period Number of seconds between two consecutive positions
+ * @param[in] jitter Maximum number of milliseconds of sampling jitter
+ * @param[in] maxspeed Maximum speed in meters per second
+ * @param[in] srid SRID of the coordinates
+ */
+DROP FUNCTION IF EXISTS berlinmod_trip;
+CREATE FUNCTION berlinmod_trip(card int, starttime timestamptz,
+  period int DEFAULT 2, jitter int DEFAULT 20, maxspeed float DEFAULT 15,
+  srid int DEFAULT 3857)
+  RETURNS tgeompoint AS $$
+DECLARE
+  x float;
+  y float;
+  angle float;
+  result tgeompoint[];
+BEGIN
+  x = 1480000 + random() * 20000;
+  y = 6890000 + random() * 20000;
+  angle = random() * 2 * pi();
+  FOR i IN 1..card
+  LOOP
+    result[i] = tgeompoint_inst(ST_SetSRID(ST_Point(round(x::numeric, 2),
+      round(y::numeric, 2)), srid), starttime + (i - 1) * period * interval '1 sec' +
+      floor(random() * jitter) * interval '1 ms');
+    /* Vehicles mostly keep their direction */
+    angle = angle + (random() - 0.5) * pi() / 8;
+    x = x + cos(angle) * random() * maxspeed * period;
+    y = y + sin(angle) * random() * maxspeed * period;
+  END LOOP;
+  RETURN tgeompoint_seq(result);
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+/**
+ * Compare the size and the scan time of the storages of temporal points
+ *
+ * @param[in] size Number of trips
+ * @param[in] card Number of instants per trip
+ */
+DROP FUNCTION IF EXISTS benchmark_tpoint_compression;
+CREATE FUNCTION benchmark_tpoint_compression(size int DEFAULT 1000,
+  card int DEFAULT 720)
+  RETURNS TABLE(storage text, bytes bigint, ratio float, scan_ms float) AS $$
+DECLARE
+  starttime timestamptz;
+  basesize bigint;
+  points bigint;
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_trips;
+  CREATE TABLE tbl_benchmark_trips AS
+  SELECT k, berlinmod_trip(card, '2020-06-01'::timestamptz + random() * interval '1 day') AS trip
+  FROM generate_series(1, size) k;
+  SELECT SUM(pg_column_size(trip)) INTO basesize FROM tbl_benchmark_trips;
+
+  FOREACH storage IN ARRAY ARRAY['default', 'columnar', 'compressed',
+    'compressed, precision 2']
+  LOOP
+    DROP TABLE IF EXISTS tbl_benchmark_storage;
+    EXECUTE format('CREATE TABLE tbl_benchmark_storage AS SELECT k, %s AS trip '
+      'FROM tbl_benchmark_trips', CASE storage
+      WHEN 'default' THEN 'trip'
+      WHEN 'columnar' THEN 'toColumnar(trip)'
+      WHEN 'compressed' THEN 'compress(trip)'
+      ELSE 'compress(trip, 2)' END);
+    SELECT SUM(pg_column_size(trip)) INTO bytes FROM tbl_benchmark_storage;
+    ratio = basesize::float / bytes;
+    /* Decoding the values is forced by a function reading all the points,
+     * numInstants only reads the header of the values */
+    starttime = clock_timestamp();
+    SELECT SUM(ST_NPoints(getValues(trip))) INTO points
+    FROM tbl_benchmark_storage;
+    scan_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+  END LOOP;
+  DROP TABLE tbl_benchmark_storage;
+  DROP TABLE tbl_benchmark_trips;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_gist_build.sql
+ * Benchmark of the sorted build of GiST indexes on temporal points, available
+ * since PostgreSQL 14, compared to the build by successive insertions.
+ *
+ * A table of trips is generated in random physical order. Then, for each
+ * build method, the index is built, its size is measured, and `repeat`
+ * queries with a spatiotemporal window are executed with sequential scans
+ * disabled. The quality of the index is measured by the number of index pages
+ * visited by the queries, which is obtained from the buffer statistics of the
+ * bitmap index scan. The build by insertions is forced with the option
+ * `buffering = on` since the sorted build is used by default when the
+ * operator class provides a sortsupport function.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_gist_build();
+ * SELECT * FROM benchmark_gist_build(10000000, 3);
+ * @endcode
+ */
+
+/**
+ * Measure the build time, size, and pages visited of GiST indexes built with
+ * and without sorting
+ *
+ * @param[in] ntrips Number of trips in the table
+ * @param[in] repeat Number of executions of each query
+ */
+DROP FUNCTION IF EXISTS benchmark_gist_build;
+CREATE FUNCTION benchmark_gist_build(ntrips int DEFAULT 1000000,
+  repeat int DEFAULT 5)
+  RETURNS TABLE(build text, query text, build_ms float, size_mb float,
+    scan_ms float, pages float, count bigint) AS $$
+DECLARE
+  starttime timestamptz;
+  buildtime float;
+  indexsize float;
+  plan json;
+  node jsonb;
+  builds text[] = ARRAY['sorted', 'insert'];
+  options text[] = ARRAY['', 'WITH (buffering = on)'];
+  queries text[] = ARRAY[
+    'temp && stbox ''STBOX T((0,0,2000-01-02),(1000,1000,2000-01-02 01:00))''',
+    'temp && stbox ''STBOX((0,0),(100,100))''',
+    'temp && period ''[2000-01-02, 2000-01-02 00:10]'''];
+  names text[] = ARRAY['stbox xt', 'stbox x', 'period'];
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_gist_build;
+  CREATE TABLE tbl_benchmark_gist_build AS
+  SELECT k, tgeompoint_seq(array_agg(tgeompoint_inst(
+    ST_Point(x + i * 10, y + i * 10),
+    '2000-01-01'::timestamptz + k * interval '1 sec' + i * interval '1 min')
+    ORDER BY i)) AS temp
+  FROM (SELECT k, random() * 10000 AS x, random() * 10000 AS y
+    FROM generate_series(1, ntrips) k) t, generate_series(0, 9) i
+  GROUP BY k, x, y ORDER BY random();
+  ANALYZE tbl_benchmark_gist_build;
+  PERFORM set_config('enable_seqscan', 'off', true);
+  FOR b IN 1..array_length(builds, 1)
+  LOOP
+    build = builds[b];
+    starttime = clock_timestamp();
+    EXECUTE format('CREATE INDEX tbl_benchmark_gist_build_idx ON '
+      'tbl_benchmark_gist_build USING gist(temp) %s', options[b]);
+    buildtime = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    indexsize = pg_relation_size('tbl_benchmark_gist_build_idx') / 1048576.0;
+    FOR i IN 1..array_length(queries, 1)
+    LOOP
+      query = names[i];
+      build_ms = buildtime;
+      size_mb = indexsize;
+      pages = 0;
+      starttime = clock_timestamp();
+      FOR j IN 1..repeat
+      LOOP
+        EXECUTE format('EXPLAIN (ANALYZE, BUFFERS, FORMAT JSON) '
+          'SELECT COUNT(*) FROM tbl_benchmark_gist_build WHERE %s',
+          queries[i]) INTO plan;
+        node = jsonb_path_query_first(plan::jsonb,
+          '$.**?(@."Node Type" == "Bitmap Index Scan")');
+        pages = pages + (node ->> 'Shared Hit Blocks')::float +
+          (node ->> 'Shared Read Blocks')::float;
+      END LOOP;
+      scan_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000 /
+        repeat;
+      pages = pages / repeat;
+      EXECUTE format('SELECT COUNT(*) FROM tbl_benchmark_gist_build WHERE %s',
+        queries[i]) INTO count;
+      RETURN NEXT;
+    END LOOP;
+    DROP INDEX tbl_benchmark_gist_build_idx;
+  END LOOP;
+  DROP TABLE tbl_benchmark_gist_build;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_similarity.sql
+ * Benchmark of the similarity distance functions when looking for the trips
+ * that are similar to a given one.
+ *
+ * A table of long trips is generated, where each trip is a random walk from a
+ * random starting point. Then, the distance between the first trip and all the
+ * other ones is computed without restriction, with a warping window, and with
+ * a maximum distance, and the number of trips whose distance is not greater
+ * than the maximum distance and the execution time are reported.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_similarity();
+ * SELECT * FROM benchmark_similarity(1000, 2000, 500);
+ * @endcode
+ */
+
+/**
+ * Measure the execution time of the Frechet and DTW distance functions
+ *
+ * @param[in] ntrips Number of trips
+ * @param[in] ninsts Number of instants of each trip
+ * @param[in] maxdist Maximum Frechet distance, the maximum DTW distance is
+ * this value times the number of instants
+ */
+DROP FUNCTION IF EXISTS benchmark_similarity;
+CREATE FUNCTION benchmark_similarity(ntrips int DEFAULT 200,
+  ninsts int DEFAULT 1000, maxdist float DEFAULT 500)
+  RETURNS TABLE(func text, band int, threshold float, count bigint,
+    time_ms float) AS $$
+DECLARE
+  starttime timestamptz;
+  bands int[] = ARRAY[-1, ninsts / 10, -1];
+  thresholds float[] = ARRAY['Infinity', 'Infinity', maxdist];
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_similarity;
+  CREATE TABLE tbl_benchmark_similarity AS
+  SELECT k, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(x, y), t)
+    ORDER BY t)) AS temp
+  FROM (SELECT k, t,
+      x0 + SUM(random() * 20 - 10) OVER w AS x,
+      y0 + SUM(random() * 20 - 10) OVER w AS y
+    FROM (SELECT k, random() * 1000 AS x0, random() * 1000 AS y0
+      FROM generate_series(1, ntrips) k) t1,
+      generate_series('2000-01-01'::timestamptz,
+        '2000-01-01'::timestamptz + (ninsts - 1) * interval '1 min',
+        interval '1 min') t
+    WINDOW w AS (PARTITION BY k ORDER BY t)) t2
+  GROUP BY k;
+  FOR i IN 1..3
+  LOOP
+    band = bands[i];
+    func = 'frechetDistance';
+    threshold = thresholds[i];
+    starttime = clock_timestamp();
+    SELECT COUNT(*) INTO count
+    FROM tbl_benchmark_similarity t1, tbl_benchmark_similarity t2
+    WHERE t1.k = 1 AND t2.k > 1 AND
+      frechetDistance(t1.temp, t2.temp, band, threshold) <= threshold;
+    time_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+    func = 'dynamicTimeWarp';
+    threshold = thresholds[i] * ninsts;
+    starttime = clock_timestamp();
+    SELECT COUNT(*) INTO count
+    FROM tbl_benchmark_similarity t1, tbl_benchmark_similarity t2
+    WHERE t1.k = 1 AND t2.k > 1 AND
+      dynamicTimeWarp(t1.temp, t2.temp, band, threshold) <= threshold;
+    time_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+  END LOOP;
+  DROP TABLE tbl_benchmark_similarity;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_spgist.sql
+ * Benchmark of the quadtree and k-d tree SP-GiST indexes on temporal points.
+ *
+ * A table of trips resembling those of the BerlinMOD benchmark is generated,
+ * where the trips start at a few hot spots and the start times follow the
+ * daily peaks of traffic, so that the data is skewed both in space and time.
+ * Then, for each operator class, the trips are inserted into an empty table
+ * with the index, the size of the index is measured, and `repeat` queries
+ * with the overlaps operator and nearest-neighbor queries with the nearest
+ * approach distance operator are executed with sequential scans disabled.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_spgist();
+ * SELECT * FROM benchmark_spgist(1000000, 3);
+ * @endcode
+ */
+
+/**
+ * Measure the insertion time, size, and query times of the quadtree and k-d
+ * tree SP-GiST indexes
+ *
+ * @param[in] ntrips Number of trips in the table
+ * @param[in] repeat Number of executions of each query
+ */
+DROP FUNCTION IF EXISTS benchmark_spgist;
+CREATE FUNCTION benchmark_spgist(ntrips int DEFAULT 100000,
+  repeat int DEFAULT 5)
+  RETURNS TABLE(opclass text, query text, insert_ms float, size_mb float,
+    query_ms float, count bigint) AS $$
+DECLARE
+  starttime timestamptz;
+  inserttime float;
+  indexsize float;
+  queries text[] = ARRAY[
+    'SELECT COUNT(*) FROM tbl_benchmark_spgist WHERE temp && '
+      'stbox ''STBOX T((0,0,2000-01-01 08:00),(1000,1000,2000-01-01 09:00))''',
+    'SELECT COUNT(*) FROM tbl_benchmark_spgist WHERE temp && '
+      'stbox ''STBOX((4000,4000),(6000,6000))''',
+    'SELECT COUNT(*) FROM (SELECT k FROM tbl_benchmark_spgist ORDER BY '
+      'temp |=| geometry ''Point(5000 5000)'' LIMIT 10) t',
+    'SELECT COUNT(*) FROM (SELECT k FROM tbl_benchmark_spgist ORDER BY '
+      'temp |=| tgeompoint ''[Point(0 0)@2000-01-01 08:00, '
+      'Point(1000 1000)@2000-01-01 09:00]'' LIMIT 10) t'];
+  names text[] = ARRAY['&& stbox xt', '&& stbox x', 'knn geometry',
+    'knn tgeompoint'];
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_spgist_trips;
+  CREATE TABLE tbl_benchmark_spgist_trips AS
+  SELECT k, tgeompoint_seq(array_agg(tgeompoint_inst(
+    ST_Point(x + i * dx, y + i * dy),
+    t + i * interval '1 min') ORDER BY i)) AS temp
+  FROM (SELECT k,
+    /* Start at one of 10 hot spots */
+    (k % 10) * 1000 + random() * 200 AS x,
+    (k % 10) * 1000 + random() * 200 AS y,
+    random() * 100 - 50 AS dx, random() * 100 - 50 AS dy,
+    /* Start around the morning or the evening peak of one of 7 days */
+    '2000-01-01'::timestamptz + (k % 7) * interval '1 day' +
+      CASE WHEN random() < 0.5 THEN interval '8 hours'
+      ELSE interval '17 hours' END + random() * interval '1 hour' AS t
+    FROM generate_series(1, ntrips) k) t, generate_series(0, 19) i
+  GROUP BY k, x, y, dx, dy, t;
+  PERFORM set_config('enable_seqscan', 'off', true);
+  FOREACH opclass IN ARRAY ARRAY['tgeompoint_quadtree_ops',
+    'tgeompoint_kdtree_ops']
+  LOOP
+    DROP TABLE IF EXISTS tbl_benchmark_spgist;
+    CREATE TABLE tbl_benchmark_spgist(k int, temp tgeompoint);
+    EXECUTE format('CREATE INDEX tbl_benchmark_spgist_idx ON '
+      'tbl_benchmark_spgist USING spgist(temp %s)', opclass);
+    starttime = clock_timestamp();
+    INSERT INTO tbl_benchmark_spgist SELECT * FROM tbl_benchmark_spgist_trips;
+    inserttime = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    indexsize = pg_relation_size('tbl_benchmark_spgist_idx') / 1048576.0;
+    ANALYZE tbl_benchmark_spgist;
+    FOR i IN 1..array_length(queries, 1)
+    LOOP
+      query = names[i];
+      insert_ms = inserttime;
+      size_mb = indexsize;
+      starttime = clock_timestamp();
+      FOR j IN 1..repeat
+      LOOP
+        EXECUTE queries[i] INTO count;
+      END LOOP;
+      query_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000 /
+        repeat;
+      RETURN NEXT;
+    END LOOP;
+  END LOOP;
+  DROP TABLE tbl_benchmark_spgist;
+  DROP TABLE tbl_benchmark_spgist_trips;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
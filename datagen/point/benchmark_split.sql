@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * benchmark_split.sql
+ * Benchmark of the functions splitting temporal points with respect to a
+ * spatial or a spatiotemporal grid.
+ *
+ * A table of long trips is generated, where each trip crosses the extent of
+ * the data diagonally, which is the worst case for the functions enumerating
+ * the tiles of the bounding box of a trip. Then, the trips are split with
+ * grids of decreasing tile size and the number of fragments obtained and the
+ * execution time are reported.
+ * Example of use:
+ * @code
+ * SELECT * FROM benchmark_split();
+ * SELECT * FROM benchmark_split(10000, 1000);
+ * @endcode
+ */
+
+/**
+ * Measure the execution time of the space and space-time split functions
+ *
+ * @param[in] ntrips Number of trips
+ * @param[in] ninsts Number of instants of each trip
+ */
+DROP FUNCTION IF EXISTS benchmark_split;
+CREATE FUNCTION benchmark_split(ntrips int DEFAULT 1000,
+  ninsts int DEFAULT 100)
+  RETURNS TABLE(func text, size float, count bigint, time_ms float) AS $$
+DECLARE
+  starttime timestamptz;
+  sizes float[] = ARRAY[1000, 100, 10];
+BEGIN
+  DROP TABLE IF EXISTS tbl_benchmark_split;
+  CREATE TABLE tbl_benchmark_split AS
+  SELECT k, tgeompoint_seq(array_agg(tgeompoint_inst(
+    ST_Point(x + i * 100000.0 / ninsts + random() * 10,
+      y + i * 100000.0 / ninsts + random() * 10),
+    '2000-01-01'::timestamptz + i * interval '1 min') ORDER BY i)) AS temp
+  FROM (SELECT k, random() * 1000 AS x, random() * 1000 AS y
+    FROM generate_series(1, ntrips) k) t, generate_series(0, ninsts - 1) i
+  GROUP BY k, x, y;
+  FOREACH size IN ARRAY sizes
+  LOOP
+    func = 'spaceSplit';
+    starttime = clock_timestamp();
+    SELECT COUNT(*) INTO count
+    FROM (SELECT spaceSplit(temp, size) FROM tbl_benchmark_split) t;
+    time_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+    func = 'spaceTimeSplit';
+    starttime = clock_timestamp();
+    SELECT COUNT(*) INTO count
+    FROM (SELECT spaceTimeSplit(temp, size, interval '10 min')
+      FROM tbl_benchmark_split) t;
+    time_ms = EXTRACT(epoch FROM clock_timestamp() - starttime) * 1000;
+    RETURN NEXT;
+  END LOOP;
+  DROP TABLE tbl_benchmark_split;
+  RETURN;
+END;
+$$ LANGUAGE PLPGSQL STRICT;
+
+-------------------------------------------------------------------------------
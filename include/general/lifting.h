@@ -49,6 +49,10 @@
  * function to every instant of the temporal value. The remaining parameters
  * are used by functions `tfunc_temporal_base` and `tfunc_temporal_temporal`
  * that apply the lifted function to two base values.
+ *
+ * When `arena` is true the intermediate values of a call are allocated in a
+ * scratch memory context that is reset at the end of the call, after copying
+ * the result into the memory context of the caller.
  */
 
 #define MAX_PARAMS 3
@@ -69,6 +73,8 @@ typedef struct
   bool (*tpfunc)(const TInstant *, const TInstant *, const TInstant *,
     const TInstant *, Datum *,
     TimestampTz *);          /**< Turning point function for two temporal types */
+  bool arena;                /**< True if the intermediate values are allocated in a scratch memory context */
+  Size arenabytes;           /**< Size in bytes of the memory held by the scratch memory context at the end of the last call */
 } LiftedFunctionInfo;
 
 /*****************************************************************************/
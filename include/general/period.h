@@ -104,6 +104,11 @@ extern bool period_gt(const Period *p1, const Period *p2);
 extern uint32 period_hash(const Period *p);
 extern uint64 period_hash_extended(const Period *p, Datum seed);
 
+/* Space-filling curve functions */
+
+extern uint64 period_zorder_key(const Period *p);
+extern void periodarr_sort_zorder(Period *periods, int count);
+
 /*****************************************************************************/
 
 #endif
@@ -38,6 +38,7 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <catalog/pg_type.h>
+#include <storage/buffile.h>
 /* MobilityDB */
 #include "general/temporal.h"
 
@@ -49,19 +50,22 @@
 #define SKIPLIST_MAXLEVEL 32  /**< maximum possible is 47 with current RNG */
 #define SKIPLIST_INITIAL_CAPACITY 1024
 #define SKIPLIST_GROW 1       /**< double the capacity to expand the skiplist */
-#define SKIPLIST_INITIAL_FREELIST 32
 
 /*****************************************************************************/
 
 /**
  * Structure to represent elements in the skiplists
+ *
+ * The links to the next elements at each level are kept in the pool of links
+ * of the skiplist starting at the position given by the field next, so that
+ * an element only takes as many links as its height.
  */
 
 typedef struct
 {
   void *value;
   int height;
-  int next[SKIPLIST_MAXLEVEL];
+  int next;         /**< Position of the links in the pool of the skiplist */
 } SkipListElem;
 
 typedef enum
@@ -71,6 +75,16 @@ typedef enum
   TEMPORAL
 } SkipListElemType;
 
+/**
+ * Structure to represent the position of a run spilled to disk in the
+ * temporary file shared by the states of an aggregate function
+ */
+typedef struct
+{
+  int fileno;
+  off_t offset;
+} SkipListRunPos;
+
 /**
  * Structure to represent skiplists that keep the current state of an aggregation
  */
@@ -80,13 +94,26 @@ typedef struct
   int capacity;
   int next;
   int length;
-  int *freed;
-  int freecount;
-  int freecap;
+  int freed[SKIPLIST_MAXLEVEL]; /**< Free elements for each height, the
+                                     first link of a free element keeps the
+                                     next one, 0 ends the list */
+  int linkcapacity; /**< Number of links allocated in the pool */
+  int linknext;     /**< First link of the pool not yet used */
   int tail;
+  bool tailvalid;   /**< True when tailpred is up to date */
+  int tailpred[SKIPLIST_MAXLEVEL]; /**< Last element before the tail at each
+                                        level, used for appending values */
   void *extra;
   size_t extrasize;
+  size_t valuesize; /**< Size of the values kept outside of the elements */
+  BufFile *spill;   /**< Temporary file of the runs spilled to disk */
+  SkipListRunPos *spillpos; /**< Positions of the runs spilled to disk */
+  int spillruns;    /**< Number of runs spilled to disk */
+  size_t spillbytes; /**< Number of bytes spilled to disk */
+  datum_func2 spillfunc; /**< Function for merging the spilled runs */
+  bool spillcrossings;   /**< Crossings for merging the spilled runs */
   SkipListElem *elems;
+  int *links;       /**< Pool of links of the elements */
 } SkipList;
 
 /*****************************************************************************/
@@ -96,7 +123,12 @@ extern SkipList *skiplist_make(FunctionCallInfo fcinfo, void **values,
 extern void *skiplist_headval(SkipList *list);
 extern void skiplist_splice(FunctionCallInfo fcinfo, SkipList *list,
   void **values, int count, datum_func2 func, bool crossings);
+extern SkipList *skiplist_merge(FunctionCallInfo fcinfo, SkipList *list1,
+  SkipList *list2, datum_func2 func, bool crossings);
+extern void **skiplist_final_values(FunctionCallInfo fcinfo, SkipList *list,
+  int *count);
 extern void **skiplist_values(SkipList *list);
+extern size_t skiplist_memsize(const SkipList *list);
 extern void aggstate_set_extra(FunctionCallInfo fcinfo, SkipList *state,
   void *data, size_t size);
 
@@ -159,6 +159,11 @@ extern TBOX *union_tbox_tbox(const TBOX *box1, const TBOX *box2);
 extern int tbox_cmp(const TBOX *box1, const TBOX *box2);
 extern bool tbox_eq(const TBOX *box1, const TBOX *box2);
 
+/* Space-filling curve functions */
+
+extern uint64 tbox_zorder_key(const TBOX *box);
+extern void tboxarr_sort_zorder(TBOX *boxes, int count);
+
 /*****************************************************************************/
 
 #endif
@@ -113,6 +113,13 @@
 #define NORMALIZE       true
 #define NORMALIZE_NO    false
 
+/** Symbolic constants for the append functions */
+#define EXPAND          true
+#define EXPAND_NO       false
+
+/** Initial number of instants of an expandable sequence */
+#define MOBDB_EXPAND_INIT_COUNT   64
+
 #define LINEAR          true
 #define STEP            false
 
@@ -170,7 +177,11 @@ struct tempsubtype_struct
 
 /*****************************************************************************
  * Macros for manipulating the 'flags' element where the less significant
- * bits are GTZXLCB, where
+ * bits are EPAGTZXLCB, where
+ *   E: expandable sequence with free space for appending instants, only
+ *      used in memory
+ *   P: compressed (packed) storage of the composing instants
+ *   A: columnar storage (structure of arrays) of the composing instants
  *   G: coordinates are geodetic
  *   T: has T coordinate,
  *   Z: has Z coordinate
@@ -191,6 +202,9 @@ struct tempsubtype_struct
 #define MOBDB_FLAG_Z          0x0010
 #define MOBDB_FLAG_T          0x0020
 #define MOBDB_FLAG_GEODETIC   0x0040
+#define MOBDB_FLAG_COLUMNAR   0x0080
+#define MOBDB_FLAG_COMPRESSED 0x0100
+#define MOBDB_FLAG_EXPANDABLE 0x0200
 
 /* The following flag is only used for TInstant */
 #define MOBDB_FLAGS_GET_BYVAL(flags)      ((bool) (((flags) & MOBDB_FLAG_BYVAL)))
@@ -200,6 +214,9 @@ struct tempsubtype_struct
 #define MOBDB_FLAGS_GET_Z(flags)          ((bool) (((flags) & MOBDB_FLAG_Z)>>4))
 #define MOBDB_FLAGS_GET_T(flags)          ((bool) (((flags) & MOBDB_FLAG_T)>>5))
 #define MOBDB_FLAGS_GET_GEODETIC(flags)   ((bool) (((flags) & MOBDB_FLAG_GEODETIC)>>6))
+#define MOBDB_FLAGS_GET_COLUMNAR(flags)   ((bool) (((flags) & MOBDB_FLAG_COLUMNAR)>>7))
+#define MOBDB_FLAGS_GET_COMPRESSED(flags) ((bool) (((flags) & MOBDB_FLAG_COMPRESSED)>>8))
+#define MOBDB_FLAGS_GET_EXPANDABLE(flags) ((bool) (((flags) & MOBDB_FLAG_EXPANDABLE)>>9))
 
 /* The following flag is only used for TInstant */
 #define MOBDB_FLAGS_SET_BYVAL(flags, value) \
@@ -216,6 +233,12 @@ struct tempsubtype_struct
   ((flags) = (value) ? ((flags) | MOBDB_FLAG_T) : ((flags) & ~MOBDB_FLAG_T))
 #define MOBDB_FLAGS_SET_GEODETIC(flags, value) \
   ((flags) = (value) ? ((flags) | MOBDB_FLAG_GEODETIC) : ((flags) & ~MOBDB_FLAG_GEODETIC))
+#define MOBDB_FLAGS_SET_COLUMNAR(flags, value) \
+  ((flags) = (value) ? ((flags) | MOBDB_FLAG_COLUMNAR) : ((flags) & ~MOBDB_FLAG_COLUMNAR))
+#define MOBDB_FLAGS_SET_COMPRESSED(flags, value) \
+  ((flags) = (value) ? ((flags) | MOBDB_FLAG_COMPRESSED) : ((flags) & ~MOBDB_FLAG_COMPRESSED))
+#define MOBDB_FLAGS_SET_EXPANDABLE(flags, value) \
+  ((flags) = (value) ? ((flags) | MOBDB_FLAG_EXPANDABLE) : ((flags) & ~MOBDB_FLAG_EXPANDABLE))
 
 /*****************************************************************************
  * Definitions for bucketing and tiling
@@ -260,6 +283,7 @@ struct tempsubtype_struct
 #define RTFrontStrategyNumber         33    /* for <</ */
 #define RTBackStrategyNumber          34    /* for />> */
 #define RTOverBackStrategyNumber      35    /* for /&> */
+#define RTOverlapsSegmentsStrategyNumber 36 /* for ?&& */
 
 /*****************************************************************************
  * Struct definitions for temporal types
@@ -316,6 +340,8 @@ typedef struct
   int16         flags;        /**< flags */
   int32         count;        /**< number of TInstant elements */
   int16         bboxsize;     /**< size of the bounding box */
+  int16         tindexblock;  /**< number of instants per entry of the time
+                                   index, 0 if there is no index */
   Period        period;       /**< time span (24 bytes) */
   /**< beginning of variable-length data */
 } TSequence;
@@ -432,13 +458,21 @@ typedef struct
 
 /* Temporal types */
 
-#define DatumGetTemporalP(X)       ((Temporal *) PG_DETOAST_DATUM(X))
+/* Values stored in columnar or compressed form are unpacked as a fallback
+ * for the functions that need the instants, while the accessors that can
+ * read the stored form use PG_GETARG_TEMPORAL_STORED_P and the functions
+ * whose loops over the instants read the columnar form use
+ * PG_GETARG_TEMPORAL_COLUMNAR_P */
+#define DatumGetTemporalP(X)       (temporal_unpack_datum(X))
 #define DatumGetTInstantP(X)       ((TInstant *) PG_DETOAST_DATUM(X))
 #define DatumGetTInstantSetP(X)    ((TInstantSet *) PG_DETOAST_DATUM(X))
 #define DatumGetTSequenceP(X)      ((TSequence *) PG_DETOAST_DATUM(X))
 #define DatumGetTSequenceSetP(X)   ((TSequenceSet *) PG_DETOAST_DATUM(X))
 
-#define PG_GETARG_TEMPORAL_P(X)    ((Temporal *) PG_GETARG_VARLENA_P(X))
+#define PG_GETARG_TEMPORAL_P(X)    (temporal_unpack_datum(PG_GETARG_DATUM(X)))
+#define PG_GETARG_TEMPORAL_STORED_P(X) ((Temporal *) PG_GETARG_VARLENA_P(X))
+#define PG_GETARG_TEMPORAL_COLUMNAR_P(X) \
+  (temporal_uncompress_datum(PG_GETARG_DATUM(X)))
 
 #define PG_GETARG_ANYDATUM(X) (get_typlen(get_fn_expr_argtype(fcinfo->flinfo, X)) == -1 ? \
   PointerGetDatum(PG_GETARG_VARLENA_P(X)) : PG_GETARG_DATUM(X))
@@ -536,8 +570,12 @@ extern Temporal *temporal_from_base(const Temporal *temp, Datum value,
 
 /* Append and merge functions */
 
-extern Temporal *temporal_append_tinstant(const Temporal *temp,
-  const Temporal *inst);
+extern Temporal *temporal_append_tinstant(Temporal *temp,
+  const Temporal *inst, bool expand);
+extern Temporal *temporal_compact(const Temporal *temp);
+extern Temporal *temporal_unpack(Temporal *temp);
+extern Temporal *temporal_unpack_datum(Datum value);
+extern Temporal *temporal_uncompress_datum(Datum value);
 extern Temporal *temporal_merge(const Temporal *temp1, const Temporal *temp2);
 extern Temporal *temporal_merge_array(Temporal **temparr, int count);
 
@@ -48,6 +48,12 @@
 
 /*****************************************************************************/
 
+/** Number of values gathered from an array of instants for computing their
+ * extent with #doublearr_extent */
+#define EXTENT_CHUNK 256
+
+/*****************************************************************************/
+
 /* Functions on generic bounding boxes of temporal types */
 
 extern size_t temporal_max_bbox_size();
@@ -61,6 +67,9 @@ extern void temporal_bbox_shift_tscale(void *box, const Interval *start,
 
 /* Compute the bounding box at the creation of temporal values */
 
+extern void doublearr_extent(const double *values, int count, double *min,
+  double *max);
+
 extern size_t temporal_bbox_size(CachedType tempype);
 extern void tinstant_make_bbox(const TInstant *inst, void *bbox);
 extern void tinstantset_make_bbox(const TInstant **inst, int count,
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_columnar.h
+ * @brief Columnar (structure of arrays) storage of temporal sequences.
+ */
+
+#ifndef __TEMPORAL_COLUMNAR_H__
+#define __TEMPORAL_COLUMNAR_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+extern bool temptype_columnar(CachedType temptype);
+extern void ensure_temptype_columnar(CachedType temptype);
+extern int tsequence_columnar_ncols(const TSequence *seq);
+extern size_t tsequence_columnar_size(const TSequence *seq);
+extern TimestampTz *tsequence_columnar_times(const TSequence *seq);
+extern void *tsequence_columnar_values(const TSequence *seq, int col);
+extern Datum tsequence_columnar_value_n(const TSequence *seq, int n);
+
+extern TSequence *tsequence_to_columnar(const TSequence *seq);
+extern TSequence *tsequence_from_columnar(const TSequence *seq);
+extern TSequenceSet *tsequenceset_to_columnar(const TSequenceSet *ts);
+extern TSequenceSet *tsequenceset_from_columnar(const TSequenceSet *ts);
+extern Temporal *temporal_to_columnar(const Temporal *temp);
+extern Temporal *temporal_from_columnar(const Temporal *temp);
+extern const TInstant *tsequence_inst_n_buf(const TSequence *seq, int n,
+  TInstant **buf);
+extern void tinstant_buf_free(TInstant **buf);
+
+extern Datum tcolumnar_segment_value_at_timestamp(const TSequence *seq,
+  Datum value1, Datum value2, TimestampTz t1, TimestampTz t2, TimestampTz t);
+extern bool tsequence_columnar_value_at_timestamp(const TSequence *seq,
+  TimestampTz t, Datum *result);
+extern bool temporal_columnar_value_at_timestamp(const Temporal *temp,
+  TimestampTz t, Datum *result);
+extern Datum temporal_columnar_start_value(const Temporal *temp);
+extern Datum temporal_columnar_end_value(const Temporal *temp);
+extern bool temporal_columnar_timestamp_n(const Temporal *temp, int n,
+  TimestampTz *result);
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_COLUMNAR_H__ */
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_compress.h
+ * @brief Compressed storage of temporal sequences.
+ */
+
+#ifndef __TEMPORAL_COMPRESS_H__
+#define __TEMPORAL_COMPRESS_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+/** Maximum number of streams: timestamps and at most three coordinates */
+#define MOBDB_COMPRESS_MAXSTREAMS 4
+/** Maximum number of decimal digits of quantized values */
+#define MOBDB_COMPRESS_MAXPRECISION 9
+/** Number of values between two restart points of the streams */
+#define MOBDB_COMPRESS_RESTART 64
+
+/**
+ * Structure to represent the header of the compressed streams of a temporal
+ * sequence, which is located after the bounding box
+ */
+typedef struct
+{
+  int16         precision;    /**< decimal digits of quantized values, -1 if not quantized */
+  int16         nstreams;     /**< number of streams */
+  uint32        streamsize[MOBDB_COMPRESS_MAXSTREAMS]; /**< size in bytes of each stream */
+} TCompressHeader;
+
+/*****************************************************************************/
+
+extern TSequence *tsequence_compress(const TSequence *seq, int precision);
+extern TSequence *tsequence_decompress(const TSequence *seq);
+extern TSequenceSet *tsequenceset_compress(const TSequenceSet *ts,
+  int precision);
+extern TSequenceSet *tsequenceset_decompress(const TSequenceSet *ts);
+extern Temporal *temporal_compress(const Temporal *temp, int precision);
+extern Temporal *temporal_decompress(const Temporal *temp);
+
+extern bool tsequence_compressed_value_at_timestamp(const TSequence *seq,
+  TimestampTz t, Datum *result);
+extern bool temporal_compressed_value_at_timestamp(const Temporal *temp,
+  TimestampTz t, Datum *result);
+extern Datum temporal_compressed_start_value(const Temporal *temp);
+extern Datum temporal_compressed_end_value(const Temporal *temp);
+extern bool temporal_compressed_timestamp_n(const Temporal *temp, int n,
+  TimestampTz *result);
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_COMPRESS_H__ */
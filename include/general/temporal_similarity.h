@@ -68,7 +68,7 @@ typedef struct
 /*****************************************************************************/
 
 extern double temporal_similarity(Temporal *temp1, Temporal *temp2,
-  SimFunc simfunc);
+  int window, double maxdist, SimFunc simfunc);
 extern Match *temporal_similarity_path(Temporal *temp1, Temporal *temp2,
   int *count, SimFunc simfunc);
 
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_sketch.h
+ * Approximate temporal aggregate functions based on time-bucketed sketches
+ */
+
+#ifndef __TEMPORAL_SKETCH_H__
+#define __TEMPORAL_SKETCH_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+#include <utils/timestamp.h>
+
+/*****************************************************************************/
+
+/**
+ * Number of bits of the hash used for selecting a HyperLogLog register, the
+ * standard error of the distinct count is 1.04 / sqrt(2^HLL_PRECISION)
+ */
+#define HLL_PRECISION     12
+#define HLL_REGISTERS     (1 << HLL_PRECISION)
+
+/** Compression of the t-digests, which bounds their number of centroids */
+#define TDIGEST_COMPRESSION  100
+/** Number of values buffered before they are merged into the centroids */
+#define TDIGEST_BUFFER       256
+
+/**
+ * Enumeration for the sketches kept in the time buckets
+ */
+typedef enum
+{
+  SKETCH_HLL,
+  SKETCH_TDIGEST,
+} SketchType;
+
+/**
+ * HyperLogLog sketch estimating the number of distinct values
+ */
+typedef struct
+{
+  uint8 registers[HLL_REGISTERS];
+} HLLSketch;
+
+/**
+ * Centroid of a t-digest
+ */
+typedef struct
+{
+  double mean;
+  double weight;
+} TDigestCentroid;
+
+/**
+ * Merging t-digest estimating the quantiles of a set of values
+ */
+typedef struct
+{
+  double min;            /**< Minimum value added */
+  double max;            /**< Maximum value added */
+  double total;          /**< Total weight, i.e., number of values added */
+  int ncentroids;        /**< Number of centroids */
+  int nbuffer;           /**< Number of values not yet merged */
+  TDigestCentroid centroids[TDIGEST_COMPRESSION];
+  double buffer[TDIGEST_BUFFER];
+} TDigest;
+
+/**
+ * Time bucket of the state with its sketch
+ */
+typedef struct
+{
+  TimestampTz t;         /**< Initial timestamp of the bucket */
+  void *sketch;          /**< HLLSketch or TDigest */
+} SketchBucket;
+
+/**
+ * State of the approximate temporal aggregates, which keeps a sketch per
+ * time bucket sorted by the initial timestamp of the buckets
+ */
+typedef struct
+{
+  SketchType type;
+  int64 tunits;          /**< Size of the time buckets */
+  TimestampTz torigin;   /**< Origin of the time buckets */
+  double fraction;       /**< Fraction of the quantiles, if any */
+  int count;             /**< Number of buckets */
+  int maxcount;          /**< Allocated number of buckets */
+  int last;              /**< Bucket of the last value added */
+  SketchBucket *buckets;
+} TSketchState;
+
+/*****************************************************************************/
+
+extern void hll_add(HLLSketch *hll, uint64 hash);
+extern double hll_estimate(const HLLSketch *hll);
+extern void tdigest_add(TDigest *td, double value);
+extern double tdigest_quantile(TDigest *td, double fraction);
+
+/*****************************************************************************/
+
+#endif
@@ -87,46 +87,109 @@ typedef struct TboxGridState
 
 /*****************************************************************************/
 
+/**
+ * Struct for storing a fragment of a temporal number contained in a value
+ * bucket
+ */
+typedef struct
+{
+  int bucket_no;        /* Number of the value bucket */
+  int seqno;            /* Position of the fragment in the split */
+  Temporal *temp;       /* Instant or sequence contained in the bucket */
+} BucketFragment;
+
+/**
+ * Struct for accumulating the fragments of a temporal number
+ *
+ * @note Only the buckets actually traversed by the temporal number have
+ * fragments in the list, so that its size does not depend on the number of
+ * buckets in the value extent of the temporal number. When a filter is set,
+ * only the fragments of the given bucket are kept and the number of the next
+ * bucket traversed by the temporal number is recorded.
+ */
+typedef struct
+{
+  int count;                  /* Number of fragments */
+  int maxcount;               /* Number of fragments allocated */
+  int filter;                 /* Bucket to keep, -1 to keep all of them */
+  int next;                   /* Smallest bucket after the filter */
+  BucketFragment *fragments;  /* Array of fragments */
+} BucketFragmentList;
+
 /**
  * Struct for storing the state that persists across multiple calls to output
  * the temporal fragments
+ *
+ * @note The fragments are computed on demand, one value bucket at a time,
+ * so that only the fragments of the current bucket are kept in memory
  */
 typedef struct ValueSplitState
 {
   bool done;
   Datum size;
-  Datum *buckets;
-  Temporal **fragments;
-  int i;
-  int count;
+  Datum start_bucket;   /* Start value of the first bucket */
+  const Temporal *temp; /* Temporal number to split */
+  int bucket_no;        /* Number of the bucket of the next fragment */
 } ValueSplitState;
 
+/**
+ * Struct for storing the position reached when splitting a temporal sequence
+ * into time buckets
+ */
+typedef struct SeqTimeSplitState
+{
+  bool done;
+  const TSequence *seq; /* Sequence to split */
+  int i;                /* Next instant of the sequence */
+  int m;                /* Number of fragments already computed */
+  TimestampTz lower;    /* Start timestamp of the next bucket */
+  TInstant *start;      /* Value at the start of the next bucket, if any */
+} SeqTimeSplitState;
+
 /**
  * Struct for storing the state that persists across multiple calls to output
  * the temporal fragments
+ *
+ * @note The fragments are computed on demand, one time bucket at a time
  */
 typedef struct TimeSplitState
 {
   bool done;
   int64 tunits;
-  TimestampTz *buckets;
-  Temporal **fragments;
-  int i;
-  int count;
+  TimestampTz torigin;
+  const Temporal *temp;       /* Temporal value to split */
+  TimestampTz bucket;         /* Start timestamp of the next bucket */
+  int i;                      /* Next instant of an instant set or next
+                                 sequence of a sequence set */
+  SeqTimeSplitState seqstate; /* Position in the current sequence */
+  const TInstant **instants;  /* Buffer for the instants of a fragment */
+  TSequence **sequences;      /* Buffer for the sequences of a fragment */
 } TimeSplitState;
 
 /**
  * Struct for storing the state that persists across multiple calls to output
  * the temporal fragments
+ *
+ * @note The fragments are computed on demand, one tile at a time
  */
 typedef struct ValueTimeSplitState
 {
   bool done;
-  Datum *value_buckets;
-  TimestampTz *time_buckets;
-  Temporal **fragments;
-  int i;
-  int count;
+  CachedType basetype;
+  Datum size;
+  int64 tunits;
+  TimestampTz torigin;
+  const Temporal *temp;      /* Temporal number to split */
+  Datum start_bucket;        /* Start value of the first value bucket */
+  int *buckets;              /* Ranges of the value buckets traversed by the
+                                temporal number, as pairs of bucket numbers */
+  int nranges;               /* Number of ranges of value buckets */
+  int range;                 /* Current range of value buckets */
+  int bucket_no;             /* Number of the current value bucket */
+  Datum value;               /* Start value of the current value bucket */
+  Temporal *atrange;         /* Temporal number restricted to the current
+                                value bucket */
+  TimeSplitState *timestate; /* Time split of the restricted value */
 } ValueTimeSplitState;
 
 /*****************************************************************************/
@@ -136,6 +136,14 @@ extern void rangearr_sort(RangeType **ranges, int count);
 extern void tinstarr_sort(TInstant **instants, int count);
 extern void tseqarr_sort(TSequence **sequences, int count);
 
+/* Space-filling curve functions */
+
+extern uint32 double_sortable_bits(double d);
+extern uint32 timestamp_sortable_bits(TimestampTz t);
+extern uint64 zorder_key(const uint32 *values, int ndims);
+extern void keyarr_sort(void *values, size_t size, int count,
+  uint64 (*keyfunc)(const void *));
+
 /* Remove duplicate functions */
 
 extern int datumarr_remove_duplicates(Datum *values, int count,
@@ -38,6 +38,9 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <catalog/pg_type.h>
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+#include <utils/sortsupport.h>
+#endif
 /* MobilityDB */
 #include "general/timetypes.h"
 
@@ -50,6 +53,13 @@ extern bool period_index_consistent_leaf(const Period *key, const Period *query,
 extern bool period_gist_consistent(const Period *key, const Period *query,
   StrategyNumber strategy);
 extern bool period_index_recheck(StrategyNumber strategy);
+extern bool time_index_get_period(Datum query, Oid typid, Period *result);
+
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+/* The following functions are also called by tnumber_gist.c and tpoint_gist.c */
+extern int gist_zorder_cmp_abbrev(Datum x, Datum y, SortSupport ssup);
+extern bool gist_zorder_abbrev_abort(int memtupcount, SortSupport ssup);
+#endif
 
 #endif
 
@@ -52,6 +52,11 @@ extern float non_negative(float val);
 extern bool tbox_index_consistent_leaf(const TBOX *key, const TBOX *query,
   StrategyNumber strategy);
 
+/* The following functions are also called by temporal_brin.c */
+extern bool tnumber_gist_consistent(const TBOX *key, const TBOX *query,
+  StrategyNumber strategy);
+extern bool tnumber_index_get_tbox(Datum query, Oid typid, TBOX *result);
+
 /*****************************************************************************/
 
 #endif
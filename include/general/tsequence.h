@@ -45,6 +45,50 @@
 
 /*****************************************************************************/
 
+/**
+ * Number of instants per entry of the time index of a sequence. The index
+ * is only built for sequences having at least MOBDB_TINDEX_MINCOUNT instants
+ */
+#define MOBDB_TINDEX_BLOCK       64
+#define MOBDB_TINDEX_MINCOUNT    512
+
+/**
+ * Maximum number of instants created by a synchronization iterator that can
+ * be alive at the same time
+ */
+#define SYNC_ITER_MAXOWNED       12
+
+/**
+ * Structure to walk two temporal sequences in lockstep. Each step yields a
+ * pair of instants at the same timestamp, which are either instants of the
+ * sequences or instants interpolated for the synchronization or at the
+ * crossings. Together with the previous pair, they define the current pair
+ * of synchronized segments.
+ */
+typedef struct
+{
+  const TSequence *seq1;       /**< First sequence */
+  const TSequence *seq2;       /**< Second sequence */
+  Period inter;                /**< Intersection of the periods */
+  bool linear1;                /**< Interpolation of the first sequence */
+  bool linear2;                /**< Interpolation of the second sequence */
+  bool crossings;              /**< True when crossings are yielded */
+  bool last;                   /**< True when the current pair is the last */
+  int i;                       /**< Next instant of the first sequence */
+  int j;                       /**< Next instant of the second sequence */
+  const TInstant *prev1;       /**< Previous instant of the first sequence */
+  const TInstant *prev2;       /**< Previous instant of the second sequence */
+  const TInstant *inst1;       /**< Current instant of the first sequence */
+  const TInstant *inst2;       /**< Current instant of the second sequence */
+  const TInstant *next1;       /**< Pending instant after a crossing */
+  const TInstant *next2;       /**< Pending instant after a crossing */
+  bool nextlast;               /**< True when the pending pair is the last */
+  int nowned;                  /**< Number of instants created */
+  TInstant *owned[SYNC_ITER_MAXOWNED]; /**< Instants created */
+} TSequenceSyncIter;
+
+/*****************************************************************************/
+
 /* General functions */
 
 extern const TInstant *tsequence_inst_n(const TSequence *seq, int index);
@@ -52,10 +96,20 @@ extern TSequence *tsequence_make(const TInstant **instants,
   int count, bool lower_inc, bool upper_inc, bool linear, bool normalize);
 extern TSequence *tsequence_make_free(TInstant **instants,
   int count, bool lower_inc, bool upper_inc, bool linear, bool normalize);
+extern TSequence *tsequence_make_exp(const TInstant **instants, int count,
+  int maxcount, bool lower_inc, bool upper_inc, bool linear, bool normalize);
 extern TSequence *tsequence_copy(const TSequence *seq);
+extern TSequence *tsequence_compact(const TSequence *seq);
 extern int tsequence_find_timestamp(const TSequence *seq, TimestampTz t);
 
 extern void *tsequence_bbox_ptr(const TSequence *seq);
+extern size_t *tsequence_offsets_ptr(const TSequence *seq);
+extern TimestampTz *tsequence_tindex_ptr(const TSequence *seq);
+extern int16 tsequence_tindex_block(int count);
+extern size_t tsequence_tindex_size(int count, int16 block);
+extern void tsequence_tindex_build(TSequence *seq);
+extern int tsequence_tindex_find(const TimestampTz *tindex, int count,
+  TimestampTz t);
 extern void tsequence_bbox(const TSequence *seq, void *box);
 extern void tsequence_make_valid1(const TInstant **instants, int count,
   bool lower_inc, bool upper_inc, bool linear);
@@ -66,8 +120,8 @@ extern TSequence **tseqarr2_to_tseqarr(TSequence ***sequences,
 
 /* Append and merge functions */
 
-extern Temporal *tsequence_append_tinstant(const TSequence *seq,
-  const TInstant *inst);
+extern Temporal *tsequence_append_tinstant(TSequence *seq,
+  const TInstant *inst, bool expand);
 extern Temporal *tsequence_merge(const TSequence *seq1, const TSequence *seq2);
 extern Temporal *tsequence_merge_array(const TSequence **sequences, int count);
 
@@ -78,6 +132,11 @@ extern TSequence **tsequence_merge_array1(const TSequence **sequences,
 
 /* Synchronization functions */
 
+extern bool tsequence_sync_init(TSequenceSyncIter *iter,
+  const TSequence *seq1, const TSequence *seq2, bool crossings);
+extern bool tsequence_sync_next(TSequenceSyncIter *iter);
+extern void tsequence_sync_end(TSequenceSyncIter *iter);
+
 extern bool synchronize_tsequence_tsequence(const TSequence *seq1,
   const TSequence *seq2, TSequence **sync1, TSequence **sync2,
   bool interpoint);
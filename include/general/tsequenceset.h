@@ -63,8 +63,9 @@ extern bool tsequenceset_find_timestamp(const TSequenceSet *ts, TimestampTz t,
 
 /* Append and merge functions */
 
-extern TSequenceSet *tsequenceset_append_tinstant(const TSequenceSet *ts,
-  const TInstant *inst);
+extern TSequenceSet *tsequenceset_append_tinstant(TSequenceSet *ts,
+  const TInstant *inst, bool expand);
+extern TSequenceSet *tsequenceset_compact(const TSequenceSet *ts);
 extern TSequenceSet *tsequenceset_merge(const TSequenceSet *ts1,
   const TSequenceSet *ts2);
 extern TSequenceSet *tsequenceset_merge_array(const TSequenceSet **ts,
@@ -193,6 +193,11 @@ extern bool stbox_le(const STBOX *box1, const STBOX *box2);
 extern bool stbox_gt(const STBOX *box1, const STBOX *box2);
 extern bool stbox_ge(const STBOX *box1, const STBOX *box2);
 
+/* Space-filling curve functions */
+
+extern uint64 stbox_zorder_key(const STBOX *box);
+extern void stboxarr_sort_zorder(STBOX *boxes, int count);
+
 /*****************************************************************************/
 
 #endif
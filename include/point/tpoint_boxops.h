@@ -61,6 +61,10 @@ extern void tpointseqarr_stbox(const TSequence **seq, int count, STBOX *box);
 extern STBOX *tpointseq_stboxes(const TSequence *seq, int *count);
 extern STBOX *tpointseqset_stboxes(const TSequenceSet *ts, int *count);
 extern STBOX * tpoint_stboxes(const Temporal *temp, int *count);
+extern STBOX *tpoint_split_n_stboxes(const Temporal *temp, int maxcount,
+  int *count);
+extern bool overlaps_segments_tpoint_stbox(const Temporal *temp,
+  const STBOX *box);
 
 /* Generic box functions */
 
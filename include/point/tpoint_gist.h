@@ -44,11 +44,37 @@
 
 /*****************************************************************************/
 
+/** Default and maximum number of boxes kept by the multi-box GiST index */
+#define MGIST_MAXBOXES_DEFAULT  8
+#define MGIST_MAXBOXES_MAX      32
+
+/**
+ * Key of the multi-box GiST index for temporal points. Leaf keys keep, in
+ * addition to the bounding box, the boxes of consecutive groups of segments
+ * of the temporal point. Internal keys and leaf keys of temporal points
+ * covered by a single box only keep the bounding box, their count is 0.
+ */
+typedef struct
+{
+  int32 vl_len_;       /**< Varlena header (do not touch directly!) */
+  int32 count;         /**< Number of boxes in the array */
+  STBOX box;           /**< Bounding box */
+  STBOX boxes[FLEXIBLE_ARRAY_MEMBER]; /**< Boxes of the groups of segments */
+} TpointMGistKey;
+
+/*****************************************************************************/
+
 /* The following functions are also called by tpoint_spgist.c */
 extern bool tpoint_index_recheck(StrategyNumber strategy);
 extern bool stbox_index_consistent_leaf(const STBOX *key, const STBOX *query,
   StrategyNumber strategy);
 
+/* The following functions are also called by temporal_brin.c */
+extern bool stbox_gist_consistent(const STBOX *key, const STBOX *query,
+  StrategyNumber strategy);
+extern bool tpoint_index_get_stbox(Datum query, CachedType type,
+  STBOX *result);
+
 /*****************************************************************************/
 
 #endif
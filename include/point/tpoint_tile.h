@@ -42,16 +42,6 @@
 
 /*****************************************************************************/
 
-/**
- * Structure for storing a bit matrix
- */
-typedef struct
-{
-  int numdims;           /**< Number of dimensions */
-  int count[MAXDIMS];    /**< Number of elements in each dimension */
-  uint8_t byte[1];       /**< beginning of variable-length data */
-} BitMatrix;
-
 /**
  * Struct for storing the state that persists across multiple calls generating
  * a multidimensional grid
@@ -63,9 +53,6 @@ typedef struct STboxGridState
   double size;         /**< Size of the x, y, and z dimension */
   int64 tunits;        /**< Size of the time dimension */
   STBOX box;           /**< Bounding box of the grid */
-  Temporal *temp;      /**< Optional temporal point to be split */
-  BitMatrix *bm;       /**< Optional bit matrix for speeding up
-                            the computation of the split functions */
   double x;            /**< Minimum x value of the current tile */
   double y;            /**< Minimum y value of the current tile */
   double z;            /**< Minimum z value of the current tile */
@@ -73,6 +60,48 @@ typedef struct STboxGridState
   int coords[MAXDIMS]; /**< Coordinates of the current tile */
 } STboxGridState;
 
+/**
+ * Struct for storing the state that persists across multiple calls of the
+ * functions splitting a temporal point with respect to a multidimensional grid
+ */
+typedef struct STboxSplitState
+{
+  int i;                /**< Number of current tile */
+  int count;            /**< Number of tiles traversed by the temporal point */
+  STBOX *tiles;         /**< Array of tiles */
+  Temporal **fragments; /**< Array of fragments of the temporal point */
+} STboxSplitState;
+
+/** Maximum level of a tile hierarchy identified by 64-bit quadkeys */
+#define MAX_QUADKEY_LEVEL 30
+
+/**
+ * Struct for storing a fragment of a temporal point contained in a tile of
+ * the finest level of a tile hierarchy
+ */
+typedef struct QuadkeyFragment
+{
+  uint64 key;           /**< Quadkey of the tile */
+  int seqno;            /**< Position of the fragment in the traversal */
+  Temporal *temp;       /**< Instant or sequence contained in the tile */
+} QuadkeyFragment;
+
+/**
+ * Struct for storing the state that persists across multiple calls of the
+ * function splitting a temporal point with respect to several levels of a
+ * tile hierarchy
+ */
+typedef struct MultiresSplitState
+{
+  int level;                  /**< Current level */
+  int maxlevel;               /**< Finest level */
+  int i;                      /**< Next fragment at the current level */
+  int count;                  /**< Number of fragments at the finest level */
+  int16 subtype;              /**< Subtype of the temporal point */
+  QuadkeyFragment *fragments; /**< Fragments sorted by quadkey */
+  QuadkeyFragment *group;     /**< Buffer for the fragments of a tile */
+} MultiresSplitState;
+
 /*****************************************************************************/
 
 
@@ -57,10 +57,20 @@ CREATE FUNCTION period_gist_same(period, period, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Period_gist_same'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION period_gist_distance(internal, period, smallint, oid, internal)
+  RETURNS float8
+  AS 'MODULE_PATHNAME', 'Period_gist_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION period_gist_fetch(internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Period_gist_fetch'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+CREATE FUNCTION period_gist_sortsupport(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Period_gist_sortsupport'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
 
 CREATE OPERATOR CLASS timestampset_rtree_ops
   DEFAULT FOR TYPE timestampset USING gist AS
@@ -115,7 +125,11 @@ CREATE OPERATOR CLASS timestampset_rtree_ops
   FUNCTION  3  timestampset_gist_compress(internal),
   FUNCTION  5  period_gist_penalty(internal, internal, internal),
   FUNCTION  6  period_gist_picksplit(internal, internal),
-  FUNCTION  7  period_gist_same(period, period, internal);
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  period_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  7  period_gist_same(period, period, internal),
+  FUNCTION  8  period_gist_distance(internal, period, smallint, oid, internal);
 
 /******************************************************************************/
 
@@ -181,6 +195,10 @@ CREATE OPERATOR CLASS period_rtree_ops
   FUNCTION  5  period_gist_penalty(internal, internal, internal),
   FUNCTION  6  period_gist_picksplit(internal, internal),
   FUNCTION  7  period_gist_same(period, period, internal),
+  FUNCTION  8  period_gist_distance(internal, period, smallint, oid, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  period_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  9  period_gist_fetch(internal);
 
 /******************************************************************************/
@@ -249,6 +267,10 @@ CREATE OPERATOR CLASS periodset_rtree_ops
   FUNCTION  3  periodset_gist_compress(internal),
   FUNCTION  5  period_gist_penalty(internal, internal, internal),
   FUNCTION  6  period_gist_picksplit(internal, internal),
-  FUNCTION  7  period_gist_same(period, period, internal);
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  period_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  7  period_gist_same(period, period, internal),
+  FUNCTION  8  period_gist_distance(internal, period, smallint, oid, internal);
 
 /******************************************************************************/
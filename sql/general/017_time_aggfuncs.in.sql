@@ -44,6 +44,15 @@ CREATE FUNCTION tagg_deserialize(bytea, internal)
   AS 'MODULE_PATHNAME', 'Tagg_deserialize'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION tagg_memsize(internal)
+  RETURNS bigint
+  AS 'MODULE_PATHNAME', 'Tagg_memsize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tagg_spillstats(internal)
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Tagg_spillstats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
 
 CREATE FUNCTION timestampset_extent_transfn(period, timestampset)
@@ -137,6 +146,66 @@ CREATE AGGREGATE tcount(periodset) (
   PARALLEL = SAFE
 );
 
+CREATE AGGREGATE tcount_memsize(timestampset) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_memsize,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
+CREATE AGGREGATE tcount_memsize(period) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_memsize,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
+CREATE AGGREGATE tcount_memsize(periodset) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_memsize,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
+CREATE AGGREGATE tcount_spillstats(timestampset) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_spillstats,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
+CREATE AGGREGATE tcount_spillstats(period) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_spillstats,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
+CREATE AGGREGATE tcount_spillstats(periodset) (
+  SFUNC = tcount_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tcount_combinefn,
+  FINALFUNC = tagg_spillstats,
+  SERIALFUNC = tagg_serialize,
+  DESERIALFUNC = tagg_deserialize,
+  PARALLEL = SAFE
+);
+
 /*****************************************************************************/
 
 CREATE FUNCTION timestampset_tunion_transfn(internal, timestampset)
@@ -497,6 +497,23 @@ CREATE FUNCTION toLinear(tfloat)
   AS 'MODULE_PATHNAME', 'Tempstep_to_templinear'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION toColumnar(tint)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_to_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION toColumnar(tfloat)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_to_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION compress(tint)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION compress(tfloat, integer DEFAULT -1)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /******************************************************************************/
 
  CREATE FUNCTION appendInstant(tbool, tbool)
@@ -608,6 +625,23 @@ CREATE FUNCTION memSize(ttext)
   AS 'MODULE_PATHNAME', 'Temporal_memory_size'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION isColumnar(tint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isColumnar(tfloat)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isCompressed(tint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isCompressed(tfloat)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 -- values is a reserved word in SQL
 CREATE FUNCTION getValue(tbool)
   RETURNS boolean
@@ -2429,3 +2463,16 @@ CREATE OPERATOR CLASS hash_ttext_ops
     FUNCTION    1   ttext_hash(ttext);
 
 /******************************************************************************/
+
+/******************************************************************************
+ * Memory usage of the lifted functions
+ ******************************************************************************/
+
+-- Size in bytes of the memory blocks held by the scratch memory context at
+-- the end of the last lifted function using it, not a count of allocations
+CREATE FUNCTION lifting_arena_bytes()
+  RETURNS bigint
+  AS 'MODULE_PATHNAME', 'Lifting_arena_bytes'
+  LANGUAGE C VOLATILE STRICT PARALLEL RESTRICTED;
+
+/******************************************************************************/
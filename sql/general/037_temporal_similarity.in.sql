@@ -33,36 +33,44 @@
  * distance and the Dynamic Time Warping (DTW) distance are implemented.
  */
 
-CREATE FUNCTION frechetDistance(tint, tint)
+CREATE FUNCTION frechetDistance(tint, tint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION frechetDistance(tint, tfloat)
+CREATE FUNCTION frechetDistance(tint, tfloat, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION frechetDistance(tfloat, tint)
+CREATE FUNCTION frechetDistance(tfloat, tint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION frechetDistance(tfloat, tfloat)
+CREATE FUNCTION frechetDistance(tfloat, tfloat, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
-CREATE FUNCTION dynamicTimeWarp(tint, tint)
+CREATE FUNCTION dynamicTimeWarp(tint, tint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION dynamicTimeWarp(tint, tfloat)
+CREATE FUNCTION dynamicTimeWarp(tint, tfloat, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION dynamicTimeWarp(tfloat, tint)
+CREATE FUNCTION dynamicTimeWarp(tfloat, tint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION dynamicTimeWarp(tfloat, tfloat)
+CREATE FUNCTION dynamicTimeWarp(tfloat, tfloat, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
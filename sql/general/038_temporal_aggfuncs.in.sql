@@ -428,3 +428,59 @@ CREATE AGGREGATE merge(ttext) (
 );
 
 /*****************************************************************************/
+
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tbool)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tint)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tfloat)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION temporal_app_tinst_transfn(internal, ttext)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION tbool_app_tinst_finalfn(internal)
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tint_app_tinst_finalfn(internal)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tfloat_app_tinst_finalfn(internal)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION ttext_app_tinst_finalfn(internal)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE AGGREGATE appendInstant(tbool) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tbool_app_tinst_finalfn
+);
+CREATE AGGREGATE appendInstant(tint) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tint_app_tinst_finalfn
+);
+CREATE AGGREGATE appendInstant(tfloat) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tfloat_app_tinst_finalfn
+);
+CREATE AGGREGATE appendInstant(ttext) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = ttext_app_tinst_finalfn
+);
+
+/*****************************************************************************/
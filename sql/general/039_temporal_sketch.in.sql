@@ -0,0 +1,228 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * temporal_sketch.sql
+ * Approximate temporal aggregate functions based on time-bucketed sketches
+ */
+
+CREATE FUNCTION tsketch_combinefn(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tsketch_combinefn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION tsketch_serialize(internal)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tsketch_serialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tsketch_deserialize(bytea, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tsketch_deserialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tsketch_count_finalfn(internal)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Tsketch_count_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tsketch_percentile_finalfn(internal)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tsketch_percentile_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
+
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tbool,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tbool,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tint,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tint,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tfloat,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tfloat,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, ttext,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, ttext,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+CREATE AGGREGATE approxCountDistinct(anyelement, tbool, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tbool, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tint, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tint, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tfloat, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tfloat, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, ttext, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, ttext, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+
+/*****************************************************************************/
+
+CREATE FUNCTION approx_percentile_transfn(internal, tint, float, interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnumber_approx_percentile_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_percentile_transfn(internal, tint, float, interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnumber_approx_percentile_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_percentile_transfn(internal, tfloat, float, interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnumber_approx_percentile_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_percentile_transfn(internal, tfloat, float, interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnumber_approx_percentile_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+CREATE AGGREGATE approxPercentile(tint, float, interval) (
+  SFUNC = approx_percentile_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_percentile_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxPercentile(tint, float, interval, timestamptz) (
+  SFUNC = approx_percentile_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_percentile_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxPercentile(tfloat, float, interval) (
+  SFUNC = approx_percentile_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_percentile_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxPercentile(tfloat, float, interval, timestamptz) (
+  SFUNC = approx_percentile_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_percentile_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+
+/*****************************************************************************/
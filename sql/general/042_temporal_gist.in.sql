@@ -54,6 +54,12 @@ CREATE FUNCTION tbox_gist_same(tbox, tbox, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Tbox_gist_same'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+CREATE FUNCTION tbox_gist_sortsupport(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Tbox_gist_sortsupport'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
 CREATE FUNCTION tbox_gist_distance(internal, tbox, smallint, oid, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Tbox_gist_distance'
@@ -137,6 +143,12 @@ CREATE OPERATOR CLASS tbox_rtree_ops
   OPERATOR  17    -|- (tbox, tbox),
   OPERATOR  17    -|- (tbox, tint),
   OPERATOR  17    -|- (tbox, tfloat),
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  -- nearest approach distance
+  OPERATOR  25    |=| (tbox, tbox) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tbox, tint) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tbox, tfloat) FOR ORDER BY pg_catalog.float_ops,
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   -- overlaps or before
   OPERATOR  28    &<# (tbox, tbox),
   OPERATOR  28    &<# (tbox, tint),
@@ -159,6 +171,9 @@ CREATE OPERATOR CLASS tbox_rtree_ops
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
 /******************************************************************************/
@@ -226,6 +241,9 @@ CREATE OPERATOR CLASS tbool_rtree_ops
   FUNCTION  3  tbool_gist_compress(internal),
   FUNCTION  5  period_gist_penalty(internal, internal, internal),
   FUNCTION  6  period_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  period_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  period_gist_same(period, period, internal);
 
 /******************************************************************************/
@@ -309,6 +327,8 @@ CREATE OPERATOR CLASS tint_rtree_ops
   OPERATOR  17    -|- (tint, tfloat),
 #if POSTGRESQL_VERSION_NUMBER >= 120000
   -- nearest approach distance
+  OPERATOR  25    |=| (tint, int) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tint, float) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tint, tbox) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tint, tint) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tint, tfloat) FOR ORDER BY pg_catalog.float_ops,
@@ -352,6 +372,9 @@ CREATE OPERATOR CLASS tint_rtree_ops
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
 /******************************************************************************/
@@ -444,6 +467,8 @@ CREATE OPERATOR CLASS tfloat_rtree_ops
   OPERATOR  17    -|- (tfloat, tfloat),
 #if POSTGRESQL_VERSION_NUMBER >= 120000
   -- nearest approach distance
+  OPERATOR  25    |=| (tfloat, int) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tfloat, float) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tfloat, tbox) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tfloat, tint) FOR ORDER BY pg_catalog.float_ops,
   OPERATOR  25    |=| (tfloat, tfloat) FOR ORDER BY pg_catalog.float_ops,
@@ -487,6 +512,9 @@ CREATE OPERATOR CLASS tfloat_rtree_ops
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
 /******************************************************************************/
@@ -554,6 +582,9 @@ CREATE OPERATOR CLASS ttext_rtree_ops
   FUNCTION  3  ttext_gist_compress(internal),
   FUNCTION  5  period_gist_penalty(internal, internal, internal),
   FUNCTION  6  period_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  period_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  period_gist_same(period, period, internal);
 
 /******************************************************************************/
@@ -99,3 +99,20 @@ CREATE AGGREGATE merge(tnpoint) (
 );
 
 /*****************************************************************************/
+
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tnpoint)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION tnpoint_app_tinst_finalfn(internal)
+  RETURNS tnpoint
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE AGGREGATE appendInstant(tnpoint) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tnpoint_app_tinst_finalfn
+);
+
+/*****************************************************************************/
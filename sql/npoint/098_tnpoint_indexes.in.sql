@@ -160,6 +160,9 @@ CREATE OPERATOR CLASS tnpoint_rtree_ops
   FUNCTION  3 tnpoint_gist_compress(internal),
   FUNCTION  5 stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6 stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7 stbox_gist_same(stbox, stbox, internal);
 --  FUNCTION  8 gist_tnpoint_distance(internal, tnpoint, smallint, oid, internal),
 
@@ -278,6 +278,23 @@ CREATE FUNCTION toLinear(tgeogpoint)
   AS 'MODULE_PATHNAME', 'Tempstep_to_templinear'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION toColumnar(tgeompoint)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_to_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION toColumnar(tgeogpoint)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_to_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION compress(tgeompoint, integer DEFAULT -1)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION compress(tgeogpoint, integer DEFAULT -1)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE FUNCTION appendInstant(tgeompoint, tgeompoint)
   RETURNS tgeompoint
   AS 'MODULE_PATHNAME', 'Temporal_append_tinstant'
@@ -337,6 +354,23 @@ CREATE FUNCTION memSize(tgeogpoint)
   AS 'MODULE_PATHNAME', 'Temporal_memory_size'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION isColumnar(tgeompoint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isColumnar(tgeogpoint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_columnar'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isCompressed(tgeompoint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION isCompressed(tgeogpoint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_is_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 -- value is a reserved word in SQL
 CREATE FUNCTION getValue(tgeompoint)
   RETURNS geometry(Point)
@@ -92,3 +92,23 @@ CREATE FUNCTION spaceTimeSplit(tgeompoint, float, interval,
   LANGUAGE C IMMUTABLE PARALLEL SAFE STRICT;
 
 /*****************************************************************************/
+
+CREATE TYPE level_key_tpoint AS (
+  level integer,
+  key bigint,
+  tpoint tgeompoint
+);
+
+CREATE FUNCTION multiresSplit(tgeompoint, size float, minlevel integer,
+    maxlevel integer, sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS SETOF level_key_tpoint
+  AS 'MODULE_PATHNAME', 'Tpoint_multires_split'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE STRICT;
+
+CREATE FUNCTION quadkey(stbox, size float, level integer,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint
+  AS 'MODULE_PATHNAME', 'Stbox_quadkey'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE STRICT;
+
+/*****************************************************************************/
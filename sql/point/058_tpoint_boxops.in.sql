@@ -1466,3 +1466,47 @@ CREATE OPERATOR -|- (
 );
 
 /*****************************************************************************/
+
+/*****************************************************************************
+ * Overlaps segments
+ *****************************************************************************/
+
+CREATE FUNCTION overlaps_segments(tgeompoint, geometry)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Overlaps_segments_tpoint_geo'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION overlaps_segments(tgeompoint, stbox)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Overlaps_segments_tpoint_stbox'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION overlaps_segments(tgeogpoint, geography)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Overlaps_segments_tpoint_geo'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION overlaps_segments(tgeogpoint, stbox)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Overlaps_segments_tpoint_stbox'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE OPERATOR ?&& (
+  PROCEDURE = overlaps_segments,
+  LEFTARG = tgeompoint, RIGHTARG = geometry,
+  RESTRICT = tpoint_sel, JOIN = tpoint_joinsel
+);
+CREATE OPERATOR ?&& (
+  PROCEDURE = overlaps_segments,
+  LEFTARG = tgeompoint, RIGHTARG = stbox,
+  RESTRICT = tpoint_sel, JOIN = tpoint_joinsel
+);
+CREATE OPERATOR ?&& (
+  PROCEDURE = overlaps_segments,
+  LEFTARG = tgeogpoint, RIGHTARG = geography,
+  RESTRICT = tpoint_sel, JOIN = tpoint_joinsel
+);
+CREATE OPERATOR ?&& (
+  PROCEDURE = overlaps_segments,
+  LEFTARG = tgeogpoint, RIGHTARG = stbox,
+  RESTRICT = tpoint_sel, JOIN = tpoint_joinsel
+);
+
+/*****************************************************************************/
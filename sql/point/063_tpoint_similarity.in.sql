@@ -33,11 +33,13 @@
  * distance and the Dynamic Time Warping (DTW) distance are implemented.
  */
 
-CREATE FUNCTION frechetDistance(tgeompoint, tgeompoint)
+CREATE FUNCTION frechetDistance(tgeompoint, tgeompoint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION frechetDistance(tgeogpoint, tgeogpoint)
+CREATE FUNCTION frechetDistance(tgeogpoint, tgeogpoint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_frechet_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
@@ -53,11 +55,13 @@ CREATE FUNCTION frechetDistancePath(tgeogpoint, tgeogpoint)
 
 /*****************************************************************************/
 
-CREATE FUNCTION dynamicTimeWarp(tgeompoint, tgeompoint)
+CREATE FUNCTION dynamicTimeWarp(tgeompoint, tgeompoint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
-CREATE FUNCTION dynamicTimeWarp(tgeogpoint, tgeogpoint)
+CREATE FUNCTION dynamicTimeWarp(tgeogpoint, tgeogpoint, band integer DEFAULT -1,
+    maxdist float DEFAULT 'Infinity')
   RETURNS float
   AS 'MODULE_PATHNAME', 'Temporal_dynamic_time_warp'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
@@ -42,20 +42,20 @@ CREATE FUNCTION tpoint_extent_transfn(stbox, tgeogpoint)
   LANGUAGE C IMMUTABLE PARALLEL SAFE;
 CREATE FUNCTION tpoint_extent_combinefn(stbox, stbox)
   RETURNS stbox
-  AS 'MODULE_PATHNAME', 'Tpoint_extent_transfn'
+  AS 'MODULE_PATHNAME', 'Tpoint_extent_combinefn'
   LANGUAGE C IMMUTABLE PARALLEL SAFE;
 
 CREATE AGGREGATE extent(tgeompoint) (
   SFUNC = tpoint_extent_transfn,
   STYPE = stbox,
-  COMBINEFUNC = tpoint_extent_combinefn --,
-  -- PARALLEL = safe
+  COMBINEFUNC = tpoint_extent_combinefn,
+  PARALLEL = safe
 );
 CREATE AGGREGATE extent(tgeogpoint) (
   SFUNC = tpoint_extent_transfn,
   STYPE = stbox,
-  COMBINEFUNC = tpoint_extent_combinefn --,
-  -- PARALLEL = safe
+  COMBINEFUNC = tpoint_extent_combinefn,
+  PARALLEL = safe
 );
 
 /*****************************************************************************/
@@ -88,6 +88,64 @@ CREATE AGGREGATE tcount(tgeogpoint) (
   PARALLEL = SAFE
 );
 
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tgeompoint,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tgeompoint,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tgeogpoint,
+    interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION approx_count_distinct_transfn(internal, anyelement, tgeogpoint,
+    interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_approx_count_distinct_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+CREATE AGGREGATE approxCountDistinct(anyelement, tgeompoint, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tgeompoint, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tgeogpoint, interval) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE approxCountDistinct(anyelement, tgeogpoint, interval, timestamptz) (
+  SFUNC = approx_count_distinct_transfn,
+  STYPE = internal,
+  COMBINEFUNC = tsketch_combinefn,
+  FINALFUNC = tsketch_count_finalfn,
+  SERIALFUNC = tsketch_serialize,
+  DESERIALFUNC = tsketch_deserialize,
+  PARALLEL = SAFE
+);
+
 CREATE FUNCTION wcount_transfn(internal, tgeompoint, interval)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Temporal_wcount_transfn'
@@ -179,3 +237,33 @@ CREATE AGGREGATE merge(tgeogpoint) (
 );
 
 /*****************************************************************************/
+
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tgeompoint)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION temporal_app_tinst_transfn(internal, tgeogpoint)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION tgeompoint_app_tinst_finalfn(internal)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tgeogpoint_app_tinst_finalfn(internal)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_app_tinst_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE AGGREGATE appendInstant(tgeompoint) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tgeompoint_app_tinst_finalfn
+);
+CREATE AGGREGATE appendInstant(tgeogpoint) (
+  SFUNC = temporal_app_tinst_transfn,
+  STYPE = internal,
+  FINALFUNC = tgeogpoint_app_tinst_finalfn
+);
+
+/*****************************************************************************/
@@ -52,6 +52,12 @@ CREATE FUNCTION stbox_gist_same(stbox, stbox, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Stbox_gist_same'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+CREATE FUNCTION stbox_gist_sortsupport(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Stbox_gist_sortsupport'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
 CREATE FUNCTION stbox_gist_distance(internal, stbox, smallint, oid, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Stbox_gist_distance'
@@ -142,6 +148,9 @@ CREATE OPERATOR CLASS stbox_rtree_ops
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
 /******************************************************************************/
@@ -289,6 +298,9 @@ CREATE OPERATOR CLASS tgeompoint_rtree_ops
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
 CREATE OPERATOR CLASS tgeogpoint_rtree_ops
@@ -373,6 +385,278 @@ CREATE OPERATOR CLASS tgeogpoint_rtree_ops
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION 11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
 /******************************************************************************/
+
+/******************************************************************************
+ * Multi-box GiST index keeping the boxes of groups of segments
+ ******************************************************************************/
+
+CREATE FUNCTION tpoint_mgist_consistent(internal, tgeompoint, smallint, oid, internal)
+  RETURNS bool
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_consistent'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_consistent(internal, tgeogpoint, smallint, oid, internal)
+  RETURNS bool
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_consistent'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_union(internal, internal)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_union'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_compress(internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_decompress(internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_decompress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_penalty(internal, internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_penalty'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_picksplit(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_picksplit'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tpoint_mgist_same(bytea, bytea, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_same'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+CREATE FUNCTION tpoint_mgist_options(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Tpoint_mgist_options'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 130000
+
+CREATE OPERATOR CLASS tgeompoint_mgist_ops
+  FOR TYPE tgeompoint USING gist AS
+  STORAGE bytea,
+  -- strictly left
+  OPERATOR  1    << (tgeompoint, geometry),
+  OPERATOR  1    << (tgeompoint, stbox),
+  OPERATOR  1    << (tgeompoint, tgeompoint),
+  -- overlaps or left
+  OPERATOR  2    &< (tgeompoint, geometry),
+  OPERATOR  2    &< (tgeompoint, stbox),
+  OPERATOR  2    &< (tgeompoint, tgeompoint),
+  -- overlaps
+  OPERATOR  3    && (tgeompoint, timestamptz),
+  OPERATOR  3    && (tgeompoint, timestampset),
+  OPERATOR  3    && (tgeompoint, period),
+  OPERATOR  3    && (tgeompoint, periodset),
+  OPERATOR  3    && (tgeompoint, geometry),
+  OPERATOR  3    && (tgeompoint, stbox),
+  OPERATOR  3    && (tgeompoint, tgeompoint),
+  -- overlaps or right
+  OPERATOR  4    &> (tgeompoint, geometry),
+  OPERATOR  4    &> (tgeompoint, stbox),
+  OPERATOR  4    &> (tgeompoint, tgeompoint),
+    -- strictly right
+  OPERATOR  5    >> (tgeompoint, geometry),
+  OPERATOR  5    >> (tgeompoint, stbox),
+  OPERATOR  5    >> (tgeompoint, tgeompoint),
+    -- same
+  OPERATOR  6    ~= (tgeompoint, geometry),
+  OPERATOR  6    ~= (tgeompoint, timestamptz),
+  OPERATOR  6    ~= (tgeompoint, timestampset),
+  OPERATOR  6    ~= (tgeompoint, period),
+  OPERATOR  6    ~= (tgeompoint, periodset),
+  OPERATOR  6    ~= (tgeompoint, stbox),
+  OPERATOR  6    ~= (tgeompoint, tgeompoint),
+  -- contains
+  OPERATOR  7    @> (tgeompoint, geometry),
+  OPERATOR  7    @> (tgeompoint, timestamptz),
+  OPERATOR  7    @> (tgeompoint, timestampset),
+  OPERATOR  7    @> (tgeompoint, period),
+  OPERATOR  7    @> (tgeompoint, periodset),
+  OPERATOR  7    @> (tgeompoint, stbox),
+  OPERATOR  7    @> (tgeompoint, tgeompoint),
+  -- contained by
+  OPERATOR  8    <@ (tgeompoint, geometry),
+  OPERATOR  8    <@ (tgeompoint, timestamptz),
+  OPERATOR  8    <@ (tgeompoint, timestampset),
+  OPERATOR  8    <@ (tgeompoint, period),
+  OPERATOR  8    <@ (tgeompoint, periodset),
+  OPERATOR  8    <@ (tgeompoint, stbox),
+  OPERATOR  8    <@ (tgeompoint, tgeompoint),
+  -- overlaps or below
+  OPERATOR  9    &<| (tgeompoint, geometry),
+  OPERATOR  9    &<| (tgeompoint, stbox),
+  OPERATOR  9    &<| (tgeompoint, tgeompoint),
+  -- strictly below
+  OPERATOR  10    <<| (tgeompoint, geometry),
+  OPERATOR  10    <<| (tgeompoint, stbox),
+  OPERATOR  10    <<| (tgeompoint, tgeompoint),
+  -- strictly above
+  OPERATOR  11    |>> (tgeompoint, geometry),
+  OPERATOR  11    |>> (tgeompoint, stbox),
+  OPERATOR  11    |>> (tgeompoint, tgeompoint),
+  -- overlaps or above
+  OPERATOR  12    |&> (tgeompoint, geometry),
+  OPERATOR  12    |&> (tgeompoint, stbox),
+  OPERATOR  12    |&> (tgeompoint, tgeompoint),
+  -- adjacent
+  OPERATOR  17    -|- (tgeompoint, geometry),
+  OPERATOR  17    -|- (tgeompoint, timestamptz),
+  OPERATOR  17    -|- (tgeompoint, timestampset),
+  OPERATOR  17    -|- (tgeompoint, period),
+  OPERATOR  17    -|- (tgeompoint, periodset),
+  OPERATOR  17    -|- (tgeompoint, stbox),
+  OPERATOR  17    -|- (tgeompoint, tgeompoint),
+  -- nearest approach distance
+  OPERATOR  25    |=| (tgeompoint, geometry) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tgeompoint, stbox) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (tgeompoint, tgeompoint) FOR ORDER BY pg_catalog.float_ops,
+  -- overlaps or before
+  OPERATOR  28    &<# (tgeompoint, timestamptz),
+  OPERATOR  28    &<# (tgeompoint, timestampset),
+  OPERATOR  28    &<# (tgeompoint, period),
+  OPERATOR  28    &<# (tgeompoint, periodset),
+  OPERATOR  28    &<# (tgeompoint, stbox),
+  OPERATOR  28    &<# (tgeompoint, tgeompoint),
+  -- strictly before
+  OPERATOR  29    <<# (tgeompoint, timestamptz),
+  OPERATOR  29    <<# (tgeompoint, timestampset),
+  OPERATOR  29    <<# (tgeompoint, period),
+  OPERATOR  29    <<# (tgeompoint, periodset),
+  OPERATOR  29    <<# (tgeompoint, stbox),
+  OPERATOR  29    <<# (tgeompoint, tgeompoint),
+  -- strictly after
+  OPERATOR  30    #>> (tgeompoint, timestamptz),
+  OPERATOR  30    #>> (tgeompoint, timestampset),
+  OPERATOR  30    #>> (tgeompoint, period),
+  OPERATOR  30    #>> (tgeompoint, periodset),
+  OPERATOR  30    #>> (tgeompoint, stbox),
+  OPERATOR  30    #>> (tgeompoint, tgeompoint),
+  -- overlaps or after
+  OPERATOR  31    #&> (tgeompoint, timestamptz),
+  OPERATOR  31    #&> (tgeompoint, timestampset),
+  OPERATOR  31    #&> (tgeompoint, period),
+  OPERATOR  31    #&> (tgeompoint, periodset),
+  OPERATOR  31    #&> (tgeompoint, stbox),
+  OPERATOR  31    #&> (tgeompoint, tgeompoint),
+  -- overlaps or front
+  OPERATOR  32    &</ (tgeompoint, geometry),
+  OPERATOR  32    &</ (tgeompoint, stbox),
+  OPERATOR  32    &</ (tgeompoint, tgeompoint),
+  -- strictly front
+  OPERATOR  33    <</ (tgeompoint, geometry),
+  OPERATOR  33    <</ (tgeompoint, stbox),
+  OPERATOR  33    <</ (tgeompoint, tgeompoint),
+  -- strictly back
+  OPERATOR  34    />> (tgeompoint, geometry),
+  OPERATOR  34    />> (tgeompoint, stbox),
+  OPERATOR  34    />> (tgeompoint, tgeompoint),
+  -- overlaps or back
+  OPERATOR  35    /&> (tgeompoint, geometry),
+  OPERATOR  35    /&> (tgeompoint, stbox),
+  OPERATOR  35    /&> (tgeompoint, tgeompoint),
+  -- overlaps segments
+  OPERATOR  36    ?&& (tgeompoint, geometry),
+  OPERATOR  36    ?&& (tgeompoint, stbox),
+  -- functions
+  FUNCTION  1  tpoint_mgist_consistent(internal, tgeompoint, smallint, oid, internal),
+  FUNCTION  2  tpoint_mgist_union(internal, internal),
+  FUNCTION  3  tpoint_mgist_compress(internal),
+  FUNCTION  4  tpoint_mgist_decompress(internal),
+  FUNCTION  5  tpoint_mgist_penalty(internal, internal, internal),
+  FUNCTION  6  tpoint_mgist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+  FUNCTION  10  tpoint_mgist_options(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 130000
+  FUNCTION  7  tpoint_mgist_same(bytea, bytea, internal);
+
+CREATE OPERATOR CLASS tgeogpoint_mgist_ops
+  FOR TYPE tgeogpoint USING gist AS
+  STORAGE bytea,
+  -- overlaps
+  OPERATOR  3    && (tgeogpoint, geography),
+  OPERATOR  3    && (tgeogpoint, timestamptz),
+  OPERATOR  3    && (tgeogpoint, timestampset),
+  OPERATOR  3    && (tgeogpoint, period),
+  OPERATOR  3    && (tgeogpoint, periodset),
+  OPERATOR  3    && (tgeogpoint, stbox),
+  OPERATOR  3    && (tgeogpoint, tgeogpoint),
+    -- same
+  OPERATOR  6    ~= (tgeogpoint, geography),
+  OPERATOR  6    ~= (tgeogpoint, timestamptz),
+  OPERATOR  6    ~= (tgeogpoint, timestampset),
+  OPERATOR  6    ~= (tgeogpoint, period),
+  OPERATOR  6    ~= (tgeogpoint, periodset),
+  OPERATOR  6    ~= (tgeogpoint, stbox),
+  OPERATOR  6    ~= (tgeogpoint, tgeogpoint),
+  -- contains
+  OPERATOR  7    @> (tgeogpoint, geography),
+  OPERATOR  7    @> (tgeogpoint, timestamptz),
+  OPERATOR  7    @> (tgeogpoint, timestampset),
+  OPERATOR  7    @> (tgeogpoint, period),
+  OPERATOR  7    @> (tgeogpoint, periodset),
+  OPERATOR  7    @> (tgeogpoint, stbox),
+  OPERATOR  7    @> (tgeogpoint, tgeogpoint),
+  -- contained by
+  OPERATOR  8    <@ (tgeogpoint, geography),
+  OPERATOR  8    <@ (tgeogpoint, timestamptz),
+  OPERATOR  8    <@ (tgeogpoint, timestampset),
+  OPERATOR  8    <@ (tgeogpoint, period),
+  OPERATOR  8    <@ (tgeogpoint, periodset),
+  OPERATOR  8    <@ (tgeogpoint, stbox),
+  OPERATOR  8    <@ (tgeogpoint, tgeogpoint),
+  -- adjacent
+  OPERATOR  17    -|- (tgeogpoint, geography),
+  OPERATOR  17    -|- (tgeogpoint, timestamptz),
+  OPERATOR  17    -|- (tgeogpoint, timestampset),
+  OPERATOR  17    -|- (tgeogpoint, period),
+  OPERATOR  17    -|- (tgeogpoint, periodset),
+  OPERATOR  17    -|- (tgeogpoint, stbox),
+  OPERATOR  17    -|- (tgeogpoint, tgeogpoint),
+  -- overlaps or before
+  OPERATOR  28    &<# (tgeogpoint, timestamptz),
+  OPERATOR  28    &<# (tgeogpoint, timestampset),
+  OPERATOR  28    &<# (tgeogpoint, period),
+  OPERATOR  28    &<# (tgeogpoint, periodset),
+  OPERATOR  28    &<# (tgeogpoint, stbox),
+  OPERATOR  28    &<# (tgeogpoint, tgeogpoint),
+  -- strictly before
+  OPERATOR  29    <<# (tgeogpoint, timestamptz),
+  OPERATOR  29    <<# (tgeogpoint, timestampset),
+  OPERATOR  29    <<# (tgeogpoint, period),
+  OPERATOR  29    <<# (tgeogpoint, periodset),
+  OPERATOR  29    <<# (tgeogpoint, stbox),
+  OPERATOR  29    <<# (tgeogpoint, tgeogpoint),
+  -- strictly after
+  OPERATOR  30    #>> (tgeogpoint, timestamptz),
+  OPERATOR  30    #>> (tgeogpoint, timestampset),
+  OPERATOR  30    #>> (tgeogpoint, period),
+  OPERATOR  30    #>> (tgeogpoint, periodset),
+  OPERATOR  30    #>> (tgeogpoint, stbox),
+  OPERATOR  30    #>> (tgeogpoint, tgeogpoint),
+  -- overlaps or after
+  OPERATOR  31    #&> (tgeogpoint, timestamptz),
+  OPERATOR  31    #&> (tgeogpoint, timestampset),
+  OPERATOR  31    #&> (tgeogpoint, period),
+  OPERATOR  31    #&> (tgeogpoint, periodset),
+  OPERATOR  31    #&> (tgeogpoint, stbox),
+  OPERATOR  31    #&> (tgeogpoint, tgeogpoint),
+  -- overlaps segments
+  OPERATOR  36    ?&& (tgeogpoint, geography),
+  OPERATOR  36    ?&& (tgeogpoint, stbox),
+  -- functions
+  FUNCTION  1  tpoint_mgist_consistent(internal, tgeogpoint, smallint, oid, internal),
+  FUNCTION  2  tpoint_mgist_union(internal, internal),
+  FUNCTION  3  tpoint_mgist_compress(internal),
+  FUNCTION  4  tpoint_mgist_decompress(internal),
+  FUNCTION  5  tpoint_mgist_penalty(internal, internal, internal),
+  FUNCTION  6  tpoint_mgist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+  FUNCTION  10  tpoint_mgist_options(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 130000
+  FUNCTION  7  tpoint_mgist_same(bytea, bytea, internal);
+
+/******************************************************************************/
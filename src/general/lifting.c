@@ -153,13 +153,115 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <utils/memutils.h>
 #include <utils/timestamp.h>
 /* MobilityDB */
 #include "general/period.h"
 #include "general/time_ops.h"
 #include "general/temporaltypes.h"
+#include "general/temporal_columnar.h"
 #include "general/temporal_util.h"
 
+/*****************************************************************************
+ * Scratch memory context
+ *****************************************************************************/
+
+/**
+ * Scratch memory context for the intermediate values of the lifted functions
+ * requesting it. The context is created on first use and is reset at the end
+ * of every call, so that the intermediate values are released in bulk
+ * instead of one by one.
+ */
+static MemoryContext lifting_arena = NULL;
+
+/**
+ * Size in bytes of the memory held by the scratch memory context at the end
+ * of the last call using it
+ */
+static Size lifting_arena_lastbytes = 0;
+
+/**
+ * Free an intermediate value unless it is allocated in the scratch memory
+ * context, which is released in bulk at the end of the call
+ */
+#define LIFTING_FREE(ptr) \
+  do { \
+    if (CurrentMemoryContext != lifting_arena) \
+      pfree(ptr); \
+  } while (0)
+
+#define LIFTING_FREE_ARRAY(array, count) \
+  do { \
+    if (CurrentMemoryContext != lifting_arena) \
+      pfree_array((void **) (array), (count)); \
+  } while (0)
+
+/**
+ * Switch to the scratch memory context if requested by the lifted function
+ *
+ * @result Return the memory context of the caller, or NULL if the scratch
+ * memory context is not used, which is also the case for nested calls
+ */
+static MemoryContext
+lifting_arena_begin(const LiftedFunctionInfo *lfinfo)
+{
+  if (! lfinfo->arena || CurrentMemoryContext == lifting_arena)
+    return NULL;
+  if (lifting_arena == NULL)
+    lifting_arena = AllocSetContextCreate(TopMemoryContext,
+      "Lifting scratch context", ALLOCSET_DEFAULT_SIZES);
+  /* Release the values left by a previous call that raised an error */
+  MemoryContextReset(lifting_arena);
+  return MemoryContextSwitchTo(lifting_arena);
+}
+
+/**
+ * Switch back to the memory context of the caller, copy the result into it,
+ * and reset the scratch memory context
+ *
+ * @param[in,out] lfinfo Information about the lifted function, whose
+ * `arenabytes` field is set to the size in bytes of the memory held by the
+ * scratch memory context at the end of the call
+ * @note The size is that of the blocks obtained by the context as given by
+ * `MemoryContextMemAllocated`, not the number of values allocated in it, and
+ * is thus an upper bound of the bytes requested by the call
+ * @param[in] oldctx Memory context of the caller
+ * @param[in] result Result of the call
+ */
+static Temporal *
+lifting_arena_end(LiftedFunctionInfo *lfinfo, MemoryContext oldctx,
+  Temporal *result)
+{
+  if (oldctx == NULL)
+    return result;
+  MemoryContextSwitchTo(oldctx);
+  if (result != NULL)
+    result = temporal_copy(result);
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+  lfinfo->arenabytes = MemoryContextMemAllocated(lifting_arena, false);
+  lifting_arena_lastbytes = lfinfo->arenabytes;
+  elog(DEBUG2, "Lifted function held %zu bytes in the scratch memory context",
+    lfinfo->arenabytes);
+#endif
+  MemoryContextReset(lifting_arena);
+  return result;
+}
+
+PG_FUNCTION_INFO_V1(Lifting_arena_bytes);
+/**
+ * Return the size in bytes of the memory held by the scratch memory context
+ * at the end of the last lifted function using it in the current backend, or
+ * 0 if there is none
+ *
+ * @note The size is that of the memory blocks of the context, not a count of
+ * allocations, and is only available from PostgreSQL 13
+ */
+PGDLLEXPORT Datum
+Lifting_arena_bytes(PG_FUNCTION_ARGS __attribute__((unused)))
+{
+  PG_RETURN_INT64((int64) lifting_arena_lastbytes);
+}
+
 /*****************************************************************************
  * Functions where the argument is a temporal type.
  * The function is applied to the composing instants.
@@ -227,11 +329,13 @@ TSequence *
 tfunc_tsequence(const TSequence *seq, LiftedFunctionInfo *lfinfo)
 {
   TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  TInstant *buf[2] = {NULL, NULL};
   for (int i = 0; i < seq->count; i++)
   {
-    const TInstant *inst = tsequence_inst_n(seq, i);
+    const TInstant *inst = tsequence_inst_n_buf(seq, i, buf);
     instants[i] = tfunc_tinstant(inst, lfinfo);
   }
+  tinstant_buf_free(buf);
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags) &&
     temptype_continuous(lfinfo->restype);
   return tsequence_make_free(instants, seq->count, seq->period.lower_inc,
@@ -267,6 +371,7 @@ tfunc_temporal(const Temporal *temp, LiftedFunctionInfo *lfinfo)
 {
   Temporal *result;
   ensure_valid_tempsubtype(temp->subtype);
+  MemoryContext oldctx = lifting_arena_begin(lfinfo);
   if (temp->subtype == INSTANT)
     result = (Temporal *) tfunc_tinstant((TInstant *) temp, lfinfo);
   else if (temp->subtype == INSTANTSET)
@@ -275,7 +380,7 @@ tfunc_temporal(const Temporal *temp, LiftedFunctionInfo *lfinfo)
     result = (Temporal *) tfunc_tsequence((TSequence *) temp, lfinfo);
   else /* temp->subtype == SEQUENCESET */
     result = (Temporal *) tfunc_tsequenceset((TSequenceSet *) temp, lfinfo);
-  return result;
+  return lifting_arena_end(lfinfo, oldctx, result);
 }
 
 /*****************************************************************************
@@ -370,11 +475,13 @@ tfunc_tsequence_base_scan(const TSequence *seq, Datum value,
   LiftedFunctionInfo *lfinfo, TSequence **result)
 {
   TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  TInstant *buf[2] = {NULL, NULL};
   for (int i = 0; i < seq->count; i++)
   {
-    const TInstant *inst = tsequence_inst_n(seq, i);
+    const TInstant *inst = tsequence_inst_n_buf(seq, i, buf);
     instants[i] = tfunc_tinstant_base(inst, value, lfinfo);
   }
+  tinstant_buf_free(buf);
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags) &&
     temptype_continuous(lfinfo->restype);
   result[0] = tsequence_make_free(instants, seq->count, seq->period.lower_inc,
@@ -398,14 +505,15 @@ tfunc_tsequence_base_turnpt(const TSequence *seq, Datum value,
 {
   int k = 0;
   TInstant **instants = palloc(sizeof(TInstant *) * seq->count * 2);
-  const TInstant *inst1 = tsequence_inst_n(seq, 0);
+  TInstant *buf[2] = {NULL, NULL};
+  const TInstant *inst1 = tsequence_inst_n_buf(seq, 0, buf);
   Datum value1 = tinstant_value(inst1);
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
   CachedType resbasetype = temptype_basetype(lfinfo->restype);
   for (int i = 1; i < seq->count; i++)
   {
     /* Each iteration of the loop adds between one and two instants */
-    const TInstant *inst2 = tsequence_inst_n(seq, i);
+    const TInstant *inst2 = tsequence_inst_n_buf(seq, i, buf);
     Datum value2 = tinstant_value(inst2);
     instants[k++] = tfunc_tinstant_base(inst1, value, lfinfo);
     /* If not constant segment and linear compute the function on the potential
@@ -423,6 +531,7 @@ tfunc_tsequence_base_turnpt(const TSequence *seq, Datum value,
     inst1 = inst2; value1 = value2;
   }
   instants[k++] = tfunc_tinstant_base(inst1, value, lfinfo);
+  tinstant_buf_free(buf);
   result[0] = tsequence_make_free(instants, k, seq->period.lower_inc,
     seq->period.upper_inc, linear, NORMALIZE);
   return 1;
@@ -447,7 +556,8 @@ static int
 tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
   LiftedFunctionInfo *lfinfo, TSequence **result)
 {
-  const TInstant *start = tsequence_inst_n(seq, 0);
+  TInstant *buf[2] = {NULL, NULL};
+  const TInstant *start = tsequence_inst_n_buf(seq, 0, buf);
   Datum startvalue = tinstant_value(start);
   Datum startresult = tfunc_base_base(startvalue, value, lfinfo);
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
@@ -458,7 +568,8 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
   {
     instants[0] = tinstant_make(startresult, start->t, lfinfo->restype);
     result[0] = tinstant_tsequence(instants[0], STEP);
-    pfree(instants[0]);
+    LIFTING_FREE(instants[0]);
+    tinstant_buf_free(buf);
     return 1;
   }
 
@@ -475,7 +586,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
   for (int i = 1; i < seq->count; i++)
   {
     /* Each iteration of the loop adds between one and three sequences */
-    const TInstant *end = tsequence_inst_n(seq, i);
+    const TInstant *end = tsequence_inst_n_buf(seq, i, buf);
     Datum endvalue = tinstant_value(end);
     Datum endresult = tfunc_base_base(endvalue, value, lfinfo);
     bool upper_inc = (i == seq->count - 1) ? seq->period.upper_inc : false;
@@ -576,7 +687,8 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
     startresult = endresult;
     lower_inc = true;
   }
-  pfree(instants[0]); pfree(instants[1]);
+  LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
+  tinstant_buf_free(buf);
   return k;
 }
 
@@ -656,6 +768,7 @@ tfunc_temporal_base(const Temporal *temp, Datum value,
 {
   Temporal *result;
   ensure_valid_tempsubtype(temp->subtype);
+  MemoryContext oldctx = lifting_arena_begin(lfinfo);
   if (temp->subtype == INSTANT)
     result = (Temporal *) tfunc_tinstant_base((TInstant *) temp, value, lfinfo);
   else if (temp->subtype == INSTANTSET)
@@ -667,7 +780,7 @@ tfunc_temporal_base(const Temporal *temp, Datum value,
   else /* temp->subtype == SEQUENCESET */
     result = (Temporal *) tfunc_tsequenceset_base((TSequenceSet *) temp, value,
       lfinfo);
-  return result;
+  return lifting_arena_end(lfinfo, oldctx, result);
 }
 
 /*****************************************************************************
@@ -993,78 +1106,42 @@ tfunc_tsequence_tsequence_lineareq(const TSequence *seq1, const TSequence *seq2,
    * where S, T, and * are values computed, respectively, at
    * Synchronization points, optional Turning points, and common points
    */
-  TInstant *inst1 = (TInstant *) tsequence_inst_n(seq1, 0);
-  TInstant *inst2 = (TInstant *) tsequence_inst_n(seq2, 0);
-  int i = 0, j = 0, k = 0, l = 0;
-  if (inst1->t < inter->lower)
-  {
-    i = tsequence_find_timestamp(seq1, inter->lower) + 1;
-    inst1 = (TInstant *) tsequence_inst_n(seq1, i);
-  }
-  else if (inst2->t < inter->lower)
-  {
-    j = tsequence_find_timestamp(seq2, inter->lower) + 1;
-    inst2 = (TInstant *) tsequence_inst_n(seq2, j);
-  }
-  int count = (seq1->count - i + seq2->count - j) * 2;
+  TSequenceSyncIter iter;
+  tsequence_sync_init(&iter, seq1, seq2, false);
+  int count = (seq1->count + seq2->count) * 2;
   TInstant **instants = palloc(sizeof(TInstant *) * count);
-  TInstant **tofree = palloc(sizeof(TInstant *) * count);
+  int k = 0;
   Datum value;
   CachedType resbasetype = temptype_basetype(lfinfo->restype);
-  while (i < seq1->count && j < seq2->count &&
-    (inst1->t <= inter->upper || inst2->t <= inter->upper))
+  while (tsequence_sync_next(&iter))
   {
-    /* Synchronize the start instant */
-    int cmp = timestamp_cmp_internal(inst1->t, inst2->t);
-    if (cmp == 0)
-    {
-      i++; j++;
-    }
-    else if (cmp < 0)
-    {
-      i++;
-      inst2 = tsequence_at_timestamp(seq2, inst1->t);
-      tofree[l++] = inst2;
-    }
-    else
-    {
-      j++;
-      inst1 = tsequence_at_timestamp(seq1, inst2->t);
-      tofree[l++] = inst1;
-    }
     /* If not the first instant compute the function on the potential
        turning point before adding the new instants */
-    TInstant *prev1, *prev2;
-    Datum value1, value2;
     TimestampTz tptime;
-    if (lfinfo->tpfunc != NULL && k > 0 &&
-      lfinfo->tpfunc(prev1, inst1, prev2, inst2, &value, &tptime))
+    if (lfinfo->tpfunc != NULL && iter.prev1 != NULL &&
+      lfinfo->tpfunc(iter.prev1, iter.inst1, iter.prev2, iter.inst2, &value,
+        &tptime))
     {
       instants[k++] = tinstant_make(value, tptime, lfinfo->restype);
     }
     /* Compute the function on the synchronized instants */
-    value1 = tinstant_value(inst1);
-    value2 = tinstant_value(inst2);
-    value = tfunc_base_base(value1, value2, lfinfo);
-    instants[k++] = tinstant_make(value, inst1->t, lfinfo->restype);
+    value = tfunc_base_base(tinstant_value(iter.inst1),
+      tinstant_value(iter.inst2), lfinfo);
+    instants[k++] = tinstant_make(value, iter.inst1->t, lfinfo->restype);
     DATUM_FREE(value, resbasetype);
-    if (i == seq1->count || j == seq2->count)
-      break;
-    prev1 = inst1; prev2 = inst2;
-    inst1 = (TInstant *) tsequence_inst_n(seq1, i);
-    inst2 = (TInstant *) tsequence_inst_n(seq2, j);
   }
+  tsequence_sync_end(&iter);
   /* We are sure that k != 0 due to the period intersection test above */
   /* The last two values of sequences with step interpolation and
      exclusive upper bound must be equal */
   if (! lfinfo->reslinear && !inter->upper_inc && k > 1)
   {
-    tofree[l++] = instants[k - 1];
+    TInstant *last = instants[k - 1];
     value = tinstant_value(instants[k - 2]);
-    instants[k - 1] = tinstant_make(value, instants[k - 1]->t, lfinfo->restype);
+    instants[k - 1] = tinstant_make(value, last->t, lfinfo->restype);
     /* We cannot DATUM_FREE(value, lfinfo->restype); */
+    LIFTING_FREE(last);
   }
-  pfree_array((void **) tofree, l);
   result[0] = tsequence_make_free(instants, k, inter->lower_inc,
     inter->upper_inc, lfinfo->reslinear, NORMALIZE);
   return 1;
@@ -1087,58 +1164,32 @@ tfunc_tsequence_tsequence_linearstep(const TSequence *seq1,
   const TSequence *seq2, LiftedFunctionInfo *lfinfo, Period *inter,
   TSequence **result)
 {
-  /* Array that keeps the new instants added for synchronization */
-  TInstant **tofree = palloc(sizeof(TInstant *) *
-    (seq1->count + seq2->count) * 2);
-  TInstant *start1 = (TInstant *) tsequence_inst_n(seq1, 0);
-  TInstant *start2 = (TInstant *) tsequence_inst_n(seq2, 0);
-  int i = 1, j = 1, k = 0, l = 0;
+  /* The synchronized segments are obtained from an iterator, the instants
+   * added for the synchronization are freed by the iterator */
+  TSequenceSyncIter iter;
+  tsequence_sync_init(&iter, seq1, seq2, false);
   /* Synchronize the start instant */
-  if (start1->t < inter->lower)
-  {
-    start1 = tsequence_at_timestamp(seq1, inter->lower);
-    tofree[l++] = start1;
-    i = tsequence_find_timestamp(seq1, inter->lower) + 1;
-  }
-  else if (start2->t < inter->lower)
-  {
-    start2 = tsequence_at_timestamp(seq2, inter->lower);
-    tofree[l++] = start2;
-    j = tsequence_find_timestamp(seq2, inter->lower) + 1;
-  }
+  tsequence_sync_next(&iter);
+  const TInstant *start1 = iter.inst1;
+  const TInstant *start2 = iter.inst2;
+  int k = 0;
   bool lower_inc = inter->lower_inc;
-  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
-  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  bool linear1 = iter.linear1;
+  bool linear2 = iter.linear2;
   TInstant *instants[2];
   Datum startvalue1, startvalue2, startresult;
   /* Each iteration of the loop adds one sequence */
   CachedType resbasetype = temptype_basetype(lfinfo->restype);
-  while (i < seq1->count && j < seq2->count)
+  while (! iter.last)
   {
     /* Compute the function at the start instant */
     startvalue1 = tinstant_value(start1);
     startvalue2 = tinstant_value(start2);
     startresult = tfunc_base_base(startvalue1, startvalue2, lfinfo);
     /* Synchronize the end instant */
-    TInstant *end1 = (TInstant *) tsequence_inst_n(seq1, i);
-    TInstant *end2 = (TInstant *) tsequence_inst_n(seq2, j);
-    int cmp = timestamp_cmp_internal(end1->t, end2->t);
-    if (cmp == 0)
-    {
-      i++; j++;
-    }
-    else if (cmp < 0)
-    {
-      i++;
-      end2 = tsegment_at_timestamp(start2, end2, linear2, end1->t);
-      tofree[l++] = end2;
-    }
-    else
-    {
-      j++;
-      end1 = tsegment_at_timestamp(start1, end1, linear1, end2->t);
-      tofree[l++] = end1;
-    }
+    tsequence_sync_next(&iter);
+    const TInstant *end1 = iter.inst1;
+    const TInstant *end2 = iter.inst2;
     /* Compute the function at the end instant */
     Datum endvalue1 = linear1 ? tinstant_value(end1) : startvalue1;
     Datum endvalue2 = linear2 ? tinstant_value(end2) : startvalue2;
@@ -1147,7 +1198,7 @@ tfunc_tsequence_tsequence_linearstep(const TSequence *seq1,
     instants[1] = tinstant_make(endresult, end1->t, lfinfo->restype);
     result[k++] = tsequence_make((const TInstant **) instants, 2, lower_inc, false,
       lfinfo->reslinear, NORMALIZE_NO);
-    pfree(instants[0]); pfree(instants[1]);
+    LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
     DATUM_FREE(startresult, resbasetype);
     DATUM_FREE(endresult, resbasetype);
     start1 = end1; start2 = end2;
@@ -1161,10 +1212,10 @@ tfunc_tsequence_tsequence_linearstep(const TSequence *seq1,
     startresult = tfunc_base_base(startvalue1, startvalue2, lfinfo);
     instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
     result[k++] = tinstant_tsequence(instants[0], lfinfo->reslinear);
-    pfree(instants[0]);
+    LIFTING_FREE(instants[0]);
     DATUM_FREE(startresult, resbasetype);
   }
-  pfree_array((void **) tofree, l);
+  tsequence_sync_end(&iter);
   return k;
 }
 
@@ -1184,60 +1235,34 @@ static int
 tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
   LiftedFunctionInfo *lfinfo, Period *inter, TSequence **result)
 {
-  /* Array that keeps the new instants added for the synchronization */
-  TInstant **tofree = palloc(sizeof(TInstant *) *
-    (seq1->count + seq2->count) * 2);
-  TInstant *start1 = (TInstant *) tsequence_inst_n(seq1, 0);
-  TInstant *start2 = (TInstant *) tsequence_inst_n(seq2, 0);
-  int i = 1, j = 1, k = 0, l = 0;
+  /* The synchronized segments are obtained from an iterator, the instants
+   * added for the synchronization are freed by the iterator */
+  TSequenceSyncIter iter;
+  tsequence_sync_init(&iter, seq1, seq2, false);
   /* Synchronize the start instant */
-  if (start1->t < inter->lower)
-  {
-    start1 = tsequence_at_timestamp(seq1, inter->lower);
-    tofree[l++] = start1;
-    i = tsequence_find_timestamp(seq1, inter->lower) + 1;
-  }
-  else if (start2->t < inter->lower)
-  {
-    start2 = tsequence_at_timestamp(seq2, inter->lower);
-    tofree[l++] = start2;
-    j = tsequence_find_timestamp(seq2, inter->lower) + 1;
-  }
+  tsequence_sync_next(&iter);
+  const TInstant *start1 = iter.inst1;
+  const TInstant *start2 = iter.inst2;
+  int k = 0;
   bool lower_inc = inter->lower_inc;
-  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
-  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  bool linear1 = iter.linear1;
+  bool linear2 = iter.linear2;
   Datum startvalue1, startvalue2, startresult;
   TInstant *instants[2];
   CachedType basetype1 = temptype_basetype(seq1->temptype);
   CachedType basetype2 = temptype_basetype(seq2->temptype);
   CachedType resbasetype = temptype_basetype(lfinfo->restype);
   /* Each iteration of the loop adds between one and three sequences */
-  while (i < seq1->count && j < seq2->count)
+  while (! iter.last)
   {
     /* Compute the function at the start instant */
     startvalue1 = tinstant_value(start1);
     startvalue2 = tinstant_value(start2);
     startresult = tfunc_base_base(startvalue1, startvalue2, lfinfo);
     /* Synchronize the end instants */
-    TInstant *end1 = (TInstant *) tsequence_inst_n(seq1, i);
-    TInstant *end2 = (TInstant *) tsequence_inst_n(seq2, j);
-    int cmp = timestamp_cmp_internal(end1->t, end2->t);
-    if (cmp == 0)
-    {
-      i++; j++;
-    }
-    else if (cmp < 0)
-    {
-      i++;
-      end2 = tsegment_at_timestamp(start2, end2, linear2, end1->t);
-      tofree[l++] = end2;
-    }
-    else
-    {
-      j++;
-      end1 = tsegment_at_timestamp(start1, end1, linear1, end2->t);
-      tofree[l++] = end1;
-    }
+    tsequence_sync_next(&iter);
+    const TInstant *end1 = iter.inst1;
+    const TInstant *end2 = iter.inst2;
     /* Compute the function at the end instant */
     Datum endvalue1 = linear1 ? tinstant_value(end1) : startvalue1;
     Datum endvalue2 = linear2 ? tinstant_value(end2) : startvalue2;
@@ -1255,7 +1280,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
       instants[1] = tinstant_make(startresult, end1->t, lfinfo->restype);
       result[k++] = tsequence_make((const TInstant **) instants, 2,
         lower_inc, false, lfinfo->reslinear, NORMALIZE_NO);
-      pfree(instants[0]); pfree(instants[1]);
+      LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
     }
     /* If either the start values or the end values are equal and both have
      * linear interpolation compute the function at the start instant,
@@ -1275,13 +1300,13 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
       {
         instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
         result[k++] = tinstant_tsequence(instants[0], lfinfo->reslinear);
-        pfree(instants[0]);
+        LIFTING_FREE(instants[0]);
       }
       instants[0] = tinstant_make(intresult, start1->t, lfinfo->restype);
       instants[1] = tinstant_make(intresult, end1->t, lfinfo->restype);
       result[k++] = tsequence_make((const TInstant **) instants, 2,
         lower_eq, false, lfinfo->reslinear, NORMALIZE_NO);
-      pfree(instants[0]); pfree(instants[1]);
+      LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
       DATUM_FREE(intvalue1, basetype1);
       DATUM_FREE(intvalue2, basetype2);
       DATUM_FREE(intresult, resbasetype);
@@ -1306,7 +1331,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
         instants[1] = tinstant_make(startresult, end1->t, lfinfo->restype);
         result[k++] = tsequence_make((const TInstant **) instants, 2,
           lower_inc, false, lfinfo->reslinear, NORMALIZE_NO);
-        pfree(instants[0]); pfree(instants[1]);
+        LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
       }
       else
       {
@@ -1315,20 +1340,20 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
         instants[1] = tinstant_make(startresult, inttime, lfinfo->restype);
         result[k++] = tsequence_make((const TInstant **) instants, 2,
           lower_inc, lower_eq, lfinfo->reslinear, NORMALIZE_NO);
-        pfree(instants[0]); pfree(instants[1]);
+        LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
         /* Second sequence if any */
         if (! lower_eq && ! upper_eq)
         {
           instants[0] = tinstant_make(intresult, inttime, lfinfo->restype);
           result[k++] = tinstant_tsequence(instants[0], lfinfo->reslinear);
-          pfree(instants[0]);
+          LIFTING_FREE(instants[0]);
         }
         /* Third sequence */
         instants[0] = tinstant_make(endresult, inttime, lfinfo->restype);
         instants[1] = tinstant_make(endresult, end1->t, lfinfo->restype);
         result[k++] = tsequence_make((const TInstant **) instants, 2,
           upper_eq, false, lfinfo->reslinear, NORMALIZE_NO);
-        pfree(instants[0]); pfree(instants[1]);
+        LIFTING_FREE(instants[0]); LIFTING_FREE(instants[1]);
         DATUM_FREE(intvalue1, basetype1);
         DATUM_FREE(intvalue2, basetype2);
         DATUM_FREE(intresult, resbasetype);
@@ -1347,10 +1372,10 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
     startresult = tfunc_base_base(startvalue1, startvalue2, lfinfo);
     instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
     result[k++] = tinstant_tsequence(instants[0], lfinfo->reslinear);
-    pfree(instants[0]);
+    LIFTING_FREE(instants[0]);
     DATUM_FREE(startresult, resbasetype);
   }
-  pfree_array((void **) tofree, l);
+  tsequence_sync_end(&iter);
   return k;
 }
 
@@ -1560,6 +1585,7 @@ tfunc_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
   Temporal *result = NULL;
   ensure_valid_tempsubtype(temp1->subtype);
   ensure_valid_tempsubtype(temp2->subtype);
+  MemoryContext oldctx = lifting_arena_begin(lfinfo);
   if (temp1->subtype == INSTANT)
   {
     if (temp2->subtype == INSTANT)
@@ -1620,7 +1646,7 @@ tfunc_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
       result = (Temporal *) tfunc_tsequenceset_tsequenceset(
           (TSequenceSet *) temp1, (TSequenceSet *) temp2, lfinfo);
   }
-  return result;
+  return lifting_arena_end(lfinfo, oldctx, result);
 }
 
 /*****************************************************************************
@@ -1901,67 +1927,40 @@ static int
 efunc_tsequence_tsequence_discont(const TSequence *seq1,
   const TSequence *seq2, LiftedFunctionInfo *lfinfo, Period *inter)
 {
-  /* Array that keeps the new instants added for the synchronization */
-  TInstant **tofree = palloc(sizeof(TInstant *) *
-    (seq1->count + seq2->count) * 2);
-  TInstant *start1 = (TInstant *) tsequence_inst_n(seq1, 0);
-  TInstant *start2 = (TInstant *) tsequence_inst_n(seq2, 0);
-  int i = 1, j = 1, l = 0;
+  /* The synchronized segments are obtained from an iterator, the instants
+   * added for the synchronization are freed by the iterator */
+  TSequenceSyncIter iter;
+  tsequence_sync_init(&iter, seq1, seq2, false);
   /* Synchronize the start instant */
-  if (start1->t < inter->lower)
-  {
-    start1 = tsequence_at_timestamp(seq1, inter->lower);
-    tofree[l++] = start1;
-    i = tsequence_find_timestamp(seq1, inter->lower) + 1;
-  }
-  else if (start2->t < inter->lower)
-  {
-    start2 = tsequence_at_timestamp(seq2, inter->lower);
-    tofree[l++] = start2;
-    j = tsequence_find_timestamp(seq2, inter->lower) + 1;
-  }
+  tsequence_sync_next(&iter);
+  const TInstant *start1 = iter.inst1;
+  const TInstant *start2 = iter.inst2;
   bool lower_inc = inter->lower_inc;
-  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
-  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  bool linear1 = iter.linear1;
+  bool linear2 = iter.linear2;
   Datum startvalue1, startvalue2;
   CachedType basetype1 = temptype_basetype(seq1->temptype);
   CachedType basetype2 = temptype_basetype(seq2->temptype);
-  while (i < seq1->count && j < seq2->count)
+  while (! iter.last)
   {
     /* Compute the function at the start instant */
     startvalue1 = tinstant_value(start1);
     startvalue2 = tinstant_value(start2);
     if (lower_inc && DatumGetBool(tfunc_base_base(startvalue1, startvalue2, lfinfo)))
     {
-      pfree_array((void **) tofree, l);
+      tsequence_sync_end(&iter);
       return 1;
     }
     /* Synchronize the end instants */
-    TInstant *end1 = (TInstant *) tsequence_inst_n(seq1, i);
-    TInstant *end2 = (TInstant *) tsequence_inst_n(seq2, j);
-    int cmp = timestamp_cmp_internal(end1->t, end2->t);
-    if (cmp == 0)
-    {
-      i++; j++;
-    }
-    else if (cmp < 0)
-    {
-      i++;
-      end2 = tsegment_at_timestamp(start2, end2, linear2, end1->t);
-      tofree[l++] = end2;
-    }
-    else
-    {
-      j++;
-      end1 = tsegment_at_timestamp(start1, end1, linear1, end2->t);
-      tofree[l++] = end1;
-    }
+    tsequence_sync_next(&iter);
+    const TInstant *end1 = iter.inst1;
+    const TInstant *end2 = iter.inst2;
     /* Compute the function at the end instant */
     Datum endvalue1 = linear1 ? tinstant_value(end1) : startvalue1;
     Datum endvalue2 = linear2 ? tinstant_value(end2) : startvalue2;
     if (DatumGetBool(tfunc_base_base(endvalue1, endvalue2, lfinfo)))
     {
-      pfree_array((void **) tofree, l);
+      tsequence_sync_end(&iter);
       return 1;
     }
 
@@ -1980,7 +1979,7 @@ efunc_tsequence_tsequence_discont(const TSequence *seq1,
       intvalue2 = tsegment_value_at_timestamp(start2, end2, linear2, inttime);
       if (DatumGetBool(tfunc_base_base(intvalue1, intvalue2, lfinfo)))
       {
-        pfree_array((void **) tofree, l);
+        tsequence_sync_end(&iter);
         return 1;
       }
     }
@@ -1992,7 +1991,7 @@ efunc_tsequence_tsequence_discont(const TSequence *seq1,
         start2, end2, linear2, &intvalue1, &intvalue2, &inttime);
       if (hascross && DatumGetBool(tfunc_base_base(intvalue1, intvalue2, lfinfo)))
       {
-        pfree_array((void **) tofree, l);
+        tsequence_sync_end(&iter);
         return 1;
       }
     }
@@ -2006,11 +2005,11 @@ efunc_tsequence_tsequence_discont(const TSequence *seq1,
     startvalue2 = tinstant_value(start2);
     if (DatumGetBool(tfunc_base_base(startvalue1, startvalue2, lfinfo)))
     {
-      pfree_array((void **) tofree, l);
+      tsequence_sync_end(&iter);
       return 1;
     }
   }
-  pfree_array((void **) tofree, l);
+  tsequence_sync_end(&iter);
   return 0;
 }
 
@@ -2147,6 +2146,7 @@ efunc_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
   int result;
   ensure_valid_tempsubtype(temp1->subtype);
   ensure_valid_tempsubtype(temp2->subtype);
+  MemoryContext oldctx = lifting_arena_begin(lfinfo);
   if (temp1->subtype == INSTANT)
   {
     if (temp2->subtype == INSTANT)
@@ -2207,6 +2207,7 @@ efunc_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
       result = efunc_tsequenceset_tsequenceset((TSequenceSet *) temp1,
         (TSequenceSet *) temp2, lfinfo);
   }
+  lifting_arena_end(lfinfo, oldctx, NULL);
   return result;
 }
 
@@ -698,6 +698,39 @@ period_hash_extended(const Period *p, Datum seed)
   return result;
 }
 
+/*****************************************************************************
+ * Space-filling curve functions
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_time_accessor
+ * @brief Return the key of a period in a space-filling curve, that is, its
+ * center as an unsigned integer that preserves the order of timestamps.
+ */
+uint64
+period_zorder_key(const Period *p)
+{
+  TimestampTz center = p->lower + (p->upper - p->lower) / 2;
+  /* Flip the sign bit so that negative timestamps are sorted first */
+  return ((uint64) center) ^ UINT64CONST(0x8000000000000000);
+}
+
+/**
+ * @ingroup libmeos_time_transf
+ * @brief Sort in place an array of periods according to their key in a
+ * space-filling curve.
+ *
+ * @note This function can be used for bulk-loading the periods in an index
+ * structure in an order that preserves their proximity
+ */
+void
+periodarr_sort_zorder(Period *periods, int count)
+{
+  keyarr_sort(periods, sizeof(Period), count,
+    (uint64 (*)(const void *)) &period_zorder_key);
+  return;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
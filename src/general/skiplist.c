@@ -37,7 +37,9 @@
 /* PostgreSQL */
 #include <assert.h>
 #include <executor/spi.h>
+#include <lib/binaryheap.h>
 #include <libpq/pqformat.h>
+#include <miscadmin.h>
 #include <utils/memutils.h>
 #include <utils/timestamp.h>
 /* GSL */
@@ -49,6 +51,8 @@
 #include "general/periodset.h"
 #include "general/time_ops.h"
 #include "general/time_aggfuncs.h"
+#include "general/tempcache.h"
+#include "general/temporaltypes.h"
 #include "general/temporal_util.h"
 #include "general/temporal_aggfuncs.h"
 
@@ -116,65 +120,91 @@ random_level()
 }
 
 /**
- * Allocate memory for the skiplist
+ * Return the new capacity of an array of the skiplist that must be
+ * expanded. Postgres has a limit of MaxAllocSize = 1 gigabyte - 1. Normally,
+ * the arrays double their size when expanded. If doubling the size goes
+ * beyond MaxAllocSize, we allocate the maximum number of elements that we
+ * can fit within MaxAllocSize. If we have previously reached this maximum
+ * and more capacity is required, an error is generated.
  */
 static int
-skiplist_alloc(FunctionCallInfo fcinfo, SkipList *list)
+skiplist_grow(int capacity, size_t size)
 {
-  list->length ++;
-  if (! list->freecount)
-  {
-    /* No free list, give first available entry */
-    if (list->next >= list->capacity)
-    {
-      /* No more capacity, let's expand. Postgres has a limit of MaxAllocSize =
-       * 1 gigabyte - 1. Normally, the skip list doubles the size when expanded.
-       * If doubling the size goes beyond MaxAllocSize, we allocate the maximum
-       * number of elements that we can fit within MaxAllocSize. If we have
-       * previously reached this maximum and more capacity is required, an
-       * error is generated. */
-      if (list->capacity == floor(MaxAllocSize / sizeof(SkipListElem)))
-        ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION),
-          errmsg("No more memory available to compute the aggregation")));
-      if (sizeof(SkipListElem) * (list->capacity << 2) > MaxAllocSize)
-        list->capacity = floor(MaxAllocSize / sizeof(SkipListElem));
-      else
-        list->capacity <<= SKIPLIST_GROW;
-      MemoryContext ctx = set_aggregation_context(fcinfo);
-      list->elems = repalloc(list->elems, sizeof(SkipListElem) * list->capacity);
-      unset_aggregation_context(ctx);
-    }
-    list->next ++;
-    return list->next - 1;
-  }
-  else
-  {
-    list->freecount --;
-    return list->freed[list->freecount];
-  }
+  if (capacity == floor(MaxAllocSize / size))
+    ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION),
+      errmsg("No more memory available to compute the aggregation")));
+  if (size * (capacity << 2) > MaxAllocSize)
+    return floor(MaxAllocSize / size);
+  return capacity << SKIPLIST_GROW;
 }
 
 /**
- * Free memory for the skiplist
+ * Allocate an element of the given height for the skiplist
+ *
+ * The element reuses a freed element of the same height if any, otherwise
+ * it takes the first available entry and as many links from the pool as
+ * its height.
  */
-static void
-skiplist_free(FunctionCallInfo fcinfo, SkipList *list, int cur)
+static int
+skiplist_alloc(FunctionCallInfo fcinfo, SkipList *list, int height)
 {
-  if (! list->freed)
+  list->length ++;
+  int cur = list->freed[height - 1];
+  if (cur)
+  {
+    /* The first link of a free element keeps the next free element */
+    list->freed[height - 1] = list->links[list->elems[cur].next];
+    return cur;
+  }
+
+  /* No free element, give first available entry */
+  if (list->next >= list->capacity)
   {
-    list->freecap = SKIPLIST_INITIAL_FREELIST;
+    list->capacity = skiplist_grow(list->capacity, sizeof(SkipListElem));
     MemoryContext ctx = set_aggregation_context(fcinfo);
-    list->freed = palloc(sizeof(int) * list->freecap);
+    list->elems = repalloc(list->elems, sizeof(SkipListElem) * list->capacity);
     unset_aggregation_context(ctx);
   }
-  else if (list->freecount == list->freecap)
+  if (list->linknext + height > list->linkcapacity)
   {
-    list->freecap <<= 1;
+    list->linkcapacity = skiplist_grow(list->linkcapacity, sizeof(int));
     MemoryContext ctx = set_aggregation_context(fcinfo);
-    list->freed = repalloc(list->freed, sizeof(int) * list->freecap);
+    list->links = repalloc(list->links, sizeof(int) * list->linkcapacity);
     unset_aggregation_context(ctx);
   }
-  list->freed[list->freecount ++] = cur;
+  cur = list->next ++;
+  list->elems[cur].height = height;
+  list->elems[cur].next = list->linknext;
+  list->linknext += height;
+  return cur;
+}
+
+/**
+ * Return the size in bytes of a value of the skiplist that is not kept in
+ * the elements of the skiplist
+ */
+static size_t
+skiplist_value_size(const SkipList *list, const void *value)
+{
+  if (list->elemtype == TIMESTAMPTZ)
+    return 0;
+  if (list->elemtype == PERIOD)
+    return sizeof(Period);
+  /* list->elemtype == TEMPORAL */
+  return VARSIZE(value);
+}
+
+/**
+ * Free an element of the skiplist, which is added to the free list of the
+ * elements of its height
+ */
+static void
+skiplist_free(SkipList *list, int cur)
+{
+  list->valuesize -= skiplist_value_size(list, list->elems[cur].value);
+  int height = list->elems[cur].height;
+  list->links[list->elems[cur].next] = list->freed[height - 1];
+  list->freed[height - 1] = cur;
   list->length --;
   return;
 }
@@ -243,11 +273,11 @@ skiplist_print(const SkipList *list)
       len +=  sprintf(buf+len, "<p0>%s\"];\n", val);
       pfree(val);
     }
-    if (e->next[0] != -1)
+    if (list->links[e->next] != -1)
     {
       for (int l = 0; l < e->height; l ++)
       {
-        int next = e->next[l];
+        int next = list->links[e->next + l];
         len += sprintf(buf+len, "\telm%d:p%d -> elm%d:p%d ", cur, l, next, l);
         if (l == 0)
           len += sprintf(buf+len, "[weight=100];\n");
@@ -255,7 +285,7 @@ skiplist_print(const SkipList *list)
           len += sprintf(buf+len, ";\n");
       }
     }
-    cur = e->next[0];
+    cur = list->links[e->next];
   }
   sprintf(buf+len, "}\n");
   ereport(WARNING, (errcode(ERRCODE_WARNING), errmsg("SKIPLIST: %s", buf)));
@@ -292,6 +322,32 @@ skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
   result->extra = NULL;
   result->extrasize = 0;
 
+  /* Compute the height of the elements and their position in the pool of
+   * links. The head and the tail have the maximum height since they grow
+   * with the list */
+  int linkcount = SKIPLIST_MAXLEVEL * 2;
+  result->elems[0].height = height;
+  result->elems[0].next = 0;
+  result->elems[count - 1].height = height;
+  result->elems[count - 1].next = SKIPLIST_MAXLEVEL;
+  for (int i = 1; i < count - 1; i ++)
+  {
+    int h = 1;
+    while (h < height && i % (1 << h) == 0)
+      h ++;
+    result->elems[i].height = h;
+    result->elems[i].next = linkcount;
+    linkcount += h;
+  }
+  int linkcapacity = SKIPLIST_INITIAL_CAPACITY;
+  while (linkcapacity <= linkcount)
+    linkcapacity <<= 1;
+  result->links = palloc0(sizeof(int) * linkcapacity);
+  result->linkcapacity = linkcapacity;
+  result->linknext = linkcount;
+  for (int level = 0; level < SKIPLIST_MAXLEVEL; level ++)
+    result->links[SKIPLIST_MAXLEVEL + level] = -1;
+
   /* Fill values first */
   result->elems[0].value = NULL;
   if (elemtype == TIMESTAMPTZ)
@@ -311,6 +367,8 @@ skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
   }
   result->elems[count - 1].value = NULL;
   result->tail = count - 1;
+  for (int i = 1; i < count - 1; i ++)
+    result->valuesize += skiplist_value_size(result, result->elems[i].value);
 
   /* Link the list in a balanced fashion */
   for (int level = 0; level < height; level ++)
@@ -320,15 +378,9 @@ skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
     {
       int next = i + step < count ? i + step : count - 1;
       if (i != count - 1)
-      {
-        result->elems[i].next[level] = next;
-        result->elems[i].height = level + 1;
-      }
+        result->links[result->elems[i].next + level] = next;
       else
-      {
-        result->elems[i].next[level] = - 1;
-        result->elems[i].height = height;
-      }
+        result->links[result->elems[i].next + level] = - 1;
     }
   }
   unset_aggregation_context(oldctx);
@@ -341,7 +393,7 @@ skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
 void *
 skiplist_headval(SkipList *list)
 {
-  return list->elems[list->elems[0].next[0]].value;
+  return list->elems[list->links[list->elems[0].next]].value;
 }
 
 /*  Function not currently used
@@ -352,161 +404,59 @@ skiplist_tailval(SkipList *list)
   int cur = 0;
   SkipListElem *e = &list->elems[cur];
   int height = e->height;
-  while (e->next[height - 1] != list->tail)
-    e = &list->elems[e->next[height - 1]];
+  while (list->links[e->next + height - 1] != list->tail)
+    e = &list->elems[list->links[e->next + height - 1]];
   return e->value;
 }
 */
 
 /**
- * Splice the skiplist with the array of values using the aggregation
- * function
- *
- * @param[in] fcinfo Catalog information about the external function
- * @param[inout] list Skiplist
- * @param[in] values Array of values
- * @param[in] count Number of elements in the array
- * @param[in] func Function
- * @param[in] crossings State whether turning points are added in the
- * when aggregating temporal segments
+ * Compute the last element before the tail at each level of the skiplist
  */
-void
-skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
-  int count, datum_func2 func, bool crossings)
+static void
+skiplist_set_tailpred(SkipList *list)
 {
-  /*
-   * O(count*log(n)) average (unless I'm mistaken)
-   * O(n+count*log(n)) worst case (when period spans the whole list so
-   * everything has to be deleted)
-   */
-  assert(list->length > 0);
-  Period p;
-  uint8 subtype = 0;
-  if (list->elemtype == TIMESTAMPTZ)
-  {
-    period_set((TimestampTz) values[0], (TimestampTz) values[count - 1],
-      true, true, &p);
-  }
-  else if (list->elemtype == PERIOD)
-  {
-    period_set(((Period *) values[0])->lower,
-      ((Period *) values[count - 1])->upper,
-      ((Period *) values[0])->lower_inc,
-      ((Period *) values[count - 1])->upper_inc, &p);
-  }
-  else /* list->elemtype == TEMPORAL */
-  {
-    subtype = ((Temporal *) skiplist_headval(list))->subtype;
-    if (subtype == INSTANT)
-      period_set(((TInstant *)values[0])->t,
-        ((TInstant *) values[count - 1])->t, true, true, &p);
-    else /* subtype == SEQUENCE */
-      period_set(((TSequence *)values[0])->period.lower,
-        ((TSequence *) values[count - 1])->period.upper,
-        ((TSequence *) values[0])->period.lower_inc,
-        ((TSequence *) values[count - 1])->period.upper_inc, &p);
-  }
-
-  int update[SKIPLIST_MAXLEVEL];
-  memset(update, 0, sizeof(update));
   int cur = 0;
-  int height = list->elems[cur].height;
   SkipListElem *e = &list->elems[cur];
+  int height = e->height;
   for (int level = height - 1; level >= 0; level --)
   {
-    while (e->next[level] != -1 &&
-      skiplist_elmpos(list, e->next[level], p.lower) == AFTER)
+    while (list->links[e->next + level] != -1 &&
+      list->links[e->next + level] != list->tail)
     {
-      cur = e->next[level];
+      cur = list->links[e->next + level];
       e = &list->elems[cur];
     }
-    update[level] = cur;
-  }
-
-  int lower = e->next[0];
-  cur = lower;
-  e = &list->elems[cur];
-
-  int spliced_count = 0;
-  while (skiplist_elmpos(list, cur, p.upper) == AFTER)
-  {
-    cur = e->next[0];
-    e = &list->elems[cur];
-    spliced_count++;
-  }
-  int upper = cur;
-  if (upper >= 0 && skiplist_elmpos(list, upper, p.upper) == DURING)
-  {
-    upper = e->next[0]; /* if found upper, one more to remove */
-    spliced_count++;
-  }
-
-  /* Delete spliced-out elements (if any) but remember their values for later */
-  void **spliced = NULL;
-  if (spliced_count != 0)
-  {
-    cur = lower;
-    spliced = palloc(sizeof(void *) * spliced_count);
-    spliced_count = 0;
-    while (cur != upper && cur != -1)
-    {
-      for (int level = 0; level < height; level ++)
-      {
-        SkipListElem *prev = &list->elems[update[level]];
-        if (prev->next[level] != cur)
-          break;
-        prev->next[level] = list->elems[cur].next[level];
-      }
-      spliced[spliced_count++] = list->elems[cur].value;
-      skiplist_free(fcinfo, list, cur);
-      cur = list->elems[cur].next[0];
-    }
-  }
-
-  /* Level down head & tail if necessary */
-  SkipListElem *head = &list->elems[0];
-  SkipListElem *tail = &list->elems[list->tail];
-  while (head->height > 1 && head->next[head->height - 1] == list->tail)
-  {
-    head->height--;
-    tail->height--;
-    height--;
-  }
-
-  if (spliced_count != 0)
-  {
-    /* We are not in a gap, compute the aggregation */
-    int newcount = 0;
-    void **newtemps;
-    if (list->elemtype == TIMESTAMPTZ)
-    {
-      newtemps = (void **) timestamp_agg((TimestampTz *) spliced, spliced_count,
-        (TimestampTz *) values, count, &newcount);
-      pfree(spliced);
-    }
-    else if (list->elemtype == PERIOD)
-    {
-      newtemps = (void **) period_agg((Period **) spliced, spliced_count,
-        (Period **) values, count, &newcount);
-      /* Delete the spliced-out period values */
-      pfree_array(spliced, spliced_count);
-    }
-    else /* list->elemtype == TEMPORAL */
-    {
-      if (subtype == INSTANT)
-        newtemps = (void **) tinstant_tagg((TInstant **) spliced,
-          spliced_count, (TInstant **) values, count, func, &newcount);
-      else
-        newtemps = (void **) tsequence_tagg((TSequence **) spliced,
-          spliced_count, (TSequence **) values, count, func, crossings, &newcount);
-      /* We need to delete the spliced-out temporal values */
-      pfree_array(spliced, spliced_count);
-    }
-    values = newtemps;
-    count = newcount;
+    list->tailpred[level] = cur;
   }
+  for (int level = height; level < SKIPLIST_MAXLEVEL; level ++)
+    list->tailpred[level] = 0;
+  list->tailvalid = true;
+  return;
+}
 
-  /* Insert new elements */
+/**
+ * Insert the array of values in the skiplist after the elements given at
+ * each level by the update vector
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ * @param[in] values Array of values
+ * @param[in] count Number of elements in the array
+ * @param[in] update Elements after which the values are inserted
+ * @param[in] height Height of the skiplist
+ * @param[in] append True when the values are inserted before the tail, in
+ * which case the last elements before the tail are kept up to date
+ */
+static void
+skiplist_insert(FunctionCallInfo fcinfo, SkipList *list, void **values,
+  int count, int *update, int height, bool append)
+{
+  SkipListElem *head, *tail;
+  /* Number of levels of tailpred set by the values already inserted. Since
+   * the values are inserted from the last one, the first value inserted
+   * having a given level is the last one in the list at this level */
+  int filled = 0;
   for (int i = count - 1; i >= 0; i--)
   {
     int rheight = random_level();
@@ -522,7 +472,7 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
       head->height = rheight;
       tail->height = rheight;
     }
-    int new = skiplist_alloc(fcinfo, list);
+    int new = skiplist_alloc(fcinfo, list, rheight);
     SkipListElem *newelm = &list->elems[new];
     MemoryContext ctx = set_aggregation_context(fcinfo);
     if (list->elemtype == TIMESTAMPTZ)
@@ -532,155 +482,1164 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
     else /* list->elemtype == TEMPORAL */
       newelm->value = temporal_copy(values[i]);
     unset_aggregation_context(ctx);
-    newelm->height = rheight;
+    list->valuesize += skiplist_value_size(list, newelm->value);
 
     for (int level = 0; level < rheight; level ++)
     {
-      newelm->next[level] = list->elems[update[level]].next[level];
-      list->elems[update[level]].next[level] = new;
+      list->links[newelm->next + level] =
+        list->links[list->elems[update[level]].next + level];
+      list->links[list->elems[update[level]].next + level] = new;
       if (level >= height && update[0] != list->tail)
       {
-        newelm->next[level] = list->tail;
+        list->links[newelm->next + level] = list->tail;
       }
     }
+    if (append && rheight > filled)
+    {
+      for (int level = filled; level < rheight; level ++)
+        list->tailpred[level] = new;
+      filled = rheight;
+    }
     if (rheight > height)
       height = rheight;
   }
-
-  if (spliced_count != 0)
-  {
-    /* We need to delete the new aggregate values */
-    if (list->elemtype == TIMESTAMPTZ)
-      pfree(values);
-    else
-      pfree_array(values, count);
-  }
   return;
 }
 
 /**
- * Return the values contained in the skiplist
+ * Aggregate two arrays of values ordered by time of the type of the
+ * elements of the skiplist
+ *
+ * @param[in] list Skiplist
+ * @param[in] values1,values2 Arrays of values
+ * @param[in] count1,count2 Number of elements in the arrays
+ * @param[in] func Function
+ * @param[in] crossings State whether turning points are added in the
+ * when aggregating temporal segments
+ * @param[out] newcount Number of elements in the result
+ * @note Return new values that must be freed by the calling function
  */
-void **
-skiplist_values(SkipList *list)
+static void **
+skiplist_agg_values(const SkipList *list, void **values1, int count1,
+  void **values2, int count2, datum_func2 func, bool crossings, int *newcount)
 {
-  void **result = palloc(sizeof(void *) * list->length);
-  int cur = list->elems[0].next[0];
-  int count = 0;
-  while (cur != list->tail)
-  {
-    result[count++] = list->elems[cur].value;
-    cur = list->elems[cur].next[0];
-  }
-  return result;
+  if (list->elemtype == TIMESTAMPTZ)
+    return (void **) timestamp_agg((TimestampTz *) values1, count1,
+      (TimestampTz *) values2, count2, newcount);
+  if (list->elemtype == PERIOD)
+    return (void **) period_agg((Period **) values1, count1,
+      (Period **) values2, count2, newcount);
+  /* list->elemtype == TEMPORAL */
+  if (((Temporal *) values1[0])->subtype == INSTANT)
+    return (void **) tinstant_tagg((TInstant **) values1, count1,
+      (TInstant **) values2, count2, func, newcount);
+  return (void **) tsequence_tagg((TSequence **) values1, count1,
+    (TSequence **) values2, count2, func, crossings, newcount);
 }
 
 /*****************************************************************************
- * Generic binary aggregate functions needed for parallelization
+ * Compact binary format of the values of the skiplists
  *****************************************************************************/
 
+/*
+ * The values are written when the states are exchanged between the processes
+ * of a parallel query or when they are spilled to disk, in both cases they
+ * are read back by the same binary. The state is thus written in a compact binary
+ * format: timestamps are written as 64-bit integers, and the values of the
+ * temporal types whose base type has a fixed length are written as flat
+ * arrays of timestamps and values without the header of each instant.
+ */
+
 /**
- * Writes the state value into the buffer
- *
- * @param[in] state State
- * @param[in] buf Buffer
+ * Return the length of the values written for a temporal type in the compact
+ * format of the values, or 0 if the base type has variable length
+ */
+static int
+aggstate_value_length(CachedType temptype)
+{
+  CachedType basetype = temptype_basetype(temptype);
+  if (basetype_byvalue(basetype))
+    return sizeof(Datum);
+  int16 len = basetype_length(basetype);
+  return len > 0 ? len : 0;
+}
+
+/**
+ * Write an instant into the buffer in the compact format
  */
 static void
-aggstate_write(SkipList *state, StringInfo buf)
+aggstate_write_inst(const TInstant *inst, bool byval, int len,
+  StringInfo buf)
 {
-  int i;
-  void **values = skiplist_values(state);
-  pq_sendint32(buf, (uint32) state->elemtype);
-  pq_sendint32(buf, (uint32) state->length);
-  if (state->elemtype == TIMESTAMPTZ)
-  {
-    for (i = 0; i < state->length; i ++)
-    {
-      bytea *time = call_send(TIMESTAMPTZOID, TimestampTzGetDatum((TimestampTz) values[i]));
-      pq_sendbytes(buf, VARDATA(time), VARSIZE(time) - VARHDRSZ);
-      pfree(time);
-    }
-  }
-  else if (state->elemtype == PERIOD)
-  {
-    for (i = 0; i < state->length; i ++)
-      period_write((const Period *) values[i], buf);
-  }
-  else /* state->elemtype == TEMPORAL */
+  pq_sendint64(buf, inst->t);
+  Datum value = tinstant_value(inst);
+  if (byval)
+    pq_sendbytes(buf, (char *) &value, sizeof(Datum));
+  else
+    pq_sendbytes(buf, DatumGetPointer(value), len);
+  return;
+}
+
+/**
+ * Read an instant from the buffer in the compact format
+ */
+static TInstant *
+aggstate_read_inst(StringInfo buf, CachedType temptype, bool byval, int len)
+{
+  TimestampTz t = (TimestampTz) pq_getmsgint64(buf);
+  const char *bytes = pq_getmsgbytes(buf, len);
+  Datum value;
+  if (byval)
+    memcpy(&value, bytes, sizeof(Datum));
+  else
+    value = PointerGetDatum(bytes);
+  return tinstant_make(value, t, temptype);
+}
+
+/**
+ * Structure to describe the values of a skiplist in the compact format
+ */
+typedef struct
+{
+  CachedType temptype;        /**< temporal type of the values */
+  uint8 subtype;              /**< subtype of the values */
+  int len;                    /**< length of the base values, 0 if variable */
+  bool byval;                 /**< base values passed by value */
+} SkipListValueFormat;
+
+/**
+ * Initialize the description of the values of a skiplist in the compact
+ * format from the first value
+ */
+static void
+skiplist_value_format(SkipListElemType elemtype, const void *value,
+  SkipListValueFormat *format)
+{
+  memset(format, 0, sizeof(SkipListValueFormat));
+  if (elemtype == TEMPORAL)
   {
-    if (state->length > 0)
-      pq_sendint32(buf, ((Temporal *) values[0])->temptype);
-    for (i = 0; i < state->length; i ++)
-    {
-      SPI_connect();
-      temporal_write((Temporal *) values[i], buf);
-      SPI_finish();
-    }
-    pq_sendint64(buf, state->extrasize);
-    if (state->extra)
-      pq_sendbytes(buf, state->extra, (int) state->extrasize);
+    const Temporal *temp = (const Temporal *) value;
+    format->temptype = temp->temptype;
+    format->subtype = temp->subtype;
+    format->len = aggstate_value_length(temp->temptype);
+    format->byval = basetype_byvalue(temptype_basetype(temp->temptype));
   }
-  pfree(values);
   return;
 }
 
 /**
- * Reads the state value from the buffer
- *
- * @param[in] fcinfo Catalog information about the external function
- * @param[in] buf Buffer
+ * Write a value of a skiplist into the buffer in the compact format
  */
-static SkipList *
-aggstate_read(FunctionCallInfo fcinfo, StringInfo buf)
+static void
+skiplist_write_value(SkipListElemType elemtype, const void *value,
+  const SkipListValueFormat *format, StringInfo buf)
 {
-  SkipListElemType elemtype = (SkipListElemType) pq_getmsgint(buf, 4);
-  int length = pq_getmsgint(buf, 4);
-  void **values = palloc0(sizeof(void *) * length);
-  SkipList *result = NULL; /* make compiler quiet */
   if (elemtype == TIMESTAMPTZ)
+    pq_sendint64(buf, (TimestampTz) value);
+  else if (elemtype == PERIOD)
   {
-    for (int i = 0; i < length; i ++)
-      values[i] = (void **) DatumGetTimestampTz(call_recv(TIMESTAMPTZOID, buf));
-    result = skiplist_make(fcinfo, values, length, TIMESTAMPTZ);
-    pfree(values);
+    const Period *p = (const Period *) value;
+    pq_sendint64(buf, p->lower);
+    pq_sendint64(buf, p->upper);
+    pq_sendbyte(buf, (uint8) ((p->lower_inc ? 1 : 0) | (p->upper_inc ? 2 : 0)));
   }
-  else if (elemtype == PERIOD)
+  else if (format->len == 0)
   {
-    for (int i = 0; i < length; i ++)
-      values[i] = period_read(buf);
-    result = skiplist_make(fcinfo, values, length, PERIOD);
-    pfree_array(values, length);
+    SPI_connect();
+    temporal_write((Temporal *) value, buf);
+    SPI_finish();
   }
-  else /* elemtype == TEMPORAL */
+  else if (format->subtype == INSTANT)
+    aggstate_write_inst((const TInstant *) value, format->byval, format->len,
+      buf);
+  else /* format->subtype == SEQUENCE */
   {
-    CachedType temptype = pq_getmsgint(buf, 4);
-    for (int i = 0; i < length; i ++)
-      values[i] = temporal_read(buf, temptype);
-    size_t extrasize = (size_t) pq_getmsgint64(buf);
-    result = skiplist_make(fcinfo, values, length, TEMPORAL);
-    if (extrasize)
-    {
-      const char *extra = pq_getmsgbytes(buf, (int) extrasize);
-      aggstate_set_extra(fcinfo, result, (void *) extra, extrasize);
-    }
-    pfree_array(values, length);
+    const TSequence *seq = (const TSequence *) value;
+    pq_sendint32(buf, seq->count);
+    pq_sendbyte(buf, (uint8) ((seq->period.lower_inc ? 1 : 0) |
+      (seq->period.upper_inc ? 2 : 0) |
+      (MOBDB_FLAGS_GET_LINEAR(seq->flags) ? 4 : 0)));
+    for (int j = 0; j < seq->count; j ++)
+      aggstate_write_inst(tsequence_inst_n(seq, j), format->byval,
+        format->len, buf);
   }
-  return result;
+  return;
 }
 
 /**
- * Reads the state value from the buffer
+ * Read a value of a skiplist from the buffer in the compact format
  *
- * @param[in] fcinfo Catalog information about the external function
- * @param[in] state State
- * @param[in] data Structure containing the data
- * @param[in] size Size of the structure
+ * @note Return a new value, excepted for timestamps
  */
-void
-aggstate_set_extra(FunctionCallInfo fcinfo, SkipList *state, void *data,
-  size_t size)
+static void *
+skiplist_read_value(SkipListElemType elemtype,
+  const SkipListValueFormat *format, StringInfo buf)
 {
-  MemoryContext ctx;
+  if (elemtype == TIMESTAMPTZ)
+    return (void *) (TimestampTz) pq_getmsgint64(buf);
+  if (elemtype == PERIOD)
+  {
+    TimestampTz lower = (TimestampTz) pq_getmsgint64(buf);
+    TimestampTz upper = (TimestampTz) pq_getmsgint64(buf);
+    uint8 bounds = (uint8) pq_getmsgbyte(buf);
+    return period_make(lower, upper, bounds & 1, bounds & 2);
+  }
+  /* elemtype == TEMPORAL */
+  if (format->len == 0)
+    return temporal_read(buf, format->temptype);
+  if (format->subtype == INSTANT)
+    return aggstate_read_inst(buf, format->temptype, format->byval,
+      format->len);
+  /* format->subtype == SEQUENCE */
+  int ninsts = pq_getmsgint(buf, 4);
+  uint8 flags = (uint8) pq_getmsgbyte(buf);
+  TInstant **instants = palloc(sizeof(TInstant *) * ninsts);
+  for (int j = 0; j < ninsts; j ++)
+    instants[j] = aggstate_read_inst(buf, format->temptype, format->byval,
+      format->len);
+  return tsequence_make_free(instants, ninsts, flags & 1, flags & 2,
+    flags & 4, NORMALIZE_NO);
+}
+
+/**
+ * Write the array of values of a skiplist into the buffer in the compact
+ * format
+ */
+static void
+skiplist_write_values(SkipListElemType elemtype, void **values, int count,
+  StringInfo buf)
+{
+  if (count == 0)
+    return;
+  SkipListValueFormat format;
+  skiplist_value_format(elemtype, values[0], &format);
+  if (elemtype == TEMPORAL)
+  {
+    pq_sendint32(buf, format.temptype);
+    pq_sendbyte(buf, format.subtype);
+    pq_sendint32(buf, format.len);
+  }
+  for (int i = 0; i < count; i ++)
+    skiplist_write_value(elemtype, values[i], &format, buf);
+  return;
+}
+
+/**
+ * Read an array of values of a skiplist from the buffer in the compact format
+ *
+ * @note Return new values that must be freed with skiplist_free_values
+ */
+static void **
+skiplist_read_values(SkipListElemType elemtype, int count, StringInfo buf)
+{
+  void **result = palloc0(sizeof(void *) * count);
+  if (count == 0)
+    return result;
+  SkipListValueFormat format;
+  memset(&format, 0, sizeof(SkipListValueFormat));
+  if (elemtype == TEMPORAL)
+  {
+    format.temptype = pq_getmsgint(buf, 4);
+    format.subtype = (uint8) pq_getmsgbyte(buf);
+    format.len = pq_getmsgint(buf, 4);
+    format.byval = basetype_byvalue(temptype_basetype(format.temptype));
+  }
+  for (int i = 0; i < count; i ++)
+    result[i] = skiplist_read_value(elemtype, &format, buf);
+  return result;
+}
+
+/**
+ * Free a value of a skiplist
+ */
+static void
+skiplist_free_value(SkipListElemType elemtype, void *value)
+{
+  if (elemtype != TIMESTAMPTZ)
+    pfree(value);
+  return;
+}
+
+/**
+ * Free an array of values of a skiplist
+ */
+static void
+skiplist_free_values(SkipListElemType elemtype, void **values, int count)
+{
+  if (elemtype == TIMESTAMPTZ)
+    pfree(values);
+  else
+    pfree_array(values, count);
+  return;
+}
+
+/**
+ * Return the start timestamp of a value of a skiplist
+ */
+static TimestampTz
+skiplist_value_lower(SkipListElemType elemtype, const void *value)
+{
+  if (elemtype == TIMESTAMPTZ)
+    return (TimestampTz) value;
+  if (elemtype == PERIOD)
+    return ((const Period *) value)->lower;
+  /* elemtype == TEMPORAL */
+  if (((const Temporal *) value)->subtype == INSTANT)
+    return ((const TInstant *) value)->t;
+  return ((const TSequence *) value)->period.lower;
+}
+
+/**
+ * Return the end timestamp of a value of a skiplist
+ */
+static TimestampTz
+skiplist_value_upper(SkipListElemType elemtype, const void *value)
+{
+  if (elemtype == TIMESTAMPTZ)
+    return (TimestampTz) value;
+  if (elemtype == PERIOD)
+    return ((const Period *) value)->upper;
+  /* elemtype == TEMPORAL */
+  if (((const Temporal *) value)->subtype == INSTANT)
+    return ((const TInstant *) value)->t;
+  return ((const TSequence *) value)->period.upper;
+}
+
+/*****************************************************************************
+ * Spilling of the skiplists to disk
+ *****************************************************************************/
+
+/*
+ * When the size of a skiplist exceeds work_mem, all its values but the last
+ * one are written as a run into a temporary file. Since the values of a
+ * skiplist are ordered by time, each run is ordered by time. Each run starts
+ * with a header giving the number of values and the size of the run, and
+ * each value is written as a record with its size, so that the runs can be
+ * read one value at a time.
+ *
+ * The runs are never loaded back into the skiplist. The final functions and
+ * the serialization read the values of all runs and of the skiplist with a
+ * k-way merge that keeps one cursor per run in a binary heap ordered by the
+ * start timestamp of the current value of each cursor, and the combine
+ * function splices the runs of the second state into the first one.
+ *
+ * The states of all the groups computed by an aggregate function share a
+ * single temporary file, kept in the extra field of the function, so that
+ * the number of open files does not grow with the number of groups. Each
+ * state keeps the positions of its runs in this file, which is closed when
+ * the memory context of the function is deleted at the end of the query.
+ * The temporary file is a buffered file of PostgreSQL, the blocks written
+ * are thus reported as temporary blocks by EXPLAIN (ANALYZE, BUFFERS). The
+ * number of runs and of bytes spilled by the final state are returned by
+ * the tcount_spillstats aggregates.
+ */
+
+/**
+ * Structure to represent the temporary file shared by the states of an
+ * aggregate function
+ */
+typedef struct
+{
+  BufFile *file;              /**< temporary file, NULL if not yet created */
+  MemoryContextCallback cb;   /**< callback closing the file */
+} SkipListSpillFile;
+
+/**
+ * Structure to represent the header of a run spilled to disk
+ */
+typedef struct
+{
+  int count;                  /**< number of values of the run */
+  size_t size;                /**< size in bytes of the values of the run */
+  SkipListValueFormat format; /**< format of the values */
+} SkipListRunHeader;
+
+/**
+ * Structure to read the values of a run spilled to disk one at a time
+ */
+typedef struct
+{
+  SkipListRunHeader header;   /**< header of the run */
+  int fileno;                 /**< file of the next value */
+  off_t offset;               /**< offset of the next value in the file */
+  int remaining;              /**< number of values not yet read */
+  StringInfoData buf;         /**< buffer of the value read */
+} SkipListRun;
+
+/**
+ * Free the values and the elements of the skiplist
+ */
+static void
+skiplist_free_elems(SkipList *list)
+{
+  if (list->elemtype != TIMESTAMPTZ)
+  {
+    int cur = list->links[list->elems[0].next];
+    while (cur != list->tail)
+    {
+      pfree(list->elems[cur].value);
+      cur = list->links[list->elems[cur].next];
+    }
+  }
+  pfree(list->elems);
+  pfree(list->links);
+  return;
+}
+
+/**
+ * Replace the values of the skiplist by the array of values, keeping the
+ * extra data and the runs spilled to disk
+ */
+static void
+skiplist_reset(FunctionCallInfo fcinfo, SkipList *list, void **values,
+  int count)
+{
+  SkipList *result = skiplist_make(fcinfo, values, count, list->elemtype);
+  skiplist_free_elems(list);
+  result->extra = list->extra;
+  result->extrasize = list->extrasize;
+  result->spill = list->spill;
+  result->spillpos = list->spillpos;
+  result->spillruns = list->spillruns;
+  result->spillbytes = list->spillbytes;
+  result->spillfunc = list->spillfunc;
+  result->spillcrossings = list->spillcrossings;
+  memcpy(list, result, sizeof(SkipList));
+  pfree(result);
+  return;
+}
+
+/**
+ * Close the temporary file shared by the states of an aggregate function
+ */
+static void
+skiplist_spillfile_close(void *arg)
+{
+  SkipListSpillFile *spillfile = (SkipListSpillFile *) arg;
+  if (spillfile->file)
+    BufFileClose(spillfile->file);
+  spillfile->file = NULL;
+  return;
+}
+
+/**
+ * Return the temporary file shared by the states of the aggregate function,
+ * creating it on the first call
+ */
+static BufFile *
+skiplist_spillfile(FunctionCallInfo fcinfo)
+{
+  FmgrInfo *flinfo = fcinfo->flinfo;
+  SkipListSpillFile *spillfile = (SkipListSpillFile *) flinfo->fn_extra;
+  if (! spillfile)
+  {
+    spillfile = MemoryContextAllocZero(flinfo->fn_mcxt,
+      sizeof(SkipListSpillFile));
+    spillfile->cb.func = skiplist_spillfile_close;
+    spillfile->cb.arg = spillfile;
+    MemoryContextRegisterResetCallback(flinfo->fn_mcxt, &spillfile->cb);
+    flinfo->fn_extra = spillfile;
+  }
+  if (! spillfile->file)
+  {
+    MemoryContext ctx = MemoryContextSwitchTo(flinfo->fn_mcxt);
+    spillfile->file = BufFileCreateTemp(false);
+    MemoryContextSwitchTo(ctx);
+  }
+  return spillfile->file;
+}
+
+/**
+ * Write all the values of the skiplist but the last one as a run at the end
+ * of the temporary file shared by the states of the aggregate function
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ * @param[in] func Function
+ * @param[in] crossings State whether turning points are added in the
+ * when aggregating temporal segments
+ */
+static void
+skiplist_spill(FunctionCallInfo fcinfo, SkipList *list, datum_func2 func,
+  bool crossings)
+{
+  if (! list->spill)
+    list->spill = skiplist_spillfile(fcinfo);
+
+  void **values = skiplist_values(list);
+  SkipListRunHeader header;
+  header.count = list->length - 1;
+  skiplist_value_format(list->elemtype, values[0], &header.format);
+  StringInfoData buf;
+  initStringInfo(&buf);
+  for (int i = 0; i < header.count; i ++)
+  {
+    /* Reserve the size of the record and fill it after writing the value */
+    int start = buf.len;
+    pq_sendint32(&buf, 0);
+    skiplist_write_value(list->elemtype, values[i], &header.format, &buf);
+    int size = buf.len - start - (int) sizeof(int32);
+    memcpy(buf.data + start, &size, sizeof(int32));
+  }
+  header.size = buf.len;
+  if (BufFileSeek(list->spill, 0, 0L, SEEK_END) != 0)
+    ereport(ERROR, (errcode_for_file_access(),
+      errmsg("could not seek in aggregate temporary file")));
+  MemoryContext ctx = set_aggregation_context(fcinfo);
+  list->spillpos = list->spillpos ?
+    repalloc(list->spillpos, sizeof(SkipListRunPos) * (list->spillruns + 1)) :
+    palloc(sizeof(SkipListRunPos));
+  unset_aggregation_context(ctx);
+  SkipListRunPos *pos = &list->spillpos[list->spillruns];
+  BufFileTell(list->spill, &pos->fileno, &pos->offset);
+  BufFileWrite(list->spill, (void *) &header, sizeof(SkipListRunHeader));
+  BufFileWrite(list->spill, (void *) buf.data, buf.len);
+  list->spillruns ++;
+  list->spillbytes += sizeof(SkipListRunHeader) + buf.len;
+  list->spillfunc = func;
+  list->spillcrossings = crossings;
+  pfree(buf.data);
+  /* Keep the last value in memory so that the skiplist is never empty */
+  skiplist_reset(fcinfo, list, &values[header.count], 1);
+  pfree(values);
+  return;
+}
+
+/**
+ * Spill the skiplist to disk if its size exceeds work_mem
+ */
+static void
+skiplist_check_spill(FunctionCallInfo fcinfo, SkipList *list,
+  datum_func2 func, bool crossings)
+{
+  if (list->length > 1 &&
+      skiplist_memsize(list) > (size_t) work_mem * 1024L)
+    skiplist_spill(fcinfo, list, func, crossings);
+  return;
+}
+
+/**
+ * Read the given number of bytes from the temporary file of the skiplist
+ */
+static void
+skiplist_spill_read(SkipList *list, void *ptr, size_t size)
+{
+  if (BufFileRead(list->spill, ptr, size) != size)
+    ereport(ERROR, (errcode_for_file_access(),
+      errmsg("could not read from aggregate temporary file")));
+  return;
+}
+
+/**
+ * Position the temporary file of the skiplist
+ */
+static void
+skiplist_spill_seek(SkipList *list, int fileno, off_t offset, int whence)
+{
+  if (BufFileSeek(list->spill, fileno, offset, whence) != 0)
+    ereport(ERROR, (errcode_for_file_access(),
+      errmsg("could not seek in aggregate temporary file")));
+  return;
+}
+
+/**
+ * Return the cursors of the runs spilled to disk, positioned before their
+ * first value
+ *
+ * Only the headers of the runs are read.
+ */
+static SkipListRun *
+skiplist_runs(SkipList *list)
+{
+  SkipListRun *result = palloc0(sizeof(SkipListRun) * list->spillruns);
+  for (int i = 0; i < list->spillruns; i ++)
+  {
+    SkipListRun *run = &result[i];
+    skiplist_spill_seek(list, list->spillpos[i].fileno,
+      list->spillpos[i].offset, SEEK_SET);
+    skiplist_spill_read(list, &run->header, sizeof(SkipListRunHeader));
+    BufFileTell(list->spill, &run->fileno, &run->offset);
+    run->remaining = run->header.count;
+    initStringInfo(&run->buf);
+  }
+  return result;
+}
+
+/**
+ * Return the next value of a run spilled to disk, the found argument is set
+ * to false when all its values have been read
+ *
+ * @note Return a new value, excepted for timestamps
+ */
+static void *
+skiplist_run_next(SkipList *list, SkipListRun *run, bool *found)
+{
+  *found = (run->remaining > 0);
+  if (! *found)
+    return NULL;
+  skiplist_spill_seek(list, run->fileno, run->offset, SEEK_SET);
+  int32 size;
+  skiplist_spill_read(list, &size, sizeof(int32));
+  resetStringInfo(&run->buf);
+  enlargeStringInfo(&run->buf, size);
+  skiplist_spill_read(list, run->buf.data, size);
+  run->buf.len = size;
+  BufFileTell(list->spill, &run->fileno, &run->offset);
+  run->remaining --;
+  return skiplist_read_value(list->elemtype, &run->header.format, &run->buf);
+}
+
+/**
+ * Free the cursors of the runs spilled to disk
+ */
+static void
+skiplist_runs_free(SkipList *list, SkipListRun *runs)
+{
+  for (int i = 0; i < list->spillruns; i ++)
+    pfree(runs[i].buf.data);
+  pfree(runs);
+  return;
+}
+
+/**
+ * Release the runs spilled to disk of the skiplist
+ *
+ * @note The space of the runs in the shared temporary file is not reclaimed
+ * before the file is closed
+ */
+static void
+skiplist_spill_release(SkipList *list)
+{
+  if (list->spillpos)
+    pfree(list->spillpos);
+  list->spill = NULL;
+  list->spillpos = NULL;
+  list->spillruns = 0;
+  list->spillbytes = 0;
+  return;
+}
+
+/**
+ * Structure to merge the values of the runs spilled to disk and of the
+ * skiplist, where the last source is the skiplist
+ */
+typedef struct
+{
+  SkipListElemType elemtype;  /**< type of the values */
+  void **heads;               /**< current value of each source */
+} SkipListMergeState;
+
+/**
+ * Comparator of the binary heap of the sources of a k-way merge, the binary
+ * heap of PostgreSQL keeps the largest element first
+ */
+static int
+skiplist_merge_cmp(Datum a, Datum b, void *arg)
+{
+  SkipListMergeState *state = (SkipListMergeState *) arg;
+  TimestampTz t1 = skiplist_value_lower(state->elemtype,
+    state->heads[DatumGetInt32(a)]);
+  TimestampTz t2 = skiplist_value_lower(state->elemtype,
+    state->heads[DatumGetInt32(b)]);
+  return (t1 > t2) ? -1 : ((t1 < t2) ? 1 : 0);
+}
+
+/**
+ * Return the values of the skiplist merged with the runs spilled to disk
+ *
+ * The runs and the skiplist are read with a k-way merge in the order of the
+ * start timestamps of their values. The values that overlap are aggregated
+ * with the function that was used when splicing the skiplist, and the values
+ * that end before the start of the next value of the merge cannot overlap
+ * any other value and are emitted. The skiplist and the runs are not
+ * modified, so that the function can be called several times.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] list Skiplist
+ * @param[out] count Number of values of the result
+ * @note The values of the result that come from the skiplist are not copied
+ */
+void **
+skiplist_final_values(FunctionCallInfo fcinfo, SkipList *list, int *count)
+{
+  if (! list->spill)
+  {
+    *count = list->length;
+    return skiplist_values(list);
+  }
+  elog(DEBUG1, "Aggregate state spilled %d runs, %zu bytes",
+    list->spillruns, list->spillbytes);
+
+  SkipListElemType elemtype = list->elemtype;
+  int nsrcs = list->spillruns + 1;
+  SkipListRun *runs = skiplist_runs(list);
+  SkipListMergeState state;
+  state.elemtype = elemtype;
+  state.heads = palloc(sizeof(void *) * nsrcs);
+  binaryheap *heap = binaryheap_allocate(nsrcs, skiplist_merge_cmp, &state);
+  bool found;
+  for (int i = 0; i < list->spillruns; i ++)
+  {
+    state.heads[i] = skiplist_run_next(list, &runs[i], &found);
+    if (found)
+      binaryheap_add_unordered(heap, Int32GetDatum(i));
+  }
+  int memcur = list->links[list->elems[0].next];
+  if (memcur != list->tail)
+  {
+    state.heads[nsrcs - 1] = list->elems[memcur].value;
+    binaryheap_add_unordered(heap, Int32GetDatum(nsrcs - 1));
+  }
+  binaryheap_build(heap);
+
+  /* The pending values are aggregated and may overlap the next values,
+   * the values read from the runs and the aggregated values are owned */
+  int maxcount = list->length + 1;
+  for (int i = 0; i < list->spillruns; i ++)
+    maxcount += runs[i].header.count;
+  void **result = palloc(sizeof(void *) * maxcount);
+  int ncount = 0;
+  void **pending = palloc(sizeof(void *));
+  bool *owned = palloc(sizeof(bool));
+  int npending = 0;
+  while (! binaryheap_empty(heap))
+  {
+    int src = DatumGetInt32(binaryheap_first(heap));
+    void *value = state.heads[src];
+    bool valueowned = (src < nsrcs - 1);
+    /* Advance the source */
+    if (valueowned)
+      state.heads[src] = skiplist_run_next(list, &runs[src], &found);
+    else
+    {
+      memcur = list->links[list->elems[memcur].next];
+      found = (memcur != list->tail);
+      if (found)
+        state.heads[src] = list->elems[memcur].value;
+    }
+    if (found)
+      binaryheap_replace_first(heap, Int32GetDatum(src));
+    else
+      binaryheap_remove_first(heap);
+
+    /* Emit the pending values that end before the value */
+    TimestampTz lower = skiplist_value_lower(elemtype, value);
+    int nemit = 0;
+    while (nemit < npending &&
+        skiplist_value_upper(elemtype, pending[nemit]) < lower)
+      nemit ++;
+    if (ncount + nemit >= maxcount)
+    {
+      maxcount = Max(maxcount * 2, ncount + nemit + 1);
+      result = repalloc(result, sizeof(void *) * maxcount);
+    }
+    memcpy(&result[ncount], pending, sizeof(void *) * nemit);
+    ncount += nemit;
+    npending -= nemit;
+    memmove(pending, &pending[nemit], sizeof(void *) * npending);
+    memmove(owned, &owned[nemit], sizeof(bool) * npending);
+
+    if (npending == 0)
+    {
+      pending[0] = value;
+      owned[0] = valueowned;
+      npending = 1;
+      continue;
+    }
+    /* Aggregate the value with the pending values that it may overlap */
+    int newcount;
+    void **newvalues = skiplist_agg_values(list, pending, npending, &value, 1,
+      list->spillfunc, list->spillcrossings, &newcount);
+    for (int i = 0; i < npending; i ++)
+    {
+      if (owned[i])
+        skiplist_free_value(elemtype, pending[i]);
+    }
+    if (valueowned)
+      skiplist_free_value(elemtype, value);
+    pfree(pending); pfree(owned);
+    pending = newvalues;
+    npending = newcount;
+    owned = palloc(sizeof(bool) * Max(newcount, 1));
+    memset(owned, true, sizeof(bool) * newcount);
+  }
+  if (ncount + npending > maxcount)
+    result = repalloc(result, sizeof(void *) * (ncount + npending));
+  memcpy(&result[ncount], pending, sizeof(void *) * npending);
+  ncount += npending;
+  pfree(pending); pfree(owned);
+  binaryheap_free(heap);
+  pfree(state.heads);
+  skiplist_runs_free(list, runs);
+  *count = ncount;
+  return result;
+}
+
+/**
+ * Splice the skiplist with the array of values using the aggregation
+ * function
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ * @param[in] values Array of values
+ * @param[in] count Number of elements in the array
+ * @param[in] func Function
+ * @param[in] crossings State whether turning points are added in the
+ * when aggregating temporal segments
+ */
+void
+skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
+  int count, datum_func2 func, bool crossings)
+{
+  /*
+   * O(count*log(n)) average (unless I'm mistaken)
+   * O(n+count*log(n)) worst case (when period spans the whole list so
+   * everything has to be deleted)
+   */
+  assert(list->length > 0);
+  Period p;
+  if (list->elemtype == TIMESTAMPTZ)
+  {
+    period_set((TimestampTz) values[0], (TimestampTz) values[count - 1],
+      true, true, &p);
+  }
+  else if (list->elemtype == PERIOD)
+  {
+    period_set(((Period *) values[0])->lower,
+      ((Period *) values[count - 1])->upper,
+      ((Period *) values[0])->lower_inc,
+      ((Period *) values[count - 1])->upper_inc, &p);
+  }
+  else /* list->elemtype == TEMPORAL */
+  {
+    uint8 subtype = ((Temporal *) skiplist_headval(list))->subtype;
+    if (subtype == INSTANT)
+      period_set(((TInstant *)values[0])->t,
+        ((TInstant *) values[count - 1])->t, true, true, &p);
+    else /* subtype == SEQUENCE */
+      period_set(((TSequence *)values[0])->period.lower,
+        ((TSequence *) values[count - 1])->period.upper,
+        ((TSequence *) values[0])->period.lower_inc,
+        ((TSequence *) values[count - 1])->period.upper_inc, &p);
+  }
+
+  int update[SKIPLIST_MAXLEVEL];
+  int height = list->elems[0].height;
+
+  /* Fast path for monotonic input, which is the usual case when aggregating
+   * values ordered by time: when the values start after the last element of
+   * the list they are appended before the tail without searching the list
+   * and without calling the aggregation function */
+  if (! list->tailvalid)
+    skiplist_set_tailpred(list);
+  if (skiplist_elmpos(list, list->tailpred[0], p.lower) == AFTER)
+  {
+    memcpy(update, list->tailpred, sizeof(update));
+    skiplist_insert(fcinfo, list, values, count, update, height, true);
+    skiplist_check_spill(fcinfo, list, func, crossings);
+    return;
+  }
+
+  memset(update, 0, sizeof(update));
+  int cur = 0;
+  SkipListElem *e = &list->elems[cur];
+  for (int level = height - 1; level >= 0; level --)
+  {
+    while (list->links[e->next + level] != -1 &&
+      skiplist_elmpos(list, list->links[e->next + level], p.lower) == AFTER)
+    {
+      cur = list->links[e->next + level];
+      e = &list->elems[cur];
+    }
+    update[level] = cur;
+  }
+
+  int lower = list->links[e->next];
+  cur = lower;
+  e = &list->elems[cur];
+
+  int spliced_count = 0;
+  while (skiplist_elmpos(list, cur, p.upper) == AFTER)
+  {
+    cur = list->links[e->next];
+    e = &list->elems[cur];
+    spliced_count++;
+  }
+  int upper = cur;
+  if (upper >= 0 && skiplist_elmpos(list, upper, p.upper) == DURING)
+  {
+    upper = list->links[e->next]; /* if found upper, one more to remove */
+    spliced_count++;
+  }
+
+  /* Delete spliced-out elements (if any) but remember their values for later */
+  void **spliced = NULL;
+  if (spliced_count != 0)
+  {
+    cur = lower;
+    spliced = palloc(sizeof(void *) * spliced_count);
+    spliced_count = 0;
+    while (cur != upper && cur != -1)
+    {
+      for (int level = 0; level < height; level ++)
+      {
+        SkipListElem *prev = &list->elems[update[level]];
+        if (list->links[prev->next + level] != cur)
+          break;
+        list->links[prev->next + level] =
+          list->links[list->elems[cur].next + level];
+      }
+      spliced[spliced_count++] = list->elems[cur].value;
+      int next = list->links[list->elems[cur].next];
+      skiplist_free(list, cur);
+      cur = next;
+    }
+  }
+
+  /* Level down head & tail if necessary */
+  SkipListElem *head = &list->elems[0];
+  SkipListElem *tail = &list->elems[list->tail];
+  while (head->height > 1 &&
+    list->links[head->next + head->height - 1] == list->tail)
+  {
+    head->height--;
+    tail->height--;
+    height--;
+  }
+
+  if (spliced_count != 0)
+  {
+    /* We are not in a gap, compute the aggregation */
+    int newcount = 0;
+    void **newtemps = skiplist_agg_values(list, spliced, spliced_count,
+      values, count, func, crossings, &newcount);
+    /* Delete the spliced-out values */
+    skiplist_free_values(list->elemtype, spliced, spliced_count);
+    values = newtemps;
+    count = newcount;
+  }
+
+  /* Insert new elements */
+  skiplist_insert(fcinfo, list, values, count, update, height, false);
+  /* The last elements before the tail are recomputed on the next call */
+  list->tailvalid = false;
+
+  if (spliced_count != 0)
+  {
+    /* We need to delete the new aggregate values */
+    skiplist_free_values(list->elemtype, values, count);
+  }
+  skiplist_check_spill(fcinfo, list, func, crossings);
+  return;
+}
+
+/**
+ * Splice the array of values ordered by time into the skiplist
+ *
+ * The values are split into batches at the elements of the skiplist lying
+ * between two consecutive values, which are found in a single pass over the
+ * values and the skiplist. Each batch is then spliced with only the elements
+ * it overlaps, while the other elements are kept in place.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ * @param[in] values Array of values
+ * @param[in] count Number of elements in the array
+ * @param[in] func Function
+ * @param[in] crossings State whether turning points are added in the
+ * when aggregating temporal segments
+ */
+static void
+skiplist_splice_values(FunctionCallInfo fcinfo, SkipList *list,
+  void **values, int count, datum_func2 func, bool crossings)
+{
+  if (count == 0)
+    return;
+  /* The batches are computed before splicing since the skiplist may be
+   * spilled to disk while splicing a batch */
+  int *cuts = palloc(sizeof(int) * count);
+  int ncuts = 0;
+  int cur = list->links[list->elems[0].next];
+  for (int i = 1; i < count; i ++)
+  {
+    TimestampTz upper = skiplist_value_upper(list->elemtype, values[i - 1]);
+    while (cur != list->tail && skiplist_elmpos(list, cur, upper) != BEFORE)
+      cur = list->links[list->elems[cur].next];
+    if (cur == list->tail)
+      break;
+    TimestampTz lower = skiplist_value_lower(list->elemtype, values[i]);
+    if (skiplist_elmpos(list, cur, lower) == AFTER)
+      cuts[ncuts++] = i;
+  }
+  cuts[ncuts++] = count;
+  int start = 0;
+  for (int i = 0; i < ncuts; i ++)
+  {
+    skiplist_splice(fcinfo, list, &values[start], cuts[i] - start, func,
+      crossings);
+    start = cuts[i];
+  }
+  pfree(cuts);
+  return;
+}
+
+/**
+ * Splice the runs spilled to disk of the second skiplist into the first one
+ * and release the runs of the second skiplist
+ *
+ * The runs are read one at a time, so that the values of the second
+ * skiplist are never loaded all at once in memory.
+ */
+static void
+skiplist_merge_runs(FunctionCallInfo fcinfo, SkipList *list1,
+  SkipList *list2, datum_func2 func, bool crossings)
+{
+  SkipListRun *runs = skiplist_runs(list2);
+  for (int i = 0; i < list2->spillruns; i ++)
+  {
+    int count = runs[i].header.count;
+    void **values = palloc(sizeof(void *) * count);
+    bool found;
+    for (int j = 0; j < count; j ++)
+      values[j] = skiplist_run_next(list2, &runs[i], &found);
+    skiplist_splice_values(fcinfo, list1, values, count, func, crossings);
+    skiplist_free_values(list1->elemtype, values, count);
+  }
+  skiplist_runs_free(list2, runs);
+  skiplist_spill_release(list2);
+  return;
+}
+
+/**
+ * Merge two skiplists using the aggregation function
+ *
+ * The values of the second skiplist, including its runs spilled to disk,
+ * are spliced into the first one, while the runs of the first skiplist are
+ * kept on disk and merged by the final function. The elements of the first
+ * skiplist that do not overlap the values of the second one are kept in
+ * place, so that the first skiplist is never rebuilt. When the values of
+ * the second skiplist are after those of the first one they are simply
+ * appended to the first skiplist.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] list1,list2 Skiplists
+ * @param[in] func Function
+ * @param[in] crossings State whether turning points are added in the
+ * when aggregating temporal segments
+ * @result Resulting skiplist
+ */
+SkipList *
+skiplist_merge(FunctionCallInfo fcinfo, SkipList *list1, SkipList *list2,
+  datum_func2 func, bool crossings)
+{
+  assert(list1->elemtype == list2->elemtype);
+  if (list2->spill)
+    skiplist_merge_runs(fcinfo, list1, list2, func, crossings);
+  void **values2 = skiplist_values(list2);
+  skiplist_splice_values(fcinfo, list1, values2, list2->length, func,
+    crossings);
+  pfree(values2);
+  return list1;
+}
+
+/**
+ * Return the size in bytes of the skiplist, including its values
+ */
+size_t
+skiplist_memsize(const SkipList *list)
+{
+  return sizeof(SkipList) + sizeof(SkipListElem) * list->capacity +
+    sizeof(int) * list->linkcapacity + list->extrasize + list->valuesize;
+}
+
+/**
+ * Return the values contained in the skiplist
+ *
+ * @note The size of the skiplist is reported at the DEBUG1 level, which
+ * allows to size work_mem for the aggregations. It is also returned by the
+ * tcount_memsize aggregates.
+ */
+void **
+skiplist_values(SkipList *list)
+{
+  elog(DEBUG1, "Aggregate state of %d values, %d links, %zu bytes",
+    list->length, list->linknext, skiplist_memsize(list));
+  void **result = palloc(sizeof(void *) * list->length);
+  int cur = list->links[list->elems[0].next];
+  int count = 0;
+  while (cur != list->tail)
+  {
+    result[count++] = list->elems[cur].value;
+    cur = list->links[list->elems[cur].next];
+  }
+  return result;
+}
+
+/*****************************************************************************
+ * Generic binary aggregate functions needed for parallelization
+ *****************************************************************************/
+
+/**
+ * Writes the state value into the buffer
+ *
+ * @param[in] state State
+ * @param[in] values,count Values of the state merged with its runs
+ * @param[in] buf Buffer
+ */
+static void
+aggstate_write(SkipList *state, void **values, int count, StringInfo buf)
+{
+  pq_sendint32(buf, (uint32) state->elemtype);
+  pq_sendint32(buf, (uint32) count);
+  skiplist_write_values(state->elemtype, values, count, buf);
+  if (state->elemtype == TEMPORAL)
+  {
+    pq_sendint64(buf, state->extrasize);
+    if (state->extra)
+      pq_sendbytes(buf, state->extra, (int) state->extrasize);
+  }
+  return;
+}
+
+/**
+ * Reads the state value from the buffer
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] buf Buffer
+ */
+static SkipList *
+aggstate_read(FunctionCallInfo fcinfo, StringInfo buf)
+{
+  SkipListElemType elemtype = (SkipListElemType) pq_getmsgint(buf, 4);
+  int length = pq_getmsgint(buf, 4);
+  void **values = skiplist_read_values(elemtype, length, buf);
+  SkipList *result = skiplist_make(fcinfo, values, length, elemtype);
+  if (elemtype == TEMPORAL)
+  {
+    size_t extrasize = (size_t) pq_getmsgint64(buf);
+    if (extrasize)
+    {
+      const char *extra = pq_getmsgbytes(buf, (int) extrasize);
+      aggstate_set_extra(fcinfo, result, (void *) extra, extrasize);
+    }
+  }
+  skiplist_free_values(elemtype, values, length);
+  return result;
+}
+
+/**
+ * Reads the state value from the buffer
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] state State
+ * @param[in] data Structure containing the data
+ * @param[in] size Size of the structure
+ */
+void
+aggstate_set_extra(FunctionCallInfo fcinfo, SkipList *state, void *data,
+  size_t size)
+{
+  MemoryContext ctx;
   assert(AggCheckCallContext(fcinfo, &ctx));
   MemoryContext oldctx = MemoryContextSwitchTo(ctx);
   state->extra = palloc(size);
@@ -698,8 +1657,11 @@ Tagg_serialize(PG_FUNCTION_ARGS)
 {
   SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
   StringInfoData buf;
+  int count;
+  void **values = skiplist_final_values(fcinfo, state, &count);
   pq_begintypsend(&buf);
-  aggstate_write(state, &buf);
+  aggstate_write(state, values, count, &buf);
+  pfree(values);
   PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
 }
 
@@ -722,4 +1684,35 @@ Tagg_deserialize(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+PG_FUNCTION_INFO_V1(Tagg_memsize);
+/**
+ * Return the size in bytes of the state value kept in memory
+ *
+ * @note The runs spilled to a temporary file are not included, they are
+ * reported by function Tagg_spillstats
+ */
+PGDLLEXPORT Datum
+Tagg_memsize(PG_FUNCTION_ARGS)
+{
+  SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
+  PG_RETURN_INT64((int64) skiplist_memsize(state));
+}
+
+PG_FUNCTION_INFO_V1(Tagg_spillstats);
+/**
+ * Return the number of runs and the number of bytes of the state value
+ * spilled to disk, which are both 0 when the state value is kept in memory
+ */
+PGDLLEXPORT Datum
+Tagg_spillstats(PG_FUNCTION_ARGS)
+{
+  SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
+  Datum values[2];
+  values[0] = Int64GetDatum((int64) state->spillruns);
+  values[1] = Int64GetDatum((int64) state->spillbytes);
+  ArrayType *result = construct_array(values, 2, INT8OID, sizeof(int64),
+    FLOAT8PASSBYVAL, 'd');
+  PG_RETURN_ARRAYTYPE_P(result);
+}
+
 /*****************************************************************************/
@@ -1092,6 +1092,44 @@ tbox_gt(const TBOX *box1, const TBOX *box2)
   return cmp > 0;
 }
 
+/*****************************************************************************
+ * Space-filling curve functions
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_box_accessor
+ * @brief Return the key of a temporal box in a Z-order curve obtained by
+ * interleaving the bits of the centers of its value and time dimensions.
+ */
+uint64
+tbox_zorder_key(const TBOX *box)
+{
+  uint32 values[2];
+  int ndims = 0;
+  if (MOBDB_FLAGS_GET_X(box->flags))
+    values[ndims++] = double_sortable_bits((box->xmin + box->xmax) / 2.0);
+  if (MOBDB_FLAGS_GET_T(box->flags))
+    values[ndims++] = timestamp_sortable_bits(box->tmin +
+      (box->tmax - box->tmin) / 2);
+  return (ndims == 0) ? 0 : zorder_key(values, ndims);
+}
+
+/**
+ * @ingroup libmeos_box_transf
+ * @brief Sort in place an array of temporal boxes according to their key in
+ * a Z-order curve.
+ *
+ * @note This function can be used for bulk-loading the boxes in an index
+ * structure in an order that preserves their proximity
+ */
+void
+tboxarr_sort_zorder(TBOX *boxes, int count)
+{
+  keyarr_sort(boxes, sizeof(TBOX), count,
+    (uint64 (*)(const void *)) &tbox_zorder_key);
+  return;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -1808,21 +1846,15 @@ Tbox_extent_transfn(PG_FUNCTION_ARGS)
   /* Can't do anything with null inputs */
   if (!box1 && !box2)
     PG_RETURN_NULL();
-  TBOX *result = (TBOX *) palloc0(sizeof(TBOX));
   /* One of the boxes is null, return the other one */
   if (!box1)
-  {
-    memcpy(result, box2, sizeof(TBOX));
-    PG_RETURN_POINTER(result);
-  }
+    PG_RETURN_POINTER(tbox_copy(box2));
   if (!box2)
-  {
-    memcpy(result, box1, sizeof(TBOX));
-    PG_RETURN_POINTER(result);
-  }
+    PG_RETURN_POINTER(box1);
 
-  /* Both boxes are not null */
-  memcpy(result, box1, sizeof(TBOX));
+  /* Both boxes are not null, expand the state in place when called as an
+   * aggregate */
+  TBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : tbox_copy(box1);
   tbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
@@ -1845,7 +1877,7 @@ Tbox_extent_combinefn(PG_FUNCTION_ARGS)
     PG_RETURN_POINTER(box2);
   /* Both boxes are not null */
   ensure_same_dimensionality_tbox(box1, box2);
-  TBOX *result = tbox_copy(box1);
+  TBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : tbox_copy(box1);
   tbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
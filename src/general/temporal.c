@@ -59,6 +59,8 @@
 #include "general/tempcache.h"
 #include "general/temporal_util.h"
 #include "general/temporal_boxops.h"
+#include "general/temporal_columnar.h"
+#include "general/temporal_compress.h"
 #include "general/temporal_parser.h"
 #include "general/rangetypes_ext.h"
 #include "general/tnumber_distance.h"
@@ -709,9 +711,16 @@ temporal_from_base(const Temporal *temp, Datum value, CachedType temptype,
 /**
  * @ingroup libmeos_temporal_transf
  * @brief Append an instant to the end of a temporal value.
+ *
+ * @param[in,out] temp Temporal value
+ * @param[in] inst Temporal instant value
+ * @param[in] expand True when a temporal sequence (set) value is expanded in
+ * place, which is the case when appending successive instants in a loop.
+ * In that case the result may be the input value and the value should be
+ * compacted with #temporal_compact before it is stored.
  */
 Temporal *
-temporal_append_tinstant(const Temporal *temp, const Temporal *inst)
+temporal_append_tinstant(Temporal *temp, const Temporal *inst, bool expand)
 {
   /* Validity tests */
   if (inst->subtype != INSTANT)
@@ -732,12 +741,88 @@ temporal_append_tinstant(const Temporal *temp, const Temporal *inst)
       (TInstant *) inst);
   else if (temp->subtype == SEQUENCE)
     result = (Temporal *) tsequence_append_tinstant((TSequence *) temp,
-      (TInstant *) inst);
+      (TInstant *) inst, expand);
   else /* temp->subtype == SEQUENCESET */
     result = (Temporal *) tsequenceset_append_tinstant((TSequenceSet *) temp,
-      (TInstant *) inst);
+      (TInstant *) inst, expand);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a copy of the temporal value without the free space reserved
+ * for appending instants in place.
+ */
+Temporal *
+temporal_compact(const Temporal *temp)
+{
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_compact((TSequence *) temp);
+  else if (temp->subtype == SEQUENCESET)
+    result = (Temporal *) tsequenceset_compact((TSequenceSet *) temp);
+  else /* temp->subtype == INSTANT || temp->subtype == INSTANTSET */
+    result = temporal_copy(temp);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return the temporal value in the default storage.
+ *
+ * The function returns its argument when it is already in the default
+ * storage, otherwise it returns a new value.
+ */
+Temporal *
+temporal_unpack(Temporal *temp)
+{
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags))
+    return temporal_from_columnar(temp);
+  if (MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    return temporal_decompress(temp);
+  return temp;
+}
+
+#ifndef MEOS
+/**
+ * Return a temporal datum detoasted and in the default storage
+ *
+ * This is the fallback path of the `PG_GETARG_TEMPORAL_P` and
+ * `DatumGetTemporalP` macros for the functions that need the instants.
+ * When the value is unpacked, the detoasted copy is freed, so that the
+ * result is the only copy that the caller needs to free with
+ * `PG_FREE_IF_COPY`.
+ */
+Temporal *
+temporal_unpack_datum(Datum value)
+{
+  Temporal *temp = (Temporal *) PG_DETOAST_DATUM(value);
+  Temporal *result = temporal_unpack(temp);
+  if (result != temp && (Pointer) temp != DatumGetPointer(value))
+    pfree(temp);
+  return result;
+}
+
+/**
+ * Return a temporal datum detoasted and, if compressed, decompressed
+ *
+ * This is the path of the `PG_GETARG_TEMPORAL_COLUMNAR_P` macro for the
+ * functions whose loops over the instants also read the columnar form, so
+ * that the values in columnar form are not unpacked.
+ */
+Temporal *
+temporal_uncompress_datum(Datum value)
+{
+  Temporal *temp = (Temporal *) PG_DETOAST_DATUM(value);
+  if (! MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    return temp;
+  Temporal *result = temporal_decompress(temp);
+  if ((Pointer) temp != DatumGetPointer(value))
+    pfree(temp);
   return result;
 }
+#endif /* #ifndef MEOS */
 
 /**
  * Convert two temporal values into a common subtype
@@ -3373,7 +3458,8 @@ PG_FUNCTION_INFO_V1(Temporal_enforce_typmod);
 PGDLLEXPORT Datum
 Temporal_enforce_typmod(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  /* The storage of the value is kept */
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   int32 typmod = PG_GETARG_INT32(1);
   /* Check if temporal typmod is consistent with the supplied one */
   temp = temporal_valid_typmod(temp, typmod);
@@ -3402,6 +3488,242 @@ temporal_bbox_slice(Datum tempdatum, void *box)
   return;
 }
 
+/*****************************************************************************
+ * Slice functions
+ *****************************************************************************/
+
+/**
+ * Minimum size of a temporal value stored out of line for which the
+ * restrictions to a timestamp or a period fetch only the needed slices
+ * of the value instead of detoasting it completely
+ */
+#define MOBDB_SLICE_MINSIZE    (64 * 1024)
+
+/**
+ * Copy into the buffer the bytes in the range [pos, pos + size) of the
+ * toasted temporal value
+ *
+ * @note The slices of a varlena value are relative to the data following
+ * its header, which is not copied when reading from the position 0
+ */
+static void
+temporal_slice_read(Datum tempdatum, size_t pos, size_t size, char *buf)
+{
+  if (pos == 0)
+  {
+    memset(buf, 0, VARHDRSZ);
+    buf += VARHDRSZ;
+    pos += VARHDRSZ;
+    size -= VARHDRSZ;
+  }
+  struct varlena *slice = PG_DETOAST_DATUM_SLICE(tempdatum, pos - VARHDRSZ,
+    size);
+  if (VARSIZE(slice) - VARHDRSZ < size)
+    elog(ERROR, "Unexpected end of temporal value");
+  memcpy(buf, VARDATA(slice), size);
+  pfree(slice);
+  return;
+}
+
+/**
+ * Return a copy of the bytes in the range [pos, pos + size) of the toasted
+ * temporal value
+ */
+static void *
+temporal_slice_fetch(Datum tempdatum, size_t pos, size_t size)
+{
+  char *result = palloc(size);
+  temporal_slice_read(tempdatum, pos, size, result);
+  return result;
+}
+
+/**
+ * Return a temporal sequence that coincides on the bounds with the sequence
+ * stored at a position of the toasted value
+ *
+ * Only the blocks of the time index of the sequence containing the bounds
+ * are read, or the whole sequence if it has no time index.
+ *
+ * @param[in] tempdatum Toasted temporal value
+ * @param[in] pos Position of the sequence in the value
+ * @param[in] seq Header of the sequence
+ * @param[in] lower,upper Bounds
+ */
+static TSequence *
+tsequence_slice_window(Datum tempdatum, size_t pos, const TSequence *seq,
+  TimestampTz lower, TimestampTz upper)
+{
+  /* Determine the range of instants to read */
+  size_t tindexsize = tsequence_tindex_size(seq->count, seq->tindexblock);
+  int first = 0, last = seq->count - 1;
+  if (seq->tindexblock != 0)
+  {
+    TimestampTz *tindex = temporal_slice_fetch(tempdatum,
+      pos + double_pad(sizeof(TSequence)) + seq->bboxsize +
+      seq->count * sizeof(size_t), tindexsize);
+    int count = (seq->count - 1) / seq->tindexblock + 1;
+    int block1 = Max(0, tsequence_tindex_find(tindex, count, lower));
+    int block2 = Max(0, tsequence_tindex_find(tindex, count, upper));
+    pfree(tindex);
+    first = block1 * seq->tindexblock;
+    last = Min((block2 + 1) * seq->tindexblock, seq->count - 1);
+    /* Keep a segment when the bounds are at the last instant */
+    if (first == last && first > 0)
+      first--;
+  }
+  int count = last - first + 1;
+
+  /* Read the offsets and the instants in the range */
+  size_t *offsets = temporal_slice_fetch(tempdatum,
+    pos + double_pad(sizeof(TSequence)) + double_pad(seq->bboxsize) +
+    first * sizeof(size_t), count * sizeof(size_t));
+  size_t pdata = pos + double_pad(sizeof(TSequence)) + seq->bboxsize +
+    seq->count * sizeof(size_t) + tindexsize;
+  int32 header;
+  temporal_slice_read(tempdatum, pdata + offsets[count - 1], VARHDRSZ,
+    (char *) &header);
+  size_t size = offsets[count - 1] + VARSIZE(&header) - offsets[0];
+  char *data = temporal_slice_fetch(tempdatum, pdata + offsets[0], size);
+  const TInstant **instants = palloc(sizeof(TInstant *) * count);
+  for (int i = 0; i < count; i++)
+    instants[i] = (TInstant *) (data + offsets[i] - offsets[0]);
+
+  /* The bounds inside the sequence are inclusive */
+  bool lower_inc = (first == 0) ? seq->period.lower_inc : true;
+  bool upper_inc = (last == seq->count - 1) ? seq->period.upper_inc : true;
+  TSequence *result = tsequence_make1(instants, count, lower_inc, upper_inc,
+    MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE_NO);
+  pfree(offsets); pfree(data); pfree(instants);
+  return result;
+}
+
+/**
+ * Read the header of a toasted temporal value and determine whether it can
+ * be accessed by slices
+ *
+ * This is the case for large sequences and sequence sets stored out of line
+ * and uncompressed, whose offsets and time index are at the beginning of the
+ * value. A compressed value must be decompressed from its start to read any
+ * slice, so that reading several slices costs more than a full detoast.
+ */
+static bool
+temporal_slice_header(Datum tempdatum, TSequence *header)
+{
+  struct varlena *attr = (struct varlena *) DatumGetPointer(tempdatum);
+  if (! VARATT_IS_EXTERNAL_ONDISK(attr) ||
+      toast_raw_datum_size(tempdatum) < MOBDB_SLICE_MINSIZE)
+    return false;
+  struct varatt_external toast_pointer;
+  VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+  if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
+    return false;
+  /* The header of a sequence is larger than the one of a sequence set */
+  temporal_slice_read(tempdatum, 0, sizeof(TSequence), (char *) header);
+  return (header->subtype == SEQUENCE || header->subtype == SEQUENCESET) &&
+    ! MOBDB_FLAGS_GET_COLUMNAR(header->flags) &&
+    ! MOBDB_FLAGS_GET_COMPRESSED(header->flags) &&
+    ! MOBDB_FLAGS_GET_EXPANDABLE(header->flags);
+}
+
+/**
+ * Return a temporal value that coincides on the bounds with a large toasted
+ * temporal value by fetching only the slices of the value that are needed
+ *
+ * For sequence sets, the sequences overlapping the bounds are found by a
+ * binary search reading only their headers.
+ *
+ * @param[in] tempdatum Toasted temporal value
+ * @param[in] lower,upper Bounds
+ * @param[out] result Resulting value, NULL if the value does not intersect
+ * the bounds
+ * @result Return false if the value must be detoasted completely
+ */
+static bool
+temporal_slice_window(Datum tempdatum, TimestampTz lower, TimestampTz upper,
+  Temporal **result)
+{
+  TSequence header;
+  if (! temporal_slice_header(tempdatum, &header))
+    return false;
+
+  if (header.subtype == SEQUENCE)
+  {
+    *result = (header.period.lower <= upper && lower <= header.period.upper) ?
+      (Temporal *) tsequence_slice_window(tempdatum, 0, &header, lower, upper) :
+      NULL;
+    return true;
+  }
+
+  /* Sequence set */
+  TSequenceSet *ts = (TSequenceSet *) &header;
+  int count = ts->count;
+  size_t *offsets = temporal_slice_fetch(tempdatum,
+    double_pad(sizeof(TSequenceSet)) + double_pad(ts->bboxsize),
+    count * sizeof(size_t));
+  size_t pdata = double_pad(sizeof(TSequenceSet)) + ts->bboxsize +
+    count * sizeof(size_t);
+  /* Find the first sequence that does not end before the lower bound */
+  TSequence seq;
+  int first = 0, last = count;
+  while (first < last)
+  {
+    int middle = (first + last) / 2;
+    temporal_slice_read(tempdatum, pdata + offsets[middle], sizeof(TSequence),
+      (char *) &seq);
+    if (seq.period.upper < lower)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  /* Collect the sequences that start before the upper bound */
+  TSequence **sequences = palloc(sizeof(TSequence *) * (count - first + 1));
+  int k = 0;
+  for (int i = first; i < count; i++)
+  {
+    temporal_slice_read(tempdatum, pdata + offsets[i], sizeof(TSequence),
+      (char *) &seq);
+    if (seq.period.lower > upper)
+      break;
+    sequences[k++] = tsequence_slice_window(tempdatum, pdata + offsets[i],
+      &seq, lower, upper);
+  }
+  pfree(offsets);
+  *result = (Temporal *) tsequenceset_make_free(sequences, k, NORMALIZE_NO);
+  return true;
+}
+
+/**
+ * Return the start value of a large toasted temporal value by fetching only
+ * the slices of the value that are needed
+ *
+ * @result Return false if the value must be detoasted completely
+ */
+static bool
+temporal_slice_start_value(Datum tempdatum, Datum *result)
+{
+  TSequence header;
+  if (! temporal_slice_header(tempdatum, &header))
+    return false;
+
+  size_t pos = 0;
+  if (header.subtype == SEQUENCESET)
+  {
+    /* Read the header of the first sequence */
+    TSequenceSet *ts = (TSequenceSet *) &header;
+    size_t offset;
+    temporal_slice_read(tempdatum, double_pad(sizeof(TSequenceSet)) +
+      double_pad(ts->bboxsize), sizeof(size_t), (char *) &offset);
+    pos = double_pad(sizeof(TSequenceSet)) + ts->bboxsize +
+      ts->count * sizeof(size_t) + offset;
+    temporal_slice_read(tempdatum, pos, sizeof(TSequence), (char *) &header);
+  }
+  TSequence *seq = tsequence_slice_window(tempdatum, pos, &header,
+    header.period.lower, header.period.lower);
+  *result = tinstant_value_copy(tsequence_inst_n(seq, 0));
+  pfree(seq);
+  return true;
+}
+
 /*****************************************************************************
  * Version functions
  *****************************************************************************/
@@ -3735,7 +4057,7 @@ Temporal_append_tinstant(PG_FUNCTION_ARGS)
 {
   Temporal *temp = PG_GETARG_TEMPORAL_P(0);
   Temporal *inst = PG_GETARG_TEMPORAL_P(1);
-  Temporal *result = temporal_append_tinstant(temp, inst);
+  Temporal *result = temporal_append_tinstant(temp, inst, EXPAND_NO);
   PG_FREE_IF_COPY(temp, 0);
   PG_FREE_IF_COPY(inst, 1);
   PG_RETURN_POINTER(result);
@@ -3843,7 +4165,7 @@ PG_FUNCTION_INFO_V1(Temporal_to_period);
 PGDLLEXPORT Datum
 Temporal_to_period(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   Period *result = (Period *) palloc(sizeof(Period));
   temporal_period(temp, result);
   PG_FREE_IF_COPY(temp, 0);
@@ -3990,7 +4312,7 @@ PG_FUNCTION_INFO_V1(Temporal_subtype);
 PGDLLEXPORT Datum
 Temporal_subtype(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   char *str = temporal_subtype(temp);
   text *result = cstring_to_text(str);
   pfree(str);
@@ -4005,7 +4327,7 @@ PG_FUNCTION_INFO_V1(Temporal_interpolation);
 PGDLLEXPORT Datum
 Temporal_interpolation(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   char *str = temporal_interpolation(temp);
   text *result = cstring_to_text(str);
   pfree(str);
@@ -4126,8 +4448,18 @@ PG_FUNCTION_INFO_V1(Temporal_start_value);
 PGDLLEXPORT Datum
 Temporal_start_value(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
-  Datum result = temporal_start_value(temp);
+  Datum result;
+  /* Large toasted values are read by slices */
+  if (temporal_slice_start_value(PG_GETARG_DATUM(0), &result))
+    PG_RETURN_DATUM(result);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
+  /* Values in columnar or compressed form are accessed without unpacking */
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags))
+    result = temporal_columnar_start_value(temp);
+  else if (MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    result = temporal_compressed_start_value(temp);
+  else
+    result = temporal_start_value(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_DATUM(result);
 }
@@ -4139,8 +4471,15 @@ PG_FUNCTION_INFO_V1(Temporal_end_value);
 PGDLLEXPORT Datum
 Temporal_end_value(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
-  Datum result = temporal_end_value(temp);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
+  Datum result;
+  /* Values in columnar or compressed form are accessed without unpacking */
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags))
+    result = temporal_columnar_end_value(temp);
+  else if (MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    result = temporal_compressed_end_value(temp);
+  else
+    result = temporal_end_value(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_DATUM(result);
 }
@@ -4206,7 +4545,7 @@ PG_FUNCTION_INFO_V1(Temporal_timespan);
 PGDLLEXPORT Datum
 Temporal_timespan(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   Interval *result = temporal_timespan(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_POINTER(result);
@@ -4219,7 +4558,7 @@ PG_FUNCTION_INFO_V1(Temporal_duration);
 PGDLLEXPORT Datum
 Temporal_duration(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   Interval *result = temporal_duration(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_POINTER(result);
@@ -4232,7 +4571,7 @@ PG_FUNCTION_INFO_V1(Temporal_num_sequences);
 PGDLLEXPORT Datum
 Temporal_num_sequences(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   ensure_seq_subtypes(temp->subtype);
   int result = temporal_num_sequences(temp);
   PG_FREE_IF_COPY(temp, 0);
@@ -4323,8 +4662,18 @@ PG_FUNCTION_INFO_V1(Temporal_num_instants);
 PGDLLEXPORT Datum
 Temporal_num_instants(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
-  int result = temporal_num_instants(temp);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
+  int result;
+  /* The number of instants of a sequence is kept in its header */
+  if (temp->subtype == SEQUENCE)
+    result = ((TSequence *) temp)->count;
+  else
+  {
+    Temporal *temp1 = temporal_unpack(temp);
+    result = temporal_num_instants(temp1);
+    if (temp1 != temp)
+      pfree(temp1);
+  }
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_INT32(result);
 }
@@ -4409,7 +4758,7 @@ PG_FUNCTION_INFO_V1(Temporal_start_timestamp);
 PGDLLEXPORT Datum
 Temporal_start_timestamp(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   TimestampTz result = temporal_start_timestamp(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_TIMESTAMPTZ(result);
@@ -4422,7 +4771,7 @@ PG_FUNCTION_INFO_V1(Temporal_end_timestamp);
 PGDLLEXPORT Datum
 Temporal_end_timestamp(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   TimestampTz result = temporal_end_timestamp(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_TIMESTAMPTZ(result);
@@ -4435,10 +4784,18 @@ PG_FUNCTION_INFO_V1(Temporal_timestamp_n);
 PGDLLEXPORT Datum
 Temporal_timestamp_n(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   int n = PG_GETARG_INT32(1); /* Assume 1-based */
   TimestampTz result;
-  bool found = temporal_timestamp_n(temp, n, &result);
+  bool found;
+  /* Values in columnar or compressed form are accessed without unpacking */
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags))
+    found = temporal_columnar_timestamp_n(temp, n, &result);
+  else if (MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    found = temporal_compressed_timestamp_n(temp, n, &result);
+  else
+    found = temporal_timestamp_n(temp, n, &result);
+  PG_FREE_IF_COPY(temp, 0);
   if (! found)
     PG_RETURN_NULL();
   PG_RETURN_TIMESTAMPTZ(result);
@@ -4874,10 +5231,22 @@ Temporal_minus_max(PG_FUNCTION_ARGS)
 static Datum
 temporal_restrict_timestamp_ext(FunctionCallInfo fcinfo, bool atfunc)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
   TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
-  Temporal *result = temporal_restrict_timestamp(temp, t, atfunc);
-  PG_FREE_IF_COPY(temp, 0);
+  Temporal *temp, *result;
+  /* Large toasted values are read by slices */
+  if (atfunc && temporal_slice_window(PG_GETARG_DATUM(0), t, t, &temp))
+  {
+    if (temp == NULL)
+      PG_RETURN_NULL();
+    result = temporal_restrict_timestamp(temp, t, atfunc);
+    pfree(temp);
+  }
+  else
+  {
+    temp = PG_GETARG_TEMPORAL_P(0);
+    result = temporal_restrict_timestamp(temp, t, atfunc);
+    PG_FREE_IF_COPY(temp, 0);
+  }
   if (result == NULL)
     PG_RETURN_NULL();
   PG_RETURN_POINTER(result);
@@ -4912,10 +5281,29 @@ PG_FUNCTION_INFO_V1(Temporal_value_at_timestamp);
 PGDLLEXPORT Datum
 Temporal_value_at_timestamp(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
   TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
   Datum result;
-  bool found = temporal_value_at_timestamp(temp, t, &result);
+  bool found;
+  /* Large toasted values are read by slices */
+  Temporal *temp;
+  if (temporal_slice_window(PG_GETARG_DATUM(0), t, t, &temp))
+  {
+    if (temp == NULL)
+      PG_RETURN_NULL();
+    found = temporal_value_at_timestamp(temp, t, &result);
+    pfree(temp);
+    if (! found)
+      PG_RETURN_NULL();
+    PG_RETURN_DATUM(result);
+  }
+  temp = PG_GETARG_TEMPORAL_STORED_P(0);
+  /* Values in columnar or compressed form are accessed without unpacking */
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags))
+    found = temporal_columnar_value_at_timestamp(temp, t, &result);
+  else if (MOBDB_FLAGS_GET_COMPRESSED(temp->flags))
+    found = temporal_compressed_value_at_timestamp(temp, t, &result);
+  else
+    found = temporal_value_at_timestamp(temp, t, &result);
   PG_FREE_IF_COPY(temp, 0);
   if (! found)
     PG_RETURN_NULL();
@@ -4963,10 +5351,23 @@ Temporal_minus_timestampset(PG_FUNCTION_ARGS)
 static Datum
 temporal_restrict_period_ext(FunctionCallInfo fcinfo, bool atfunc)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
   Period *p = PG_GETARG_PERIOD_P(1);
-  Temporal *result = temporal_restrict_period(temp, p, atfunc);
-  PG_FREE_IF_COPY(temp, 0);
+  Temporal *temp, *result;
+  /* Large toasted values are read by slices */
+  if (atfunc && temporal_slice_window(PG_GETARG_DATUM(0), p->lower, p->upper,
+      &temp))
+  {
+    if (temp == NULL)
+      PG_RETURN_NULL();
+    result = temporal_restrict_period(temp, p, atfunc);
+    pfree(temp);
+  }
+  else
+  {
+    temp = PG_GETARG_TEMPORAL_P(0);
+    result = temporal_restrict_period(temp, p, atfunc);
+    PG_FREE_IF_COPY(temp, 0);
+  }
   if (result == NULL)
     PG_RETURN_NULL();
   PG_RETURN_POINTER(result);
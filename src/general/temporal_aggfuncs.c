@@ -192,9 +192,10 @@ tinstant_tagg(TInstant **instants1, int count1, TInstant **instants2,
       j++;
     }
   }
-  /* We finished to aggregate state1 */
-  assert (i == count1);
-  /* Copy the instants from state2 that are after the end of state1 */
+  /* Copy the instants from state1 or state2 that are after the end of the
+     other state */
+  while (i < count1)
+    result[count++] = tinstant_copy(instants1[i++]);
   while (j < count2)
     result[count++] = tinstant_copy(instants2[j++]);
   *newcount = count;
@@ -614,11 +615,7 @@ temporal_tagg_combinefn1(FunctionCallInfo fcinfo, SkipList *state1,
 
   Temporal *head2 = (Temporal *) skiplist_headval(state2);
   ensure_same_tempsubtype_skiplist(state1, head2);
-  int count2 = state2->length;
-  void **values2 = skiplist_values(state2);
-  skiplist_splice(fcinfo, state1, values2, count2, func, crossings);
-  pfree_array(values2, count2);
-  return state1;
+  return skiplist_merge(fcinfo, state1, state2, func, crossings);
 }
 
 /**
@@ -656,15 +653,17 @@ Temporal_tagg_finalfn(PG_FUNCTION_ARGS)
   if (state->length == 0)
     PG_RETURN_NULL();
 
-  Temporal **values = (Temporal **) skiplist_values(state);
+  int count;
+  Temporal **values = (Temporal **) skiplist_final_values(fcinfo,
+    state, &count);
   Temporal *result = NULL;
   assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
   if (values[0]->subtype == INSTANT)
     result = (Temporal *) tinstantset_make((const TInstant **)values,
-      state->length, MERGE_NO);
+      count, MERGE_NO);
   else /* values[0]->subtype == SEQUENCE */
     result = (Temporal *) tsequenceset_make((const TSequence **)values,
-      state->length, NORMALIZE);
+      count, NORMALIZE);
   pfree(values);
   PG_RETURN_POINTER(result);
 }
@@ -962,6 +961,14 @@ Temporal_tcount_combinefn(PG_FUNCTION_ARGS)
  * Temporal extent
  *****************************************************************************/
 
+/*
+ * The extent aggregates only read the bounding box of the temporal values,
+ * which is found in the header of the values and thus only the header is
+ * detoasted. When called as aggregates, the transition and combine functions
+ * expand the state in place instead of allocating a new box for every row,
+ * since the state is kept in the aggregate memory context.
+ */
+
 PG_FUNCTION_INFO_V1(Temporal_extent_transfn);
 /**
  * Transition function for temporal extent aggregation of temporal values
@@ -971,32 +978,22 @@ PGDLLEXPORT Datum
 Temporal_extent_transfn(PG_FUNCTION_ARGS)
 {
   Period *p = PG_ARGISNULL(0) ? NULL : PG_GETARG_PERIOD_P(0);
-  Temporal *temp = PG_ARGISNULL(1) ? NULL : PG_GETARG_TEMPORAL_P(1);
-  Period *result;
 
   /* Can't do anything with null inputs */
-  if (!p && !temp)
+  if (!p && PG_ARGISNULL(1))
     PG_RETURN_NULL();
-  /* Null period and non-null temporal, return the bbox of the temporal */
-  if (!p)
-  {
-    result = palloc0(sizeof(Period));
-    temporal_bbox(temp, result);
-    PG_RETURN_POINTER(result);
-  }
   /* Non-null period and null temporal, return the period */
-  if (!temp)
-  {
-    result = palloc0(sizeof(Period));
-    memcpy(result, p, sizeof(Period));
-    PG_RETURN_POINTER(result);
-  }
+  if (PG_ARGISNULL(1))
+    PG_RETURN_POINTER(p);
 
   Period p1;
-  temporal_bbox(temp, &p1);
-  result = period_super_union(p, &p1);
+  temporal_bbox_slice(PG_GETARG_DATUM(1), &p1);
+  /* Null period and non-null temporal, return the bbox of the temporal */
+  if (!p)
+    PG_RETURN_POINTER(period_copy(&p1));
 
-  PG_FREE_IF_COPY(temp, 1);
+  Period *result = AggCheckCallContext(fcinfo, NULL) ? p : period_copy(p);
+  period_expand(&p1, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -1017,7 +1014,8 @@ Temporal_extent_combinefn(PG_FUNCTION_ARGS)
   if (p2 && !p1)
     PG_RETURN_POINTER(p2);
 
-  Period *result = period_super_union(p1, p2);
+  Period *result = AggCheckCallContext(fcinfo, NULL) ? p1 : period_copy(p1);
+  period_expand(p2, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -1031,29 +1029,24 @@ PGDLLEXPORT Datum
 Tnumber_extent_transfn(PG_FUNCTION_ARGS)
 {
   TBOX *box = PG_ARGISNULL(0) ? NULL : PG_GETARG_TBOX_P(0);
-  Temporal *temp = PG_ARGISNULL(1) ? NULL : PG_GETARG_TEMPORAL_P(1);
 
   /* Can't do anything with null inputs */
-  if (!box && !temp)
+  if (!box && PG_ARGISNULL(1))
     PG_RETURN_NULL();
-  TBOX *result = palloc0(sizeof(TBOX));
+  /* Non-null box and null temporal, return the box */
+  if (PG_ARGISNULL(1))
+    PG_RETURN_POINTER(box);
+
+  TBOX box1;
+  memset(&box1, 0, sizeof(TBOX));
+  temporal_bbox_slice(PG_GETARG_DATUM(1), &box1);
   /* Null box and non-null temporal, return the bbox of the temporal */
   if (!box)
-  {
-    temporal_bbox(temp, result);
-    PG_RETURN_POINTER(result);
-  }
-  /* Non-null box and null temporal, return the box */
-  if (!temp)
-  {
-    memcpy(result, box, sizeof(TBOX));
-    PG_RETURN_POINTER(result);
-  }
+    PG_RETURN_POINTER(tbox_copy(&box1));
 
   /* Both box and temporal are not null */
-  temporal_bbox(temp, result);
-  tbox_expand(box, result);
-  PG_FREE_IF_COPY(temp, 1);
+  TBOX *result = AggCheckCallContext(fcinfo, NULL) ? box : tbox_copy(box);
+  tbox_expand(&box1, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -1075,7 +1068,7 @@ Tnumber_extent_combinefn(PG_FUNCTION_ARGS)
     PG_RETURN_POINTER(box2);
   /* Both boxes are not null */
   ensure_same_dimensionality_tbox(box1, box2);
-  TBOX *result = tbox_copy(box1);
+  TBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : tbox_copy(box1);
   tbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
@@ -1384,11 +1377,13 @@ Tnumber_tavg_finalfn(PG_FUNCTION_ARGS)
   if (state->length == 0)
     PG_RETURN_NULL();
 
-  Temporal **values = (Temporal **) skiplist_values(state);
+  int count;
+  Temporal **values = (Temporal **) skiplist_final_values(fcinfo,
+    state, &count);
   assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
   Temporal *result = (values[0]->subtype == INSTANT) ?
-    (Temporal *) tinstant_tavg_finalfn((TInstant **)values, state->length) :
-    (Temporal *) tsequence_tavg_finalfn((TSequence **)values, state->length);
+    (Temporal *) tinstant_tavg_finalfn((TInstant **)values, count) :
+    (Temporal *) tsequence_tavg_finalfn((TSequence **)values, count);
   pfree(values);
   PG_RETURN_POINTER(result);
 }
@@ -1416,3 +1411,71 @@ Temporal_merge_combinefn(PG_FUNCTION_ARGS)
 }
 
 /*****************************************************************************/
+
+/*****************************************************************************
+ * Append aggregate
+ * The instants, which must be given in timestamp order, are appended in place
+ * to an expandable temporal sequence (set) value kept in the aggregate
+ * context, so that the aggregation costs amortized constant time per row.
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Temporal_app_tinst_transfn);
+/**
+ * Transition function for append aggregate of temporal instant values
+ */
+PGDLLEXPORT Datum
+Temporal_app_tinst_transfn(PG_FUNCTION_ARGS)
+{
+  Temporal *state = PG_ARGISNULL(0) ? NULL :
+    (Temporal *) PG_GETARG_POINTER(0);
+  if (PG_ARGISNULL(1))
+  {
+    if (state)
+      PG_RETURN_POINTER(state);
+    else
+      PG_RETURN_NULL();
+  }
+
+  Temporal *inst = PG_GETARG_TEMPORAL_P(1);
+  if (inst->subtype != INSTANT)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The argument must be of instant subtype")));
+  MemoryContext ctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    elog(ERROR, "Transition function called in non-aggregate context");
+  MemoryContext oldctx = MemoryContextSwitchTo(ctx);
+  Temporal *result;
+  if (! state)
+  {
+    /* Create an expandable sequence from the first instant */
+    const TInstant *instants[1];
+    instants[0] = (TInstant *) inst;
+    result = (Temporal *) tsequence_make_exp(instants, 1,
+      MOBDB_EXPAND_INIT_COUNT, true, true,
+      MOBDB_FLAGS_GET_CONTINUOUS(inst->flags), NORMALIZE_NO);
+  }
+  else
+  {
+    result = temporal_append_tinstant(state, inst, EXPAND);
+    if (result != state)
+      pfree(state);
+  }
+  MemoryContextSwitchTo(oldctx);
+  PG_FREE_IF_COPY(inst, 1);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_app_tinst_finalfn);
+/**
+ * Final function for append aggregate of temporal instant values
+ */
+PGDLLEXPORT Datum
+Temporal_app_tinst_finalfn(PG_FUNCTION_ARGS)
+{
+  /* The final function is strict, we do not need to test for null values */
+  Temporal *state = (Temporal *) PG_GETARG_POINTER(0);
+  Temporal *result = temporal_compact(state);
+  PG_RETURN_POINTER(result);
+}
+
+/*****************************************************************************/
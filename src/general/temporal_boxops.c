@@ -47,6 +47,7 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <float.h>
 #include <utils/builtins.h>
 #include <utils/timestamp.h>
 /* MobilityDB */
@@ -218,9 +219,52 @@ tinstant_make_bbox(const TInstant *inst, void *box)
   return;
 }
 
+/**
+ * Expand the extent given by the minimum and maximum values with the values
+ * of the array
+ *
+ * The loop keeps four independent pairs of accumulators and has no
+ * data-dependent branches, so that compilers can turn it into SIMD min/max
+ * instructions.
+ *
+ * @param[in] values Array of values
+ * @param[in] count Number of elements in the array
+ * @param[in,out] min,max Extent
+ */
+void
+doublearr_extent(const double *values, int count, double *min, double *max)
+{
+  double min0 = *min, min1 = *min, min2 = *min, min3 = *min;
+  double max0 = *max, max1 = *max, max2 = *max, max3 = *max;
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    min0 = values[i] < min0 ? values[i] : min0;
+    min1 = values[i + 1] < min1 ? values[i + 1] : min1;
+    min2 = values[i + 2] < min2 ? values[i + 2] : min2;
+    min3 = values[i + 3] < min3 ? values[i + 3] : min3;
+    max0 = values[i] > max0 ? values[i] : max0;
+    max1 = values[i + 1] > max1 ? values[i + 1] : max1;
+    max2 = values[i + 2] > max2 ? values[i + 2] : max2;
+    max3 = values[i + 3] > max3 ? values[i + 3] : max3;
+  }
+  for (; i < count; i++)
+  {
+    min0 = values[i] < min0 ? values[i] : min0;
+    max0 = values[i] > max0 ? values[i] : max0;
+  }
+  *min = Min(Min(min0, min1), Min(min2, min3));
+  *max = Max(Max(max0, max1), Max(max2, max3));
+  return;
+}
+
 /**
  * Set the temporal box from the array of temporal number instant values
  *
+ * The values are gathered by chunks into a contiguous buffer whose extent
+ * is computed by #doublearr_extent. Since the instants are ordered, the
+ * time extent is given by the first and the last instants.
+ *
  * @param[in] box Box
  * @param[in] instants Temporal instants
  * @param[in] count Number of elements in the array
@@ -228,13 +272,26 @@ tinstant_make_bbox(const TInstant *inst, void *box)
 static void
 tnumberinstarr_tbox(const TInstant **instants, int count, TBOX *box)
 {
-  tinstant_make_bbox(instants[0], box);
-  for (int i = 1; i < count; i++)
+  double values[EXTENT_CHUNK];
+  double xmin = DBL_MAX, xmax = -DBL_MAX;
+  bool isint = (instants[0]->temptype == T_TINT);
+  for (int i = 0; i < count; i += EXTENT_CHUNK)
   {
-    TBOX box1;
-    tinstant_make_bbox(instants[i], &box1);
-    tbox_expand(&box1, box);
+    int n = Min(EXTENT_CHUNK, count - i);
+    if (isint)
+    {
+      for (int j = 0; j < n; j++)
+        values[j] = (double) DatumGetInt32(tinstant_value(instants[i + j]));
+    }
+    else
+    {
+      for (int j = 0; j < n; j++)
+        values[j] = DatumGetFloat8(tinstant_value(instants[i + j]));
+    }
+    doublearr_extent(values, n, &xmin, &xmax);
   }
+  tbox_set(true, true, xmin, xmax, instants[0]->t, instants[count - 1]->t,
+    box);
   return;
 }
 
@@ -554,6 +611,9 @@ boxop_tnumber_tnumber(const Temporal *temp1, const Temporal *temp2,
 /*****************************************************************************
  * Bounding box operators for temporal types: Generic functions
  * The inclusive/exclusive bounds are taken into account for the comparisons
+ * The operators only read the bounding box, which is kept in the header of
+ * values stored in columnar or compressed form, and thus the temporal values
+ * are not unpacked
  *****************************************************************************/
 
 /**
@@ -567,7 +627,7 @@ boxop_timestamp_temporal_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
   TimestampTz t = PG_GETARG_TIMESTAMPTZ(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_temporal_timestamp(temp, t, func, true);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_BOOL(result);
@@ -583,7 +643,7 @@ Datum
 boxop_temporal_timestamp_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
   bool result = boxop_temporal_timestamp(temp, t, func, false);
   PG_FREE_IF_COPY(temp, 0);
@@ -601,7 +661,7 @@ boxop_timestampset_temporal_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
   TimestampSet *ts = PG_GETARG_TIMESTAMPSET_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_temporal_timestampset(temp, ts, func, true);
   PG_FREE_IF_COPY(ts, 0);
   PG_FREE_IF_COPY(temp, 1);
@@ -618,7 +678,7 @@ Datum
 boxop_temporal_timestampset_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   TimestampSet *ts = PG_GETARG_TIMESTAMPSET_P(1);
   bool result = boxop_temporal_timestampset(temp, ts, func, false);
   PG_FREE_IF_COPY(temp, 0);
@@ -637,7 +697,7 @@ boxop_period_temporal_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
   Period *p = PG_GETARG_PERIOD_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_temporal_period(temp, p, func, true);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_BOOL(result);
@@ -653,7 +713,7 @@ Datum
 boxop_temporal_period_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   Period *p = PG_GETARG_PERIOD_P(1);
   bool result = boxop_temporal_period(temp, p, func, false);
   PG_FREE_IF_COPY(temp, 0);
@@ -671,7 +731,7 @@ boxop_periodset_temporal_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
   PeriodSet *ps = PG_GETARG_PERIODSET_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_temporal_periodset(temp, ps, func, true);
   PG_FREE_IF_COPY(ps, 0);
   PG_FREE_IF_COPY(temp, 1);
@@ -688,7 +748,7 @@ Datum
 boxop_temporal_periodset_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   PeriodSet *ps = PG_GETARG_PERIODSET_P(1);
   bool result = boxop_temporal_periodset(temp, ps, func, false);
   PG_FREE_IF_COPY(temp, 0);
@@ -706,8 +766,8 @@ Datum
 boxop_temporal_temporal_ext(FunctionCallInfo fcinfo,
   bool (*func)(const Period *, const Period *))
 {
-  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
-  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp1 = PG_GETARG_TEMPORAL_STORED_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_temporal_temporal(temp1, temp2, func);
   PG_FREE_IF_COPY(temp1, 0);
   PG_FREE_IF_COPY(temp2, 1);
@@ -1231,7 +1291,7 @@ boxop_number_tnumber_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
   Datum value = PG_GETARG_DATUM(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   CachedType basetype = oid_type(get_fn_expr_argtype(fcinfo->flinfo, 0));
   bool result = boxop_tnumber_number(temp, value, basetype, func, INVERT);
   PG_FREE_IF_COPY(temp, 1);
@@ -1248,7 +1308,7 @@ Datum
 boxop_tnumber_number_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   Datum value = PG_GETARG_DATUM(1);
   CachedType basetype = oid_type(get_fn_expr_argtype(fcinfo->flinfo, 1));
   bool result = boxop_tnumber_number(temp, value, basetype, func, INVERT_NO);
@@ -1267,7 +1327,7 @@ boxop_range_tnumber_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
   RangeType *range = PG_GETARG_RANGE_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   int result = boxop_tnumber_range(temp, range, func, INVERT);
   PG_FREE_IF_COPY(range, 0);
   PG_FREE_IF_COPY(temp, 1);
@@ -1286,7 +1346,7 @@ Datum
 boxop_tnumber_range_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   RangeType *range = PG_GETARG_RANGE_P(1);
   int result = boxop_tnumber_range(temp, range, func, INVERT_NO);
   PG_FREE_IF_COPY(temp, 0);
@@ -1307,7 +1367,7 @@ boxop_tbox_tnumber_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
   TBOX *box = PG_GETARG_TBOX_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_tnumber_tbox(temp, box, func, INVERT);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_BOOL(result);
@@ -1323,7 +1383,7 @@ Datum
 boxop_tnumber_tbox_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   TBOX *box = PG_GETARG_TBOX_P(1);
   bool result = boxop_tnumber_tbox(temp, box, func, INVERT_NO);
   PG_FREE_IF_COPY(temp, 0);
@@ -1340,8 +1400,8 @@ Datum
 boxop_tnumber_tnumber_ext(FunctionCallInfo fcinfo,
   bool (*func)(const TBOX *, const TBOX *))
 {
-  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
-  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp1 = PG_GETARG_TEMPORAL_STORED_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_tnumber_tnumber(temp1, temp2, func);
   PG_FREE_IF_COPY(temp1, 0);
   PG_FREE_IF_COPY(temp2, 1);
@@ -0,0 +1,269 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_brin.c
+ * @brief BRIN inclusion index for temporal types.
+ *
+ * Each page range is summarized by the union of the bounding boxes of the
+ * temporal values in the range, that is, a period for temporal booleans and
+ * temporal texts, a temporal box for temporal numbers, and a spatiotemporal
+ * box for temporal points. Since the summary is the union of the boxes, the
+ * consistent method applies the same tests as those of the internal nodes of
+ * the GiST indexes. The summary type is the storage type of the operator
+ * class, the same functions are thus used for all temporal types.
+ */
+
+#include "general/temporal_brin.h"
+
+/* PostgreSQL */
+#include <access/brin_internal.h>
+#include <access/brin_tuple.h>
+#include <access/skey.h>
+#include <utils/datum.h>
+#include <utils/typcache.h>
+/* MobilityDB */
+#include "general/temporal.h"
+#include "general/tempcache.h"
+#include "general/time_gist.h"
+#include "general/tnumber_gist.h"
+#include "point/stbox.h"
+#include "point/tpoint_gist.h"
+
+/*****************************************************************************
+ * Utility functions
+ *****************************************************************************/
+
+/**
+ * Return the type of the summary of the column of a BRIN index, which is the
+ * storage type of the operator class
+ */
+static CachedType
+temporal_brin_boxtype(BrinDesc *bdesc, AttrNumber attno)
+{
+  Form_pg_attribute attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+  return oid_type(attr->atttypid);
+}
+
+/**
+ * Expand the second bounding box with the first one
+ *
+ * @param[in] box1 Bounding box
+ * @param[inout] box2 Bounding box that is expanded
+ * @param[in] boxtype Type of the bounding boxes
+ */
+static void
+temporal_brin_expand(const void *box1, void *box2, CachedType boxtype)
+{
+  if (boxtype == T_PERIOD)
+    period_expand((const Period *) box1, (Period *) box2);
+  else if (boxtype == T_TBOX)
+    tbox_expand((const TBOX *) box1, (TBOX *) box2);
+  else if (boxtype == T_STBOX)
+    stbox_expand((const STBOX *) box1, (STBOX *) box2);
+  else
+    elog(ERROR, "unknown bounding box type for BRIN index: %d", boxtype);
+  return;
+}
+
+/*****************************************************************************
+ * BRIN support functions
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Temporal_brin_opcinfo);
+/**
+ * BRIN opcinfo method for temporal types
+ *
+ * The only value stored for a page range is the union of the bounding boxes
+ * of the values in the range, whose type is passed as argument
+ */
+PGDLLEXPORT Datum
+Temporal_brin_opcinfo(PG_FUNCTION_ARGS)
+{
+  Oid typoid = PG_GETARG_OID(0);
+  BrinOpcInfo *result = palloc0(MAXALIGN(SizeofBrinOpcInfo(1)));
+  result->oi_nstored = 1;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  result->oi_regular_nulls = true;
+#endif
+  result->oi_typcache[0] = lookup_type_cache(typoid, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_brin_add_value);
+/**
+ * BRIN add value method for temporal types
+ *
+ * Expand the summary of the page range with the bounding box of the new
+ * value. Only the header of toasted values is read since it contains the
+ * bounding box. Return true if the summary has been modified.
+ */
+PGDLLEXPORT Datum
+Temporal_brin_add_value(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+  Datum newval = PG_GETARG_DATUM(2);
+#if POSTGRESQL_VERSION_NUMBER < 140000
+  bool isnull = PG_GETARG_BOOL(3);
+  /* If the new value is null, we record that we saw it if it's the first
+   * one; otherwise, there's nothing to do */
+  if (isnull)
+  {
+    if (column->bv_hasnulls)
+      PG_RETURN_BOOL(false);
+    column->bv_hasnulls = true;
+    PG_RETURN_BOOL(true);
+  }
+#endif /* POSTGRESQL_VERSION_NUMBER < 140000 */
+
+  CachedType boxtype = temporal_brin_boxtype(bdesc, column->bv_attno);
+  size_t size = bdesc->bd_info[column->bv_attno - 1]->oi_typcache[0]->typlen;
+  bboxunion box;
+  temporal_bbox_slice(newval, &box);
+
+  /* If the page range is empty the summary is the bounding box */
+  if (column->bv_allnulls)
+  {
+    column->bv_values[BRIN_TEMPORAL_UNION] = datumCopy(PointerGetDatum(&box),
+      false, size);
+    column->bv_allnulls = false;
+    PG_RETURN_BOOL(true);
+  }
+
+  /* Expand the summary in place, its memory belongs to the BRIN tuple */
+  void *summary = DatumGetPointer(column->bv_values[BRIN_TEMPORAL_UNION]);
+  bboxunion oldsummary;
+  memcpy(&oldsummary, summary, size);
+  temporal_brin_expand(&box, summary, boxtype);
+  PG_RETURN_BOOL(memcmp(&oldsummary, summary, size) != 0);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_brin_consistent);
+/**
+ * BRIN consistent method for temporal types
+ *
+ * Return true if the page range may contain values satisfying the scan key
+ */
+PGDLLEXPORT Datum
+Temporal_brin_consistent(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+  ScanKey key = (ScanKey) PG_GETARG_POINTER(2);
+  StrategyNumber strategy = key->sk_strategy;
+  Oid typid = key->sk_subtype;
+  bool result;
+
+#if POSTGRESQL_VERSION_NUMBER < 140000
+  /* Handle IS NULL and IS NOT NULL tests */
+  if (key->sk_flags & SK_ISNULL)
+  {
+    if (key->sk_flags & SK_SEARCHNULL)
+      PG_RETURN_BOOL(column->bv_allnulls || column->bv_hasnulls);
+    /* For IS NOT NULL we can only skip ranges that only contain nulls */
+    if (key->sk_flags & SK_SEARCHNOTNULL)
+      PG_RETURN_BOOL(! column->bv_allnulls);
+    /* All indexable operators are strict */
+    PG_RETURN_BOOL(false);
+  }
+  /* If the range only contains nulls it cannot be consistent */
+  if (column->bv_allnulls)
+    PG_RETURN_BOOL(false);
+#endif /* POSTGRESQL_VERSION_NUMBER < 140000 */
+
+  /* Apply the tests of the internal nodes of the GiST indexes */
+  CachedType boxtype = temporal_brin_boxtype(bdesc, column->bv_attno);
+  Pointer summary = DatumGetPointer(column->bv_values[BRIN_TEMPORAL_UNION]);
+  if (boxtype == T_PERIOD)
+  {
+    Period query;
+    if (! time_index_get_period(key->sk_argument, typid, &query))
+      PG_RETURN_BOOL(false);
+    result = period_gist_consistent((Period *) summary, &query, strategy);
+  }
+  else if (boxtype == T_TBOX)
+  {
+    TBOX query;
+    if (! tnumber_index_get_tbox(key->sk_argument, typid, &query))
+      PG_RETURN_BOOL(false);
+    result = tnumber_gist_consistent((TBOX *) summary, &query, strategy);
+  }
+  else if (boxtype == T_STBOX)
+  {
+    STBOX query;
+    if (! tpoint_index_get_stbox(key->sk_argument, oid_type(typid), &query))
+      PG_RETURN_BOOL(false);
+    result = stbox_gist_consistent((STBOX *) summary, &query, strategy);
+  }
+  else
+    elog(ERROR, "unknown bounding box type for BRIN index: %d", boxtype);
+
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_brin_union);
+/**
+ * BRIN union method for temporal types
+ *
+ * Expand the summary of the first page range with the one of the second
+ */
+PGDLLEXPORT Datum
+Temporal_brin_union(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *col_a = (BrinValues *) PG_GETARG_POINTER(1);
+  BrinValues *col_b = (BrinValues *) PG_GETARG_POINTER(2);
+
+#if POSTGRESQL_VERSION_NUMBER < 140000
+  /* Adjust the null flags */
+  if (! col_a->bv_hasnulls && col_b->bv_hasnulls)
+    col_a->bv_hasnulls = true;
+  /* If there are no values in B, there is nothing to do */
+  if (col_b->bv_allnulls)
+    PG_RETURN_VOID();
+  /* If there are no values in A, copy the summary of B */
+  if (col_a->bv_allnulls)
+  {
+    size_t size = bdesc->bd_info[col_a->bv_attno - 1]->oi_typcache[0]->typlen;
+    col_a->bv_allnulls = false;
+    col_a->bv_values[BRIN_TEMPORAL_UNION] = datumCopy(
+      col_b->bv_values[BRIN_TEMPORAL_UNION], false, size);
+    PG_RETURN_VOID();
+  }
+#endif /* POSTGRESQL_VERSION_NUMBER < 140000 */
+
+  CachedType boxtype = temporal_brin_boxtype(bdesc, col_a->bv_attno);
+  temporal_brin_expand(
+    DatumGetPointer(col_b->bv_values[BRIN_TEMPORAL_UNION]),
+    DatumGetPointer(col_a->bv_values[BRIN_TEMPORAL_UNION]), boxtype);
+  PG_RETURN_VOID();
+}
+
+/*****************************************************************************/
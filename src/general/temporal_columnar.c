@@ -0,0 +1,681 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_columnar.c
+ * @brief Columnar (structure of arrays) storage of temporal sequences.
+ *
+ * In the default storage of temporal sequences each composing instant is a
+ * self-contained varlena value, which for temporal points includes a full
+ * serialized geometry. For temporal integers, temporal floats, and temporal
+ * points, a sequence can alternatively be stored in columnar form, where the
+ * timestamps and each coordinate of the values are kept in contiguous arrays.
+ * This reduces the storage size and allows functions that scan the
+ * timestamps, such as `valueAtTimestamp`, to work directly on the arrays.
+ *
+ * Columnar values are flagged with `MOBDB_FLAG_COLUMNAR`. The bounding box
+ * operators and the accessors such as `startValue`, `timestampN`, or
+ * `valueAtTimestamp` read the stored form directly. The lifted functions
+ * with one temporal argument, such as the temporal distance to a number or
+ * to a point, and the length of temporal points iterate over the columns
+ * with function `tsequence_inst_n_buf` and receive their argument with the
+ * `PG_GETARG_TEMPORAL_COLUMNAR_P` macro. The remaining functions fall back to
+ * unpacking the values into the default storage with the
+ * `PG_GETARG_TEMPORAL_P` and `DatumGetTemporalP` macros.
+ */
+
+#include "general/temporal_columnar.h"
+
+/* PostgreSQL */
+#include <assert.h>
+/* MobilityDB */
+#include "general/tempcache.h"
+#include "general/temporal_util.h"
+#include "general/time_ops.h"
+#include "general/tinstant.h"
+#include "general/tsequence.h"
+#include "general/tsequenceset.h"
+#include "point/tpoint.h"
+#include "point/tpoint_spatialfuncs.h"
+
+/*****************************************************************************
+ * Memory layout
+ *****************************************************************************/
+
+/**
+ * Return true if the temporal type can be stored in columnar form
+ */
+bool
+temptype_columnar(CachedType temptype)
+{
+  return (temptype == T_TINT || temptype == T_TFLOAT ||
+    temptype == T_TGEOMPOINT || temptype == T_TGEOGPOINT);
+}
+
+/**
+ * Ensure that the temporal type can be stored in columnar form
+ */
+void
+ensure_temptype_columnar(CachedType temptype)
+{
+  if (! temptype_columnar(temptype))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Columnar and compressed storage are only supported for temporal integers, floats, and points")));
+  return;
+}
+
+/**
+ * Return the number of value columns of a temporal sequence in columnar form
+ */
+int
+tsequence_columnar_ncols(const TSequence *seq)
+{
+  if (tgeo_type(seq->temptype))
+    return MOBDB_FLAGS_GET_Z(seq->flags) ? 3 : 2;
+  return 1;
+}
+
+/**
+ * Return the size in bytes of an element of the value columns
+ */
+static size_t
+tsequence_columnar_width(const TSequence *seq)
+{
+  return (seq->temptype == T_TINT) ? sizeof(int32) : sizeof(double);
+}
+
+/**
+ * Return the size in bytes of a temporal sequence in columnar form
+ */
+size_t
+tsequence_columnar_size(const TSequence *seq)
+{
+  return double_pad(sizeof(TSequence)) + double_pad(seq->bboxsize) +
+    seq->count * sizeof(TimestampTz) + tsequence_columnar_ncols(seq) *
+    double_pad(seq->count * tsequence_columnar_width(seq));
+}
+
+/**
+ * Return a pointer to the array of timestamps of a temporal sequence in
+ * columnar form
+ *
+ * For example, the memory structure of a temporal point sequence in columnar
+ * form with Z dimension is as follows:
+ * @code
+ * -------------------------------------------------------------------------
+ * ( TSequence )_X | ( bbox )_X | t_0 | ... | ( x_0 | ... )_X | ( y_0 | ... )_X
+ * -------------------------------------------------------------------------
+ * --------------------
+ * ( z_0 | ... )_X |
+ * --------------------
+ * @endcode
+ * where the `X` are unused bytes added for double padding.
+ */
+TimestampTz *
+tsequence_columnar_times(const TSequence *seq)
+{
+  return (TimestampTz *)(((char *) seq) + double_pad(sizeof(TSequence)) +
+    double_pad(seq->bboxsize));
+}
+
+/**
+ * Return a pointer to the n-th value column of a temporal sequence in
+ * columnar form
+ */
+void *
+tsequence_columnar_values(const TSequence *seq, int col)
+{
+  assert(col >= 0 && col < tsequence_columnar_ncols(seq));
+  return (void *)(((char *) tsequence_columnar_times(seq)) +
+    seq->count * sizeof(TimestampTz) +
+    col * double_pad(seq->count * tsequence_columnar_width(seq)));
+}
+
+/**
+ * Return the n-th base value of a temporal sequence in columnar form
+ */
+Datum
+tsequence_columnar_value_n(const TSequence *seq, int n)
+{
+  if (seq->temptype == T_TINT)
+    return Int32GetDatum(((int32 *) tsequence_columnar_values(seq, 0))[n]);
+  if (seq->temptype == T_TFLOAT)
+    return Float8GetDatum(((double *) tsequence_columnar_values(seq, 0))[n]);
+  /* Temporal point */
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  double x = ((double *) tsequence_columnar_values(seq, 0))[n];
+  double y = ((double *) tsequence_columnar_values(seq, 1))[n];
+  double z = hasz ? ((double *) tsequence_columnar_values(seq, 2))[n] : 0.0;
+  return point_make(x, y, z, hasz, MOBDB_FLAGS_GET_GEODETIC(seq->flags),
+    tpointseq_srid(seq));
+}
+
+/*****************************************************************************
+ * Conversion functions
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence in columnar form.
+ * @pre The temporal sequence is not in columnar form
+ */
+TSequence *
+tsequence_to_columnar(const TSequence *seq)
+{
+  assert(! MOBDB_FLAGS_GET_COLUMNAR(seq->flags));
+  ensure_temptype_columnar(seq->temptype);
+  /* The free space of expandable sequences and the time index are not kept */
+  TSequence *result = palloc0(tsequence_columnar_size(seq));
+  memcpy(result, seq, sizeof(TSequence));
+  SET_VARSIZE(result, tsequence_columnar_size(seq));
+  MOBDB_FLAGS_SET_EXPANDABLE(result->flags, false);
+  result->tindexblock = 0;
+  MOBDB_FLAGS_SET_COLUMNAR(result->flags, true);
+  memcpy(tsequence_bbox_ptr(result), tsequence_bbox_ptr(seq), seq->bboxsize);
+
+  TimestampTz *times = tsequence_columnar_times(result);
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  for (int i = 0; i < seq->count; i++)
+  {
+    const TInstant *inst = tsequence_inst_n(seq, i);
+    Datum value = tinstant_value(inst);
+    times[i] = inst->t;
+    if (seq->temptype == T_TINT)
+      ((int32 *) tsequence_columnar_values(result, 0))[i] =
+        DatumGetInt32(value);
+    else if (seq->temptype == T_TFLOAT)
+      ((double *) tsequence_columnar_values(result, 0))[i] =
+        DatumGetFloat8(value);
+    else if (hasz)
+    {
+      const POINT3DZ *p = datum_point3dz_p(value);
+      ((double *) tsequence_columnar_values(result, 0))[i] = p->x;
+      ((double *) tsequence_columnar_values(result, 1))[i] = p->y;
+      ((double *) tsequence_columnar_values(result, 2))[i] = p->z;
+    }
+    else
+    {
+      const POINT2D *p = datum_point2d_p(value);
+      ((double *) tsequence_columnar_values(result, 0))[i] = p->x;
+      ((double *) tsequence_columnar_values(result, 1))[i] = p->y;
+    }
+  }
+  return result;
+}
+
+/**
+ * Overwrite the timestamp and the value of an instant with the ones of the
+ * n-th instant of a temporal sequence in columnar form
+ *
+ * @param[in] seq Temporal sequence in columnar form
+ * @param[in] n Position of the instant
+ * @param[in,out] inst Instant of the same type and dimensionality
+ */
+static void
+tinstant_columnar_patch(const TSequence *seq, int n, TInstant *inst)
+{
+  inst->t = tsequence_columnar_times(seq)[n];
+  Datum *value_ptr = tinstant_value_ptr(inst);
+  if (seq->temptype == T_TINT)
+    *value_ptr = Int32GetDatum(
+      ((int32 *) tsequence_columnar_values(seq, 0))[n]);
+  else if (seq->temptype == T_TFLOAT)
+    *value_ptr = Float8GetDatum(
+      ((double *) tsequence_columnar_values(seq, 0))[n]);
+  else if (MOBDB_FLAGS_GET_Z(seq->flags))
+  {
+    POINT3DZ *p = (POINT3DZ *) gserialized_point3dz_p(
+      (GSERIALIZED *) value_ptr);
+    p->x = ((double *) tsequence_columnar_values(seq, 0))[n];
+    p->y = ((double *) tsequence_columnar_values(seq, 1))[n];
+    p->z = ((double *) tsequence_columnar_values(seq, 2))[n];
+  }
+  else
+  {
+    POINT2D *p = (POINT2D *) gserialized_point2d_p(
+      (GSERIALIZED *) value_ptr);
+    p->x = ((double *) tsequence_columnar_values(seq, 0))[n];
+    p->y = ((double *) tsequence_columnar_values(seq, 1))[n];
+  }
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence in columnar form in the default storage.
+ *
+ * All instants of the supported types have the same size. The first instant
+ * is therefore used as a template that is copied and patched with the
+ * timestamp and the coordinates of each instant, and the bounding box is
+ * copied from the input value instead of being recomputed.
+ * @pre The temporal sequence is in columnar form
+ */
+TSequence *
+tsequence_from_columnar(const TSequence *seq)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(seq->flags));
+  const TimestampTz *times = tsequence_columnar_times(seq);
+  Datum value = tsequence_columnar_value_n(seq, 0);
+  TInstant *inst = tinstant_make(value, times[0], seq->temptype);
+  size_t instsize = double_pad(VARSIZE(inst));
+
+  /* Create the temporal sequence */
+  int16 tindexblock = tsequence_tindex_block(seq->count);
+  size_t pdata = double_pad(sizeof(TSequence)) + double_pad(seq->bboxsize) +
+    seq->count * sizeof(size_t) +
+    tsequence_tindex_size(seq->count, tindexblock);
+  size_t memsize = pdata + seq->count * instsize;
+  TSequence *result = palloc0(memsize);
+  memcpy(result, seq, sizeof(TSequence));
+  SET_VARSIZE(result, memsize);
+  MOBDB_FLAGS_SET_EXPANDABLE(result->flags, false);
+  result->tindexblock = tindexblock;
+  MOBDB_FLAGS_SET_COLUMNAR(result->flags, false);
+  memcpy(tsequence_bbox_ptr(result), tsequence_bbox_ptr(seq), seq->bboxsize);
+
+  /* Store the composing instants */
+  size_t *offsets = tsequence_offsets_ptr(result);
+  for (int i = 0; i < seq->count; i++)
+  {
+    TInstant *inst1 = (TInstant *) (((char *) result) + pdata + i * instsize);
+    memcpy(inst1, inst, VARSIZE(inst));
+    offsets[i] = i * instsize;
+    tinstant_columnar_patch(seq, i, inst1);
+  }
+  tsequence_tindex_build(result);
+  pfree(inst);
+  if (tgeo_type(seq->temptype))
+    pfree(DatumGetPointer(value));
+  return result;
+}
+
+/**
+ * Return the n-th instant of a temporal sequence in the default or in the
+ * columnar form
+ *
+ * This function allows the loops over the segments of a sequence to read a
+ * sequence in columnar form without unpacking it. The instant is then built
+ * into one of two buffers, chosen by the parity of n, so that the instants
+ * n - 1 and n remain valid together. The buffers are created by the first
+ * calls and only their timestamp and value are overwritten afterwards.
+ *
+ * @param[in] seq Temporal sequence
+ * @param[in] n Position of the instant
+ * @param[in,out] buf Array of two buffers initialized to NULL by the caller,
+ * which are freed with function `tinstant_buf_free`
+ */
+const TInstant *
+tsequence_inst_n_buf(const TSequence *seq, int n, TInstant **buf)
+{
+  if (! MOBDB_FLAGS_GET_COLUMNAR(seq->flags))
+    return tsequence_inst_n(seq, n);
+  TInstant **inst = &buf[n % 2];
+  if (*inst == NULL)
+  {
+    Datum value = tsequence_columnar_value_n(seq, n);
+    *inst = tinstant_make(value, tsequence_columnar_times(seq)[n],
+      seq->temptype);
+    if (tgeo_type(seq->temptype))
+      pfree(DatumGetPointer(value));
+  }
+  else
+    tinstant_columnar_patch(seq, n, *inst);
+  return *inst;
+}
+
+/**
+ * Free the buffers used by function `tsequence_inst_n_buf`
+ */
+void
+tinstant_buf_free(TInstant **buf)
+{
+  for (int i = 0; i < 2; i++)
+  {
+    if (buf[i] != NULL)
+    {
+      pfree(buf[i]);
+      buf[i] = NULL;
+    }
+  }
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence set whose composing sequences are in
+ * columnar form.
+ * @pre The temporal sequence set is not in columnar form
+ */
+TSequenceSet *
+tsequenceset_to_columnar(const TSequenceSet *ts)
+{
+  assert(! MOBDB_FLAGS_GET_COLUMNAR(ts->flags));
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_to_columnar(tsequenceset_seq_n(ts, i));
+  TSequenceSet *result = tsequenceset_make_free(sequences, ts->count,
+    NORMALIZE_NO);
+  MOBDB_FLAGS_SET_COLUMNAR(result->flags, true);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence set in columnar form in the default
+ * storage.
+ * @pre The temporal sequence set is in columnar form
+ */
+TSequenceSet *
+tsequenceset_from_columnar(const TSequenceSet *ts)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(ts->flags));
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_from_columnar(tsequenceset_seq_n(ts, i));
+  return tsequenceset_make_free(sequences, ts->count, NORMALIZE_NO);
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal value in columnar form.
+ *
+ * Instant and instant set values are returned unchanged since their
+ * composing instants do not share a common header.
+ */
+Temporal *
+temporal_to_columnar(const Temporal *temp)
+{
+  ensure_temptype_columnar(temp->temptype);
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (MOBDB_FLAGS_GET_COLUMNAR(temp->flags) ||
+      temp->subtype == INSTANT || temp->subtype == INSTANTSET)
+    result = temporal_copy(temp);
+  else if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_to_columnar((TSequence *) temp);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_to_columnar((TSequenceSet *) temp);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal value in columnar form in the default storage.
+ */
+Temporal *
+temporal_from_columnar(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(temp->flags));
+  Temporal *result;
+  if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_from_columnar((TSequence *) temp);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_from_columnar((TSequenceSet *) temp);
+  return result;
+}
+
+/*****************************************************************************
+ * Accessor functions
+ *****************************************************************************/
+
+/**
+ * Return the base value at the timestamp of a segment of a temporal sequence
+ * stored in columnar or compressed form
+ *
+ * @param[in] seq Temporal sequence from which the segment is taken
+ * @param[in] value1,value2 Base values at the start and at the end of the
+ * segment, which are freed by the function unless returned
+ * @param[in] t1,t2 Timestamps at the start and at the end of the segment
+ * @param[in] t Timestamp
+ * @pre The timestamp is in the interval [t1, t2)
+ */
+Datum
+tcolumnar_segment_value_at_timestamp(const TSequence *seq, Datum value1,
+  Datum value2, TimestampTz t1, TimestampTz t2, TimestampTz t)
+{
+  bool byval = ! tgeo_type(seq->temptype);
+  /* Step interpolation or t is equal to lower bound */
+  if (! MOBDB_FLAGS_GET_LINEAR(seq->flags) || t == t1)
+  {
+    if (! byval)
+      pfree(DatumGetPointer(value2));
+    return value1;
+  }
+
+  /* Interpolation for types with linear interpolation */
+  long double duration1 = (long double) (t - t1);
+  long double duration2 = (long double) (t2 - t1);
+  long double ratio = duration1 / duration2;
+  if (seq->temptype == T_TFLOAT)
+  {
+    double start = DatumGetFloat8(value1);
+    double end = DatumGetFloat8(value2);
+    return Float8GetDatum(start +
+      (double) ((long double)(end - start) * ratio));
+  }
+  /* Temporal point */
+  Datum result;
+  if (datum_point_eq(value1, value2))
+    result = value1;
+  else
+  {
+    result = geosegm_interpolate_point(value1, value2, ratio);
+    pfree(DatumGetPointer(value1));
+  }
+  pfree(DatumGetPointer(value2));
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the base value of a temporal sequence in columnar form at the
+ * timestamp.
+ *
+ * The instant is located with a binary search on the array of timestamps
+ * without unpacking the sequence.
+ * @param[in] seq Temporal value
+ * @param[in] t Timestamp
+ * @param[out] result Base value
+ * @result Return true if the timestamp is found in the temporal value
+ */
+bool
+tsequence_columnar_value_at_timestamp(const TSequence *seq, TimestampTz t,
+  Datum *result)
+{
+  /* Bounding box test */
+  if (! contains_period_timestamp(&seq->period, t))
+    return false;
+
+  /* Find the last instant whose timestamp is less than or equal to t */
+  const TimestampTz *times = tsequence_columnar_times(seq);
+  int first = 0, last = seq->count - 1;
+  while (first < last)
+  {
+    int middle = (first + last + 1) / 2;
+    if (times[middle] <= t)
+      first = middle;
+    else
+      last = middle - 1;
+  }
+  Datum value1 = tsequence_columnar_value_n(seq, first);
+  if (times[first] == t)
+    *result = value1;
+  else
+  {
+    Datum value2 = tsequence_columnar_value_n(seq, first + 1);
+    *result = tcolumnar_segment_value_at_timestamp(seq, value1, value2,
+      times[first], times[first + 1], t);
+  }
+  return true;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the base value of a temporal value in columnar form at the
+ * timestamp.
+ */
+bool
+temporal_columnar_value_at_timestamp(const Temporal *temp, TimestampTz t,
+  Datum *result)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(temp->flags));
+  if (temp->subtype == SEQUENCE)
+    return tsequence_columnar_value_at_timestamp((TSequence *) temp, t,
+      result);
+
+  /* temp->subtype == SEQUENCESET */
+  const TSequenceSet *ts = (TSequenceSet *) temp;
+  int loc;
+  if (! tsequenceset_find_timestamp(ts, t, &loc))
+    return false;
+  return tsequence_columnar_value_at_timestamp(tsequenceset_seq_n(ts, loc),
+    t, result);
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the start base value of a temporal value in columnar form.
+ */
+Datum
+temporal_columnar_start_value(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(temp->flags));
+  const TSequence *seq = (temp->subtype == SEQUENCE) ? (TSequence *) temp :
+    tsequenceset_seq_n((TSequenceSet *) temp, 0);
+  return tsequence_columnar_value_n(seq, 0);
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the end base value of a temporal value in columnar form.
+ */
+Datum
+temporal_columnar_end_value(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(temp->flags));
+  const TSequence *seq = (temp->subtype == SEQUENCE) ? (TSequence *) temp :
+    tsequenceset_seq_n((TSequenceSet *) temp,
+      ((TSequenceSet *) temp)->count - 1);
+  return tsequence_columnar_value_n(seq, seq->count - 1);
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the n-th distinct timestamp of a temporal value in columnar
+ * form.
+ *
+ * The timestamps shared by consecutive sequences of a sequence set are
+ * counted once, as in function `tsequenceset_timestamp_n`. Since the first
+ * and last timestamps of a sequence are the bounds of its period, only the
+ * array of timestamps of the sequence containing the result is read.
+ * @note n is assumed 1-based
+ */
+bool
+temporal_columnar_timestamp_n(const Temporal *temp, int n,
+  TimestampTz *result)
+{
+  assert(MOBDB_FLAGS_GET_COLUMNAR(temp->flags));
+  if (n < 1)
+    return false;
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (TSequence *) temp;
+    if (n > seq->count)
+      return false;
+    *result = tsequence_columnar_times(seq)[n - 1];
+    return true;
+  }
+
+  /* temp->subtype == SEQUENCESET, continue the search 0-based */
+  const TSequenceSet *ts = (TSequenceSet *) temp;
+  n--;
+  TimestampTz prev = 0;
+  int count = 0, prevcount = 0;
+  for (int i = 0; i < ts->count; i++)
+  {
+    const TSequence *seq = tsequenceset_seq_n(ts, i);
+    count += seq->count;
+    if (i > 0 && prev == seq->period.lower)
+    {
+      prevcount--;
+      count--;
+    }
+    if (prevcount <= n && n < count)
+    {
+      *result = tsequence_columnar_times(seq)[n - prevcount];
+      return true;
+    }
+    prevcount = count;
+    prev = seq->period.upper;
+  }
+  return false;
+}
+
+/*****************************************************************************
+ * SQL functions
+ *****************************************************************************/
+
+#ifndef MEOS
+
+PG_FUNCTION_INFO_V1(Temporal_to_columnar);
+/**
+ * Return the temporal value in columnar form
+ */
+PGDLLEXPORT Datum
+Temporal_to_columnar(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *result = temporal_to_columnar(temp);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_is_columnar);
+/**
+ * Return true if the temporal value is stored in columnar form
+ */
+PGDLLEXPORT Datum
+Temporal_is_columnar(PG_FUNCTION_ARGS)
+{
+  /* Only the header of the value is needed */
+  Datum tempdatum = PG_GETARG_DATUM(0);
+  Temporal *temp;
+  if (PG_DATUM_NEEDS_DETOAST((struct varlena *) tempdatum))
+    temp = (Temporal *) PG_DETOAST_DATUM_SLICE(tempdatum, 0,
+      sizeof(Temporal));
+  else
+    temp = (Temporal *) tempdatum;
+  bool result = MOBDB_FLAGS_GET_COLUMNAR(temp->flags);
+  PG_FREE_IF_COPY_P(temp, DatumGetPointer(tempdatum));
+  PG_RETURN_BOOL(result);
+}
+
+#endif /* #ifndef MEOS */
+
+/*****************************************************************************/
@@ -66,6 +66,7 @@ tcomp_temporal_base(const Temporal *temp, Datum value, CachedType basetype,
   lfinfo.discont = MOBDB_FLAGS_GET_LINEAR(temp->flags);
   lfinfo.tpfunc_base = NULL;
   lfinfo.tpfunc = NULL;
+  lfinfo.arena = true;
   return tfunc_temporal_base(temp, value, &lfinfo);
 }
 
@@ -95,6 +96,7 @@ tcomp_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
     MOBDB_FLAGS_GET_LINEAR(temp2->flags);
   lfinfo.tpfunc_base = NULL;
   lfinfo.tpfunc = NULL;
+  lfinfo.arena = true;
   Temporal *result = tfunc_temporal_temporal(temp1, temp2, &lfinfo);
   return result;
 }
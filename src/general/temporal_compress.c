@@ -0,0 +1,1159 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_compress.c
+ * @brief Compressed storage of temporal sequences.
+ *
+ * Temporal integers, floats, and points sampled at near-regular intervals are
+ * highly compressible. A compressed sequence keeps its header and bounding box
+ * unchanged, so that index support and bounding box operators work as usual,
+ * and replaces the instants by one bit stream for the timestamps and one bit
+ * stream for each coordinate of the values, following the approach of the
+ * Gorilla time series database:
+ * - timestamps and integers are encoded as delta-of-deltas, where a regular
+ *   sampling makes most deltas-of-deltas equal to zero and encoded in 1 bit,
+ * - floats are encoded as the XOR with the previous value, whose leading and
+ *   trailing zero bits are omitted,
+ * - floats may optionally be quantized to a fixed number of decimal digits,
+ *   in which case they are scaled to integers and encoded as delta-of-deltas.
+ *
+ * The encoding of each stream restarts every `MOBDB_COMPRESS_RESTART`
+ * values from an absolute value, and the bit positions of the restart points
+ * are kept after the header. Functions such as `valueAtTimestamp`,
+ * `startValue`, or `timestampN` decode the streams from the nearest restart
+ * point without building the expanded value. Compressed values are only
+ * expanded by the `PG_GETARG_TEMPORAL_P` and `DatumGetTemporalP` macros in
+ * the functions that need the instants.
+ */
+
+#include "general/temporal_compress.h"
+
+/* PostgreSQL */
+#include <assert.h>
+#include <math.h>
+/* MobilityDB */
+#include "general/tempcache.h"
+#include "general/temporal_columnar.h"
+#include "general/temporal_util.h"
+#include "general/time_ops.h"
+#include "general/tinstant.h"
+#include "general/tsequence.h"
+#include "general/tsequenceset.h"
+#include "point/tpoint.h"
+#include "point/tpoint_spatialfuncs.h"
+
+/*****************************************************************************
+ * Bit streams
+ *****************************************************************************/
+
+/**
+ * Structure to write a bit stream
+ */
+typedef struct
+{
+  uint8 *data;      /**< buffer */
+  size_t size;      /**< allocated size of the buffer in bytes */
+  size_t nbits;     /**< number of bits written */
+} BitWriter;
+
+/**
+ * Structure to read a bit stream
+ */
+typedef struct
+{
+  const uint8 *data; /**< buffer */
+  size_t pos;        /**< position of the next bit to read */
+} BitReader;
+
+/**
+ * Initialize a bit writer with an estimated size in bytes
+ */
+static void
+bitwriter_init(BitWriter *bw, size_t size)
+{
+  bw->size = Max(size, 16);
+  bw->data = palloc0(bw->size);
+  bw->nbits = 0;
+  return;
+}
+
+/**
+ * Return the number of bytes written in a bit stream
+ */
+static size_t
+bitwriter_bytes(const BitWriter *bw)
+{
+  return (bw->nbits + 7) / 8;
+}
+
+/**
+ * Write the `nbits` least significant bits of the value, starting from the
+ * most significant one
+ */
+static void
+bitwriter_put(BitWriter *bw, uint64 value, int nbits)
+{
+  assert(nbits > 0 && nbits <= 64);
+  size_t needed = (bw->nbits + nbits + 7) / 8;
+  if (needed > bw->size)
+  {
+    size_t newsize = Max(needed, bw->size * 2);
+    bw->data = repalloc(bw->data, newsize);
+    memset(bw->data + bw->size, 0, newsize - bw->size);
+    bw->size = newsize;
+  }
+  while (nbits > 0)
+  {
+    int avail = 8 - (int) (bw->nbits & 7);
+    int n = Min(avail, nbits);
+    uint8 chunk = (uint8) ((value >> (nbits - n)) & ((1u << n) - 1));
+    bw->data[bw->nbits >> 3] |= (uint8) (chunk << (avail - n));
+    bw->nbits += n;
+    nbits -= n;
+  }
+  return;
+}
+
+/**
+ * Read the next `nbits` bits of a bit stream
+ */
+static uint64
+bitreader_get(BitReader *br, int nbits)
+{
+  assert(nbits > 0 && nbits <= 64);
+  uint64 result = 0;
+  while (nbits > 0)
+  {
+    int avail = 8 - (int) (br->pos & 7);
+    int n = Min(avail, nbits);
+    uint8 chunk = (uint8) ((br->data[br->pos >> 3] >> (avail - n)) &
+      ((1u << n) - 1));
+    result = (result << n) | chunk;
+    br->pos += n;
+    nbits -= n;
+  }
+  return result;
+}
+
+/**
+ * Return the number of leading zero bits of a nonzero value
+ */
+static inline int
+uint64_leading_zeros(uint64 x)
+{
+#if defined(__GNUC__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while (! (x & ((uint64) 1 << 63)))
+  {
+    x <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/**
+ * Return the number of trailing zero bits of a nonzero value
+ */
+static inline int
+uint64_trailing_zeros(uint64 x)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while (! (x & 1))
+  {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/*****************************************************************************
+ * Delta-of-delta encoding of integers and timestamps
+ *****************************************************************************/
+
+/**
+ * Encode an array of integers as delta-of-deltas
+ *
+ * The first value is written in 64 bits. Each following delta-of-delta is
+ * zigzag-encoded and written with a variable-length prefix:
+ * `0` for zero, `10` + 7 bits, `110` + 12 bits, `1110` + 20 bits, and
+ * `1111` + 64 bits. The bucket sizes are chosen for microsecond timestamps
+ * with a sampling jitter of a few milliseconds.
+ *
+ * Every `MOBDB_COMPRESS_RESTART` values the encoding restarts, that is, the
+ * value is written in 64 bits as the first one, and the bit position of the
+ * restart is stored in the `restarts` array.
+ */
+static void
+int64arr_encode(BitWriter *bw, const int64 *values, int count,
+  uint32 *restarts)
+{
+  int64 prevdelta = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (i % MOBDB_COMPRESS_RESTART == 0)
+    {
+      if (i > 0)
+        restarts[i / MOBDB_COMPRESS_RESTART - 1] = (uint32) bw->nbits;
+      bitwriter_put(bw, (uint64) values[i], 64);
+      prevdelta = 0;
+      continue;
+    }
+    int64 delta = values[i] - values[i - 1];
+    int64 dod = delta - prevdelta;
+    uint64 zz = ((uint64) dod << 1) ^ (uint64) (dod >> 63);
+    if (zz == 0)
+      bitwriter_put(bw, 0x0, 1);
+    else if (zz < ((uint64) 1 << 7))
+    {
+      bitwriter_put(bw, 0x2, 2);
+      bitwriter_put(bw, zz, 7);
+    }
+    else if (zz < ((uint64) 1 << 12))
+    {
+      bitwriter_put(bw, 0x6, 3);
+      bitwriter_put(bw, zz, 12);
+    }
+    else if (zz < ((uint64) 1 << 20))
+    {
+      bitwriter_put(bw, 0xE, 4);
+      bitwriter_put(bw, zz, 20);
+    }
+    else
+    {
+      bitwriter_put(bw, 0xF, 4);
+      bitwriter_put(bw, zz, 64);
+    }
+    prevdelta = delta;
+  }
+  return;
+}
+
+/**
+ * Structure to decode a stream of delta-of-deltas one value at a time
+ */
+typedef struct
+{
+  BitReader br;     /**< bit stream */
+  int64 prev;       /**< previous value */
+  int64 prevdelta;  /**< previous delta */
+  int n;            /**< position of the next value */
+} Int64Decoder;
+
+/**
+ * Initialize a decoder of delta-of-deltas positioned at the restart point
+ * preceding the value at position `n`
+ *
+ * @param[in] dec Decoder
+ * @param[in] data Stream
+ * @param[in] restarts Bit positions of the restart points of the stream
+ * @param[in] n Position of the value
+ */
+static void
+int64dec_init(Int64Decoder *dec, const uint8 *data, const uint32 *restarts,
+  int n)
+{
+  int k = n / MOBDB_COMPRESS_RESTART;
+  dec->br.data = data;
+  dec->br.pos = (k == 0) ? 0 : restarts[k - 1];
+  dec->prev = dec->prevdelta = 0;
+  dec->n = k * MOBDB_COMPRESS_RESTART;
+  return;
+}
+
+/**
+ * Return the next value of a stream of delta-of-deltas
+ */
+static int64
+int64dec_next(Int64Decoder *dec)
+{
+  if (dec->n++ % MOBDB_COMPRESS_RESTART == 0)
+  {
+    dec->prev = (int64) bitreader_get(&dec->br, 64);
+    dec->prevdelta = 0;
+    return dec->prev;
+  }
+  uint64 zz;
+  if (bitreader_get(&dec->br, 1) == 0)
+    zz = 0;
+  else if (bitreader_get(&dec->br, 1) == 0)
+    zz = bitreader_get(&dec->br, 7);
+  else if (bitreader_get(&dec->br, 1) == 0)
+    zz = bitreader_get(&dec->br, 12);
+  else if (bitreader_get(&dec->br, 1) == 0)
+    zz = bitreader_get(&dec->br, 20);
+  else
+    zz = bitreader_get(&dec->br, 64);
+  int64 dod = (int64) (zz >> 1) ^ -((int64) (zz & 1));
+  dec->prevdelta += dod;
+  dec->prev += dec->prevdelta;
+  return dec->prev;
+}
+
+/*****************************************************************************
+ * XOR encoding of floats
+ *****************************************************************************/
+
+/**
+ * Return the bit representation of a float
+ */
+static uint64
+double_bits(double value)
+{
+  uint64 result;
+  memcpy(&result, &value, sizeof(double));
+  return result;
+}
+
+/**
+ * Return the float of a bit representation
+ */
+static double
+bits_double(uint64 bits)
+{
+  double result;
+  memcpy(&result, &bits, sizeof(double));
+  return result;
+}
+
+/**
+ * Encode an array of floats as XORs with the previous value
+ *
+ * The first value is written in 64 bits. For each following value, a `0` is
+ * written when it is equal to the previous one. Otherwise, a `1` is followed
+ * either by `0` and the meaningful bits of the XOR when they fit in the
+ * window of the previous XOR, or by `1`, the number of leading zeros in
+ * 6 bits, the number of meaningful bits minus one in 6 bits, and the
+ * meaningful bits. The encoding restarts every `MOBDB_COMPRESS_RESTART`
+ * values as for delta-of-deltas.
+ */
+static void
+doublearr_encode(BitWriter *bw, const double *values, int count,
+  uint32 *restarts)
+{
+  uint64 prev = 0;
+  int prevlead = -1, prevtrail = 0;
+  for (int i = 0; i < count; i++)
+  {
+    uint64 cur = double_bits(values[i]);
+    if (i % MOBDB_COMPRESS_RESTART == 0)
+    {
+      /* The window of the previous XOR is not kept across restarts */
+      if (i > 0)
+        restarts[i / MOBDB_COMPRESS_RESTART - 1] = (uint32) bw->nbits;
+      bitwriter_put(bw, cur, 64);
+      prevlead = -1;
+      prev = cur;
+      continue;
+    }
+    uint64 x = cur ^ prev;
+    if (x == 0)
+      bitwriter_put(bw, 0x0, 1);
+    else
+    {
+      int lead = uint64_leading_zeros(x);
+      int trail = uint64_trailing_zeros(x);
+      bitwriter_put(bw, 0x1, 1);
+      if (prevlead >= 0 && lead >= prevlead && trail >= prevtrail)
+      {
+        bitwriter_put(bw, 0x0, 1);
+        bitwriter_put(bw, x >> prevtrail, 64 - prevlead - prevtrail);
+      }
+      else
+      {
+        int n = 64 - lead - trail;
+        bitwriter_put(bw, 0x1, 1);
+        bitwriter_put(bw, (uint64) lead, 6);
+        bitwriter_put(bw, (uint64) (n - 1), 6);
+        bitwriter_put(bw, x >> trail, n);
+        prevlead = lead;
+        prevtrail = trail;
+      }
+    }
+    prev = cur;
+  }
+  return;
+}
+
+/**
+ * Structure to decode a stream of XOR-encoded floats one value at a time
+ */
+typedef struct
+{
+  BitReader br;     /**< bit stream */
+  uint64 prev;      /**< bits of the previous value */
+  int lead;         /**< leading zeros of the current window */
+  int trail;        /**< trailing zeros of the current window */
+  int n;            /**< position of the next value */
+} DoubleDecoder;
+
+/**
+ * Initialize a decoder of XOR-encoded floats positioned at the restart point
+ * preceding the value at position `n`
+ *
+ * @param[in] dec Decoder
+ * @param[in] data Stream
+ * @param[in] restarts Bit positions of the restart points of the stream
+ * @param[in] n Position of the value
+ */
+static void
+doubledec_init(DoubleDecoder *dec, const uint8 *data, const uint32 *restarts,
+  int n)
+{
+  int k = n / MOBDB_COMPRESS_RESTART;
+  dec->br.data = data;
+  dec->br.pos = (k == 0) ? 0 : restarts[k - 1];
+  dec->prev = 0;
+  dec->lead = dec->trail = 0;
+  dec->n = k * MOBDB_COMPRESS_RESTART;
+  return;
+}
+
+/**
+ * Return the next value of a stream of XOR-encoded floats
+ */
+static double
+doubledec_next(DoubleDecoder *dec)
+{
+  if (dec->n++ % MOBDB_COMPRESS_RESTART == 0)
+    dec->prev = bitreader_get(&dec->br, 64);
+  else if (bitreader_get(&dec->br, 1) == 1)
+  {
+    if (bitreader_get(&dec->br, 1) == 1)
+    {
+      dec->lead = (int) bitreader_get(&dec->br, 6);
+      int n = (int) bitreader_get(&dec->br, 6) + 1;
+      dec->trail = 64 - dec->lead - n;
+    }
+    int n = 64 - dec->lead - dec->trail;
+    dec->prev ^= bitreader_get(&dec->br, n) << dec->trail;
+  }
+  return bits_double(dec->prev);
+}
+
+/*****************************************************************************
+ * Memory layout
+ *****************************************************************************/
+
+/**
+ * Return a pointer to the header of the streams of a compressed sequence
+ *
+ * The memory structure of a compressed temporal sequence is as follows:
+ * @code
+ * -----------------------------------------------------------------------
+ * ( TSequence )_X | ( bbox )_X | TCompressHeader | restarts_0 | ...
+ * -----------------------------------------------------------------------
+ * -----------------------
+ * stream_0 | ...
+ * -----------------------
+ * @endcode
+ * where the `X` are unused bytes added for double padding, `stream_0` encodes
+ * the timestamps, and the following streams encode each coordinate of the
+ * values. Each `restarts_i` array keeps the bit positions in `stream_i` of
+ * the restart points after the first value.
+ */
+static TCompressHeader *
+tsequence_compress_header(const TSequence *seq)
+{
+  return (TCompressHeader *)(((char *) seq) + double_pad(sizeof(TSequence)) +
+    double_pad(seq->bboxsize));
+}
+
+/**
+ * Return the number of restart points after the first value of the streams
+ * of a sequence with the given number of instants
+ */
+static int
+tcompress_nrestarts(int count)
+{
+  return (count - 1) / MOBDB_COMPRESS_RESTART;
+}
+
+/**
+ * Return a pointer to the restart points of the n-th stream of a compressed
+ * sequence
+ */
+static const uint32 *
+tsequence_compress_restarts(const TSequence *seq, int n)
+{
+  const TCompressHeader *header = tsequence_compress_header(seq);
+  assert(n >= 0 && n < header->nstreams);
+  return (uint32 *)(((char *) header) + sizeof(TCompressHeader)) +
+    n * tcompress_nrestarts(seq->count);
+}
+
+/**
+ * Return a pointer to the n-th stream of a compressed sequence
+ */
+static const uint8 *
+tsequence_compress_stream(const TSequence *seq, int n)
+{
+  const TCompressHeader *header = tsequence_compress_header(seq);
+  assert(n >= 0 && n < header->nstreams);
+  const uint8 *result = ((uint8 *) header) + sizeof(TCompressHeader) +
+    header->nstreams * tcompress_nrestarts(seq->count) * sizeof(uint32);
+  for (int i = 0; i < n; i++)
+    result += header->streamsize[i];
+  return result;
+}
+
+/**
+ * Ensure that the number of decimal digits of quantized values is valid
+ */
+static void
+ensure_valid_precision(int precision)
+{
+  if (precision < -1 || precision > MOBDB_COMPRESS_MAXPRECISION)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The precision must be -1 for a lossless compression or between 0 and %d",
+        MOBDB_COMPRESS_MAXPRECISION)));
+  return;
+}
+
+/**
+ * Round the value to the precision given by the scale
+ */
+static double
+double_quantize(double value, double scale)
+{
+  return (double) llround(value * scale) / scale;
+}
+
+/**
+ * Return true if the value can be quantized with the scale into a 64-bit
+ * integer, which is not the case for very large or non-finite values
+ */
+static bool
+double_quantizable(double value, double scale)
+{
+  /* The negation also rejects NaN */
+  return fabs(value) * scale < 9223372036854775808.0;
+}
+
+/**
+ * Return true if all the values of a temporal sequence can be quantized with
+ * the scale
+ */
+static bool
+tsequence_quantizable(const TSequence *seq, double scale)
+{
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  for (int i = 0; i < seq->count; i++)
+  {
+    Datum value = tinstant_value(tsequence_inst_n(seq, i));
+    if (seq->temptype == T_TFLOAT)
+    {
+      if (! double_quantizable(DatumGetFloat8(value), scale))
+        return false;
+    }
+    else
+    {
+      POINT4D p;
+      datum_point4d(value, &p);
+      if (! double_quantizable(p.x, scale) ||
+          ! double_quantizable(p.y, scale) ||
+          (hasz && ! double_quantizable(p.z, scale)))
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return a temporal sequence whose values are rounded to a number of decimal
+ * digits, so that the bounding box is computed on the rounded values
+ */
+static TSequence *
+tsequence_quantize(const TSequence *seq, int precision)
+{
+  double scale = pow(10.0, precision);
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  bool geodetic = MOBDB_FLAGS_GET_GEODETIC(seq->flags);
+  int32 srid = tgeo_type(seq->temptype) ? tpointseq_srid(seq) : 0;
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  for (int i = 0; i < seq->count; i++)
+  {
+    const TInstant *inst = tsequence_inst_n(seq, i);
+    Datum value = tinstant_value(inst);
+    if (seq->temptype == T_TFLOAT)
+      instants[i] = tinstant_make(Float8GetDatum(double_quantize(
+        DatumGetFloat8(value), scale)), inst->t, seq->temptype);
+    else
+    {
+      POINT4D p;
+      datum_point4d(value, &p);
+      Datum point = point_make(double_quantize(p.x, scale),
+        double_quantize(p.y, scale), hasz ? double_quantize(p.z, scale) : 0.0,
+        hasz, geodetic, srid);
+      instants[i] = tinstant_make(point, inst->t, seq->temptype);
+      pfree(DatumGetPointer(point));
+    }
+  }
+  TSequence *result = tsequence_make1((const TInstant **) instants,
+    seq->count, seq->period.lower_inc, seq->period.upper_inc,
+    MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE_NO);
+  pfree_array((void **) instants, seq->count);
+  return result;
+}
+
+/*****************************************************************************
+ * Compression and decompression functions
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence in compressed form.
+ *
+ * @param[in] seq Temporal sequence
+ * @param[in] precision Number of decimal digits to which the float values or
+ * the coordinates are quantized, -1 for a lossless compression
+ * @pre The temporal sequence is in the default storage
+ */
+TSequence *
+tsequence_compress(const TSequence *seq, int precision)
+{
+  assert(! MOBDB_FLAGS_GET_COLUMNAR(seq->flags) &&
+    ! MOBDB_FLAGS_GET_COMPRESSED(seq->flags));
+  ensure_temptype_columnar(seq->temptype);
+  ensure_valid_precision(precision);
+  /* Integers are always encoded without loss. The values that overflow a
+   * 64-bit integer when quantized are also encoded without loss */
+  if (seq->temptype == T_TINT || (precision >= 0 &&
+      ! tsequence_quantizable(seq, pow(10.0, precision))))
+    precision = -1;
+  TSequence *seq1 = (precision >= 0) ?
+    tsequence_quantize(seq, precision) : (TSequence *) seq;
+  TSequence *colseq = tsequence_to_columnar(seq1);
+  int count = colseq->count;
+  int nstreams = tsequence_columnar_ncols(colseq) + 1;
+  int nrestarts = tcompress_nrestarts(count);
+  double scale = (precision >= 0) ? pow(10.0, precision) : 1.0;
+
+  /* Encode the streams */
+  BitWriter writers[MOBDB_COMPRESS_MAXSTREAMS];
+  uint32 *restarts = palloc(sizeof(uint32) * Max(nstreams * nrestarts, 1));
+  bitwriter_init(&writers[0], count);
+  int64arr_encode(&writers[0],
+    (const int64 *) tsequence_columnar_times(colseq), count, restarts);
+  int64 *ints = palloc(sizeof(int64) * count);
+  for (int i = 1; i < nstreams; i++)
+  {
+    const void *values = tsequence_columnar_values(colseq, i - 1);
+    bitwriter_init(&writers[i], count);
+    if (seq->temptype == T_TINT)
+    {
+      for (int j = 0; j < count; j++)
+        ints[j] = ((const int32 *) values)[j];
+      int64arr_encode(&writers[i], ints, count, restarts + i * nrestarts);
+    }
+    else if (precision >= 0)
+    {
+      for (int j = 0; j < count; j++)
+        ints[j] = llround(((const double *) values)[j] * scale);
+      int64arr_encode(&writers[i], ints, count, restarts + i * nrestarts);
+    }
+    else
+      doublearr_encode(&writers[i], (const double *) values, count,
+        restarts + i * nrestarts);
+  }
+  pfree(ints);
+
+  /* Create the compressed sequence */
+  size_t memsize = double_pad(sizeof(TSequence)) + double_pad(seq1->bboxsize) +
+    sizeof(TCompressHeader) + nstreams * nrestarts * sizeof(uint32);
+  for (int i = 0; i < nstreams; i++)
+    memsize += bitwriter_bytes(&writers[i]);
+  TSequence *result = palloc0(memsize);
+  memcpy(result, colseq, sizeof(TSequence));
+  SET_VARSIZE(result, memsize);
+  MOBDB_FLAGS_SET_COLUMNAR(result->flags, false);
+  MOBDB_FLAGS_SET_COMPRESSED(result->flags, true);
+  memcpy(tsequence_bbox_ptr(result), tsequence_bbox_ptr(seq1),
+    seq1->bboxsize);
+  TCompressHeader *header = tsequence_compress_header(result);
+  header->precision = (int16) precision;
+  header->nstreams = (int16) nstreams;
+  uint8 *data = ((uint8 *) header) + sizeof(TCompressHeader);
+  memcpy(data, restarts, nstreams * nrestarts * sizeof(uint32));
+  data += nstreams * nrestarts * sizeof(uint32);
+  pfree(restarts);
+  for (int i = 0; i < nstreams; i++)
+  {
+    size_t size = bitwriter_bytes(&writers[i]);
+    header->streamsize[i] = (uint32) size;
+    memcpy(data, writers[i].data, size);
+    data += size;
+    pfree(writers[i].data);
+  }
+  pfree(colseq);
+  if (seq1 != seq)
+    pfree(seq1);
+  return result;
+}
+
+/**
+ * Return a compressed temporal sequence in columnar form
+ */
+static TSequence *
+tsequence_compressed_to_columnar(const TSequence *seq)
+{
+  size_t memsize = tsequence_columnar_size(seq);
+  TSequence *result = palloc0(memsize);
+  memcpy(result, seq, sizeof(TSequence));
+  SET_VARSIZE(result, memsize);
+  MOBDB_FLAGS_SET_COMPRESSED(result->flags, false);
+  MOBDB_FLAGS_SET_COLUMNAR(result->flags, true);
+  memcpy(tsequence_bbox_ptr(result), tsequence_bbox_ptr(seq), seq->bboxsize);
+
+  const TCompressHeader *header = tsequence_compress_header(seq);
+  Int64Decoder intdec;
+  int64dec_init(&intdec, tsequence_compress_stream(seq, 0),
+    tsequence_compress_restarts(seq, 0), 0);
+  TimestampTz *times = tsequence_columnar_times(result);
+  for (int i = 0; i < seq->count; i++)
+    times[i] = (TimestampTz) int64dec_next(&intdec);
+  double scale = (header->precision >= 0) ? pow(10.0, header->precision) : 1.0;
+  for (int i = 1; i < header->nstreams; i++)
+  {
+    void *values = tsequence_columnar_values(result, i - 1);
+    const uint8 *stream = tsequence_compress_stream(seq, i);
+    const uint32 *restarts = tsequence_compress_restarts(seq, i);
+    if (seq->temptype == T_TINT)
+    {
+      int64dec_init(&intdec, stream, restarts, 0);
+      for (int j = 0; j < seq->count; j++)
+        ((int32 *) values)[j] = (int32) int64dec_next(&intdec);
+    }
+    else if (header->precision >= 0)
+    {
+      int64dec_init(&intdec, stream, restarts, 0);
+      for (int j = 0; j < seq->count; j++)
+        ((double *) values)[j] = (double) int64dec_next(&intdec) / scale;
+    }
+    else
+    {
+      DoubleDecoder doubledec;
+      doubledec_init(&doubledec, stream, restarts, 0);
+      for (int j = 0; j < seq->count; j++)
+        ((double *) values)[j] = doubledec_next(&doubledec);
+    }
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a compressed temporal sequence in the default storage.
+ */
+TSequence *
+tsequence_decompress(const TSequence *seq)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(seq->flags));
+  TSequence *colseq = tsequence_compressed_to_columnar(seq);
+  TSequence *result = tsequence_from_columnar(colseq);
+  pfree(colseq);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal sequence set whose composing sequences are in
+ * compressed form.
+ * @pre The temporal sequence set is in the default storage
+ */
+TSequenceSet *
+tsequenceset_compress(const TSequenceSet *ts, int precision)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_compress(tsequenceset_seq_n(ts, i), precision);
+  TSequenceSet *result = tsequenceset_make_free(sequences, ts->count,
+    NORMALIZE_NO);
+  MOBDB_FLAGS_SET_COMPRESSED(result->flags, true);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a compressed temporal sequence set in the default storage.
+ */
+TSequenceSet *
+tsequenceset_decompress(const TSequenceSet *ts)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(ts->flags));
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_decompress(tsequenceset_seq_n(ts, i));
+  return tsequenceset_make_free(sequences, ts->count, NORMALIZE_NO);
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a temporal value in compressed form.
+ *
+ * Instant and instant set values are returned unchanged.
+ * @param[in] temp Temporal value
+ * @param[in] precision Number of decimal digits to which the float values or
+ * the coordinates are quantized, -1 for a lossless compression
+ * @pre The temporal value is in the default storage
+ */
+Temporal *
+temporal_compress(const Temporal *temp, int precision)
+{
+  ensure_temptype_columnar(temp->temptype);
+  ensure_valid_precision(precision);
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT || temp->subtype == INSTANTSET)
+    result = temporal_copy(temp);
+  else if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_compress((TSequence *) temp, precision);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_compress((TSequenceSet *) temp,
+      precision);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a compressed temporal value in the default storage.
+ */
+Temporal *
+temporal_decompress(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(temp->flags));
+  Temporal *result;
+  if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_decompress((TSequence *) temp);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_decompress((TSequenceSet *) temp);
+  return result;
+}
+
+/*****************************************************************************
+ * Accessor functions
+ *****************************************************************************/
+
+/**
+ * Decode the base values at positions `n` to `n + count - 1` of a compressed
+ * temporal sequence
+ *
+ * The streams are decoded from the restart point preceding the position `n`,
+ * so that at most `MOBDB_COMPRESS_RESTART` values are decoded per stream.
+ * @param[in] seq Temporal sequence
+ * @param[in] n Position of the first value
+ * @param[in] count Number of values, which is either 1 or 2
+ * @param[out] values Base values
+ */
+static void
+tsequence_compressed_values(const TSequence *seq, int n, int count,
+  Datum *values)
+{
+  assert(count == 1 || count == 2);
+  const TCompressHeader *header = tsequence_compress_header(seq);
+  double scale = (header->precision >= 0) ? pow(10.0, header->precision) : 1.0;
+  double coords[2][3] = {{0}};
+  int first = (n / MOBDB_COMPRESS_RESTART) * MOBDB_COMPRESS_RESTART;
+  for (int i = 1; i < header->nstreams; i++)
+  {
+    const uint8 *stream = tsequence_compress_stream(seq, i);
+    const uint32 *restarts = tsequence_compress_restarts(seq, i);
+    Int64Decoder intdec;
+    DoubleDecoder doubledec;
+    bool isint = (seq->temptype == T_TINT || header->precision >= 0);
+    if (isint)
+      int64dec_init(&intdec, stream, restarts, n);
+    else
+      doubledec_init(&doubledec, stream, restarts, n);
+    for (int j = first; j < n + count; j++)
+    {
+      double value = isint ? (double) int64dec_next(&intdec) / scale :
+        doubledec_next(&doubledec);
+      if (j >= n)
+        coords[j - n][i - 1] = value;
+    }
+  }
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  for (int i = 0; i < count; i++)
+  {
+    if (seq->temptype == T_TINT)
+      values[i] = Int32GetDatum((int32) coords[i][0]);
+    else if (seq->temptype == T_TFLOAT)
+      values[i] = Float8GetDatum(coords[i][0]);
+    else
+      values[i] = point_make(coords[i][0], coords[i][1], coords[i][2], hasz,
+        MOBDB_FLAGS_GET_GEODETIC(seq->flags), tpointseq_srid(seq));
+  }
+  return;
+}
+
+/**
+ * Return the timestamp at the k-th restart point of a compressed temporal
+ * sequence, which is stored in 64 bits
+ */
+static TimestampTz
+tsequence_compressed_restart_timestamp(const TSequence *seq, int k)
+{
+  BitReader br;
+  br.data = tsequence_compress_stream(seq, 0);
+  br.pos = (k == 0) ? 0 : tsequence_compress_restarts(seq, 0)[k - 1];
+  return (TimestampTz) bitreader_get(&br, 64);
+}
+
+/**
+ * Return the timestamp at position `n` of a compressed temporal sequence
+ */
+static TimestampTz
+tsequence_compressed_timestamp_n(const TSequence *seq, int n)
+{
+  Int64Decoder dec;
+  int64dec_init(&dec, tsequence_compress_stream(seq, 0),
+    tsequence_compress_restarts(seq, 0), n);
+  TimestampTz result = 0;
+  while (dec.n <= n)
+    result = (TimestampTz) int64dec_next(&dec);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the base value of a compressed temporal sequence at the
+ * timestamp.
+ *
+ * The restart point preceding the timestamp is found with a binary search on
+ * the timestamps stored at the restart points, the timestamps are decoded
+ * from there until the segment containing the timestamp is found, and only
+ * the values of this segment are built.
+ * @param[in] seq Temporal value
+ * @param[in] t Timestamp
+ * @param[out] result Base value
+ * @result Return true if the timestamp is found in the temporal value
+ */
+bool
+tsequence_compressed_value_at_timestamp(const TSequence *seq, TimestampTz t,
+  Datum *result)
+{
+  /* Bounding box test */
+  if (! contains_period_timestamp(&seq->period, t))
+    return false;
+
+  /* Find the last restart point whose timestamp is less than or equal to t */
+  int first = 0, last = tcompress_nrestarts(seq->count);
+  while (first < last)
+  {
+    int middle = (first + last + 1) / 2;
+    if (tsequence_compressed_restart_timestamp(seq, middle) <= t)
+      first = middle;
+    else
+      last = middle - 1;
+  }
+
+  /* Find the last instant whose timestamp is less than or equal to t */
+  int n = first * MOBDB_COMPRESS_RESTART;
+  Int64Decoder dec;
+  int64dec_init(&dec, tsequence_compress_stream(seq, 0),
+    tsequence_compress_restarts(seq, 0), n);
+  TimestampTz t1 = (TimestampTz) int64dec_next(&dec), t2 = t1;
+  while (n < seq->count - 1)
+  {
+    t2 = (TimestampTz) int64dec_next(&dec);
+    if (t2 > t)
+      break;
+    t1 = t2;
+    n++;
+  }
+  Datum values[2];
+  if (t1 == t)
+  {
+    tsequence_compressed_values(seq, n, 1, values);
+    *result = values[0];
+  }
+  else
+  {
+    tsequence_compressed_values(seq, n, 2, values);
+    *result = tcolumnar_segment_value_at_timestamp(seq, values[0], values[1],
+      t1, t2, t);
+  }
+  return true;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the base value of a compressed temporal value at the
+ * timestamp.
+ */
+bool
+temporal_compressed_value_at_timestamp(const Temporal *temp, TimestampTz t,
+  Datum *result)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(temp->flags));
+  if (temp->subtype == SEQUENCE)
+    return tsequence_compressed_value_at_timestamp((TSequence *) temp, t,
+      result);
+
+  /* temp->subtype == SEQUENCESET */
+  const TSequenceSet *ts = (TSequenceSet *) temp;
+  int loc;
+  if (! tsequenceset_find_timestamp(ts, t, &loc))
+    return false;
+  return tsequence_compressed_value_at_timestamp(tsequenceset_seq_n(ts, loc),
+    t, result);
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the start base value of a compressed temporal value.
+ */
+Datum
+temporal_compressed_start_value(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(temp->flags));
+  const TSequence *seq = (temp->subtype == SEQUENCE) ? (TSequence *) temp :
+    tsequenceset_seq_n((TSequenceSet *) temp, 0);
+  Datum result;
+  tsequence_compressed_values(seq, 0, 1, &result);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the end base value of a compressed temporal value.
+ */
+Datum
+temporal_compressed_end_value(const Temporal *temp)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(temp->flags));
+  const TSequence *seq = (temp->subtype == SEQUENCE) ? (TSequence *) temp :
+    tsequenceset_seq_n((TSequenceSet *) temp,
+      ((TSequenceSet *) temp)->count - 1);
+  Datum result;
+  tsequence_compressed_values(seq, seq->count - 1, 1, &result);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_accessor
+ * @brief Return the n-th distinct timestamp of a compressed temporal value.
+ *
+ * The sequence containing the timestamp is found as in function
+ * `temporal_columnar_timestamp_n` and the timestamp is decoded from the
+ * preceding restart point.
+ * @note n is assumed 1-based
+ */
+bool
+temporal_compressed_timestamp_n(const Temporal *temp, int n,
+  TimestampTz *result)
+{
+  assert(MOBDB_FLAGS_GET_COMPRESSED(temp->flags));
+  if (n < 1)
+    return false;
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (TSequence *) temp;
+    if (n > seq->count)
+      return false;
+    *result = tsequence_compressed_timestamp_n(seq, n - 1);
+    return true;
+  }
+
+  /* temp->subtype == SEQUENCESET, continue the search 0-based */
+  const TSequenceSet *ts = (TSequenceSet *) temp;
+  n--;
+  TimestampTz prev = 0;
+  int count = 0, prevcount = 0;
+  for (int i = 0; i < ts->count; i++)
+  {
+    const TSequence *seq = tsequenceset_seq_n(ts, i);
+    count += seq->count;
+    if (i > 0 && prev == seq->period.lower)
+    {
+      prevcount--;
+      count--;
+    }
+    if (prevcount <= n && n < count)
+    {
+      *result = tsequence_compressed_timestamp_n(seq, n - prevcount);
+      return true;
+    }
+    prevcount = count;
+    prev = seq->period.upper;
+  }
+  return false;
+}
+
+/*****************************************************************************
+ * SQL functions
+ *****************************************************************************/
+
+#ifndef MEOS
+
+PG_FUNCTION_INFO_V1(Temporal_compress);
+/**
+ * Return the temporal value in compressed form
+ */
+PGDLLEXPORT Datum
+Temporal_compress(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int precision = (PG_NARGS() > 1) ? PG_GETARG_INT32(1) : -1;
+  Temporal *result = temporal_compress(temp, precision);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_is_compressed);
+/**
+ * Return true if the temporal value is stored in compressed form
+ */
+PGDLLEXPORT Datum
+Temporal_is_compressed(PG_FUNCTION_ARGS)
+{
+  /* Only the header of the value is needed */
+  Datum tempdatum = PG_GETARG_DATUM(0);
+  Temporal *temp;
+  if (PG_DATUM_NEEDS_DETOAST((struct varlena *) tempdatum))
+    temp = (Temporal *) PG_DETOAST_DATUM_SLICE(tempdatum, 0,
+      sizeof(Temporal));
+  else
+    temp = (Temporal *) tempdatum;
+  bool result = MOBDB_FLAGS_GET_COMPRESSED(temp->flags);
+  PG_FREE_IF_COPY_P(temp, DatumGetPointer(tempdatum));
+  PG_RETURN_BOOL(result);
+}
+
+#endif /* #ifndef MEOS */
+
+/*****************************************************************************/
@@ -42,6 +42,9 @@
 #include <math.h>
 #if POSTGRESQL_VERSION_NUMBER < 120000
 #include <access/htup_details.h>
+#include <utils/builtins.h>
+#else
+#include <utils/float.h>
 #endif
 /* PostgreGIS */
 #include <liblwgeom.h>
@@ -98,75 +101,348 @@ tinstant_distance(const TInstant *inst1, const TInstant *inst2)
   elog(ERROR, "Unexpected base type in function tinstant_distance");
 }
 
+/*****************************************************************************
+ * Coordinates of the instants
+ *****************************************************************************/
+
+/**
+ * Return the number of coordinates used for computing the distance between
+ * the instants of two temporal values, or 0 if the distance cannot be
+ * computed from the coordinates, i.e., for temporal geographic points
+ *
+ * @param[in] temp1,temp2 Temporal values
+ */
+static int
+temporal_similarity_dims(const Temporal *temp1, const Temporal *temp2)
+{
+  if (tnumber_type(temp1->temptype))
+    return 1;
+  if (MOBDB_FLAGS_GET_GEODETIC(temp1->flags))
+    return 0;
+  return (MOBDB_FLAGS_GET_Z(temp1->flags) &&
+    MOBDB_FLAGS_GET_Z(temp2->flags)) ? 3 : 2;
+}
+
+/**
+ * Extract once the coordinates of an array of temporal instants so that
+ * the dynamic programming does not need to access the values of the
+ * instants for every cell of the distance matrix
+ *
+ * @param[in] instants Array of temporal instants
+ * @param[in] count Number of instants in the array
+ * @param[in] dims Number of coordinates of each instant
+ */
+static double *
+tinstarr_coords(const TInstant **instants, int count, int dims)
+{
+  double *result = palloc(sizeof(double) * count * dims);
+  for (int i = 0; i < count; i++)
+  {
+    double *coords = &result[i * dims];
+    if (dims == 1)
+      coords[0] = tnumberinst_double(instants[i]);
+    else if (dims == 2)
+    {
+      const POINT2D *p = datum_point2d_p(tinstant_value(instants[i]));
+      coords[0] = p->x;
+      coords[1] = p->y;
+    }
+    else /* dims == 3 */
+    {
+      const POINT3DZ *p = datum_point3dz_p(tinstant_value(instants[i]));
+      coords[0] = p->x;
+      coords[1] = p->y;
+      coords[2] = p->z;
+    }
+  }
+  return result;
+}
+
+/**
+ * Return the Euclidean distance between two points given by their
+ * coordinates
+ */
+static double
+coords_distance(const double *coords1, const double *coords2, int dims)
+{
+  if (dims == 1)
+    return fabs(coords1[0] - coords2[0]);
+  double result = 0.0;
+  for (int k = 0; k < dims; k++)
+  {
+    double d = coords1[k] - coords2[k];
+    result += d * d;
+  }
+  return sqrt(result);
+}
+
+/**
+ * Return the Euclidean distance between a point and a box given by the
+ * coordinates of its lower and upper corners
+ */
+static double
+coords_box_distance(const double *coords, const double *lower,
+  const double *upper, int dims)
+{
+  double result = 0.0;
+  for (int k = 0; k < dims; k++)
+  {
+    double d = 0.0;
+    if (coords[k] < lower[k])
+      d = lower[k] - coords[k];
+    else if (coords[k] > upper[k])
+      d = coords[k] - upper[k];
+    result += d * d;
+  }
+  return sqrt(result);
+}
+
+/*****************************************************************************
+ * Warping window and lower bounds
+ *****************************************************************************/
+
+/**
+ * Compute the columns of a row of the distance matrix that are within the
+ * Sakoe-Chiba band, i.e., at most a given number of cells away from the
+ * diagonal joining the first and the last cells of the matrix
+ *
+ * @param[in] i Row of the matrix
+ * @param[in] count1,count2 Number of rows and columns of the matrix
+ * @param[in] window Width of the band, a negative value means no band
+ * @param[out] lower,upper Columns of the row within the band
+ * @pre The number of rows is greater than or equal to the number of columns,
+ * which ensures that the bands of two consecutive rows overlap
+ */
+static void
+similarity_band(int i, int count1, int count2, int window, int *lower,
+  int *upper)
+{
+  if (window < 0)
+  {
+    *lower = 0;
+    *upper = count2 - 1;
+    return;
+  }
+  double diag = (count1 > 1) ?
+    (double) i * (count2 - 1) / (count1 - 1) : 0.0;
+  *lower = Max(0, (int) floor(diag) - window);
+  *upper = Min(count2 - 1, (int) ceil(diag) + window);
+  return;
+}
+
+/**
+ * Compute the envelope of the second series for each row of the distance
+ * matrix, i.e., the box enclosing the points of the second series that are
+ * within the band of the row. The envelope is computed with a sliding
+ * window minimum and maximum, since the bounds of the band never decrease.
+ *
+ * @param[in] coords2 Coordinates of the second series
+ * @param[in] count1,count2 Number of rows and columns of the matrix
+ * @param[in] dims Number of coordinates of each point
+ * @param[in] window Width of the band, a negative value means no band
+ * @param[out] lower,upper Corners of the envelope of each row
+ */
+static void
+coords_envelope(const double *coords2, int count1, int count2, int dims,
+  int window, double *lower, double *upper)
+{
+  int *minqueue = palloc(sizeof(int) * count2);
+  int *maxqueue = palloc(sizeof(int) * count2);
+  for (int k = 0; k < dims; k++)
+  {
+    int minhead = 0, mintail = 0, maxhead = 0, maxtail = 0, next = 0;
+    for (int i = 0; i < count1; i++)
+    {
+      int lo, hi;
+      similarity_band(i, count1, count2, window, &lo, &hi);
+      /* Enqueue the points entering the band */
+      for (; next <= hi; next++)
+      {
+        double value = coords2[next * dims + k];
+        while (mintail > minhead &&
+            coords2[minqueue[mintail - 1] * dims + k] >= value)
+          mintail--;
+        minqueue[mintail++] = next;
+        while (maxtail > maxhead &&
+            coords2[maxqueue[maxtail - 1] * dims + k] <= value)
+          maxtail--;
+        maxqueue[maxtail++] = next;
+      }
+      /* Dequeue the points leaving the band */
+      while (minqueue[minhead] < lo)
+        minhead++;
+      while (maxqueue[maxhead] < lo)
+        maxhead++;
+      lower[i * dims + k] = coords2[minqueue[minhead] * dims + k];
+      upper[i * dims + k] = coords2[maxqueue[maxhead] * dims + k];
+    }
+  }
+  pfree(minqueue); pfree(maxqueue);
+  return;
+}
+
+/**
+ * Compute a lower bound of the similarity distance between two series of
+ * points. The bound is the maximum of the following bounds, where the
+ * cheaper ones are computed first so that the computation stops as soon as
+ * the maximum distance is exceeded.
+ * - LB_Kim: the first and the last cells of the matrix are in every path.
+ * - Box bound: every column of the matrix is in a path, and the distance of
+ *   a point of the second series to the bounding box of the first series is
+ *   a lower bound of the distances in its column.
+ * - LB_Keogh: every row of the matrix is in a path, and the distance of a
+ *   point of the first series to the envelope of the second series within
+ *   the band of its row is a lower bound of the distances in its row.
+ * The cumulative bound of the rows after each row obtained from LB_Keogh is
+ * also returned for early abandoning the dynamic programming.
+ *
+ * @param[in] coords1,coords2 Coordinates of the series
+ * @param[in] count1,count2 Number of points of the series
+ * @param[in] dims Number of coordinates of each point
+ * @param[in] window Width of the band, a negative value means no band
+ * @param[in] maxdist Maximum distance
+ * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @param[out] rowbound Bound of the rows following each row, may be NULL
+ * @result Lower bound, whose computation stops once it exceeds maxdist
+ */
+static double
+coords_similarity_bound(const double *coords1, int count1,
+  const double *coords2, int count2, int dims, int window, double maxdist,
+  SimFunc simfunc, double *rowbound)
+{
+  /* LB_Kim */
+  double first = coords_distance(coords1, coords2, dims);
+  double last = coords_distance(&coords1[(count1 - 1) * dims],
+    &coords2[(count2 - 1) * dims], dims);
+  double result;
+  if (simfunc == FRECHET)
+    result = Max(first, last);
+  else /* simfunc == DYNTIMEWARP */
+    result = (count1 == 1 && count2 == 1) ? first : first + last;
+  if (MOBDB_FP_LT(maxdist, result))
+    return result;
+
+  /* Bounding box of the first series */
+  double lower[3], upper[3];
+  for (int k = 0; k < dims; k++)
+    lower[k] = upper[k] = coords1[k];
+  for (int i = 1; i < count1; i++)
+  {
+    for (int k = 0; k < dims; k++)
+    {
+      lower[k] = Min(lower[k], coords1[i * dims + k]);
+      upper[k] = Max(upper[k], coords1[i * dims + k]);
+    }
+  }
+  double bound = 0.0;
+  for (int j = 0; j < count2; j++)
+  {
+    double d = coords_box_distance(&coords2[j * dims], lower, upper, dims);
+    if (simfunc == FRECHET)
+      bound = Max(bound, d);
+    else /* simfunc == DYNTIMEWARP */
+      bound += d;
+  }
+  result = Max(result, bound);
+  if (MOBDB_FP_LT(maxdist, result))
+    return result;
+
+  /* LB_Keogh */
+  double *envlower = palloc(sizeof(double) * count1 * dims);
+  double *envupper = palloc(sizeof(double) * count1 * dims);
+  coords_envelope(coords2, count1, count2, dims, window, envlower, envupper);
+  bound = 0.0;
+  for (int i = count1 - 1; i >= 0; i--)
+  {
+    if (rowbound)
+      rowbound[i] = bound;
+    double d = coords_box_distance(&coords1[i * dims], &envlower[i * dims],
+      &envupper[i * dims], dims);
+    if (simfunc == FRECHET)
+      bound = Max(bound, d);
+    else /* simfunc == DYNTIMEWARP */
+      bound += d;
+  }
+  pfree(envlower); pfree(envupper);
+  return Max(result, bound);
+}
+
 /*****************************************************************************
  * Linear space computation of the similarity distance
  *****************************************************************************/
 
 /**
  * Linear space computation of the similarity distance between two temporal
- * values. Only two rows of the full matrix are used.
+ * values. Only two rows of the full matrix are used and only the cells
+ * within the band are computed. The computation is abandoned as soon as
+ * the minimum distance of a row, plus the bound of the following rows,
+ * exceeds the maximum distance.
  *
  * @param[out] dist Array keeping the distances
  * @param[in] instants1,instants2 Arrays of temporal instants
+ * @param[in] coords1,coords2 Coordinates of the instants, NULL if the
+ * distance must be computed from the instants
  * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] dims Number of coordinates of each instant
+ * @param[in] window Width of the band, a negative value means no band
+ * @param[in] maxdist Maximum distance
+ * @param[in] rowbound Bound of the rows following each row, may be NULL
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @result Similarity distance, or infinity if it exceeds maxdist
  */
 static double
-tinstarr_similarity1(double *dist, const TInstant **instants1, int count1,
-  const TInstant **instants2, int count2, SimFunc simfunc)
+tinstarr_similarity1(double *dist, const TInstant **instants1,
+  const double *coords1, int count1, const TInstant **instants2,
+  const double *coords2, int count2, int dims, int window, double maxdist,
+  const double *rowbound, SimFunc simfunc)
 {
-
+  double infinity = get_float8_infinity();
+  /* First column of the band of the two previous rows */
+  int lo1 = 0, lo2 = 0;
   for (int i = 0; i < count1; i++)
   {
-    for (int j = 0; j < count2; j++)
+    double *row = &dist[i%2 * count2];
+    const double *prevrow = &dist[(i + 1)%2 * count2];
+    int lo, hi;
+    similarity_band(i, count1, count2, window, &lo, &hi);
+    /* Reset the cells before the band that were computed two rows before,
+     * since the bands never move backwards the other ones are already reset */
+    for (int j = lo2; j < lo; j++)
+      row[j] = infinity;
+    double rowmin = infinity;
+    for (int j = lo; j <= hi; j++)
     {
-      const TInstant *inst1 = instants1[i];
-      const TInstant *inst2 = instants2[j];
-      double d = tinstant_distance(inst1, inst2);
+      double d = coords1 ?
+        coords_distance(&coords1[i * dims], &coords2[j * dims], dims) :
+        tinstant_distance(instants1[i], instants2[j]);
+      double prev;
       if (i > 0 && j > 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[i%2 * count2 + j] = Max(d,
-            Min(dist[(i - 1)%2 * count2 + j - 1],
-              Min(dist[(i - 1)%2 * count2 + j], dist[i%2 * count2 + j - 1])));
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[i%2 * count2 + j] = d +
-            Min(dist[(i - 1)%2 * count2 + j - 1],
-              Min(dist[(i - 1)%2 * count2 + j], dist[i%2 * count2 + j - 1]));
-        }
-      }
-      else if (i > 0 && j == 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[i%2 * count2] = Max(d, dist[(i - 1)%2 * count2]);
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[i%2 * count2] = d + dist[(i - 1)%2 * count2];
-        }
-      }
-      else if (i == 0 && j > 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[j] = Max(d, dist[j - 1]);
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[j] = d + dist[j - 1];
-        }
-      }
+        prev = Min(prevrow[j - 1], Min(prevrow[j], row[j - 1]));
+      else if (i > 0)
+        prev = prevrow[j];
+      else if (j > 0)
+        prev = row[j - 1];
       else /* i == 0 && j == 0 */
-      {
-        dist[0] = d;
-      }
+        prev = 0.0;
+      if (simfunc == FRECHET)
+        row[j] = Max(d, prev);
+      else /* simfunc == DYNTIMEWARP */
+        row[j] = d + prev;
+      rowmin = Min(rowmin, row[j]);
+    }
+    /* Early abandon */
+    if (maxdist < infinity)
+    {
+      double bound = rowbound ? rowbound[i] : 0.0;
+      if (MOBDB_FP_LT(maxdist,
+          simfunc == FRECHET ? Max(rowmin, bound) : rowmin + bound))
+        return infinity;
     }
+    lo2 = lo1;
+    lo1 = lo;
   }
-  return dist[(count1 - 1)%2 * count2 + count2 - 1];
+  double result = dist[(count1 - 1)%2 * count2 + count2 - 1];
+  return (result > maxdist) ? infinity : result;
 }
 
 /**
@@ -175,22 +451,56 @@ tinstarr_similarity1(double *dist, const TInstant **instants1, int count1,
  *
  * @param[in] instants1,instants2 Arrays of temporal instants
  * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] dims Number of coordinates of each instant, 0 if the distance
+ * must be computed from the instants
+ * @param[in] window Width of the band, a negative value means no band
+ * @param[in] maxdist Maximum distance, infinity means no maximum
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @pre The first array has at least as many instants as the second one
  */
 double
 tinstarr_similarity(const TInstant **instants1, int count1,
-  const TInstant **instants2, int count2, SimFunc simfunc)
+  const TInstant **instants2, int count2, int dims, int window,
+  double maxdist, SimFunc simfunc)
 {
+  double infinity = get_float8_infinity();
+  /* A band covering all the columns is the same as no band */
+  if (window >= count2)
+    window = -1;
+  double *coords1 = NULL, *coords2 = NULL, *rowbound = NULL;
+  if (dims > 0)
+  {
+    coords1 = tinstarr_coords(instants1, count1, dims);
+    coords2 = tinstarr_coords(instants2, count2, dims);
+    /* The lower bounds are only useful when there is a maximum distance */
+    if (maxdist < infinity)
+    {
+      rowbound = palloc(sizeof(double) * count1);
+      double bound = coords_similarity_bound(coords1, count1, coords2,
+        count2, dims, window, maxdist, simfunc, rowbound);
+      if (MOBDB_FP_LT(maxdist, bound))
+      {
+        pfree(coords1); pfree(coords2); pfree(rowbound);
+        return infinity;
+      }
+    }
+  }
   /* Allocate memory for two rows of the distance matrix */
   double *dist = (double *) palloc(sizeof(double) * 2 * count2);
-  /* Initialise it with -1.0 */
+  /* Initialise it with infinity, i.e., cells out of the band */
   for (int i = 0; i < 2 * count2; i++)
-    *(dist + i) = -1.0;
+    *(dist + i) = infinity;
   /* Call the linear_space computation of the similarity distance */
-  double result = tinstarr_similarity1(dist, instants1, count1, instants2,
-    count2, simfunc);
+  double result = tinstarr_similarity1(dist, instants1, coords1, count1,
+    instants2, coords2, count2, dims, window, maxdist, rowbound, simfunc);
   /* Free memory */
   pfree(dist);
+  if (coords1)
+  {
+    pfree(coords1); pfree(coords2);
+  }
+  if (rowbound)
+    pfree(rowbound);
   return result;
 }
 
@@ -199,18 +509,26 @@ tinstarr_similarity(const TInstant **instants1, int count1,
  * @brief Compute the similarity distance between two temporal values.
  *
  * @param[in] temp1,temp2 Temporal values
+ * @param[in] window Width of the Sakoe-Chiba band around the diagonal of the
+ * distance matrix, a negative value means no band
+ * @param[in] maxdist Maximum distance, infinity means no maximum
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @result Similarity distance, or infinity if it is greater than maxdist
  */
 double
-temporal_similarity(Temporal *temp1, Temporal *temp2, SimFunc simfunc)
+temporal_similarity(Temporal *temp1, Temporal *temp2, int window,
+  double maxdist, SimFunc simfunc)
 {
   double result;
   int count1, count2;
   const TInstant **instants1 = temporal_instants(temp1, &count1);
   const TInstant **instants2 = temporal_instants(temp2, &count2);
+  int dims = temporal_similarity_dims(temp1, temp2);
   result = count1 > count2 ?
-    tinstarr_similarity(instants1, count1, instants2, count2, simfunc) :
-    tinstarr_similarity(instants2, count2, instants1, count1, simfunc);
+    tinstarr_similarity(instants1, count1, instants2, count2, dims, window,
+      maxdist, simfunc) :
+    tinstarr_similarity(instants2, count2, instants1, count1, dims, window,
+      maxdist, simfunc);
   /* Free memory */
   pfree(instants1); pfree(instants2);
   return result;
@@ -450,10 +768,14 @@ temporal_similarity_ext(FunctionCallInfo fcinfo, SimFunc simfunc)
 {
   Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
   Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  int window = PG_NARGS() > 2 ? PG_GETARG_INT32(2) : -1;
+  double maxdist = PG_NARGS() > 3 ? PG_GETARG_FLOAT8(3) :
+    get_float8_infinity();
   /* Store fcinfo into a global variable for temporal geographic points */
   if (temp1->temptype == T_TGEOGPOINT)
     store_fcinfo(fcinfo);
-  double result = temporal_similarity(temp1, temp2, simfunc);
+  double result = temporal_similarity(temp1, temp2, window, maxdist,
+    simfunc);
   PG_FREE_IF_COPY(temp1, 0);
   PG_FREE_IF_COPY(temp2, 1);
   PG_RETURN_FLOAT8(result);
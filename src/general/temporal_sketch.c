@@ -0,0 +1,851 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_sketch.c
+ * @brief Approximate temporal aggregate functions based on time-bucketed
+ * sketches.
+ *
+ * The aggregates split the time line into buckets as the `time_bucket`
+ * function and keep a bounded-size sketch per bucket: a HyperLogLog sketch
+ * for the number of distinct values and a merging t-digest for the quantiles
+ * of the values of temporal numbers. The memory used by the state thus
+ * depends on the number of buckets but not on the number of input values.
+ * The sketches are mergeable so that the aggregates can be computed in
+ * parallel.
+ */
+
+#include "general/temporal_sketch.h"
+
+/* C */
+#include <assert.h>
+#include <math.h>
+/* PostgreSQL */
+#include <libpq/pqformat.h>
+#include <utils/builtins.h>
+#include <utils/typcache.h>
+/* MobilityDB */
+#include "general/temporaltypes.h"
+#include "general/tempcache.h"
+#include "general/temporal_util.h"
+#include "general/temporal_tile.h"
+
+/*****************************************************************************
+ * HyperLogLog sketch
+ *****************************************************************************/
+
+/**
+ * Add a hash value to a HyperLogLog sketch
+ *
+ * The first HLL_PRECISION bits of the hash select the register, which keeps
+ * the maximum position of the leftmost 1-bit found in the remaining bits.
+ */
+void
+hll_add(HLLSketch *hll, uint64 hash)
+{
+  int index = (int) (hash >> (64 - HLL_PRECISION));
+  uint64 bits = hash << HLL_PRECISION;
+  uint8 rank = 1;
+  while (rank <= 64 - HLL_PRECISION &&
+    ! (bits & UINT64CONST(0x8000000000000000)))
+  {
+    rank++;
+    bits <<= 1;
+  }
+  if (rank > hll->registers[index])
+    hll->registers[index] = rank;
+  return;
+}
+
+/**
+ * Merge the second HyperLogLog sketch into the first one
+ */
+static void
+hll_merge(HLLSketch *hll1, const HLLSketch *hll2)
+{
+  for (int i = 0; i < HLL_REGISTERS; i++)
+  {
+    if (hll2->registers[i] > hll1->registers[i])
+      hll1->registers[i] = hll2->registers[i];
+  }
+  return;
+}
+
+/**
+ * Return the estimated number of distinct values of a HyperLogLog sketch
+ *
+ * Small cardinalities, for which the raw estimate is biased, are estimated
+ * by linear counting of the empty registers. No correction is needed for
+ * large cardinalities since the hashes have 64 bits.
+ */
+double
+hll_estimate(const HLLSketch *hll)
+{
+  double m = (double) HLL_REGISTERS;
+  double sum = 0.0;
+  int zeros = 0;
+  for (int i = 0; i < HLL_REGISTERS; i++)
+  {
+    sum += ldexp(1.0, - (int) hll->registers[i]);
+    if (hll->registers[i] == 0)
+      zeros++;
+  }
+  double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double result = alpha * m * m / sum;
+  if (result <= 2.5 * m && zeros > 0)
+    result = m * log(m / (double) zeros);
+  return result;
+}
+
+/*****************************************************************************
+ * Merging t-digest
+ *****************************************************************************/
+
+/**
+ * Comparator for sorting the centroids of a t-digest
+ */
+static int
+tdigest_centroid_cmp(const void *c1, const void *c2)
+{
+  double m1 = ((const TDigestCentroid *) c1)->mean;
+  double m2 = ((const TDigestCentroid *) c2)->mean;
+  return (m1 < m2) ? -1 : ((m1 > m2) ? 1 : 0);
+}
+
+/**
+ * Return the largest quantile that a centroid starting at quantile q can
+ * reach, using the scale function k(q) = delta / (2 pi) * asin(2q - 1)
+ * which keeps the centroids small near the tails of the distribution
+ */
+static double
+tdigest_qlimit(double q)
+{
+  double k = TDIGEST_COMPRESSION / (2.0 * M_PI) * asin(2.0 * q - 1.0) + 1.0;
+  if (k >= TDIGEST_COMPRESSION / 4.0)
+    return 1.0;
+  return (sin(2.0 * M_PI * k / TDIGEST_COMPRESSION) + 1.0) / 2.0;
+}
+
+/**
+ * Merge the buffered values of a t-digest and, if given, the centroids and
+ * the buffered values of a second t-digest into the centroids of the first
+ * one
+ */
+static void
+tdigest_compress(TDigest *td, const TDigest *td2)
+{
+  TDigestCentroid values[2 * (TDIGEST_COMPRESSION + TDIGEST_BUFFER)];
+  int count = 0;
+  memcpy(values, td->centroids, sizeof(TDigestCentroid) * td->ncentroids);
+  count += td->ncentroids;
+  for (int i = 0; i < td->nbuffer; i++)
+  {
+    values[count].mean = td->buffer[i];
+    values[count++].weight = 1.0;
+  }
+  if (td2)
+  {
+    memcpy(&values[count], td2->centroids,
+      sizeof(TDigestCentroid) * td2->ncentroids);
+    count += td2->ncentroids;
+    for (int i = 0; i < td2->nbuffer; i++)
+    {
+      values[count].mean = td2->buffer[i];
+      values[count++].weight = 1.0;
+    }
+    if (td2->total > 0)
+    {
+      td->min = (td->total > 0) ? Min(td->min, td2->min) : td2->min;
+      td->max = (td->total > 0) ? Max(td->max, td2->max) : td2->max;
+      td->total += td2->total;
+    }
+  }
+  td->nbuffer = 0;
+  if (count == 0)
+    return;
+
+  qsort(values, (size_t) count, sizeof(TDigestCentroid),
+    &tdigest_centroid_cmp);
+  TDigestCentroid current = values[0];
+  double sofar = 0.0;
+  double qlimit = tdigest_qlimit(0.0);
+  int ncentroids = 0;
+  for (int i = 1; i < count; i++)
+  {
+    double q = (sofar + current.weight + values[i].weight) / td->total;
+    if (q <= qlimit || ncentroids == TDIGEST_COMPRESSION - 1)
+    {
+      current.weight += values[i].weight;
+      current.mean += (values[i].mean - current.mean) * values[i].weight /
+        current.weight;
+    }
+    else
+    {
+      td->centroids[ncentroids++] = current;
+      sofar += current.weight;
+      qlimit = tdigest_qlimit(sofar / td->total);
+      current = values[i];
+    }
+  }
+  td->centroids[ncentroids++] = current;
+  td->ncentroids = ncentroids;
+  return;
+}
+
+/**
+ * Add a value to a t-digest
+ */
+void
+tdigest_add(TDigest *td, double value)
+{
+  if (td->total == 0)
+    td->min = td->max = value;
+  else
+  {
+    td->min = Min(td->min, value);
+    td->max = Max(td->max, value);
+  }
+  td->total += 1.0;
+  td->buffer[td->nbuffer++] = value;
+  if (td->nbuffer == TDIGEST_BUFFER)
+    tdigest_compress(td, NULL);
+  return;
+}
+
+/**
+ * Return the estimated quantile of a t-digest
+ *
+ * The centroids are located at the rank of their center and the quantile is
+ * interpolated linearly between them and the extreme values. This yields
+ * the exact continuous percentile while all centroids are singletons, that
+ * is, for small number of values.
+ */
+double
+tdigest_quantile(TDigest *td, double fraction)
+{
+  tdigest_compress(td, NULL);
+  assert(td->ncentroids > 0);
+  double rank = fraction * (td->total - 1.0);
+  double prevrank = 0.0, prevmean = td->min, cum = 0.0;
+  for (int i = 0; i < td->ncentroids; i++)
+  {
+    const TDigestCentroid *c = &td->centroids[i];
+    double center = cum + (c->weight - 1.0) / 2.0;
+    if (rank <= center)
+    {
+      if (center <= prevrank)
+        return c->mean;
+      return prevmean + (c->mean - prevmean) * (rank - prevrank) /
+        (center - prevrank);
+    }
+    prevrank = center;
+    prevmean = c->mean;
+    cum += c->weight;
+  }
+  double lastrank = td->total - 1.0;
+  if (lastrank <= prevrank)
+    return td->max;
+  return prevmean + (td->max - prevmean) * (rank - prevrank) /
+    (lastrank - prevrank);
+}
+
+/*****************************************************************************
+ * Aggregate state
+ *****************************************************************************/
+
+/**
+ * Return the size of the sketches of the state
+ */
+static size_t
+tsketch_size(const TSketchState *state)
+{
+  return (state->type == SKETCH_HLL) ? sizeof(HLLSketch) : sizeof(TDigest);
+}
+
+/**
+ * Create an empty aggregate state
+ *
+ * @param[in] type Type of the sketches
+ * @param[in] tunits Size of the time buckets in PostgreSQL time units
+ * @param[in] torigin Origin of the time buckets
+ * @param[in] fraction Fraction of the quantiles
+ * @pre Must be called in the aggregate memory context
+ */
+static TSketchState *
+tsketch_state_make(SketchType type, int64 tunits, TimestampTz torigin,
+  double fraction)
+{
+  TSketchState *result = palloc0(sizeof(TSketchState));
+  result->type = type;
+  result->tunits = tunits;
+  result->torigin = torigin;
+  result->fraction = fraction;
+  result->maxcount = 64;
+  result->last = -1;
+  result->buckets = palloc(sizeof(SketchBucket) * result->maxcount);
+  return result;
+}
+
+/**
+ * Return the sketch of the bucket starting at a timestamp, adding the bucket
+ * if it is not yet in the state
+ *
+ * Since the input values are frequently ordered by time, the bucket of the
+ * last value added is tested before the binary search.
+ *
+ * @pre Must be called in the aggregate memory context
+ */
+static void *
+tsketch_bucket(TSketchState *state, TimestampTz t)
+{
+  if (state->last >= 0 && state->buckets[state->last].t == t)
+    return state->buckets[state->last].sketch;
+
+  int first = 0, last = state->count - 1;
+  while (first <= last)
+  {
+    int middle = (first + last) / 2;
+    if (state->buckets[middle].t == t)
+    {
+      state->last = middle;
+      return state->buckets[middle].sketch;
+    }
+    if (state->buckets[middle].t < t)
+      first = middle + 1;
+    else
+      last = middle - 1;
+  }
+
+  /* Insert a new bucket at position first */
+  if (state->count == state->maxcount)
+  {
+    state->maxcount *= 2;
+    state->buckets = repalloc(state->buckets,
+      sizeof(SketchBucket) * state->maxcount);
+  }
+  if (first < state->count)
+    memmove(&state->buckets[first + 1], &state->buckets[first],
+      sizeof(SketchBucket) * (state->count - first));
+  state->buckets[first].t = t;
+  state->buckets[first].sketch = palloc0(tsketch_size(state));
+  state->count++;
+  state->last = first;
+  return state->buckets[first].sketch;
+}
+
+/**
+ * Merge a sketch into another one of the same type
+ */
+static void
+tsketch_merge(SketchType type, void *sketch1, const void *sketch2)
+{
+  if (type == SKETCH_HLL)
+    hll_merge((HLLSketch *) sketch1, (const HLLSketch *) sketch2);
+  else
+    tdigest_compress((TDigest *) sketch1, (const TDigest *) sketch2);
+  return;
+}
+
+/**
+ * Ensure that the parameters of the aggregate are constant
+ */
+static void
+ensure_same_tsketch_params(const TSketchState *state, SketchType type,
+  int64 tunits, TimestampTz torigin, double fraction)
+{
+  if (state->type != type || state->tunits != tunits ||
+      state->torigin != torigin || state->fraction != fraction)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The parameters of the approximate aggregates must be constant")));
+  return;
+}
+
+/**
+ * Get the size and the origin of the time buckets from the arguments of the
+ * aggregate function, where the origin is optional
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] argno Argument number of the size of the buckets
+ * @param[in] state State, which keeps the default origin after the first call
+ * @param[out] tunits Size of the time buckets in PostgreSQL time units
+ * @param[out] torigin Origin of the time buckets
+ */
+static void
+tsketch_get_params(FunctionCallInfo fcinfo, int argno,
+  const TSketchState *state, int64 *tunits, TimestampTz *torigin)
+{
+  Interval *duration = PG_GETARG_INTERVAL_P(argno);
+  ensure_valid_duration(duration);
+  *tunits = get_interval_units(duration);
+  if (PG_NARGS() > argno + 1 && ! PG_ARGISNULL(argno + 1))
+    *torigin = PG_GETARG_TIMESTAMPTZ(argno + 1);
+  else if (state)
+    *torigin = state->torigin;
+  else
+    /* Same default origin as the time bucket functions */
+    *torigin = DatumGetTimestampTz(DirectFunctionCall3(timestamptz_in,
+      CStringGetDatum("2000-01-03"), ObjectIdGetDatum(InvalidOid),
+      Int32GetDatum(-1)));
+  return;
+}
+
+/**
+ * Add a hash value to the buckets of a time period
+ */
+static void
+tsketch_add_hash_period(TSketchState *state, TimestampTz lower,
+  TimestampTz upper, bool upper_inc, uint64 hash)
+{
+  TimestampTz t = timestamptz_bucket(lower, state->tunits, state->torigin);
+  TimestampTz end = timestamptz_bucket(upper, state->tunits, state->torigin);
+  /* An exclusive upper bound at the start of a bucket is not in the bucket */
+  if (! upper_inc && end == upper && end > t)
+    end -= state->tunits;
+  for ( ; t <= end; t += state->tunits)
+    hll_add((HLLSketch *) tsketch_bucket(state, t), hash);
+  return;
+}
+
+/**
+ * Add a hash value to the buckets in which a temporal value is defined
+ */
+static void
+tsketch_add_hash(TSketchState *state, const Temporal *temp, uint64 hash)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    const TInstant *inst = (const TInstant *) temp;
+    tsketch_add_hash_period(state, inst->t, inst->t, true, hash);
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    for (int i = 0; i < ti->count; i++)
+    {
+      const TInstant *inst = tinstantset_inst_n(ti, i);
+      tsketch_add_hash_period(state, inst->t, inst->t, true, hash);
+    }
+  }
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    tsketch_add_hash_period(state, seq->period.lower, seq->period.upper,
+      seq->period.upper_inc, hash);
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    for (int i = 0; i < ts->count; i++)
+    {
+      const TSequence *seq = tsequenceset_seq_n(ts, i);
+      tsketch_add_hash_period(state, seq->period.lower, seq->period.upper,
+        seq->period.upper_inc, hash);
+    }
+  }
+  return;
+}
+
+/**
+ * Add the values of the instants of a temporal number to the buckets of
+ * their timestamp
+ */
+static void
+tsketch_add_values(TSketchState *state, const Temporal *temp)
+{
+  int count;
+  const TInstant **instants = temporal_instants(temp, &count);
+  for (int i = 0; i < count; i++)
+  {
+    TimestampTz t = timestamptz_bucket(instants[i]->t, state->tunits,
+      state->torigin);
+    tdigest_add((TDigest *) tsketch_bucket(state, t),
+      tnumberinst_double(instants[i]));
+  }
+  pfree(instants);
+  return;
+}
+
+/**
+ * Return the 64-bit hash of the identifier given as second argument of the
+ * aggregate function using the extended hash function of its type
+ */
+static uint64
+tsketch_hash(FunctionCallInfo fcinfo, Datum value)
+{
+  FmgrInfo *finfo = (FmgrInfo *) fcinfo->flinfo->fn_extra;
+  if (! finfo)
+  {
+    Oid type = get_fn_expr_argtype(fcinfo->flinfo, 1);
+    TypeCacheEntry *typentry = lookup_type_cache(type,
+      TYPECACHE_HASH_EXTENDED_PROC_FINFO);
+    if (! OidIsValid(typentry->hash_extended_proc_finfo.fn_oid))
+      ereport(ERROR, (errcode(ERRCODE_UNDEFINED_FUNCTION),
+        errmsg("could not identify an extended hash function for type %s",
+          format_type_be(type))));
+    finfo = MemoryContextAlloc(fcinfo->flinfo->fn_mcxt, sizeof(FmgrInfo));
+    fmgr_info_copy(finfo, &typentry->hash_extended_proc_finfo,
+      fcinfo->flinfo->fn_mcxt);
+    fcinfo->flinfo->fn_extra = finfo;
+  }
+  uint64 hash = DatumGetUInt64(FunctionCall2Coll(finfo, PG_GET_COLLATION(),
+    value, UInt64GetDatum(0)));
+  /* Finalization of MurmurHash3 to spread the bits of weak hash functions */
+  hash ^= hash >> 33;
+  hash *= UINT64CONST(0xff51afd7ed558ccd);
+  hash ^= hash >> 33;
+  hash *= UINT64CONST(0xc4ceb9fe1a85ec53);
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/*****************************************************************************
+ * Aggregate functions
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Temporal_approx_count_distinct_transfn);
+/**
+ * Transition function for the approximate number of distinct identifiers
+ * per time bucket
+ */
+PGDLLEXPORT Datum
+Temporal_approx_count_distinct_transfn(PG_FUNCTION_ARGS)
+{
+  MemoryContext ctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    elog(ERROR, "Transition function called in non-aggregate context");
+  TSketchState *state = PG_ARGISNULL(0) ? NULL :
+    (TSketchState *) PG_GETARG_POINTER(0);
+  if (PG_ARGISNULL(1) || PG_ARGISNULL(2) || PG_ARGISNULL(3))
+  {
+    if (state)
+      PG_RETURN_POINTER(state);
+    PG_RETURN_NULL();
+  }
+
+  Temporal *temp = PG_GETARG_TEMPORAL_P(2);
+  uint64 hash = tsketch_hash(fcinfo, PG_GETARG_DATUM(1));
+  int64 tunits;
+  TimestampTz torigin;
+  tsketch_get_params(fcinfo, 3, state, &tunits, &torigin);
+  MemoryContext oldctx = MemoryContextSwitchTo(ctx);
+  if (! state)
+    state = tsketch_state_make(SKETCH_HLL, tunits, torigin, 0.0);
+  else
+    ensure_same_tsketch_params(state, SKETCH_HLL, tunits, torigin, 0.0);
+  tsketch_add_hash(state, temp, hash);
+  MemoryContextSwitchTo(oldctx);
+  PG_FREE_IF_COPY(temp, 2);
+  PG_RETURN_POINTER(state);
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_approx_percentile_transfn);
+/**
+ * Transition function for the approximate percentile of the values per time
+ * bucket
+ */
+PGDLLEXPORT Datum
+Tnumber_approx_percentile_transfn(PG_FUNCTION_ARGS)
+{
+  MemoryContext ctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    elog(ERROR, "Transition function called in non-aggregate context");
+  TSketchState *state = PG_ARGISNULL(0) ? NULL :
+    (TSketchState *) PG_GETARG_POINTER(0);
+  if (PG_ARGISNULL(1) || PG_ARGISNULL(2) || PG_ARGISNULL(3))
+  {
+    if (state)
+      PG_RETURN_POINTER(state);
+    PG_RETURN_NULL();
+  }
+
+  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  double fraction = PG_GETARG_FLOAT8(2);
+  if (fraction < 0.0 || fraction > 1.0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The fraction must be between 0 and 1")));
+  int64 tunits;
+  TimestampTz torigin;
+  tsketch_get_params(fcinfo, 3, state, &tunits, &torigin);
+  MemoryContext oldctx = MemoryContextSwitchTo(ctx);
+  if (! state)
+    state = tsketch_state_make(SKETCH_TDIGEST, tunits, torigin, fraction);
+  else
+    ensure_same_tsketch_params(state, SKETCH_TDIGEST, tunits, torigin,
+      fraction);
+  tsketch_add_values(state, temp);
+  MemoryContextSwitchTo(oldctx);
+  PG_FREE_IF_COPY(temp, 1);
+  PG_RETURN_POINTER(state);
+}
+
+PG_FUNCTION_INFO_V1(Tsketch_combinefn);
+/**
+ * Combine function for the approximate temporal aggregates
+ */
+PGDLLEXPORT Datum
+Tsketch_combinefn(PG_FUNCTION_ARGS)
+{
+  MemoryContext ctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    elog(ERROR, "Combine function called in non-aggregate context");
+  TSketchState *state1 = PG_ARGISNULL(0) ? NULL :
+    (TSketchState *) PG_GETARG_POINTER(0);
+  TSketchState *state2 = PG_ARGISNULL(1) ? NULL :
+    (TSketchState *) PG_GETARG_POINTER(1);
+  if (! state2)
+  {
+    if (state1)
+      PG_RETURN_POINTER(state1);
+    PG_RETURN_NULL();
+  }
+
+  MemoryContext oldctx = MemoryContextSwitchTo(ctx);
+  if (! state1)
+    state1 = tsketch_state_make(state2->type, state2->tunits,
+      state2->torigin, state2->fraction);
+  else
+    ensure_same_tsketch_params(state1, state2->type, state2->tunits,
+      state2->torigin, state2->fraction);
+  size_t size = tsketch_size(state1);
+  for (int i = 0; i < state2->count; i++)
+  {
+    int count = state1->count;
+    void *sketch = tsketch_bucket(state1, state2->buckets[i].t);
+    if (state1->count > count)
+      /* New bucket */
+      memcpy(sketch, state2->buckets[i].sketch, size);
+    else
+      tsketch_merge(state1->type, sketch, state2->buckets[i].sketch);
+  }
+  MemoryContextSwitchTo(oldctx);
+  PG_RETURN_POINTER(state1);
+}
+
+PG_FUNCTION_INFO_V1(Tsketch_serialize);
+/**
+ * Serialize the state of the approximate temporal aggregates
+ *
+ * Only the nonzero registers of the HyperLogLog sketches and the centroids
+ * of the t-digests are written.
+ */
+PGDLLEXPORT Datum
+Tsketch_serialize(PG_FUNCTION_ARGS)
+{
+  TSketchState *state = (TSketchState *) PG_GETARG_POINTER(0);
+  StringInfoData buf;
+  pq_begintypsend(&buf);
+  pq_sendint32(&buf, (uint32) state->type);
+  pq_sendint64(&buf, state->tunits);
+  pq_sendint64(&buf, state->torigin);
+  pq_sendfloat8(&buf, state->fraction);
+  pq_sendint32(&buf, (uint32) state->count);
+  for (int i = 0; i < state->count; i++)
+  {
+    pq_sendint64(&buf, state->buckets[i].t);
+    if (state->type == SKETCH_HLL)
+    {
+      const HLLSketch *hll = (const HLLSketch *) state->buckets[i].sketch;
+      int nonzero = 0;
+      for (int j = 0; j < HLL_REGISTERS; j++)
+      {
+        if (hll->registers[j])
+          nonzero++;
+      }
+      pq_sendint32(&buf, (uint32) nonzero);
+      for (int j = 0; j < HLL_REGISTERS; j++)
+      {
+        if (hll->registers[j])
+        {
+          pq_sendint16(&buf, (uint16) j);
+          pq_sendbyte(&buf, hll->registers[j]);
+        }
+      }
+    }
+    else
+    {
+      TDigest *td = (TDigest *) state->buckets[i].sketch;
+      tdigest_compress(td, NULL);
+      pq_sendfloat8(&buf, td->min);
+      pq_sendfloat8(&buf, td->max);
+      pq_sendfloat8(&buf, td->total);
+      pq_sendint32(&buf, (uint32) td->ncentroids);
+      for (int j = 0; j < td->ncentroids; j++)
+      {
+        pq_sendfloat8(&buf, td->centroids[j].mean);
+        pq_sendfloat8(&buf, td->centroids[j].weight);
+      }
+    }
+  }
+  PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
+PG_FUNCTION_INFO_V1(Tsketch_deserialize);
+/**
+ * Deserialize the state of the approximate temporal aggregates
+ */
+PGDLLEXPORT Datum
+Tsketch_deserialize(PG_FUNCTION_ARGS)
+{
+  MemoryContext ctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    elog(ERROR, "Deserialize function called in non-aggregate context");
+  bytea *data = PG_GETARG_BYTEA_P(0);
+  StringInfoData buf =
+  {
+    .cursor = 0,
+    .data = VARDATA(data),
+    .len = VARSIZE(data) - VARHDRSZ,
+    .maxlen = VARSIZE(data) - VARHDRSZ
+  };
+  MemoryContext oldctx = MemoryContextSwitchTo(ctx);
+  SketchType type = (SketchType) pq_getmsgint(&buf, 4);
+  int64 tunits = pq_getmsgint64(&buf);
+  TimestampTz torigin = pq_getmsgint64(&buf);
+  double fraction = pq_getmsgfloat8(&buf);
+  TSketchState *result = tsketch_state_make(type, tunits, torigin, fraction);
+  int count = pq_getmsgint(&buf, 4);
+  for (int i = 0; i < count; i++)
+  {
+    TimestampTz t = pq_getmsgint64(&buf);
+    /* The buckets are serialized in order so they are appended */
+    void *sketch = tsketch_bucket(result, t);
+    if (type == SKETCH_HLL)
+    {
+      HLLSketch *hll = (HLLSketch *) sketch;
+      int nonzero = pq_getmsgint(&buf, 4);
+      for (int j = 0; j < nonzero; j++)
+      {
+        int index = pq_getmsgint(&buf, 2);
+        hll->registers[index] = (uint8) pq_getmsgbyte(&buf);
+      }
+    }
+    else
+    {
+      TDigest *td = (TDigest *) sketch;
+      td->min = pq_getmsgfloat8(&buf);
+      td->max = pq_getmsgfloat8(&buf);
+      td->total = pq_getmsgfloat8(&buf);
+      td->ncentroids = pq_getmsgint(&buf, 4);
+      for (int j = 0; j < td->ncentroids; j++)
+      {
+        td->centroids[j].mean = pq_getmsgfloat8(&buf);
+        td->centroids[j].weight = pq_getmsgfloat8(&buf);
+      }
+    }
+  }
+  MemoryContextSwitchTo(oldctx);
+  PG_RETURN_POINTER(result);
+}
+
+/**
+ * Return the estimate of a bucket of the state
+ */
+static Datum
+tsketch_bucket_value(TSketchState *state, int i)
+{
+  if (state->type == SKETCH_HLL)
+    return Int32GetDatum((int) (hll_estimate(
+      (const HLLSketch *) state->buckets[i].sketch) + 0.5));
+  return Float8GetDatum(tdigest_quantile(
+    (TDigest *) state->buckets[i].sketch, state->fraction));
+}
+
+/**
+ * Return the estimates of the buckets of the state as a temporal value with
+ * step interpolation, where consecutive buckets are in the same sequence
+ *
+ * @param[in] state State
+ * @param[in] temptype Temporal type of the result
+ */
+static Temporal *
+tsketch_finalize(TSketchState *state, CachedType temptype)
+{
+  TInstant **instants = palloc(sizeof(TInstant *) * (state->count + 1));
+  TSequence **sequences = palloc(sizeof(TSequence *) * state->count);
+  int ninsts = 0, nseqs = 0;
+  for (int i = 0; i < state->count; i++)
+  {
+    TimestampTz t = state->buckets[i].t;
+    Datum value = tsketch_bucket_value(state, i);
+    instants[ninsts++] = tinstant_make(value, t, temptype);
+    if (i == state->count - 1 ||
+        state->buckets[i + 1].t != t + state->tunits)
+    {
+      instants[ninsts++] = tinstant_make(value, t + state->tunits, temptype);
+      sequences[nseqs++] = tsequence_make((const TInstant **) instants,
+        ninsts, true, false, STEP, NORMALIZE);
+      for (int j = 0; j < ninsts; j++)
+        pfree(instants[j]);
+      ninsts = 0;
+    }
+  }
+  pfree(instants);
+  if (nseqs == 1)
+  {
+    Temporal *result = (Temporal *) sequences[0];
+    pfree(sequences);
+    return result;
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, nseqs, NORMALIZE);
+}
+
+PG_FUNCTION_INFO_V1(Tsketch_count_finalfn);
+/**
+ * Final function for the approximate number of distinct identifiers per
+ * time bucket
+ */
+PGDLLEXPORT Datum
+Tsketch_count_finalfn(PG_FUNCTION_ARGS)
+{
+  /* The final function is strict, we do not need to test for null values */
+  TSketchState *state = (TSketchState *) PG_GETARG_POINTER(0);
+  if (state->count == 0)
+    PG_RETURN_NULL();
+  Temporal *result = tsketch_finalize(state, T_TINT);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tsketch_percentile_finalfn);
+/**
+ * Final function for the approximate percentile of the values per time
+ * bucket
+ */
+PGDLLEXPORT Datum
+Tsketch_percentile_finalfn(PG_FUNCTION_ARGS)
+{
+  /* The final function is strict, we do not need to test for null values */
+  TSketchState *state = (TSketchState *) PG_GETARG_POINTER(0);
+  if (state->count == 0)
+    PG_RETURN_NULL();
+  Temporal *result = tsketch_finalize(state, T_TFLOAT);
+  PG_RETURN_POINTER(result);
+}
+
+/*****************************************************************************/
@@ -195,6 +195,27 @@ static const IndexableFunction TNPointIndexableFunctions[] = {
   {"dwithin", DWITHIN_IDX, 3, 3},
   {NULL, 0, 0, 0}
 };
+/**
+ * Return true if the ever spatial relationship can be filtered with the
+ * segment boxes of a multi-box index on a temporal point
+ *
+ * @note If a point of the trajectory satisfies the relationship, the box of
+ * the segment containing it overlaps the box of the other argument. This is
+ * not the case for disjoint, which is therefore excluded.
+ */
+static bool
+tpoint_segment_indexable(uint16_t index, CachedType lefttype,
+  Oid opfamilyoid, Oid leftoid, Oid rightoid)
+{
+  if (index != CONTAINS_IDX && index != INTERSECTS_IDX &&
+      index != TOUCHES_IDX)
+    return false;
+  if (! tgeo_type(lefttype))
+    return false;
+  return get_opfamily_member(opfamilyoid, leftoid, rightoid,
+    RTOverlapsSegmentsStrategyNumber) != InvalidOid;
+}
+
 static int16
 temporal_get_strategy_by_type(CachedType temptype, uint16_t index)
 {
@@ -471,7 +492,8 @@ temporal_supportfn_ext(FunctionCallInfo fcinfo, TemporalFamily tempfamily)
            righttype == T_STBOX || righttype == T_TGEOMPOINT ||
            righttype == T_TGEOGPOINT || righttype == T_TNPOINT))
         exproid = type_oid(T_STBOX);
-      else
+      else if (idxfn.expand_arg || ! tpoint_segment_indexable(idxfn.index,
+          lefttype, opfamilyoid, leftoid, rightoid))
         PG_RETURN_POINTER((Node *) NULL);
 
       idxoperid = get_opfamily_member(opfamilyoid, leftoid, exproid, strategy);
@@ -479,6 +501,18 @@ temporal_supportfn_ext(FunctionCallInfo fcinfo, TemporalFamily tempfamily)
         elog(ERROR, "no operator found for '%s': opfamily %u type %d",
           idxfn.fn_name, opfamilyoid, leftoid);
 
+      /*
+       * Multi-box indexes on temporal points keep the boxes of the segments,
+       * use them to filter the (expanded) box when the operator is available
+       */
+      if (tgeo_type(lefttype))
+      {
+        Oid segoperid = get_opfamily_member(opfamilyoid, leftoid, exproid,
+          RTOverlapsSegmentsStrategyNumber);
+        if (segoperid != InvalidOid)
+          idxoperid = segoperid;
+      }
+
       /*
        * For DWithin we need to build a more complex return.
        * We want to expand the non-indexed side of the call by the
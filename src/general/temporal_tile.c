@@ -38,6 +38,7 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <assert.h>
+#include <limits.h>
 #include <float.h>
 #include <funcapi.h>
 #if POSTGRESQL_VERSION_NUMBER < 120000
@@ -564,344 +565,281 @@ Period_bucket(PG_FUNCTION_ARGS)
  *****************************************************************************/
 
 /**
- * Create the initial state that persists across multiple calls of the function
+ * Initialize the position for splitting a temporal sequence
  *
+ * @param[out] state Position to initialize
+ * @param[in] seq Temporal value
  * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] buckets Initial timestamps of the buckets
- * @param[in] fragments Fragments of the input temporal value
- * @param[in] count Number of elements in the input arrays
- *
- * @pre count is greater than 0
+ * @param[in] torigin Time origin of the tiles
  */
-TimeSplitState *
-time_split_state_make(int64 tunits, TimestampTz *buckets, Temporal **fragments,
-  int count)
+static void
+tsequence_time_split_init(SeqTimeSplitState *state, const TSequence *seq,
+  int64 tunits, TimestampTz torigin)
 {
-  assert(count > 0);
-  TimeSplitState *state = palloc0(sizeof(TimeSplitState));
-  /* Fill in state */
   state->done = false;
-  state->tunits = tunits;
-  state->buckets = buckets;
-  state->fragments = fragments;
+  state->seq = seq;
   state->i = 0;
-  state->count = count;
-  return state;
-}
-
-/**
- * Increment the current state to output the next split
- *
- * @param[in] state State to increment
- */
-void
-time_split_state_next(TimeSplitState *state)
-{
-  /* Move to the next split */
-  state->i++;
-  if (state->i == state->count)
-    state->done = true;
+  state->m = 0;
+  state->lower = timestamptz_bucket(seq->period.lower, tunits, torigin);
+  state->start = NULL;
   return;
 }
 
-/*****************************************************************************/
-
-/**
- * Split a temporal value into an array of fragments according to time buckets.
- *
- * @param[in] inst Temporal value
- * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] torigin Time origin of the tiles
- * @param[out] buckets Start timestamp of the buckets containing a fragment
- * @param[out] newcount Number of values in the output array
- */
-static TInstant **
-tinstant_time_split(const TInstant *inst, int64 tunits, TimestampTz torigin,
-  TimestampTz **buckets, int *newcount)
-{
-  TInstant **result = palloc(sizeof(TInstant *));
-  TimestampTz *times = palloc(sizeof(TimestampTz));
-  result[0] = tinstant_copy(inst);
-  times[0] = timestamptz_bucket(inst->t, tunits, torigin);
-  *buckets = times;
-  *newcount = 1;
-  return result;
-}
-
-/*****************************************************************************/
-
-/**
- * Split a temporal value into an array of fragments according to time buckets.
- *
- * @param[in] ti Temporal value
- * @param[in] start Start timestamp of the buckets
- * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] count Number of buckets
- * @param[out] buckets Start timestamp of the buckets containing a fragment
- * @param[out] newcount Number of values in the output array
- */
-static TInstantSet **
-tinstantset_time_split(const TInstantSet *ti, TimestampTz start,
-  int64 tunits, int count, TimestampTz **buckets, int *newcount)
-{
-  TInstantSet **result = palloc(sizeof(TInstantSet *) * count);
-  TimestampTz *times = palloc(sizeof(TimestampTz) * count);
-  const TInstant **instants = palloc(sizeof(TInstant *) * ti->count);
-  int i = 0,  /* counter for instants of temporal value */
-      k = 0,  /* counter for instants of next split */
-      l = 0;  /* counter for resulting fragments */
-  TimestampTz lower = start;
-  TimestampTz upper = start + tunits;
-  while (i < ti->count)
-  {
-    const TInstant *inst = tinstantset_inst_n(ti, i);
-    if (lower <= inst->t && inst->t < upper)
-    {
-      instants[k++] = inst;
-      i++;
-    }
-    else
-    {
-      if (k > 0)
-      {
-        times[l] = lower;
-        result[l++] = tinstantset_make(instants, k, MERGE_NO);
-        k = 0;
-      }
-      lower = upper;
-      upper += tunits;
-    }
-  }
-  if (k > 0)
-  {
-    times[l] = lower;
-    result[l++] = tinstantset_make(instants, k, MERGE_NO);
-  }
-  pfree(instants);
-  *buckets = times;
-  *newcount = l;
-  return result;
-}
-
-/*****************************************************************************/
-
 /**
- * Split a temporal value into an array of fragments according to period buckets.
+ * Return the fragment of a temporal sequence in the next time bucket and
+ * advance the position
  *
- * @param[in] seq Temporal value
- * @param[in] start,end Start and end timestamps of the buckets
+ * @param[inout] state Position reached in the sequence
  * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] count Number of buckets
- * @param[out] result Output array of fragments of the temporal value
- * @param[out] times Output array of bucket lower bounds
+ * @param[in] instants Buffer for the instants of the fragment, which must be
+ * able to hold the instants of the sequence plus two
  *
  * @note This function is called for each sequence of a temporal sequence set
  */
-static int
-tsequence_time_split1(const TSequence *seq, TimestampTz start, TimestampTz end,
-  int64 tunits, int count, TSequence **result, TimestampTz *times)
+static TSequence *
+tsequence_time_split_next(SeqTimeSplitState *state, int64 tunits,
+  const TInstant **instants)
 {
-  TimestampTz lower = start;
-  TimestampTz upper = lower + tunits;
-  /* This loop is needed for filtering unnecesary time buckets for the sequences
-   * composing a sequence set */
-  /* The upper bound for the bucket is exclusive => the test below is >= */
-  while (lower < end &&
-    (seq->period.lower >= upper || lower > seq->period.upper ||
-      (lower == seq->period.upper && ! seq->period.upper_inc)))
-  {
-    lower = upper;
-    upper += tunits;
-  }
-
-  const TInstant **instants = palloc(sizeof(TInstant *) * seq->count * count);
-  TInstant **tofree = palloc(sizeof(TInstant *) * seq->count * count);
+  assert(! state->done);
+  const TSequence *seq = state->seq;
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
-  int i = 0,  /* counter for instants of temporal value */
-      k = 0,  /* counter for instants of next split */
-      l = 0,  /* counter for instants to free */
-      m = 0;  /* counter for resulting fragments */
-  bool lower_inc1;
-  while (i < seq->count)
+  TimestampTz upper = state->lower + tunits;
+  TSequence *result;
+  bool lower_inc1 = (state->m == 0) ? seq->period.lower_inc : true;
+  int k = 0;  /* counter for instants of the fragment */
+  /* Reuse the end value of the previous bucket for the beginning of the bucket */
+  if (state->start)
+    instants[k++] = state->start;
+  while (state->i < seq->count)
   {
-    const TInstant *inst = tsequence_inst_n(seq, i);
-    if ((lower <= inst->t && inst->t < upper) ||
-      (inst->t == upper && (linear || i == seq->count - 1)))
+    const TInstant *inst = tsequence_inst_n(seq, state->i);
+    if ((state->lower <= inst->t && inst->t < upper) ||
+      (inst->t == upper && (linear || state->i == seq->count - 1)))
     {
       instants[k++] = inst;
-      i++;
+      state->i++;
     }
     else
     {
       assert(k > 0);
       /* Compute the value at the end of the bucket */
+      TInstant *tofree = NULL;
       if (instants[k - 1]->t < upper)
       {
         if (linear)
-          tofree[l] = tsegment_at_timestamp(instants[k - 1], inst, linear,
+          tofree = tsegment_at_timestamp(instants[k - 1], inst, linear,
             upper);
         else
         {
           /* The last two values of sequences with step interpolation and
            * exclusive upper bound must be equal */
           Datum value = tinstant_value(instants[k - 1]);
-          tofree[l] = tinstant_make(value, upper, seq->temptype);
+          tofree = tinstant_make(value, upper, seq->temptype);
         }
-        instants[k++] = tofree[l++];
+        instants[k++] = tofree;
       }
-      lower_inc1 = (m == 0) ? seq->period.lower_inc : true;
-      times[m] = lower;
-      result[m++] = tsequence_make(instants, k, lower_inc1,
+      result = tsequence_make(instants, k, lower_inc1,
          (k > 1) ? false : true, linear, NORMALIZE);
-      k = 0;
-      lower = upper;
-      upper += tunits;
-      /* The second condition is needed for filtering unnecesary buckets for the
-       * sequences composing a sequence set */
-      if (lower >= end || ! contains_period_timestamp(&seq->period, lower))
-        break;
-      /* Reuse the end value of the previous bucket for the beginning of the bucket */
-      if (lower < inst->t)
-        instants[k++] = tsequence_inst_n(result[m - 1], result[m - 1]->count - 1);
-     }
+      state->m++;
+      /* The values at the start and end of the bucket are copied into the
+       * fragment */
+      if (state->start)
+        pfree(state->start);
+      state->start = NULL;
+      if (tofree)
+        pfree(tofree);
+      state->lower = upper;
+      if (! contains_period_timestamp(&seq->period, state->lower))
+        state->done = true;
+      else if (state->lower < inst->t)
+        state->start = tinstant_copy(tsequence_inst_n(result,
+          result->count - 1));
+      return result;
+    }
   }
-  if (k > 0)
+  /* Last fragment of the sequence */
+  assert(k > 0);
+  result = tsequence_make(instants, k, lower_inc1, seq->period.upper_inc,
+    linear, NORMALIZE);
+  state->m++;
+  if (state->start)
+    pfree(state->start);
+  state->start = NULL;
+  state->done = true;
+  return result;
+}
+
+/*****************************************************************************/
+
+/**
+ * Return the fragment of a temporal value in the next time bucket
+ *
+ * @param[inout] state State of the split
+ */
+static TInstantSet *
+tinstantset_time_split_next(TimeSplitState *state)
+{
+  const TInstantSet *ti = (const TInstantSet *) state->temp;
+  TimestampTz upper = state->bucket + state->tunits;
+  int k = 0;  /* counter for instants of the fragment */
+  while (state->i < ti->count)
   {
-    lower_inc1 = (m == 0) ? seq->period.lower_inc : true;
-    times[m] = lower;
-    result[m++] = tsequence_make(instants, k, lower_inc1,
-      seq->period.upper_inc, linear, NORMALIZE);
+    const TInstant *inst = tinstantset_inst_n(ti, state->i);
+    if (inst->t >= upper)
+      break;
+    state->instants[k++] = inst;
+    state->i++;
   }
-  pfree_array((void **) tofree, l);
-  pfree(instants);
-  return m;
+  TInstantSet *result = tinstantset_make(state->instants, k, MERGE_NO);
+  /* Move to the bucket of the next instant, skipping the empty buckets */
+  if (state->i == ti->count)
+    state->done = true;
+  else
+    state->bucket = timestamptz_bucket(tinstantset_inst_n(ti, state->i)->t,
+      state->tunits, state->torigin);
+  return result;
 }
 
 /**
- * Split a temporal value into an array of fragments according to period buckets.
+ * Return the fragment of a temporal value in the next time bucket
  *
- * @param[in] seq Temporal value
- * @param[in] start,end Start and end timestamps of the buckets
- * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] count Number of buckets
- * @param[out] buckets Start timestamp of the buckets containing a fragment
- * @param[out] newcount Number of values in the output array
+ * @param[inout] state State of the split
+ *
+ * @note The fragment is composed of at most one sequence per composing
+ * sequence of the temporal value
  */
-static TSequence **
-tsequence_time_split(const TSequence *seq, TimestampTz start, TimestampTz end,
-  int64 tunits, int count, TimestampTz **buckets, int *newcount)
+static TSequenceSet *
+tsequenceset_time_split_next(TimeSplitState *state)
 {
-  TSequence **result = palloc(sizeof(TSequence *) * count);
-  TimestampTz *times = palloc(sizeof(TimestampTz) * count);
-  *newcount = tsequence_time_split1(seq, start, end, tunits, count,
-    result, times);
-  *buckets = times;
+  const TSequenceSet *ts = (const TSequenceSet *) state->temp;
+  int k = 0;  /* counter for sequences of the fragment */
+  while (state->i < ts->count && state->seqstate.lower == state->bucket)
+  {
+    state->sequences[k++] = tsequence_time_split_next(&state->seqstate,
+      state->tunits, state->instants);
+    if (state->seqstate.done && ++state->i < ts->count)
+      tsequence_time_split_init(&state->seqstate,
+        tsequenceset_seq_n(ts, state->i), state->tunits, state->torigin);
+  }
+  assert(k > 0);
+  TSequenceSet *result = tsequenceset_make(
+    (const TSequence **) state->sequences, k, NORMALIZE);
+  for (int i = 0; i < k; i++)
+    pfree(state->sequences[i]);
+  if (state->i == ts->count)
+    state->done = true;
+  else
+    state->bucket = state->seqstate.lower;
   return result;
 }
 
+/*****************************************************************************/
+
 /**
- * Split a temporal value into an array of disjoint fragments
+ * Create the initial state for splitting a temporal value with respect to
+ * period buckets
  *
- * @param[in] ts Temporal value
- * @param[in] start,end Start and end timestamps of the buckets
+ * @param[in] temp Temporal value
  * @param[in] tunits Size of the time buckets in PostgreSQL time units
- * @param[in] count Number of buckets
- * @param[out] buckets Start timestamp of the buckets containing a fragment
- * @param[out] newcount Number of values in the output array
+ * @param[in] torigin Time origin of the tiles
+ *
+ * @note The temporal value must not be freed while the state is in use
  */
-static TSequenceSet **
-tsequenceset_time_split(const TSequenceSet *ts, TimestampTz start, TimestampTz end,
-  int64 tunits, int count, TimestampTz **buckets, int *newcount)
+TimeSplitState *
+time_split_state_make(const Temporal *temp, int64 tunits, TimestampTz torigin)
 {
-  /* Singleton sequence set */
-  if (ts->count == 1)
+  TimeSplitState *state = palloc0(sizeof(TimeSplitState));
+  /* Fill in state */
+  state->done = false;
+  state->tunits = tunits;
+  state->torigin = torigin;
+  state->temp = temp;
+  state->i = 0;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    state->bucket = timestamptz_bucket(((const TInstant *) temp)->t, tunits,
+      torigin);
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    state->bucket = timestamptz_bucket(tinstantset_inst_n(ti, 0)->t, tunits,
+      torigin);
+    state->instants = palloc(sizeof(TInstant *) * ti->count);
+  }
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    tsequence_time_split_init(&state->seqstate, seq, tunits, torigin);
+    state->bucket = state->seqstate.lower;
+    /* A fragment contains at most the instants of the sequence located in
+     * its bucket plus the values at the start and at the end of the bucket */
+    state->instants = palloc(sizeof(TInstant *) * (seq->count + 2));
+  }
+  else /* temp->subtype == SEQUENCESET */
   {
-    const TSequence *seq = tsequenceset_seq_n(ts, 0);
-    TSequence **sequences = tsequence_time_split(seq, start, end, tunits,
-      count, buckets, newcount);
-    TSequenceSet **result = palloc(sizeof(TSequenceSet *) * *newcount);
-    for (int i = 0; i < *newcount; i++)
-      result[i] = tsequence_tsequenceset(sequences[i]);
-    pfree_array((void **) sequences, *newcount);
-    return result;
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    tsequence_time_split_init(&state->seqstate, tsequenceset_seq_n(ts, 0),
+      tunits, torigin);
+    state->bucket = state->seqstate.lower;
+    state->instants = palloc(sizeof(TInstant *) * (ts->totalcount + 2));
+    state->sequences = palloc(sizeof(TSequence *) * ts->count);
   }
+  return state;
+}
 
-  /* General case */
-  /* Sequences obtained by spliting one composing sequence */
-  TSequence **sequences = palloc(sizeof(TSequence *) * (ts->count * count));
-  /* Start timestamp of buckets obtained by spliting one composing sequence */
-  TimestampTz *times = palloc(sizeof(TimestampTz) * (ts->count + count));
-  /* Sequences composing the currently constructed bucket of the sequence set */
-  TSequence **fragments = palloc(sizeof(TSequence *) * (ts->count * count));
-  /* Sequences for the buckets of the sequence set */
-  TSequenceSet **result = palloc(sizeof(TSequenceSet *) * count);
-  /* Variable used to adjust the start timestamp passed to the
-   * tsequence_time_split1 function in the loop */
-  TimestampTz lower = start;
-  int k = 0, /* Number of accumulated fragments of the current time bucket */
-      m = 0; /* Number of time buckets already processed */
-  for (int i = 0; i < ts->count; i++)
+/**
+ * Return the fragment of the temporal value in the next time bucket and
+ * advance the state
+ *
+ * @param[inout] state State of the split
+ * @param[out] bucket Start timestamp of the bucket containing the fragment
+ * @result Fragment of the temporal value, or NULL when all the fragments have
+ * been returned
+ */
+Temporal *
+time_split_state_next(TimeSplitState *state, TimestampTz *bucket)
+{
+  if (state->done)
+    return NULL;
+  *bucket = state->bucket;
+  Temporal *result;
+  if (state->temp->subtype == INSTANT)
   {
-    TimestampTz upper = lower + tunits;
-    const TSequence *seq = tsequenceset_seq_n(ts, i);
-    /* Output the accumulated fragments of the current time bucket (if any)
-     * if the current sequence starts on the next time bucket */
-    if (k > 0 && seq->period.lower >= upper)
-    {
-      result[m++] = tsequenceset_make((const TSequence **) fragments, k,
-        NORMALIZE);
-      for (int j = 0; j < k; j++)
-        pfree(fragments[j]);
-      k = 0;
-      lower += tunits;
-      upper += tunits;
-    }
-    /* Number of time buckets of the current sequence */
-    int l = tsequence_time_split1(seq, lower, end, tunits, count,
-      sequences, &times[m]);
-    /* If the current sequence has produced more than two time buckets */
-    if (l > 1)
-    {
-      /* Assemble the accumulated fragments of the first time bucket (if any)  */
-      if (k > 0)
-      {
-        fragments[k++] = sequences[0];
-        result[m++] = tsequenceset_make((const TSequence **) fragments, k,
-          NORMALIZE);
-        for (int j = 0; j < k; j++)
-          pfree(fragments[j]);
-        k = 0;
-      }
-      else
-      {
-        result[m++] = tsequence_tsequenceset(sequences[0]);
-        pfree(sequences[0]);
-      }
-      for (int j = 1; j < l - 1; j++)
-      {
-        result[m++] = tsequence_tsequenceset(sequences[j]);
-        pfree(sequences[j]);
-      }
-    }
-    /* Save the last fragment in case it is necessary to assemble with the
-     * first one of the next sequence */
-    fragments[k++] = sequences[l - 1];
-    lower = times[m];
+    result = (Temporal *) tinstant_copy((const TInstant *) state->temp);
+    state->done = true;
   }
-  /* Process the accumulated fragments of the last time bucket */
-  if (k > 0)
+  else if (state->temp->subtype == INSTANTSET)
+    result = (Temporal *) tinstantset_time_split_next(state);
+  else if (state->temp->subtype == SEQUENCE)
   {
-    result[m++] = tsequenceset_make((const TSequence **) fragments, k,
-      NORMALIZE);
-    for (int j = 0; j < k; j++)
-      pfree(fragments[j]);
+    result = (Temporal *) tsequence_time_split_next(&state->seqstate,
+      state->tunits, state->instants);
+    state->done = state->seqstate.done;
+    state->bucket = state->seqstate.lower;
   }
-  pfree(sequences); pfree(fragments);
-  *buckets = times;
-  *newcount = m;
+  else /* state->temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_time_split_next(state);
   return result;
 }
 
+/**
+ * Free the state of the split
+ *
+ * @param[in] state State to free
+ */
+void
+time_split_state_free(TimeSplitState *state)
+{
+  if (state->seqstate.start)
+    pfree(state->seqstate.start);
+  if (state->instants)
+    pfree(state->instants);
+  if (state->sequences)
+    pfree(state->sequences);
+  pfree(state);
+  return;
+}
+
 /*****************************************************************************/
 
 /**
@@ -923,21 +861,17 @@ temporal_time_split(Temporal *temp, TimestampTz start, TimestampTz end,
 {
   assert(start < end);
   assert(count > 0);
-  /* Split the temporal value */
-  Temporal **fragments;
-  ensure_valid_tempsubtype(temp->subtype);
-  if (temp->subtype == INSTANT)
-    fragments = (Temporal **) tinstant_time_split((const TInstant *) temp,
-      tunits, torigin, buckets, newcount);
-  else if (temp->subtype == INSTANTSET)
-    fragments = (Temporal **) tinstantset_time_split((const TInstantSet *) temp,
-      start, tunits, count, buckets, newcount);
-  else if (temp->subtype == SEQUENCE)
-    fragments = (Temporal **) tsequence_time_split((const TSequence *) temp,
-      start, end, tunits, count, buckets, newcount);
-  else /* temp->subtype == SEQUENCESET */
-    fragments = (Temporal **) tsequenceset_time_split((const TSequenceSet *) temp,
-      start, end, tunits, count, buckets, newcount);
+  /* The temporal value has at most one fragment per bucket */
+  Temporal **fragments = palloc(sizeof(Temporal *) * count);
+  TimestampTz *times = palloc(sizeof(TimestampTz) * count);
+  TimeSplitState *state = time_split_state_make(temp, tunits, torigin);
+  int k = 0;
+  Temporal *fragment;
+  while ((fragment = time_split_state_next(state, &times[k])) != NULL)
+    fragments[k++] = fragment;
+  time_split_state_free(state);
+  *buckets = times;
+  *newcount = k;
   return fragments;
 }
 
@@ -959,7 +893,6 @@ Temporal_time_split(PG_FUNCTION_ARGS)
   if (SRF_IS_FIRSTCALL())
   {
     /* Get input parameters */
-    Temporal *temp = PG_GETARG_TEMPORAL_P(0);
     Interval *duration = PG_GETARG_INTERVAL_P(1);
     TimestampTz torigin = PG_GETARG_TIMESTAMPTZ(2);
 
@@ -972,58 +905,44 @@ Temporal_time_split(PG_FUNCTION_ARGS)
     /* Switch to memory context appropriate for multiple function calls */
     MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
 
-    /* Compute the bounds */
-    Period p;
-    temporal_period(temp, &p);
-    TimestampTz start_time = p.lower;
-    TimestampTz end_time = p.upper;
-    TimestampTz start_bucket = timestamptz_bucket(start_time, tunits,
-      torigin);
-    /* We need to add tunits to obtain the end timestamp of the last bucket */
-    TimestampTz end_bucket = timestamptz_bucket(end_time, tunits,
-      torigin) + tunits;
-    int count = (int) (((int64) end_bucket - (int64) start_bucket) / tunits);
-    /* Split the temporal value */
-    TimestampTz *buckets;
-    int newcount;
-    Temporal **fragments = temporal_time_split(temp, start_bucket,
-      end_bucket, tunits, torigin, count, &buckets, &newcount);
-    assert(newcount > 0);
+    /* The temporal value must persist across calls since the fragments are
+     * computed on demand */
+    Temporal *temp = PG_GETARG_TEMPORAL_P(0);
 
     /* Create function state */
-    funcctx->user_fctx = time_split_state_make(tunits, buckets, fragments, newcount);
+    funcctx->user_fctx = time_split_state_make(temp, tunits, torigin);
     /* Build a tuple description for the function output */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
     BlessTupleDesc(funcctx->tuple_desc);
     MemoryContextSwitchTo(oldcontext);
-    PG_FREE_IF_COPY(temp, 0);
   }
 
   /* Stuff done on every call of the function */
   funcctx = SRF_PERCALL_SETUP();
   /* Get state */
   state = funcctx->user_fctx;
+  /* Compute the next fragment in the memory context of the state */
+  MemoryContext oldcontext =
+    MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+  TimestampTz bucket;
+  Temporal *fragment = time_split_state_next(state, &bucket);
   /* Stop when we've output all the fragments */
-  if (state->done)
+  if (fragment == NULL)
   {
-    /* Switch to memory context appropriate for multiple function calls */
-    MemoryContext oldcontext =
-      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-    for (int i = 0; i < state->count; i++)
-      pfree(state->fragments[i]);
-    pfree(state);
+    time_split_state_free(state);
     MemoryContextSwitchTo(oldcontext);
     SRF_RETURN_DONE(funcctx);
   }
 
   /* Store timestamp and split */
-  tuple_arr[0] = TimestampTzGetDatum(state->buckets[state->i]);
-  tuple_arr[1] = PointerGetDatum(state->fragments[state->i]);
-  /* Advance state */
-  time_split_state_next(state);
+  tuple_arr[0] = TimestampTzGetDatum(bucket);
+  tuple_arr[1] = PointerGetDatum(fragment);
   /* Form tuple and return */
+  MemoryContextSwitchTo(oldcontext);
   tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
   result = HeapTupleGetDatum(tuple);
+  /* The fragment has been copied into the tuple */
+  pfree(fragment);
   SRF_RETURN_NEXT(funcctx, result);
 }
 
@@ -1214,49 +1133,6 @@ Tbox_multidim_tile(PG_FUNCTION_ARGS)
  * Value split functions for temporal numbers
  *****************************************************************************/
 
-/**
- * Create the initial state that persists across multiple calls of the function
- *
- * @param[in] size Size of the value buckets
- * @param[in] buckets Initial values of the buckets
- * @param[in] fragments Fragments of the input temporal value
- * @param[in] count Number of elements in the input arrays
- *
- * @pre count is greater than 0
- */
-ValueSplitState *
-value_split_state_make(Datum size, Datum *buckets, Temporal **fragments,
-  int count)
-{
-  assert(count > 0);
-  ValueSplitState *state = palloc0(sizeof(ValueSplitState));
-  /* Fill in state */
-  state->done = false;
-  state->size = size;
-  state->buckets = buckets;
-  state->fragments = fragments;
-  state->i = 0;
-  state->count = count;
-  return state;
-}
-
-/**
- * Increment the current state to output the next split
- *
- * @param[in] state State to increment
- */
-void
-value_split_state_next(ValueSplitState *state)
-{
-  /* Move to the next split */
-  state->i++;
-  if (state->i == state->count)
-    state->done = true;
-  return;
-}
-
-/*****************************************************************************/
-
 /**
  * Get the bucket number in the bucket space that contains the value
  *
@@ -1280,209 +1156,241 @@ bucket_position(Datum value, Datum size, Datum origin, CachedType type)
 /*****************************************************************************/
 
 /**
- * Split a temporal value into an array of fragments according to value buckets.
- *
- * @param[in] inst Temporal value
- * @param[in] size Size of the value buckets
- * @param[in] start_bucket Value of the start bucket
- * @param[out] buckets Start value of the buckets containing a fragment
- * @param[out] newcount Number of values in the output arrays
+ * Initialize a list of fragments
  */
-static TInstant **
-tnumberinst_value_split(const TInstant *inst, Datum start_bucket, Datum size,
-  Datum **buckets, int *newcount)
+static void
+bucket_fragments_init(BucketFragmentList *list, int maxcount, int filter)
 {
-  Datum value = tinstant_value(inst);
-  CachedType basetype = temptype_basetype(inst->temptype);
-  TInstant **result = palloc(sizeof(TInstant *));
-  Datum *values = palloc(sizeof(Datum));
-  result[0] = tinstant_copy(inst);
-  values[0] = number_bucket(value, size, start_bucket, basetype);
-  *buckets = values;
-  *newcount = 1;
-  return result;
+  list->count = 0;
+  list->maxcount = Max(maxcount, 1);
+  list->filter = filter;
+  list->next = INT_MAX;
+  list->fragments = palloc(sizeof(BucketFragment) * list->maxcount);
+  return;
 }
 
-/*****************************************************************************/
-
 /**
- * Split a temporal value into an array of fragments according to value buckets.
- *
- * @param[in] ti Temporal value
- * @param[in] size Size of the value buckets
- * @param[in] start_bucket Value of the start bucket
- * @param[in] count Number of buckets
- * @param[out] buckets Start value of the buckets containing a fragment
- * @param[out] newcount Number of values in the output arrays
+ * Determine whether the fragments of a bucket are kept in the list
  */
-static TInstantSet **
-tnumberinstset_value_split(const TInstantSet *ti, Datum start_bucket, Datum size,
-  int count, Datum **buckets, int *newcount)
+static bool
+bucket_fragments_wanted(BucketFragmentList *list, int bucket_no)
 {
-  CachedType basetype = temptype_basetype(ti->temptype);
-  TInstantSet **result;
-  Datum *values, value, bucket_value;
+  if (list->filter < 0 || bucket_no == list->filter)
+    return true;
+  if (bucket_no > list->filter && bucket_no < list->next)
+    list->next = bucket_no;
+  return false;
+}
 
-  /* Singleton instant set */
-  if (ti->count == 1)
+/**
+ * Add a fragment to the list
+ */
+static void
+bucket_fragments_add(BucketFragmentList *list, int bucket_no, Temporal *temp)
+{
+  if (list->count == list->maxcount)
   {
-    result = palloc(sizeof(TInstantSet *));
-    values = palloc(sizeof(Datum));
-    result[0] = tinstantset_copy(ti);
-    value = tinstant_value(tinstantset_inst_n(ti, 0));
-    values[0] = number_bucket(value, size, start_bucket, basetype);
-    *buckets = values;
-    *newcount = 1;
-    return result;
+    list->maxcount *= 2;
+    list->fragments = repalloc(list->fragments,
+      sizeof(BucketFragment) * list->maxcount);
   }
+  BucketFragment *frag = &list->fragments[list->count];
+  frag->bucket_no = bucket_no;
+  frag->seqno = list->count++;
+  frag->temp = temp;
+  return;
+}
 
-  /* General case */
-  const TInstant **instants = palloc(sizeof(TInstant *) * ti->count * count);
-  /* palloc0 to initialize the counters to 0 */
-  int *numinsts = palloc0(sizeof(int) * count);
-  for (int i = 0; i < ti->count; i++)
-  {
-    const TInstant *inst = tinstantset_inst_n(ti, i);
-    value = tinstant_value(inst);
-    bucket_value = number_bucket(value, size, start_bucket, basetype);
-    int bucket_no = bucket_position(bucket_value, size, start_bucket, basetype);
-    int inst_no = numinsts[bucket_no]++;
-    instants[bucket_no * ti->count + inst_no] = inst;
-  }
-  /* Assemble the result for each value bucket */
-  result = palloc(sizeof(TInstantSet *) * count);
-  values = palloc(sizeof(Datum) * count);
-  int k = 0;
-  bucket_value = start_bucket;
-  for (int i = 0; i < count; i++)
+/**
+ * Comparator function for fragments, which are sorted by bucket and then in
+ * the order in which they were obtained
+ */
+static int
+bucket_fragment_cmp(const void *a, const void *b)
+{
+  const BucketFragment *frag1 = (const BucketFragment *) a;
+  const BucketFragment *frag2 = (const BucketFragment *) b;
+  if (frag1->bucket_no != frag2->bucket_no)
+    return (frag1->bucket_no < frag2->bucket_no) ? -1 : 1;
+  return (frag1->seqno < frag2->seqno) ? -1 :
+    ((frag1->seqno > frag2->seqno) ? 1 : 0);
+}
+
+/**
+ * Sort the fragments of the list by bucket and return the number of distinct
+ * buckets
+ */
+static int
+bucket_fragments_sort(BucketFragmentList *list)
+{
+  if (list->count > 1)
+    qsort(list->fragments, (size_t) list->count, sizeof(BucketFragment),
+      bucket_fragment_cmp);
+  int result = 0;
+  for (int i = 0; i < list->count; i++)
   {
-    if (numinsts[i] > 0)
-    {
-      result[k] = tinstantset_make(&instants[i * ti->count], numinsts[i], MERGE_NO);
-      values[k++] = bucket_value;
-    }
-    bucket_value = datum_add(bucket_value, size, basetype, basetype);
+    if (i == 0 ||
+        list->fragments[i].bucket_no != list->fragments[i - 1].bucket_no)
+      result++;
   }
-  pfree(instants);
-  pfree(numinsts);
-  *buckets = values;
-  *newcount = k;
   return result;
 }
 
-/*****************************************************************************/
+/**
+ * Return the start value of a bucket given by its number
+ */
+static Datum
+bucket_value_n(Datum start_bucket, Datum size, int bucket_no,
+  CachedType basetype)
+{
+  ensure_tnumber_basetype(basetype);
+  if (basetype == T_INT4)
+    return Int32GetDatum(DatumGetInt32(start_bucket) +
+      bucket_no * DatumGetInt32(size));
+  else /* basetype == T_FLOAT8 */
+    return Float8GetDatum(DatumGetFloat8(start_bucket) +
+      bucket_no * DatumGetFloat8(size));
+}
+
+/**
+ * Get the bucket number of a value
+ */
+static int
+value_bucket_no(Datum value, Datum start_bucket, Datum size,
+  CachedType basetype)
+{
+  Datum bucket_value = number_bucket(value, size, start_bucket, basetype);
+  return bucket_position(bucket_value, size, start_bucket, basetype);
+}
+
+/*****************************************************************************/
+
+/**
+ * Split a temporal value into fragments according to value buckets.
+ *
+ * @param[inout] list List of fragments
+ * @param[in] inst Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ */
+static void
+tnumberinst_value_split(BucketFragmentList *list, const TInstant *inst,
+  Datum start_bucket, Datum size)
+{
+  CachedType basetype = temptype_basetype(inst->temptype);
+  int bucket_no = value_bucket_no(tinstant_value(inst), start_bucket, size,
+    basetype);
+  if (bucket_fragments_wanted(list, bucket_no))
+    bucket_fragments_add(list, bucket_no, (Temporal *) inst);
+  return;
+}
+
+/**
+ * Split a temporal value into fragments according to value buckets.
+ *
+ * @param[inout] list List of fragments
+ * @param[in] ti Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ */
+static void
+tnumberinstset_value_split(BucketFragmentList *list, const TInstantSet *ti,
+  Datum start_bucket, Datum size)
+{
+  for (int i = 0; i < ti->count; i++)
+    tnumberinst_value_split(list, tinstantset_inst_n(ti, i), start_bucket,
+      size);
+  return;
+}
+
+/*****************************************************************************/
 
 /**
- * Split a temporal value into an array of fragments according to value buckets.
+ * Split a temporal value into fragments according to value buckets.
  *
- * @param[inout] result Array containing the fragments of each bucket
- * @param[inout] numseqs Number of fragments for each bucket
- * @param[in] numcols Number of columns in the 2D pointer array. It can be
- *    seq->count for sequences or ts->totalcount for sequence sets
+ * @param[inout] list List of fragments
  * @param[in] seq Temporal value
  * @param[in] start_bucket Value of the start bucket
  * @param[in] size Size of the value buckets
- * @param[in] count Number of buckets
  */
 static void
-tnumberseq_step_value_split(TSequence **result, int *numseqs, int numcols,
-  const TSequence *seq, Datum start_bucket, Datum size, int count)
+tnumberseq_step_value_split(BucketFragmentList *list, const TSequence *seq,
+  Datum start_bucket, Datum size)
 {
   assert(! MOBDB_FLAGS_GET_LINEAR(seq->flags));
   CachedType basetype = temptype_basetype(seq->temptype);
-  Datum value, bucket_value;
-  int bucket_no, seq_no;
+  Datum value;
+  int bucket_no;
 
   /* Instantaneous sequence */
   if (seq->count == 1)
   {
     value = tinstant_value(tsequence_inst_n(seq, 0));
-    bucket_value = number_bucket(value, size, start_bucket, basetype);
-    bucket_no = bucket_position(bucket_value, size, start_bucket, basetype);
-    seq_no = numseqs[bucket_no]++;
-    result[bucket_no * numcols + seq_no] = tsequence_copy(seq);
+    bucket_no = value_bucket_no(value, start_bucket, size, basetype);
+    if (bucket_fragments_wanted(list, bucket_no))
+      bucket_fragments_add(list, bucket_no, (Temporal *) tsequence_copy(seq));
     return;
   }
 
   /* General case */
-  TInstant **tofree = palloc(sizeof(TInstant *) * count * seq->count);
-  int l = 0;   /* counter for the instants to free */
   const TInstant *inst1;
   for (int i = 1; i < seq->count; i++)
   {
     inst1 = tsequence_inst_n(seq, i - 1);
     value = tinstant_value(inst1);
-    bucket_value = number_bucket(value, size, start_bucket, basetype);
-    bucket_no = bucket_position(bucket_value, size, start_bucket, basetype);
-    seq_no = numseqs[bucket_no]++;
+    bucket_no = value_bucket_no(value, start_bucket, size, basetype);
+    if (! bucket_fragments_wanted(list, bucket_no))
+      continue;
     const TInstant *inst2 = tsequence_inst_n(seq, i);
     bool lower_inc1 = (i == 1) ? seq->period.lower_inc : true;
     TInstant *bounds[2];
     bounds[0] = (TInstant *) inst1;
-    int k = 1;
-    if (i < seq->count)
-    {
-      tofree[l++] = bounds[1] = tinstant_make(value, inst2->t, seq->temptype);
-      k++;
-    }
-    result[bucket_no * numcols + seq_no] = tsequence_make((const TInstant **) bounds,
-      k, lower_inc1, false, STEP, NORMALIZE);
-    bounds[0] = bounds[1];
-    inst1 = inst2;
-    lower_inc1 = true;
+    bounds[1] = tinstant_make(value, inst2->t, seq->temptype);
+    bucket_fragments_add(list, bucket_no, (Temporal *) tsequence_make(
+      (const TInstant **) bounds, 2, lower_inc1, false, STEP, NORMALIZE));
+    pfree(bounds[1]);
   }
   /* Last value if upper inclusive */
   if (seq->period.upper_inc)
   {
     inst1 = tsequence_inst_n(seq, seq->count - 1);
     value = tinstant_value(inst1);
-    bucket_value = number_bucket(value, size, start_bucket, basetype);
-    bucket_no = bucket_position(bucket_value, size, start_bucket, basetype);
-    seq_no = numseqs[bucket_no]++;
-    result[bucket_no * numcols + seq_no] = tsequence_make(&inst1, 1,
-      true, true, STEP, NORMALIZE);
+    bucket_no = value_bucket_no(value, start_bucket, size, basetype);
+    if (bucket_fragments_wanted(list, bucket_no))
+      bucket_fragments_add(list, bucket_no, (Temporal *) tsequence_make(
+        &inst1, 1, true, true, STEP, NORMALIZE));
   }
-  pfree_array((void **) tofree, l);
   return;
 }
 
-/*****************************************************************************/
-
 /**
- * Split a temporal value into an array of fragments according to value buckets.
+ * Split a temporal value into fragments according to value buckets.
  *
- * @param[inout] result Array containing the fragments of each bucket
- * @param[inout] numseqs Number of fragments for each bucket
- * @param[in] numcols Number of columns in the 2D pointer array. It can be
- *    seq->count for sequences or ts->totalcount for sequence sets
+ * @param[inout] list List of fragments
  * @param[in] seq Temporal value
  * @param[in] start_bucket Value of the start bucket
  * @param[in] size Size of the value buckets
- * @param[in] count Number of buckets
  */
 static void
-tnumberseq_linear_value_split(TSequence **result, int *numseqs, int numcols,
-  const TSequence *seq, Datum start_bucket, Datum size, int count)
+tnumberseq_linear_value_split(BucketFragmentList *list, const TSequence *seq,
+  Datum start_bucket, Datum size)
 {
   assert(MOBDB_FLAGS_GET_LINEAR(seq->flags));
   CachedType basetype = temptype_basetype(seq->temptype);
   Datum value1, bucket_value1;
-  int bucket_no1, seq_no;
+  int bucket_no1;
 
   /* Instantaneous sequence */
   if (seq->count == 1)
   {
     value1 = tinstant_value(tsequence_inst_n(seq, 0));
-    bucket_value1 = number_bucket(value1, size, start_bucket, basetype);
-    bucket_no1 = bucket_position(bucket_value1, size, start_bucket, basetype);
-    seq_no = numseqs[bucket_no1]++;
-    result[bucket_no1 * numcols + seq_no] = tsequence_copy(seq);
+    bucket_no1 = value_bucket_no(value1, start_bucket, size, basetype);
+    if (bucket_fragments_wanted(list, bucket_no1))
+      bucket_fragments_add(list, bucket_no1, (Temporal *) tsequence_copy(seq));
     return;
   }
 
   /* General case */
-  TInstant **tofree = palloc(sizeof(TInstant *) * seq->count * count);
-  int l = 0;   /* counter for the instants to free */
   const TInstant *inst1 = tsequence_inst_n(seq, 0);
   value1 = tinstant_value(inst1);
   bucket_value1 = number_bucket(value1, size, start_bucket, basetype);
@@ -1531,10 +1439,14 @@ tnumberseq_linear_value_split(TSequence **result, int *numseqs, int numcols,
     RangeType *segrange = range_make(min_value, max_value, lower_inc1, upper_inc1, basetype);
     TInstant *bounds[2];
     bounds[first] = incr ? (TInstant *) inst1 : (TInstant *) inst2;
+    /* Instants computed for the bucket bounds, which are freed as soon as
+     * they are no longer needed */
+    TInstant *tofree1 = NULL, *tofree2 = NULL;
     Datum bucket_lower = incr ? bucket_value1 : bucket_value2;
     Datum bucket_upper = datum_add(bucket_lower, size, basetype, basetype);
     for (int j = first_bucket; j <= last_bucket; j++)
     {
+      tofree2 = NULL;
       /* Choose between interpolate or take one of the segment ends */
       if (datum_lt(min_value, bucket_upper, basetype) &&
         datum_lt(bucket_upper, max_value, basetype))
@@ -1545,7 +1457,7 @@ tnumberseq_linear_value_split(TSequence **result, int *numseqs, int numcols,
         Datum projvalue;
         tlinearsegm_intersection_value(inst1, inst2, bucket_upper, basetype,
           &projvalue, &t);
-        tofree[l++] = bounds[last] =  RANGE_ROUNDOFF ?
+        tofree2 = bounds[last] =  RANGE_ROUNDOFF ?
           tinstant_make(bucket_upper, t, seq->temptype) :
           tinstant_make(projvalue, t, seq->temptype);
       }
@@ -1580,166 +1492,275 @@ tnumberseq_linear_value_split(TSequence **result, int *numseqs, int numcols,
       /* We cannot add to last bucket if last instant has exclusive bound */
       if (k == 1 && ! upper_inc1)
         break;
-      seq_no = numseqs[j]++;
-      result[j * numcols + seq_no] = tsequence_make((const TInstant **) bounds,
-        k, (k > 1) ? lower_inc1 : true, (k > 1) ? upper_inc1 : true,
-        LINEAR, NORMALIZE_NO);
+      if (bucket_fragments_wanted(list, j))
+        bucket_fragments_add(list, j, (Temporal *) tsequence_make(
+          (const TInstant **) bounds, k, (k > 1) ? lower_inc1 : true,
+          (k > 1) ? upper_inc1 : true, LINEAR, NORMALIZE_NO));
+      if (tofree1)
+        pfree(tofree1);
+      tofree1 = tofree2;
       bounds[first] = bounds[last];
       bucket_lower = bucket_upper;
       bucket_upper = datum_add(bucket_upper, size, basetype, basetype);
     }
+    if (tofree1)
+      pfree(tofree1);
+    if (tofree2 && tofree2 != tofree1)
+      pfree(tofree2);
     pfree(segrange);
     inst1 = inst2;
     value1 = value2;
     bucket_value1 = bucket_value2;
     bucket_no1 = bucket_no2;
   }
-  pfree_array((void **) tofree, l);
   return;
 }
 
 /*****************************************************************************/
 
 /**
- * Split a temporal value into an array of fragments according to value buckets.
+ * Split a temporal value into fragments according to value buckets.
  *
+ * @param[inout] list List of fragments
  * @param[in] seq Temporal value
  * @param[in] start_bucket Value of the start bucket
  * @param[in] size Size of the value buckets
- * @param[in] count Number of buckets
- * @param[out] buckets Start value of the buckets containing the fragments
- * @param[out] newcount Number of elements in output arrays
  */
-static TSequenceSet **
-tnumberseq_value_split(const TSequence *seq, Datum start_bucket, Datum size,
-  int count, Datum **buckets, int *newcount)
+static void
+tnumberseq_value_split(BucketFragmentList *list, const TSequence *seq,
+  Datum start_bucket, Datum size)
 {
-  CachedType basetype = temptype_basetype(seq->temptype);
-  /* Instantaneous sequence */
-  if (seq->count == 1)
+  if (MOBDB_FLAGS_GET_LINEAR(seq->flags))
+    tnumberseq_linear_value_split(list, seq, start_bucket, size);
+  else
+    tnumberseq_step_value_split(list, seq, start_bucket, size);
+  return;
+}
+
+/**
+ * Split a temporal value into fragments according to value buckets.
+ *
+ * @param[inout] list List of fragments
+ * @param[in] ts Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ */
+static void
+tnumberseqset_value_split(BucketFragmentList *list, const TSequenceSet *ts,
+  Datum start_bucket, Datum size)
+{
+  for (int i = 0; i < ts->count; i++)
+    tnumberseq_value_split(list, tsequenceset_seq_n(ts, i), start_bucket,
+      size);
+  return;
+}
+
+/**
+ * Split a temporal value into fragments according to value buckets.
+ *
+ * @param[inout] list List of fragments
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ */
+static void
+tnumber_value_split1(BucketFragmentList *list, const Temporal *temp,
+  Datum start_bucket, Datum size)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    tnumberinst_value_split(list, (const TInstant *) temp, start_bucket, size);
+  else if (temp->subtype == INSTANTSET)
+    tnumberinstset_value_split(list, (const TInstantSet *) temp, start_bucket,
+      size);
+  else if (temp->subtype == SEQUENCE)
+    tnumberseq_value_split(list, (const TSequence *) temp, start_bucket, size);
+  else /* temp->subtype == SEQUENCESET */
+    tnumberseqset_value_split(list, (const TSequenceSet *) temp, start_bucket,
+      size);
+  return;
+}
+
+/**
+ * Assemble the fragments of a temporal number in the value bucket of the
+ * fragment at the given position of the list, which must be sorted, and
+ * advance the position to the fragment of the next bucket
+ *
+ * @param[in] list List of fragments
+ * @param[in] temp Temporal value
+ * @param[inout] i Position of the first fragment of the bucket
+ * @param[out] bucket_no Number of the bucket
+ * @note The sequences of the bucket, which have been created by the split,
+ * are freed
+ */
+static Temporal *
+bucket_fragments_assemble(BucketFragmentList *list, const Temporal *temp,
+  int *i, int *bucket_no)
+{
+  int first = *i;
+  *bucket_no = list->fragments[first].bucket_no;
+  int last = first;
+  while (last < list->count && list->fragments[last].bucket_no == *bucket_no)
+    last++;
+  int l = last - first;
+  Temporal **temps = palloc(sizeof(Temporal *) * l);
+  for (int j = 0; j < l; j++)
+    temps[j] = list->fragments[first + j].temp;
+  Temporal *result;
+  if (temp->subtype == INSTANT)
+    result = (Temporal *) tinstant_copy((const TInstant *) temps[0]);
+  else if (temp->subtype == INSTANTSET)
+    result = (Temporal *) tinstantset_make((const TInstant **) temps, l,
+      MERGE_NO);
+  else
   {
-    TSequenceSet **result = palloc(sizeof(TSequenceSet *));
-    Datum *values = palloc(sizeof(Datum));
-    result[0] = tsequence_tsequenceset(seq);
-    Datum value = tinstant_value(tsequence_inst_n(seq, 0));
-    values[0] = number_bucket(value, size, start_bucket, basetype);
-    *buckets = values;
-    *newcount = 1;
-    return result;
+    result = (Temporal *) tsequenceset_make((const TSequence **) temps, l,
+      NORMALIZE);
+    /* The instants of the list are those of the temporal value while the
+     * sequences have been created by the split */
+    for (int j = 0; j < l; j++)
+      pfree(temps[j]);
   }
+  pfree(temps);
+  *i = last;
+  return result;
+}
 
-  /* General case */
-  TSequence **sequences = palloc(sizeof(TSequence *) * seq->count * count);
-  /* palloc0 to initialize the counters to 0 */
-  int *numseqs = palloc0(sizeof(int) * count);
-  if (MOBDB_FLAGS_GET_LINEAR(seq->flags))
-    tnumberseq_linear_value_split(sequences, numseqs, seq->count, seq,
-      start_bucket, size, count);
-  else
-    tnumberseq_step_value_split(sequences, numseqs, seq->count, seq,
-      start_bucket, size, count);
-  /* Assemble the result for each value bucket */
-  TSequenceSet **result = palloc(sizeof(TSequenceSet *) * count);
-  Datum *values = palloc(sizeof(Datum) * count);
-  Datum bucket_value = start_bucket;
-  int k = 0;
-  for (int i = 0; i < count; i++)
+/**
+ * Assemble the fragments of a temporal number for each value bucket
+ *
+ * @param[in] list List of fragments, which is freed by the function
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ * @param[out] buckets Start value of the buckets containing the fragments
+ * @param[out] newcount Number of elements in output arrays
+ */
+static Temporal **
+tnumber_value_split_assemble(BucketFragmentList *list, const Temporal *temp,
+  Datum start_bucket, Datum size, Datum **buckets, int *newcount)
+{
+  CachedType basetype = temptype_basetype(temp->temptype);
+  int count = bucket_fragments_sort(list);
+  Temporal **result = palloc(sizeof(Temporal *) * Max(count, 1));
+  Datum *values = palloc(sizeof(Datum) * Max(count, 1));
+  int i = 0, k = 0;
+  while (i < list->count)
   {
-    if (numseqs[i] > 0)
-    {
-      result[k] = tsequenceset_make((const TSequence **)(&sequences[seq->count * i]),
-        numseqs[i], NORMALIZE);
-      values[k++] = bucket_value;
-    }
-    bucket_value = datum_add(bucket_value, size, basetype, basetype);
+    int bucket_no;
+    result[k] = bucket_fragments_assemble(list, temp, &i, &bucket_no);
+    values[k++] = bucket_value_n(start_bucket, size, bucket_no, basetype);
   }
-  pfree(sequences);
-  pfree(numseqs);
+  pfree(list->fragments);
   *buckets = values;
   *newcount = k;
-  return result;}
+  return result;
+}
 
 /*****************************************************************************/
 
 /**
- * Split a temporal value into an array of fragments according to value buckets.
+ * @ingroup libmeos_temporal_tiling
+ * @brief Split a temporal number into fragments with respect to value buckets
  *
- * @param[in] ts Temporal value
- * @param[in] start_bucket Start value of the first bucket
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
  * @param[in] size Size of the value buckets
  * @param[in] count Number of buckets
  * @param[out] buckets Start value of the buckets containing the fragments
  * @param[out] newcount Number of values in the output arrays
  */
-static TSequenceSet **
-tnumberseqset_value_split(const TSequenceSet *ts, Datum start_bucket, Datum size,
+Temporal **
+tnumber_value_split(Temporal *temp, Datum start_bucket, Datum size,
   int count, Datum **buckets, int *newcount)
 {
-  /* Singleton sequence set */
-  if (ts->count == 1)
-    return tnumberseq_value_split(tsequenceset_seq_n(ts, 0), start_bucket, size,
-      count, buckets, newcount);
+  assert(count > 0);
+  BucketFragmentList list;
+  bucket_fragments_init(&list, temporal_num_instants(temp), -1);
+  tnumber_value_split1(&list, temp, start_bucket, size);
+  return tnumber_value_split_assemble(&list, temp, start_bucket, size,
+    buckets, newcount);
+}
 
-  /* General case */
-  CachedType basetype = temptype_basetype(ts->temptype);
-  TSequence **bucketseqs = palloc(sizeof(TSequence *) * ts->totalcount * count);
-  /* palloc0 to initialize the counters to 0 */
-  int *numseqs = palloc0(sizeof(int) * count);
-  for (int i = 0; i < ts->count; i++)
+/*****************************************************************************/
+
+/**
+ * Create the initial state for splitting a temporal number with respect to
+ * value buckets
+ *
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ *
+ * @note The temporal value must not be freed while the state is in use
+ */
+ValueSplitState *
+value_split_state_make(const Temporal *temp, Datum start_bucket, Datum size)
+{
+  ValueSplitState *state = palloc0(sizeof(ValueSplitState));
+  /* Fill in state */
+  state->done = false;
+  state->size = size;
+  state->start_bucket = start_bucket;
+  state->temp = temp;
+  state->bucket_no = 0;
+  return state;
+}
+
+/**
+ * Return the fragment of the temporal number in the next value bucket and
+ * advance the state
+ *
+ * @param[inout] state State of the split
+ * @param[out] bucket Start value of the bucket containing the fragment
+ * @result Fragment of the temporal number, or NULL when all the fragments
+ * have been returned
+ *
+ * @note Each call traverses the temporal number keeping only the fragments
+ * of the current bucket while recording the next bucket that it traverses,
+ * so that the empty buckets are skipped. The memory used is thus bounded by
+ * the fragments of a single bucket and the traversals stop as soon as the
+ * caller stops asking for fragments, at the price of one traversal of the
+ * temporal number per bucket that it traverses.
+ */
+Temporal *
+value_split_state_next(ValueSplitState *state, Datum *bucket)
+{
+  while (! state->done)
   {
-    const TSequence *seq = tsequenceset_seq_n(ts, i);
-    if (MOBDB_FLAGS_GET_LINEAR(ts->flags))
-      tnumberseq_linear_value_split(bucketseqs, numseqs, ts->totalcount, seq,
-        start_bucket, size, count);
+    BucketFragmentList list;
+    bucket_fragments_init(&list, 8, state->bucket_no);
+    tnumber_value_split1(&list, state->temp, state->start_bucket,
+      state->size);
+    if (list.next == INT_MAX)
+      state->done = true;
     else
-      tnumberseq_step_value_split(bucketseqs, numseqs, ts->totalcount, seq,
-        start_bucket, size, count);
-  }
-  /* Assemble the result for each value bucket */
-  TSequenceSet **result = palloc(sizeof(TSequenceSet *) * count);
-  Datum *values = palloc(sizeof(Datum) * count);
-  Datum bucket_value = start_bucket;
-  int k = 0;
-  for (int i = 0; i < count; i++)
-  {
-    if (numseqs[i] > 0)
+      state->bucket_no = list.next;
+    if (list.count > 0)
     {
-      result[k] = tsequenceset_make((const TSequence **)(&bucketseqs[i * ts->totalcount]),
-        numseqs[i], NORMALIZE);
-      values[k++] = bucket_value;
+      int i = 0, bucket_no;
+      Temporal *result = bucket_fragments_assemble(&list, state->temp, &i,
+        &bucket_no);
+      *bucket = bucket_value_n(state->start_bucket, state->size, bucket_no,
+        temptype_basetype(state->temp->temptype));
+      pfree(list.fragments);
+      return result;
     }
-    bucket_value = datum_add(bucket_value, size, basetype, basetype);
+    pfree(list.fragments);
   }
-  pfree(bucketseqs);
-  pfree(numseqs);
-  *buckets = values;
-  *newcount = k;
-  return result;
+  return NULL;
 }
 
-/*****************************************************************************/
-
-Temporal **
-tnumber_value_split(Temporal *temp, Datum start_bucket, Datum size,
-  int count, Datum **buckets, int *newcount)
+/**
+ * Free the state of the split
+ *
+ * @param[in] state State to free
+ */
+void
+value_split_state_free(ValueSplitState *state)
 {
-  assert(count > 0);
-  /* Split the temporal value */
-  Temporal **fragments;
-  ensure_valid_tempsubtype(temp->subtype);
-  if (temp->subtype == INSTANT)
-    fragments = (Temporal **) tnumberinst_value_split((const TInstant *) temp,
-      start_bucket, size, buckets, newcount);
-  else if (temp->subtype == INSTANTSET)
-    fragments = (Temporal **) tnumberinstset_value_split((const TInstantSet *) temp,
-      start_bucket, size, count, buckets, newcount);
-  else if (temp->subtype == SEQUENCE)
-    fragments = (Temporal **) tnumberseq_value_split((const TSequence *) temp,
-      start_bucket, size, count, buckets, newcount);
-  else /* temp->subtype == SEQUENCESET */
-    fragments = (Temporal **) tnumberseqset_value_split((const TSequenceSet *) temp,
-      start_bucket, size, count, buckets, newcount);
-  return fragments;
+  pfree(state);
+  return;
 }
 
 PG_FUNCTION_INFO_V1(Tnumber_value_split);
@@ -1759,7 +1780,13 @@ Tnumber_value_split(PG_FUNCTION_ARGS)
   /* If the function is being called for the first time */
   if (SRF_IS_FIRSTCALL())
   {
-    /* Get input parameters */
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+    /* Get input parameters. The temporal value must persist across calls
+     * since the fragments are computed on demand */
     Temporal *temp = PG_GETARG_TEMPORAL_P(0);
     Datum size = PG_GETARG_DATUM(1);
     Datum origin = PG_GETARG_DATUM(2);
@@ -1768,65 +1795,45 @@ Tnumber_value_split(PG_FUNCTION_ARGS)
     CachedType basetype = temptype_basetype(temp->temptype);
     ensure_positive_datum(size, basetype);
 
-    /* Initialize the FuncCallContext */
-    funcctx = SRF_FIRSTCALL_INIT();
-    /* Switch to memory context appropriate for multiple function calls */
-    MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-
     /* Compute the value bounds */
     RangeType *range = tnumber_range((const Temporal *) temp);
     Datum start_value = lower_datum(range);
-    /* We need to add size to obtain the end value of the last bucket */
-    Datum end_value = datum_add(upper_datum(range), size, basetype, basetype);
     Datum start_bucket = number_bucket(start_value, size, origin, basetype);
-    Datum end_bucket = number_bucket(end_value, size, origin, basetype);
-    int count = (basetype == T_INT4) ?
-      (DatumGetInt32(end_bucket) - DatumGetInt32(start_bucket)) /
-        DatumGetInt32(size) :
-      floor((DatumGetFloat8(end_bucket) - DatumGetFloat8(start_bucket)) /
-        DatumGetFloat8(size));
-
-    /* Split the temporal value */
-    Datum *buckets;
-    int newcount;
-    Temporal **fragments = tnumber_value_split(temp, start_bucket, size,
-      count, &buckets, &newcount);
-    assert(newcount > 0);
+    pfree(range);
 
     /* Create function state */
-    funcctx->user_fctx = value_split_state_make(size, buckets, fragments, newcount);
+    funcctx->user_fctx = value_split_state_make(temp, start_bucket, size);
     /* Build a tuple description for the function output */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
     BlessTupleDesc(funcctx->tuple_desc);
     MemoryContextSwitchTo(oldcontext);
-    PG_FREE_IF_COPY(temp, 0);
   }
 
   /* Stuff done on every call of the function */
   funcctx = SRF_PERCALL_SETUP();
   /* Get state */
   state = funcctx->user_fctx;
+  /* Compute the next fragment in the memory context of the state */
+  MemoryContext oldcontext =
+    MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+  Datum bucket;
+  Temporal *fragment = value_split_state_next(state, &bucket);
+  MemoryContextSwitchTo(oldcontext);
   /* Stop when we've output all the fragments */
-  if (state->done)
+  if (fragment == NULL)
   {
-    /* Switch to memory context appropriate for multiple function calls */
-    MemoryContext oldcontext =
-      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-    for (int i = 0; i < state->count; i++)
-      pfree(state->fragments[i]);
-    pfree(state);
-    MemoryContextSwitchTo(oldcontext);
+    value_split_state_free(state);
     SRF_RETURN_DONE(funcctx);
   }
 
-  /* Store timestamp and split */
-  tuple_arr[0] = state->buckets[state->i];
-  tuple_arr[1] = PointerGetDatum(state->fragments[state->i]);
-  /* Advance state */
-  value_split_state_next(state);
+  /* Store value and split */
+  tuple_arr[0] = bucket;
+  tuple_arr[1] = PointerGetDatum(fragment);
   /* Form tuple and return */
   tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
   result = HeapTupleGetDatum(tuple);
+  /* The fragment has been copied into the tuple */
+  pfree(fragment);
   SRF_RETURN_NEXT(funcctx, result);
 }
 
@@ -1835,43 +1842,224 @@ Tnumber_value_split(PG_FUNCTION_ARGS)
  *****************************************************************************/
 
 /**
- * Create the initial state that persists across multiple calls of the function
+ * Comparator function for ranges of buckets
+ */
+static int
+bucket_range_cmp(const void *a, const void *b)
+{
+  const int *range1 = (const int *) a;
+  const int *range2 = (const int *) b;
+  if (range1[0] != range2[0])
+    return (range1[0] < range2[0]) ? -1 : 1;
+  return (range1[1] < range2[1]) ? -1 : ((range1[1] > range2[1]) ? 1 : 0);
+}
+
+/**
+ * Add to the array the ranges of value buckets traversed by a temporal
+ * sequence
  *
- * @param[in] value_buckets Initial values of the tiles
- * @param[in] time_buckets Initial timestamps of the tiles
- * @param[in] fragments Fragments of the input temporal value
- * @param[in] count Number of elements in the input arrays
+ * @note For linear interpolation all the buckets between the values of two
+ * consecutive instants are traversed, otherwise only the buckets of the
+ * values of the instants
+ */
+static int
+tnumberseq_value_buckets(const TSequence *seq, Datum start_bucket,
+  Datum size, int *ranges, int k)
+{
+  CachedType basetype = temptype_basetype(seq->temptype);
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  int bucket_no1 = value_bucket_no(tinstant_value(tsequence_inst_n(seq, 0)),
+    start_bucket, size, basetype);
+  ranges[k++] = bucket_no1;
+  ranges[k++] = bucket_no1;
+  for (int i = 1; i < seq->count; i++)
+  {
+    int bucket_no2 = value_bucket_no(tinstant_value(tsequence_inst_n(seq, i)),
+      start_bucket, size, basetype);
+    ranges[k++] = linear ? Min(bucket_no1, bucket_no2) : bucket_no2;
+    ranges[k++] = linear ? Max(bucket_no1, bucket_no2) : bucket_no2;
+    bucket_no1 = bucket_no2;
+  }
+  return k;
+}
+
+/**
+ * Return the ranges of value buckets traversed by a temporal number, sorted
+ * and merged, as an array of pairs of bucket numbers
  *
- * @pre count is greater than 0
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ * @param[out] count Number of ranges
+ * @note The ranges are computed from the values of the instants without
+ * restricting the temporal number, and only the buckets that they contain
+ * need to be restricted
+ */
+static int *
+tnumber_value_buckets(const Temporal *temp, Datum start_bucket, Datum size,
+  int *count)
+{
+  CachedType basetype = temptype_basetype(temp->temptype);
+  int ninsts = temporal_num_instants(temp);
+  int *ranges = palloc(sizeof(int) * 2 * ninsts);
+  int k = 0;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    ranges[0] = ranges[1] = value_bucket_no(tinstant_value(
+      (const TInstant *) temp), start_bucket, size, basetype);
+    k = 2;
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    for (int i = 0; i < ti->count; i++)
+    {
+      ranges[k] = ranges[k + 1] = value_bucket_no(tinstant_value(
+        tinstantset_inst_n(ti, i)), start_bucket, size, basetype);
+      k += 2;
+    }
+  }
+  else if (temp->subtype == SEQUENCE)
+    k = tnumberseq_value_buckets((const TSequence *) temp, start_bucket, size,
+      ranges, k);
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    for (int i = 0; i < ts->count; i++)
+      k = tnumberseq_value_buckets(tsequenceset_seq_n(ts, i), start_bucket,
+        size, ranges, k);
+  }
+  /* Sort the ranges and merge those that overlap or are adjacent */
+  int nranges = k / 2;
+  if (nranges > 1)
+    qsort(ranges, (size_t) nranges, sizeof(int) * 2, bucket_range_cmp);
+  int l = 0;
+  for (int i = 1; i < nranges; i++)
+  {
+    if (ranges[2 * i] <= ranges[2 * l + 1] + 1)
+      ranges[2 * l + 1] = Max(ranges[2 * l + 1], ranges[2 * i + 1]);
+    else
+    {
+      l++;
+      ranges[2 * l] = ranges[2 * i];
+      ranges[2 * l + 1] = ranges[2 * i + 1];
+    }
+  }
+  *count = l + 1;
+  return ranges;
+}
+
+/**
+ * Create the initial state for splitting a temporal number with respect to
+ * value and period tiles
+ *
+ * @param[in] temp Temporal value
+ * @param[in] start_bucket Value of the start bucket
+ * @param[in] size Size of the value buckets
+ * @param[in] tunits Size of the time buckets in PostgreSQL time units
+ * @param[in] torigin Time origin of the tiles
+ *
+ * @note The temporal value must not be freed while the state is in use
  */
 ValueTimeSplitState *
-value_time_split_state_make(Datum *value_buckets, TimestampTz *time_buckets,
-  Temporal **fragments, int count)
+value_time_split_state_make(const Temporal *temp, Datum start_bucket,
+  Datum size, int64 tunits, TimestampTz torigin)
 {
-  assert(count > 0);
   ValueTimeSplitState *state = palloc0(sizeof(ValueTimeSplitState));
   /* Fill in state */
   state->done = false;
-  state->value_buckets = value_buckets;
-  state->time_buckets = time_buckets;
-  state->fragments = fragments;
-  state->i = 0;
-  state->count = count;
+  state->basetype = temptype_basetype(temp->temptype);
+  state->size = size;
+  state->tunits = tunits;
+  state->torigin = torigin;
+  state->temp = temp;
+  state->start_bucket = start_bucket;
+  state->buckets = tnumber_value_buckets(temp, start_bucket, size,
+    &state->nranges);
+  state->range = 0;
+  state->bucket_no = state->buckets[0];
+  state->atrange = NULL;
+  state->timestate = NULL;
   return state;
 }
 
 /**
- * Increment the current state to the next tile of the multidimensional grid
+ * Return the fragment of the temporal number in the next tile and advance the
+ * state
  *
- * @param[in] state State to increment
+ * @param[inout] state State of the split
+ * @param[out] value Start value of the tile containing the fragment
+ * @param[out] t Start timestamp of the tile containing the fragment
+ * @result Fragment of the temporal number, or NULL when all the fragments
+ * have been returned
+ *
+ * @note The temporal number is restricted to one value bucket at a time,
+ * which is then split with respect to the time buckets. Only the value
+ * buckets traversed by the temporal number are restricted.
+ */
+Temporal *
+value_time_split_state_next(ValueTimeSplitState *state, Datum *value,
+  TimestampTz *t)
+{
+  while (! state->done)
+  {
+    if (state->timestate != NULL)
+    {
+      Temporal *result = time_split_state_next(state->timestate, t);
+      if (result != NULL)
+      {
+        *value = state->value;
+        return result;
+      }
+      /* Move to the next value bucket */
+      time_split_state_free(state->timestate);
+      pfree(state->atrange);
+      state->timestate = NULL;
+      state->atrange = NULL;
+      state->bucket_no++;
+    }
+    /* Skip the value buckets that are not traversed */
+    if (state->bucket_no > state->buckets[2 * state->range + 1])
+    {
+      if (++state->range == state->nranges)
+      {
+        state->done = true;
+        break;
+      }
+      state->bucket_no = state->buckets[2 * state->range];
+    }
+    state->value = bucket_value_n(state->start_bucket, state->size,
+      state->bucket_no, state->basetype);
+    Datum upper_value = datum_add(state->value, state->size, state->basetype,
+      state->basetype);
+    RangeType *range = range_make(state->value, upper_value, true, false,
+      state->basetype);
+    state->atrange = tnumber_restrict_range(state->temp, range, REST_AT);
+    pfree(range);
+    if (state->atrange != NULL)
+      state->timestate = time_split_state_make(state->atrange, state->tunits,
+        state->torigin);
+    else
+      state->bucket_no++;
+  }
+  return NULL;
+}
+
+/**
+ * Free the state of the split
+ *
+ * @param[in] state State to free
  */
 void
-value_time_split_state_next(ValueTimeSplitState *state)
+value_time_split_state_free(ValueTimeSplitState *state)
 {
-  /* Move to the next split */
-  state->i++;
-  if (state->i == state->count)
-    state->done = true;
+  if (state->timestate)
+    time_split_state_free(state->timestate);
+  if (state->atrange)
+    pfree(state->atrange);
+  pfree(state->buckets);
+  pfree(state);
   return;
 }
 
@@ -1894,7 +2082,13 @@ Tnumber_value_time_split(PG_FUNCTION_ARGS)
   /* If the function is being called for the first time */
   if (SRF_IS_FIRSTCALL())
   {
-    /* Get input parameters */
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+    /* Get input parameters. The temporal value must persist across calls
+     * since the fragments are computed on demand */
     Temporal *temp = PG_GETARG_TEMPORAL_P(0);
     Datum size = PG_GETARG_DATUM(1);
     Interval *duration = PG_GETARG_INTERVAL_P(2);
@@ -1907,106 +2101,49 @@ Tnumber_value_time_split(PG_FUNCTION_ARGS)
     ensure_valid_duration(duration);
     int64 tunits = get_interval_units(duration);
 
-    /* Initialize the FuncCallContext */
-    funcctx = SRF_FIRSTCALL_INIT();
-    /* Switch to memory context appropriate for multiple function calls */
-    MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-
     /* Compute the value bounds */
     RangeType *range = tnumber_range((const Temporal *) temp);
     Datum start_value = lower_datum(range);
-    /* We need to add size to obtain the end value of the last bucket */
-    Datum end_value = datum_add(upper_datum(range), size, basetype, basetype);
     Datum start_bucket = number_bucket(start_value, size, origin, basetype);
-    Datum end_bucket = number_bucket(end_value, size, origin, basetype);
-    int value_count = (basetype == T_INT4) ?
-      (DatumGetInt32(end_bucket) - DatumGetInt32(start_bucket)) / DatumGetInt32(size) :
-      floor((DatumGetFloat8(end_bucket) - DatumGetFloat8(start_bucket)) / DatumGetFloat8(size));
-
-    /* Compute the time bounds */
-    Period p;
-    temporal_period(temp, &p);
-    TimestampTz start_time = p.lower;
-    TimestampTz end_time = p.upper;
-    TimestampTz start_time_bucket = timestamptz_bucket(start_time,
-      tunits, torigin);
-    /* We need to add tunits to obtain the end timestamp of the last bucket */
-    TimestampTz end_time_bucket = timestamptz_bucket(end_time, tunits,
-      torigin) + tunits;
-    int time_count = (int) (((int64) end_time_bucket - (int64) start_time_bucket) / tunits);
-
-    /* Compute the number of tiles */
-    int count = value_count * time_count;
-
-    /* Split the temporal value */
-    Datum *value_buckets = palloc(sizeof(Datum) * count);
-    TimestampTz *time_buckets = palloc(sizeof(TimestampTz) * count);
-    Temporal **fragments = palloc(sizeof(Temporal *) * count);
-    int k = 0;
-    Datum lower_value = start_bucket;
-    while (datum_lt(lower_value, end_bucket, basetype))
-    {
-      Datum upper_value = datum_add(lower_value, size, basetype, basetype);
-      range = range_make(lower_value, upper_value, true, false, basetype);
-      Temporal *atrange = tnumber_restrict_range(temp, range, REST_AT);
-      if (atrange != NULL)
-      {
-        int num_time_splits;
-        TimestampTz *times;
-        Temporal **time_splits = temporal_time_split(atrange,
-          start_time_bucket, end_time_bucket, tunits, torigin, time_count, &times,
-          &num_time_splits);
-        for (int i = 0; i < num_time_splits; i++)
-        {
-          value_buckets[i + k] = lower_value;
-          time_buckets[i + k] = times[i];
-          fragments[i + k] = time_splits[i];
-        }
-        k += num_time_splits;
-        pfree(time_splits);
-        pfree(times);
-      }
-      pfree(range);
-      lower_value = upper_value;
-    }
+    pfree(range);
 
-    assert(k > 0);
     /* Create function state */
-    funcctx->user_fctx = value_time_split_state_make(value_buckets,
-      time_buckets, fragments, k);
+    funcctx->user_fctx = value_time_split_state_make(temp, start_bucket,
+      size, tunits, torigin);
     /* Build a tuple description for the function output */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
     BlessTupleDesc(funcctx->tuple_desc);
     MemoryContextSwitchTo(oldcontext);
-    PG_FREE_IF_COPY(temp, 0);
   }
 
   /* stuff done on every call of the function */
   funcctx = SRF_PERCALL_SETUP();
   /* get state */
   state = funcctx->user_fctx;
+  /* Compute the next fragment in the memory context of the state */
+  MemoryContext oldcontext =
+    MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+  Datum value;
+  TimestampTz t;
+  Temporal *fragment = value_time_split_state_next(state, &value, &t);
   /* Stop when we've output all the fragments */
-  if (state->done)
+  if (fragment == NULL)
   {
-    /* Switch to memory context appropriate for multiple function calls */
-    MemoryContext oldcontext =
-      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-    for (int i = 0; i < state->count; i++)
-      pfree(state->fragments[i]);
-    pfree(state);
+    value_time_split_state_free(state);
     MemoryContextSwitchTo(oldcontext);
     SRF_RETURN_DONE(funcctx);
   }
+  MemoryContextSwitchTo(oldcontext);
 
   /* Store value, timestamp, and split */
-  tuple_arr[0] = state->value_buckets[state->i];
-  tuple_arr[1] = TimestampTzGetDatum(state->time_buckets[state->i]);
-  tuple_arr[2] = PointerGetDatum(state->fragments[state->i]);
-  /* Advance state */
-  value_time_split_state_next(state);
+  tuple_arr[0] = value;
+  tuple_arr[1] = TimestampTzGetDatum(t);
+  tuple_arr[2] = PointerGetDatum(fragment);
   /* Form tuple and return */
   tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
   result = HeapTupleGetDatum(tuple);
+  /* The fragment has been copied into the tuple */
+  pfree(fragment);
   SRF_RETURN_NEXT(funcctx, result);
 }
 
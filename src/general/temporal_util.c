@@ -1040,6 +1040,123 @@ tseqarr_sort(TSequence **sequences, int count)
     (qsort_comparator) &tseqarr_sort_cmp);
 }
 
+/*****************************************************************************
+ * Space-filling curve functions
+ * These functions are used for sorting bounding boxes so that boxes that are
+ * close in space and time are also close in the sort order, e.g., for the
+ * sorted build of GiST indexes
+ *****************************************************************************/
+
+/**
+ * Return the bits of a double converted to a float as an unsigned integer
+ * such that the order of the integers is the order of the doubles
+ */
+uint32
+double_sortable_bits(double d)
+{
+  union
+  {
+    float f;
+    uint32 u;
+  } conv;
+  conv.f = (float) d;
+  /* Flip all the bits of negative values and the sign bit of the other ones */
+  return (conv.u & 0x80000000) ? ~conv.u : (conv.u | 0x80000000);
+}
+
+/**
+ * Return a timestamp in seconds as an unsigned integer such that the order of
+ * the integers is the order of the timestamps
+ *
+ * @note The seconds are clamped to the range of a 32-bit integer, which
+ * covers about 68 years around the PostgreSQL epoch. The Z-order key takes
+ * the most significant bits of the result, e.g., a resolution of 2^11 seconds
+ * for three dimensions and 2^16 seconds for four dimensions.
+ */
+uint32
+timestamp_sortable_bits(TimestampTz t)
+{
+  int64 secs = t / USECS_PER_SEC;
+  if (secs < PG_INT32_MIN)
+    secs = PG_INT32_MIN;
+  else if (secs > PG_INT32_MAX)
+    secs = PG_INT32_MAX;
+  /* Flip the sign bit so that negative timestamps are sorted first */
+  return ((uint32) (int32) secs) ^ 0x80000000;
+}
+
+/**
+ * Return the key of the Z-order (or Morton) curve obtained by interleaving
+ * the most significant bits of the values
+ *
+ * @param[in] values Values, which must be sortable unsigned integers
+ * @param[in] ndims Number of values, between 1 and 4
+ */
+uint64
+zorder_key(const uint32 *values, int ndims)
+{
+  assert(ndims >= 1 && ndims <= 4);
+  int nbits = Min(64 / ndims, 32);
+  uint64 result = 0;
+  for (int i = 31; i >= 32 - nbits; i--)
+    for (int j = 0; j < ndims; j++)
+      result = (result << 1) | ((values[j] >> i) & 1);
+  return result;
+}
+
+/**
+ * Structure for sorting the elements of an array according to their keys
+ */
+typedef struct
+{
+  uint64 key;       /**< Key of the element */
+  int pos;          /**< Position of the element in the array */
+} KeyPos;
+
+/**
+ * Comparator function for elements with a key, ties are broken by the
+ * position so that the sort is stable
+ */
+static int
+keypos_sort_cmp(const KeyPos *l, const KeyPos *r)
+{
+  if (l->key != r->key)
+    return (l->key < r->key) ? -1 : 1;
+  return (l->pos < r->pos) ? -1 : ((l->pos > r->pos) ? 1 : 0);
+}
+
+/**
+ * Sort in place an array of elements of the given size according to the
+ * keys computed by the function
+ *
+ * @param[inout] values Array of elements
+ * @param[in] size Size of the elements
+ * @param[in] count Number of elements
+ * @param[in] keyfunc Function computing the key of an element
+ */
+void
+keyarr_sort(void *values, size_t size, int count,
+  uint64 (*keyfunc)(const void *))
+{
+  if (count <= 1)
+    return;
+  KeyPos *keys = palloc(sizeof(KeyPos) * count);
+  char *elems = (char *) values;
+  for (int i = 0; i < count; i++)
+  {
+    keys[i].key = keyfunc(elems + i * size);
+    keys[i].pos = i;
+  }
+  qsort(keys, (size_t) count, sizeof(KeyPos),
+    (qsort_comparator) &keypos_sort_cmp);
+  char *copy = palloc(size * count);
+  memcpy(copy, values, size * count);
+  for (int i = 0; i < count; i++)
+    memcpy(elems + i * size, copy + keys[i].pos * size, size);
+  pfree(copy); pfree(keys);
+  return;
+}
+
 /*****************************************************************************
  * Remove duplicate functions
  * These functions assume that the array has been sorted before
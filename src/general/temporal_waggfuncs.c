@@ -35,6 +35,7 @@
 #include "general/temporal_waggfuncs.h"
 
 /* PostgreSQL */
+#include <math.h>
 #include <utils/builtins.h>
 #include <utils/timestamp.h>
 /* MobilityDB */
@@ -75,170 +76,78 @@ tinstant_extend(const TInstant *inst, const Interval *interval,
 }
 
 /**
- * Extend the temporal instant set value by the time interval
- *
- * @param[in] ti Temporal value
- * @param[in] interval Interval
- * @param[out] result Array on which the pointers of the newly constructed
- * values are stored
- */
-static int
-tinstantset_extend(const TInstantSet *ti, const Interval *interval,
-  TSequence **result)
-{
-  for (int i = 0; i < ti->count; i++)
-  {
-    const TInstant *inst = tinstantset_inst_n(ti, i);
-    tinstant_extend(inst, interval, &result[i]);
-  }
-  return ti->count;
-}
-
-/**
- * Extend the temporal sequence value by the time interval
+ * Extend a segment of the temporal sequence value by the time interval
  *
  * @param[in] seq Temporal value
+ * @param[in] i Position of the segment, that is, of its first instant
  * @param[in] interval Interval
  * @param[in] min True if the calling function is min, max otherwise.
- * @param[out] result Array on which the pointers of the newly constructed
- * values are stored
  * This parameter is only used for linear interpolation.
  */
-static int
-tsequence_extend(const TSequence *seq, const Interval *interval, bool min,
-  TSequence **result)
+static TSequence *
+tsequence_extend_segment(const TSequence *seq, int i,
+  const Interval *interval, bool min)
 {
+  TSequence *result;
   if (seq->count == 1)
-    return tinstant_extend(tsequence_inst_n(seq, 0), interval, result);
+  {
+    tinstant_extend(tsequence_inst_n(seq, 0), interval, &result);
+    return result;
+  }
 
   TInstant *instants[3];
-  TInstant *inst1 = (TInstant *) tsequence_inst_n(seq, 0);
+  TInstant *inst1 = (TInstant *) tsequence_inst_n(seq, i);
+  TInstant *inst2 = (TInstant *) tsequence_inst_n(seq, i + 1);
   Datum value1 = tinstant_value(inst1);
+  Datum value2 = tinstant_value(inst2);
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
-  bool lower_inc = seq->period.lower_inc;
+  bool lower_inc = (i == 0) ? seq->period.lower_inc : true;
+  bool upper_inc = (i == seq->count - 2) ? seq->period.upper_inc : false ;
   CachedType basetype = temptype_basetype(seq->temptype);
-  for (int i = 0; i < seq->count - 1; i++)
-  {
-    TInstant *inst2 = (TInstant *) tsequence_inst_n(seq, i + 1);
-    Datum value2 = tinstant_value(inst2);
-    bool upper_inc = (i == seq->count - 2) ? seq->period.upper_inc : false ;
-
-    /* Stepwise interpolation or constant segment */
-    if (! linear || datum_eq(value1, value2, basetype))
-    {
-      TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
-        timestamptz_pl_interval, TimestampTzGetDatum(inst2->t),
-        PointerGetDatum(interval)));
-      instants[0] = (TInstant *) inst1;
-      instants[1] = tinstant_make(value1, upper, inst1->temptype);
-      result[i] = tsequence_make((const TInstant **) instants, 2,
-        lower_inc, upper_inc, linear, NORMALIZE_NO);
-      pfree(instants[1]);
-    }
-    else
-    {
-      /* Increasing period and minimum function or
-       * decreasing period and maximum function */
-      if ((datum_lt(value1, value2, basetype) && min) ||
-        (datum_gt(value1, value2, basetype) && !min))
-      {
-        /* Extend the start value for the duration of the window */
-        TimestampTz lower = DatumGetTimestampTz(DirectFunctionCall2(
-          timestamptz_pl_interval, TimestampTzGetDatum(inst1->t),
-          PointerGetDatum(interval)));
-        TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
-          timestamptz_pl_interval, TimestampTzGetDatum(inst2->t),
-          PointerGetDatum(interval)));
-        instants[0] = inst1;
-        instants[1] = tinstant_make(value1, lower, inst1->temptype);
-        instants[2] = tinstant_make(value2, upper, inst1->temptype);
-        result[i] = tsequence_make((const TInstant **) instants, 3,
-          lower_inc, upper_inc, linear, NORMALIZE_NO);
-        pfree(instants[1]); pfree(instants[2]);
-      }
-      else
-      {
-        /* Extend the end value for the duration of the window */
-        TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
-          timestamptz_pl_interval, TimestampTzGetDatum(seq->period.upper),
-          PointerGetDatum(interval)));
-        instants[0] = inst1;
-        instants[1] = inst2;
-        instants[2] = tinstant_make(value2, upper, inst1->temptype);
-        result[i] = tsequence_make((const TInstant**) instants, 3,
-          lower_inc, upper_inc, linear, NORMALIZE_NO);
-        pfree(instants[2]);
-      }
-    }
-    inst1 = inst2;
-    value1 = value2;
-    lower_inc = true;
-  }
-  return seq->count - 1;
-}
-
-/**
- * Extend the temporal sequence set value by the time interval
- *
- * @param[out] result Array on which the pointers of the newly constructed
- * values are stored
- * @param[in] ts Temporal value
- * @param[in] interval Interval
- * @param[in] min True if the calling function is min, max otherwise.
- * This parameter is only used for linear interpolation.
- */
-static int
-tsequenceset_extend(const TSequenceSet *ts, const Interval *interval, bool min,
-  TSequence **result)
-{
-  if (ts->count == 1)
-    return tsequence_extend(tsequenceset_seq_n(ts, 0), interval, min, result);
 
-  int k = 0;
-  for (int i = 0; i < ts->count; i++)
+  /* Stepwise interpolation or constant segment */
+  if (! linear || datum_eq(value1, value2, basetype))
   {
-    const TSequence *seq = tsequenceset_seq_n(ts, i);
-    k += tsequence_extend(seq, interval, min, &result[k]);
-  }
-  return k;
-}
-
-/**
- * Extend the temporal value by the time interval (dispatch function)
- *
- * @param[in] temp Temporal value
- * @param[in] interval Interval
- * @param[in] min True if the calling function is min, max otherwise
- * @param[out] count Number of elements in the output array
- */
-static TSequence **
-temporal_extend(Temporal *temp, Interval *interval, bool min, int *count)
-{
-  TSequence **result;
-  ensure_valid_tempsubtype(temp->subtype);
-  if (temp->subtype == INSTANT)
-  {
-    TInstant *inst = (TInstant *)temp;
-    result = palloc(sizeof(TSequence *));
-    *count = tinstant_extend(inst, interval, result);
-  }
-  else if (temp->subtype == INSTANTSET)
-  {
-    TInstantSet *ti = (TInstantSet *)temp;
-    result = palloc(sizeof(TSequence *) * ti->count);
-    *count = tinstantset_extend(ti, interval, result);
+    TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
+      timestamptz_pl_interval, TimestampTzGetDatum(inst2->t),
+      PointerGetDatum(interval)));
+    instants[0] = inst1;
+    instants[1] = tinstant_make(value1, upper, inst1->temptype);
+    result = tsequence_make((const TInstant **) instants, 2,
+      lower_inc, upper_inc, linear, NORMALIZE_NO);
+    pfree(instants[1]);
   }
-  else if (temp->subtype == SEQUENCE)
+  /* Increasing period and minimum function or
+   * decreasing period and maximum function */
+  else if ((datum_lt(value1, value2, basetype) && min) ||
+    (datum_gt(value1, value2, basetype) && !min))
   {
-    TSequence *seq = (TSequence *)temp;
-    result = palloc(sizeof(TSequence *) * seq->count);
-    *count = tsequence_extend(seq, interval, min, result);
+    /* Extend the start value for the duration of the window */
+    TimestampTz lower = DatumGetTimestampTz(DirectFunctionCall2(
+      timestamptz_pl_interval, TimestampTzGetDatum(inst1->t),
+      PointerGetDatum(interval)));
+    TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
+      timestamptz_pl_interval, TimestampTzGetDatum(inst2->t),
+      PointerGetDatum(interval)));
+    instants[0] = inst1;
+    instants[1] = tinstant_make(value1, lower, inst1->temptype);
+    instants[2] = tinstant_make(value2, upper, inst1->temptype);
+    result = tsequence_make((const TInstant **) instants, 3,
+      lower_inc, upper_inc, linear, NORMALIZE_NO);
+    pfree(instants[1]); pfree(instants[2]);
   }
-  else /* temp->subtype == SEQUENCESET */
+  else
   {
-    TSequenceSet *ts = (TSequenceSet *)temp;
-    result = palloc(sizeof(TSequence *) * ts->totalcount);
-    *count = tsequenceset_extend(ts, interval, min, result);
+    /* Extend the end value for the duration of the window */
+    TimestampTz upper = DatumGetTimestampTz(DirectFunctionCall2(
+      timestamptz_pl_interval, TimestampTzGetDatum(seq->period.upper),
+      PointerGetDatum(interval)));
+    instants[0] = inst1;
+    instants[1] = inst2;
+    instants[2] = tinstant_make(value2, upper, inst1->temptype);
+    result = tsequence_make((const TInstant**) instants, 3,
+      lower_inc, upper_inc, linear, NORMALIZE_NO);
+    pfree(instants[2]);
   }
   return result;
 }
@@ -569,39 +478,565 @@ tnumber_transform_wavg(const Temporal *temp, const Interval *interval,
 }
 
 /*****************************************************************************
- * Generic moving window transition functions
+ * Sliding window engine
  *****************************************************************************/
 
+/*
+ * The values of a temporal value that is given in time order are active
+ * in the moving window during a period that starts at the timestamp of the
+ * value and ends at the end of its validity extended by the time interval.
+ * Both the starts and the ends of these periods are ordered by time, the
+ * values active at a timestamp are thus a contiguous range of the values.
+ * This range is swept in a single pass: the values are read from the
+ * temporal value when they enter the window and are evicted when they leave
+ * it, so that only the values in the window are kept in a circular buffer.
+ * A monotonic deque of the values is kept for the minimum and the maximum,
+ * and running sums, which are updated when a value enters or leaves the
+ * window, are kept for the count, the sum, and the average. The sums of
+ * floats are compensated to limit the cancellation errors. The result for
+ * the temporal value is then spliced at once into the skiplist instead of
+ * splicing the extension of each of its values. This is done when the
+ * extension of the values is constant, that is, for instant values or
+ * sequences with step interpolation. For the minimum and the maximum of
+ * sequences with linear interpolation, the extension of each segment is
+ * aggregated with the part of the result that it overlaps, and the part of
+ * the result that ends before the segment is final.
+ */
+
 /**
- * Generic moving window transition function for min, max, and sum aggregation
+ * Structure to represent a value of a temporal value and the period during
+ * which it is active in the moving window
+ */
+typedef struct
+{
+  Datum value;
+  TimestampTz lower;
+  TimestampTz upper;
+  bool lower_inc;
+  bool upper_inc;
+} WindowValue;
+
+/**
+ * Structure to read the values of a temporal value in time order
+ */
+typedef struct
+{
+  const Temporal *temp;
+  const Interval *interval;
+  bool wcount;      /**< True when each value is counted as 1 */
+  int seqno;        /**< Current sequence of a sequence set */
+  int instno;       /**< Next instant or segment */
+} WindowCursor;
+
+/**
+ * Structure to represent the state of the sweep of the moving window
+ *
+ * @note The positions of the values are increasing, the values and the
+ * deque are kept in circular buffers indexed by the positions modulo their
+ * capacity
+ */
+typedef struct
+{
+  WindowCursor cursor;  /**< Position in the temporal value */
+  bool hasnext;         /**< True when a value has not entered the window */
+  WindowValue nextval;  /**< Next value to enter the window */
+  WindowValue *window;  /**< Values in the window */
+  int *deque;       /**< Monotonic deque for the minimum and maximum */
+  int capacity;     /**< Capacity of the circular buffers */
+  int first;        /**< Position of the first value in the window */
+  int next;         /**< Position of the next value to enter the window */
+  int front;
+  int back;
+  datum_func2 func; /**< Aggregate function */
+  bool isint;       /**< True when the values are integers */
+  CachedType basetype;
+  int64 isum;       /**< Running sum of integers */
+  double fsum;      /**< Running sum of floats */
+  double fcomp;     /**< Compensation of the running sum of floats */
+  double2 avg;      /**< Value of the average aggregate */
+} WindowState;
+
+#define WINDOW_VALUE(state, i) ((state)->window[(i) % (state)->capacity])
+#define WINDOW_DEQUE(state, i) ((state)->deque[(i) % (state)->capacity])
+
+/**
+ * Set the value and the period during which it is active in the window
+ */
+static void
+window_value_set(Datum value, TimestampTz lower, TimestampTz upper,
+  bool lower_inc, bool upper_inc, const Interval *interval,
+  WindowValue *result)
+{
+  result->value = value;
+  result->lower = lower;
+  result->upper = DatumGetTimestampTz(DirectFunctionCall2(
+    timestamptz_pl_interval, TimestampTzGetDatum(upper),
+    PointerGetDatum(interval)));
+  result->lower_inc = lower_inc;
+  result->upper_inc = upper_inc;
+  return;
+}
+
+/**
+ * Read the next value of a temporal value and the period during which it is
+ * active in the window, as done in functions tsequence_extend_segment
+ * and tsequence_transform_wcount for step interpolation
+ *
+ * @result False when all the values have been read
+ */
+static bool
+window_cursor_next(WindowCursor *cursor, WindowValue *result)
+{
+  const Temporal *temp = cursor->temp;
+  const TInstant *inst1, *inst2 = NULL;
+  bool lower_inc = true, upper_inc = true;
+  if (temp->subtype == INSTANT)
+  {
+    if (cursor->instno > 0)
+      return false;
+    inst1 = (const TInstant *) temp;
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    if (cursor->instno == ti->count)
+      return false;
+    inst1 = tinstantset_inst_n(ti, cursor->instno);
+  }
+  else
+  {
+    const TSequence *seq;
+    if (temp->subtype == SEQUENCE)
+    {
+      if (cursor->seqno > 0)
+        return false;
+      seq = (const TSequence *) temp;
+    }
+    else /* temp->subtype == SEQUENCESET */
+    {
+      const TSequenceSet *ts = (const TSequenceSet *) temp;
+      if (cursor->seqno == ts->count)
+        return false;
+      seq = tsequenceset_seq_n(ts, cursor->seqno);
+    }
+    inst1 = tsequence_inst_n(seq, cursor->instno);
+    if (seq->count > 1)
+    {
+      inst2 = tsequence_inst_n(seq, cursor->instno + 1);
+      lower_inc = (cursor->instno == 0) ? seq->period.lower_inc : true;
+      upper_inc = (cursor->instno == seq->count - 2) ?
+        seq->period.upper_inc : false;
+    }
+    /* Move to the next sequence after the last segment */
+    if (cursor->instno >= seq->count - 2)
+    {
+      cursor->seqno++;
+      cursor->instno = -1;
+    }
+  }
+  cursor->instno++;
+  window_value_set(cursor->wcount ? Int32GetDatum(1) : tinstant_value(inst1),
+    inst1->t, inst2 ? inst2->t : inst1->t, lower_inc, upper_inc,
+    cursor->interval, result);
+  return true;
+}
+
+/**
+ * Return a value of a temporal number as a double
+ */
+static double
+window_value_double(const WindowState *state, Datum value)
+{
+  return state->isint ? (double) DatumGetInt32(value) :
+    DatumGetFloat8(value);
+}
+
+/**
+ * Add a value to the compensated running sum of floats
+ */
+static void
+window_fsum_add(WindowState *state, double value)
+{
+  double t = state->fsum + value;
+  if (fabs(state->fsum) >= fabs(value))
+    state->fcomp += (state->fsum - t) + value;
+  else
+    state->fcomp += (value - t) + state->fsum;
+  state->fsum = t;
+  return;
+}
+
+/**
+ * Double the capacity of the circular buffers of the window
+ */
+static void
+window_grow(WindowState *state)
+{
+  int capacity = state->capacity * 2;
+  WindowValue *window = palloc(sizeof(WindowValue) * capacity);
+  int *deque = palloc(sizeof(int) * capacity);
+  for (int i = state->first; i < state->next; i++)
+    window[i % capacity] = WINDOW_VALUE(state, i);
+  for (int i = state->front; i < state->back; i++)
+    deque[i % capacity] = WINDOW_DEQUE(state, i);
+  pfree(state->window);
+  pfree(state->deque);
+  state->window = window;
+  state->deque = deque;
+  state->capacity = capacity;
+  return;
+}
+
+/**
+ * Add the next value to the window and read the following one
+ */
+static void
+window_push(WindowState *state)
+{
+  if (state->next - state->first == state->capacity)
+    window_grow(state);
+  int i = state->next++;
+  WINDOW_VALUE(state, i) = state->nextval;
+  state->hasnext = window_cursor_next(&state->cursor, &state->nextval);
+  Datum value = WINDOW_VALUE(state, i).value;
+  if (state->func == &datum_min_int32 || state->func == &datum_min_float8 ||
+      state->func == &datum_max_int32 || state->func == &datum_max_float8)
+  {
+    bool min = (state->func == &datum_min_int32 ||
+      state->func == &datum_min_float8);
+    while (state->back > state->front)
+    {
+      Datum last = WINDOW_VALUE(state,
+        WINDOW_DEQUE(state, state->back - 1)).value;
+      if (min ? datum_lt(last, value, state->basetype) :
+          datum_gt(last, value, state->basetype))
+        break;
+      state->back--;
+    }
+    WINDOW_DEQUE(state, state->back++) = i;
+  }
+  else if (state->func == &datum_sum_int32)
+    state->isum += DatumGetInt32(value);
+  else if (state->func == &datum_sum_float8)
+    window_fsum_add(state, DatumGetFloat8(value));
+  else /* state->func == &datum_sum_double2 */
+  {
+    window_fsum_add(state, window_value_double(state, value));
+    state->avg.b += 1;
+  }
+  return;
+}
+
+/**
+ * Evict the first value from the window
+ */
+static void
+window_pop(WindowState *state)
+{
+  int i = state->first++;
+  Datum value = WINDOW_VALUE(state, i).value;
+  if (state->back > state->front && WINDOW_DEQUE(state, state->front) == i)
+    state->front++;
+  if (state->func == &datum_sum_int32)
+    state->isum -= DatumGetInt32(value);
+  else if (state->func == &datum_sum_float8)
+    window_fsum_add(state, - DatumGetFloat8(value));
+  else if (state->func == &datum_sum_double2)
+  {
+    window_fsum_add(state, - window_value_double(state, value));
+    state->avg.b -= 1;
+  }
+  /* Restart the sum of floats from zero when the window becomes empty */
+  if (state->first == state->next)
+    state->fsum = state->fcomp = 0.0;
+  return;
+}
+
+/**
+ * Return the aggregate of the values in the window
+ */
+static Datum
+window_value(WindowState *state)
+{
+  if (state->back > state->front)
+    return WINDOW_VALUE(state, WINDOW_DEQUE(state, state->front)).value;
+  if (state->func == &datum_sum_int32)
+    return Int32GetDatum((int32) state->isum);
+  if (state->func == &datum_sum_float8)
+    return Float8GetDatum(state->fsum + state->fcomp);
+  /* state->func == &datum_sum_double2 */
+  state->avg.a = state->fsum + state->fcomp;
+  return PointerGetDatum(&state->avg);
+}
+
+/**
+ * Add the constant sequence to the array of sequences, which is enlarged if
+ * needed
+ */
+static void
+window_piece(Datum value, TimestampTz lower, TimestampTz upper,
+  bool lower_inc, bool upper_inc, CachedType temptype, bool linear,
+  TSequence ***result, int *count, int *maxcount)
+{
+  if (*count == *maxcount)
+  {
+    *maxcount *= 2;
+    *result = repalloc(*result, sizeof(TSequence *) * *maxcount);
+  }
+  TInstant *instants[2];
+  instants[0] = tinstant_make(value, lower, temptype);
+  if (lower == upper)
+  {
+    (*result)[(*count)++] = tsequence_make((const TInstant **) instants, 1,
+      true, true, linear, NORMALIZE_NO);
+    pfree(instants[0]);
+    return;
+  }
+  instants[1] = tinstant_make(value, upper, temptype);
+  (*result)[(*count)++] = tsequence_make((const TInstant **) instants, 2,
+    lower_inc, upper_inc, linear, NORMALIZE_NO);
+  pfree(instants[0]); pfree(instants[1]);
+  return;
+}
+
+/**
+ * Compute the moving window aggregate of a temporal value in a single pass
  *
- * @param[in] fcinfo Catalog information about the external function
- * @param[inout] state Skiplist containing the state
  * @param[in] temp Temporal value
  * @param[in] interval Interval
- * @param[in] func Function
+ * @param[in] func Aggregate function
+ * @param[in] wcount True when computing the count, in which case each value
+ * is counted as 1
+ * @param[in] temptype Temporal type of the result
+ * @param[in] linear True when the result has linear interpolation
+ * @param[out] count Number of elements in the output array
+ */
+static TSequence **
+temporal_window_agg(const Temporal *temp, const Interval *interval,
+  datum_func2 func, bool wcount, CachedType temptype, bool linear,
+  int *count)
+{
+  WindowState state;
+  memset(&state, 0, sizeof(WindowState));
+  state.cursor.temp = temp;
+  state.cursor.interval = interval;
+  state.cursor.wcount = wcount;
+  state.func = func;
+  state.isint = wcount || temp->temptype == T_TINT;
+  state.basetype = temptype_basetype(temp->temptype);
+  state.capacity = 16;
+  state.window = palloc(sizeof(WindowValue) * state.capacity);
+  state.deque = palloc(sizeof(int) * state.capacity);
+  state.hasnext = window_cursor_next(&state.cursor, &state.nextval);
+  CachedType basetype = temptype_basetype(temptype);
+
+  int maxpieces = 16;
+  TSequence **pieces = palloc(sizeof(TSequence *) * maxpieces);
+  int npieces = 0;
+  bool open = false;
+  Datum value = 0;
+  double2 avg;
+  TimestampTz lower = 0;
+  bool lower_inc = false;
+  while (state.hasnext || state.first < state.next)
+  {
+    /* Next timestamp at which the window changes */
+    TimestampTz t;
+    if (! state.hasnext)
+      t = WINDOW_VALUE(&state, state.first).upper;
+    else if (state.first == state.next)
+      t = state.nextval.lower;
+    else
+      t = Min(state.nextval.lower, WINDOW_VALUE(&state, state.first).upper);
+
+    /* Window at the timestamp */
+    while (state.first < state.next &&
+        WINDOW_VALUE(&state, state.first).upper == t &&
+        ! WINDOW_VALUE(&state, state.first).upper_inc)
+      window_pop(&state);
+    while (state.hasnext && state.nextval.lower == t &&
+        state.nextval.lower_inc)
+      window_push(&state);
+    if (state.first < state.next)
+    {
+      Datum v = window_value(&state);
+      if (! open || ! datum_eq(value, v, basetype))
+      {
+        if (open)
+          window_piece(value, lower, t, lower_inc, false, temptype, linear,
+            &pieces, &npieces, &maxpieces);
+        open = true;
+        lower = t;
+        lower_inc = true;
+        value = v;
+        if (func == &datum_sum_double2)
+        {
+          avg = *DatumGetDouble2P(v);
+          value = PointerGetDatum(&avg);
+        }
+      }
+    }
+    else if (open)
+    {
+      window_piece(value, lower, t, lower_inc, false, temptype, linear,
+        &pieces, &npieces, &maxpieces);
+      open = false;
+    }
+
+    /* Window after the timestamp */
+    while (state.first < state.next &&
+        WINDOW_VALUE(&state, state.first).upper == t)
+      window_pop(&state);
+    while (state.hasnext && state.nextval.lower == t)
+      window_push(&state);
+    if (state.first < state.next)
+    {
+      Datum v = window_value(&state);
+      if (! open || ! datum_eq(value, v, basetype))
+      {
+        if (open)
+          window_piece(value, lower, t, lower_inc, true, temptype, linear,
+            &pieces, &npieces, &maxpieces);
+        open = true;
+        lower = t;
+        lower_inc = false;
+        value = v;
+        if (func == &datum_sum_double2)
+        {
+          avg = *DatumGetDouble2P(v);
+          value = PointerGetDatum(&avg);
+        }
+      }
+    }
+    else if (open)
+    {
+      window_piece(value, lower, t, lower_inc, true, temptype, linear,
+        &pieces, &npieces, &maxpieces);
+      open = false;
+    }
+  }
+  pfree(state.window);
+  pfree(state.deque);
+
+  TSequence **result = tseqarr_normalize((const TSequence **) pieces,
+    npieces, count);
+  pfree_array((void **) pieces, npieces);
+  return result;
+}
+
+/**
+ * Compute the moving window minimum or maximum of a temporal sequence (set)
+ * with linear interpolation in a single pass
+ *
+ * @param[in] temp Temporal value
+ * @param[in] interval Interval
+ * @param[in] func Aggregate function
  * @param[in] min True if the calling function is min, max otherwise
  * @param[in] crossings State whether turning points are added in the segments
- * @note This function is directly called by the window sum aggregation for
- * temporal floats after verifying since the operation is not supported for
- * sequence (set) type
+ * @param[out] count Number of elements in the output array
+ * @note The extension of each segment is aggregated with the pending
+ * sequences of the result that it may overlap, the pending sequences that
+ * end before the start of the segment are final since the segments are
+ * ordered by time
+ */
+static TSequence **
+tsequence_window_linear_agg(const Temporal *temp, const Interval *interval,
+  datum_func2 func, bool min, bool crossings, int *count)
+{
+  int nseqs = (temp->subtype == SEQUENCE) ? 1 :
+    ((const TSequenceSet *) temp)->count;
+  int maxcount = 16, ncount = 0;
+  TSequence **result = palloc(sizeof(TSequence *) * maxcount);
+  TSequence **pending = palloc(sizeof(TSequence *));
+  int npending = 0;
+  for (int i = 0; i < nseqs; i++)
+  {
+    const TSequence *seq = (temp->subtype == SEQUENCE) ?
+      (const TSequence *) temp :
+      tsequenceset_seq_n((const TSequenceSet *) temp, i);
+    int nsegs = (seq->count == 1) ? 1 : seq->count - 1;
+    for (int j = 0; j < nsegs; j++)
+    {
+      TSequence *piece = tsequence_extend_segment(seq, j, interval, min);
+      /* Emit the pending sequences that end before the segment */
+      int nemit = 0;
+      while (nemit < npending &&
+          pending[nemit]->period.upper < piece->period.lower)
+        nemit++;
+      if (ncount + nemit > maxcount)
+      {
+        maxcount = Max(maxcount * 2, ncount + nemit);
+        result = repalloc(result, sizeof(TSequence *) * maxcount);
+      }
+      memcpy(&result[ncount], pending, sizeof(TSequence *) * nemit);
+      ncount += nemit;
+      if (nemit == npending)
+      {
+        pending[0] = piece;
+        npending = 1;
+        continue;
+      }
+      int newcount;
+      TSequence **newpending = tsequence_tagg(&pending[nemit],
+        npending - nemit, &piece, 1, func, crossings, &newcount);
+      for (int k = nemit; k < npending; k++)
+        pfree(pending[k]);
+      pfree(pending);
+      pfree(piece);
+      pending = newpending;
+      npending = newcount;
+    }
+  }
+  if (ncount + npending > maxcount)
+    result = repalloc(result, sizeof(TSequence *) * (ncount + npending));
+  memcpy(&result[ncount], pending, sizeof(TSequence *) * npending);
+  pfree(pending);
+  *count = ncount + npending;
+  return result;
+}
+
+/**
+ * Splice the moving window aggregate of a temporal value into the state
+ *
+ * @note The sequences are freed by the function
  */
 static SkipList *
-temporal_wagg_transfn1(FunctionCallInfo fcinfo, SkipList *state,
-  Temporal *temp, Interval *interval, datum_func2 func,
-  bool min, bool crossings)
+temporal_window_splice(FunctionCallInfo fcinfo, SkipList *state,
+  TSequence **sequences, int count, datum_func2 func, bool crossings)
 {
-  int count;
-  TSequence **sequences = temporal_extend(temp, interval, min, &count);
-  SkipList *result = tsequence_tagg_transfn(fcinfo, state, sequences[0],
-    func, crossings);
-  for (int i = 1; i < count; i++)
-    result = tsequence_tagg_transfn(fcinfo, result, sequences[i],
-      func, crossings);
+  SkipList *result;
+  if (! state)
+    result = skiplist_make(fcinfo, (void **) sequences, count, TEMPORAL);
+  else
+  {
+    ensure_same_tempsubtype_skiplist(state, (Temporal *) sequences[0]);
+    skiplist_splice(fcinfo, state, (void **) sequences, count, func,
+      crossings);
+    result = state;
+  }
   pfree_array((void **) sequences, count);
   return result;
 }
 
+/**
+ * Splice the moving window aggregate of a temporal value into the state
+ */
+static SkipList *
+temporal_window_transfn(FunctionCallInfo fcinfo, SkipList *state,
+  const Temporal *temp, const Interval *interval, datum_func2 func,
+  bool wcount, CachedType temptype, bool linear, bool crossings)
+{
+  int count;
+  TSequence **sequences = temporal_window_agg(temp, interval, func, wcount,
+    temptype, linear, &count);
+  return temporal_window_splice(fcinfo, state, sequences, count, func,
+    crossings);
+}
+
+/*****************************************************************************
+ * Generic moving window transition functions
+ *****************************************************************************/
+
 /**
  * Generic moving window transition function for min, max, and sum aggregation
  *
@@ -629,8 +1064,26 @@ temporal_wagg_transfn(FunctionCallInfo fcinfo, datum_func2 func,
     ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
       errmsg("Operation not supported for temporal float sequences")));
 
-  SkipList *result = temporal_wagg_transfn1(fcinfo, state, temp, interval,
-    func, min, crossings);
+  SkipList *result;
+  if (temp->subtype == INSTANT || temp->subtype == INSTANTSET)
+  {
+    const TInstant *inst = (temp->subtype == INSTANT) ?
+      (const TInstant *) temp : tinstantset_inst_n((TInstantSet *) temp, 0);
+    result = temporal_window_transfn(fcinfo, state, temp, interval, func,
+      false, temp->temptype, MOBDB_FLAGS_GET_CONTINUOUS(inst->flags),
+      crossings);
+  }
+  else if (! MOBDB_FLAGS_GET_LINEAR(temp->flags))
+    result = temporal_window_transfn(fcinfo, state, temp, interval, func,
+      false, temp->temptype, STEP, crossings);
+  else
+  {
+    int count;
+    TSequence **sequences = tsequence_window_linear_agg(temp, interval, func,
+      min, crossings, &count);
+    result = temporal_window_splice(fcinfo, state, sequences, count, func,
+      crossings);
+  }
 
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_POINTER(result);
@@ -654,14 +1107,26 @@ temporal_wagg_transform_transfn(FunctionCallInfo fcinfo, datum_func2 func,
   }
   Temporal *temp = PG_GETARG_TEMPORAL_P(1);
   Interval *interval = PG_GETARG_INTERVAL_P(2);
-  int count;
-  TSequence **sequences = transform(temp, interval, &count);
-  SkipList *result = tsequence_tagg_transfn(fcinfo, state, sequences[0],
-    func, false);
-  for (int i = 1; i < count; i++)
-    result = tsequence_tagg_transfn(fcinfo, result, sequences[i],
-      func, false);
-  pfree_array((void **) sequences, count);
+  SkipList *result;
+  /* The count of all values and the average of instant values or integer
+   * sequences are computed by sweeping the window */
+  if (transform == &temporal_transform_wcount)
+    result = temporal_window_transfn(fcinfo, state, temp, interval, func,
+      true, T_TINT, STEP, false);
+  else if (temp->subtype == INSTANT || temp->subtype == INSTANTSET ||
+      temp->temptype == T_TINT)
+    result = temporal_window_transfn(fcinfo, state, temp, interval, func,
+      false, T_TDOUBLE2, LINEAR, false);
+  else
+  {
+    int count;
+    TSequence **sequences = transform(temp, interval, &count);
+    result = tsequence_tagg_transfn(fcinfo, state, sequences[0], func, false);
+    for (int i = 1; i < count; i++)
+      result = tsequence_tagg_transfn(fcinfo, result, sequences[i],
+        func, false);
+    pfree_array((void **) sequences, count);
+  }
   PG_FREE_IF_COPY(temp, 1);
   PG_FREE_IF_COPY(interval, 2);
   PG_RETURN_POINTER(result);
@@ -246,17 +246,21 @@ time_agg_combinefn(FunctionCallInfo fcinfo, SkipList *state1,
     return state1;
 
   assert(state1->elemtype == state2->elemtype);
-  int count2 = state2->length;
-  void **values = skiplist_values(state2);
-  skiplist_splice(fcinfo, state1, values, count2, NULL, CROSSINGS_NO);
-  pfree(values);
-  return state1;
+  return skiplist_merge(fcinfo, state1, state2, NULL, CROSSINGS_NO);
 }
 
 /*****************************************************************************
  * Aggregate transition functions for time types
  *****************************************************************************/
 
+/*
+ * The extent aggregates only read the bounding period of the time values,
+ * which is found in the header of the values and thus only the header is
+ * detoasted. When called as aggregates, the transition and combine functions
+ * expand the state in place instead of allocating a new period for every
+ * row, since the state is kept in the aggregate memory context.
+ */
+
 PG_FUNCTION_INFO_V1(Timestampset_extent_transfn);
 /**
  * Transition function for temporal extent aggregation of timestamp set values
@@ -266,32 +270,22 @@ PGDLLEXPORT Datum
 Timestampset_extent_transfn(PG_FUNCTION_ARGS)
 {
   Period *p = PG_ARGISNULL(0) ? NULL : PG_GETARG_PERIOD_P(0);
-  TimestampSet *ts = PG_ARGISNULL(1) ? NULL : PG_GETARG_TIMESTAMPSET_P(1);
-  Period *result;
 
   /* Can't do anything with null inputs */
-  if (!p && !ts)
+  if (!p && PG_ARGISNULL(1))
     PG_RETURN_NULL();
-  /* Null period and non-null timestampset, return the bbox of the timestampset */
-  if (!p)
-  {
-    result = palloc(sizeof(Period));
-    timestampset_bbox(ts, result);
-    PG_RETURN_POINTER(result);
-  }
   /* Non-null period and null timestampset, return the period */
-  if (!ts)
-  {
-    result = palloc0(sizeof(Period));
-    memcpy(result, p, sizeof(Period));
-    PG_RETURN_POINTER(result);
-  }
+  if (PG_ARGISNULL(1))
+    PG_RETURN_POINTER(p);
 
   Period p1;
-  timestampset_bbox(ts, &p1);
-  result = period_super_union(p, &p1);
+  timestampset_bbox_slice(PG_GETARG_DATUM(1), &p1);
+  /* Null period and non-null timestampset, return the bbox of the timestampset */
+  if (!p)
+    PG_RETURN_POINTER(period_copy(&p1));
 
-  PG_FREE_IF_COPY(ts, 1);
+  Period *result = AggCheckCallContext(fcinfo, NULL) ? p : period_copy(p);
+  period_expand(&p1, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -315,12 +309,11 @@ Period_extent_transfn(PG_FUNCTION_ARGS)
     result = period_copy(p2);
   /* Non-null period and null period, return the period */
   else if (!p2)
-    result = period_copy(p1);
+    result = p1;
   else
   {
-    Period p;
-    period_set(p2->lower, p2->upper, p2->lower_inc, p2->upper_inc, &p);
-    result = period_super_union(p1, &p);
+    result = AggCheckCallContext(fcinfo, NULL) ? p1 : period_copy(p1);
+    period_expand(p2, result);
   }
   PG_RETURN_POINTER(result);
 }
@@ -334,32 +327,22 @@ PGDLLEXPORT Datum
 Periodset_extent_transfn(PG_FUNCTION_ARGS)
 {
   Period *p = PG_ARGISNULL(0) ? NULL : PG_GETARG_PERIOD_P(0);
-  PeriodSet *ps = PG_ARGISNULL(1) ? NULL : PG_GETARG_PERIODSET_P(1);
-  Period *result;
 
   /* Can't do anything with null inputs */
-  if (!p && !ps)
+  if (!p && PG_ARGISNULL(1))
     PG_RETURN_NULL();
-  /* Null period and non-null period set, return the bbox of the period set */
-  if (!p)
-  {
-    result = palloc(sizeof(Period));
-    periodset_bbox(ps, result);
-    PG_RETURN_POINTER(result);
-  }
-  /* Non-null period and null temporal, return the period */
-  if (!ps)
-  {
-    result = palloc0(sizeof(Period));
-    memcpy(result, p, sizeof(Period));
-    PG_RETURN_POINTER(result);
-  }
+  /* Non-null period and null period set, return the period */
+  if (PG_ARGISNULL(1))
+    PG_RETURN_POINTER(p);
 
   Period p1;
-  periodset_bbox(ps, &p1);
-  result = period_super_union(p, &p1);
+  periodset_bbox_slice(PG_GETARG_DATUM(1), &p1);
+  /* Null period and non-null period set, return the bbox of the period set */
+  if (!p)
+    PG_RETURN_POINTER(period_copy(&p1));
 
-  PG_FREE_IF_COPY(ps, 1);
+  Period *result = AggCheckCallContext(fcinfo, NULL) ? p : period_copy(p);
+  period_expand(&p1, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -630,7 +613,8 @@ Time_extent_combinefn(PG_FUNCTION_ARGS)
   if (p2 && !p1)
     PG_RETURN_POINTER(p2);
 
-  Period *result = period_super_union(p1, p2);
+  Period *result = AggCheckCallContext(fcinfo, NULL) ? p1 : period_copy(p1);
+  period_expand(p2, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -671,8 +655,10 @@ Timestamp_tunion_finalfn(PG_FUNCTION_ARGS)
     PG_RETURN_NULL();
 
   assert(state->elemtype == TIMESTAMPTZ);
-  TimestampTz *values = (TimestampTz *) skiplist_values(state);
-  TimestampSet *result = timestampset_make(values, state->length);
+  int count;
+  TimestampTz *values = (TimestampTz *) skiplist_final_values(fcinfo,
+    state, &count);
+  TimestampSet *result = timestampset_make(values, count);
   pfree(values);
   PG_RETURN_POINTER(result);
 }
@@ -690,8 +676,10 @@ Period_tunion_finalfn(PG_FUNCTION_ARGS)
     PG_RETURN_NULL();
 
   assert(state->elemtype == PERIOD);
-  const Period **values = (const Period **) skiplist_values(state);
-  PeriodSet *result = periodset_make(values, state->length, NORMALIZE_NO);
+  int count;
+  const Period **values = (const Period **) skiplist_final_values(fcinfo,
+    state, &count);
+  PeriodSet *result = periodset_make(values, count, NORMALIZE_NO);
   pfree(values);
   PG_RETURN_POINTER(result);
 }
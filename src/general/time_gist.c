@@ -38,7 +38,11 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <float.h>
 #include <access/gist.h>
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+#include <utils/sortsupport.h>
+#endif
 #include <utils/timestamp.h>
 /* MobilityDB */
 #include "general/timetypes.h"
@@ -146,40 +150,34 @@ period_index_recheck(StrategyNumber strategy)
 
 /**
  * Transform the query argument into a period
+ *
+ * @param[in] query Query argument, which is not NULL since the index
+ * support functions are strict
+ * @param[in] typid Oid of the type of the query argument
+ * @param[out] result Period
+ * @note This function is used for both GiST and BRIN indexes
  */
-static bool
-time_gist_get_period(FunctionCallInfo fcinfo, Period *result, Oid typid)
+bool
+time_index_get_period(Datum query, Oid typid, Period *result)
 {
   CachedType type = oid_type(typid);
   if (type == T_TIMESTAMPTZ)
   {
-    /* Since function period_gist_consistent is strict, t is not NULL */
-    TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
+    TimestampTz t = DatumGetTimestampTz(query);
     period_set(t, t, true, true, result);
   }
   else if (type == T_TIMESTAMPSET)
-  {
-    Datum tsdatum = PG_GETARG_DATUM(1);
-    timestampset_bbox_slice(tsdatum, result);
-  }
+    timestampset_bbox_slice(query, result);
   else if (type == T_PERIOD)
   {
-    Period *p = PG_GETARG_PERIOD_P(1);
-    if (p == NULL)
-      PG_RETURN_BOOL(false);
+    Period *p = DatumGetPeriodP(query);
     memcpy(result, p, sizeof(Period));
   }
   else if (type == T_PERIODSET)
-  {
-    Datum psdatum = PG_GETARG_DATUM(1);
-    periodset_bbox_slice(psdatum, result);
-  }
+    periodset_bbox_slice(query, result);
   /* For temporal types whose bounding box is a period */
   else if (temporal_type(type))
-  {
-    Datum tempdatum = PG_GETARG_DATUM(1);
-    temporal_bbox_slice(tempdatum, result);
-  }
+    temporal_bbox_slice(query, result);
   else
     elog(ERROR, "Unsupported type for indexing: %d", type);
   return true;
@@ -208,7 +206,7 @@ Period_gist_consistent(PG_FUNCTION_ARGS)
     PG_RETURN_BOOL(false);
 
   /* Transform the query into a box */
-  if (! time_gist_get_period(fcinfo, &query, typid))
+  if (! time_index_get_period(PG_GETARG_DATUM(1), typid, &query))
     PG_RETURN_BOOL(false);
 
   if (GIST_LEAF(entry))
@@ -862,6 +860,124 @@ Period_gist_same(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+/*****************************************************************************
+ * GiST sortsupport method
+ *****************************************************************************/
+
+/**
+ * Comparator of abbreviated keys, which are the keys of the bounding boxes
+ * in a space-filling curve
+ *
+ * @note Function shared by the sortsupport methods of all bounding box types
+ */
+int
+gist_zorder_cmp_abbrev(Datum x, Datum y,
+  SortSupport ssup __attribute__((unused)))
+{
+  uint64 z1 = DatumGetUInt64(x);
+  uint64 z2 = DatumGetUInt64(y);
+  if (z1 == z2)
+    return 0;
+  return (z1 < z2) ? -1 : 1;
+}
+
+/**
+ * Return false since the abbreviated keys are as discriminating as the full
+ * ones and thus the abbreviation is never aborted
+ *
+ * @note Function shared by the sortsupport methods of all bounding box types
+ */
+bool
+gist_zorder_abbrev_abort(int memtupcount __attribute__((unused)),
+  SortSupport ssup __attribute__((unused)))
+{
+  return false;
+}
+
+/**
+ * Comparator of periods according to their key in a space-filling curve
+ */
+static int
+period_gist_cmp_full(Datum x, Datum y,
+  SortSupport ssup __attribute__((unused)))
+{
+  Period *b1 = DatumGetPeriodP(x);
+  Period *b2 = DatumGetPeriodP(y);
+  uint64 z1 = period_zorder_key(b1);
+  uint64 z2 = period_zorder_key(b2);
+  if (z1 != z2)
+    return (z1 < z2) ? -1 : 1;
+  return period_cmp(b1, b2);
+}
+
+/**
+ * Convert a period into its key in a space-filling curve
+ */
+static Datum
+period_gist_abbrev_convert(Datum original,
+  SortSupport ssup __attribute__((unused)))
+{
+  return UInt64GetDatum(period_zorder_key(DatumGetPeriodP(original)));
+}
+
+PG_FUNCTION_INFO_V1(Period_gist_sortsupport);
+/**
+ * GiST sortsupport method for time types
+ *
+ * The keys are sorted according to a Z-order curve, which enables the
+ * sorted build of the index available since PostgreSQL 14
+ */
+PGDLLEXPORT Datum
+Period_gist_sortsupport(PG_FUNCTION_ARGS)
+{
+  SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+#if SIZEOF_DATUM == 8
+  if (ssup->abbreviate)
+  {
+    ssup->comparator = &gist_zorder_cmp_abbrev;
+    ssup->abbrev_converter = &period_gist_abbrev_convert;
+    ssup->abbrev_abort = &gist_zorder_abbrev_abort;
+    ssup->abbrev_full_comparator = &period_gist_cmp_full;
+  }
+  else
+#endif
+    ssup->comparator = &period_gist_cmp_full;
+  PG_RETURN_VOID();
+}
+#endif /* POSTGRESQL_VERSION_NUMBER >= 140000 */
+
+/*****************************************************************************
+ * GiST distance method
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Period_gist_distance);
+/**
+ * GiST distance method for time types. Return the distance in seconds
+ * between the query and the period of the entry.
+ */
+PGDLLEXPORT Datum
+Period_gist_distance(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  Oid typid = PG_GETARG_OID(3);
+  Period *key = DatumGetPeriodP(entry->key);
+  Period query;
+
+  /* No recheck is needed since the distance operators of the time types also
+   * compute the distance between the bounding periods of their arguments */
+  if (key == NULL)
+    PG_RETURN_FLOAT8(DBL_MAX);
+
+  /* Transform the query into a period */
+  if (! time_index_get_period(PG_GETARG_DATUM(1), typid, &query))
+    PG_RETURN_FLOAT8(DBL_MAX);
+
+  /* For internal entries this is a lower bound of the distance to all the
+   * periods in the subtree */
+  PG_RETURN_FLOAT8(distance_secs_period_period(key, &query));
+}
+
 /*****************************************************************************
  * GiST fetch method
  *****************************************************************************/
@@ -107,6 +107,7 @@ distance_tnumber_number(const Temporal *temp, Datum value,
   lfinfo.discont = CONTINUOUS;
   lfinfo.tpfunc_base = &tlinearsegm_intersection_value;
   lfinfo.tpfunc = NULL;
+  lfinfo.arena = true;
   Temporal *result = tfunc_temporal_base(temp, value, &lfinfo);
   return result;
 }
@@ -157,6 +158,7 @@ distance_tnumber_tnumber(const Temporal *temp1, const Temporal *temp2,
   lfinfo.invert = INVERT_NO;
   lfinfo.discont = CONTINUOUS;
   lfinfo.tpfunc = lfinfo.reslinear ? &tnumber_min_dist_at_timestamp : NULL;
+  lfinfo.arena = true;
   Temporal *result = tfunc_temporal_temporal(temp1, temp2, &lfinfo);
   return result;
 }
@@ -270,7 +272,7 @@ Distance_number_tnumber(PG_FUNCTION_ARGS)
 {
   Datum value = PG_GETARG_DATUM(0);
   Oid valuetypid = get_fn_expr_argtype(fcinfo->flinfo, 0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_COLUMNAR_P(1);
   Oid restypid = get_fn_expr_rettype(fcinfo->flinfo);
   Temporal *result = distance_tnumber_number(temp, value,
     oid_type(valuetypid), oid_type(restypid));
@@ -286,7 +288,7 @@ PG_FUNCTION_INFO_V1(Distance_tnumber_number);
 PGDLLEXPORT Datum
 Distance_tnumber_number(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_COLUMNAR_P(0);
   Datum value = PG_GETARG_DATUM(1);
   Oid restypid = get_fn_expr_rettype(fcinfo->flinfo);
   Oid valuetypid = get_fn_expr_argtype(fcinfo->flinfo, 1);
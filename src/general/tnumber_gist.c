@@ -45,6 +45,9 @@
 #if POSTGRESQL_VERSION_NUMBER >= 120000
 #include <utils/float.h>
 #endif
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+#include <utils/sortsupport.h>
+#endif
 /* MobilityDB */
 #include "general/rangetypes_ext.h"
 #include "general/period.h"
@@ -146,7 +149,7 @@ tbox_index_consistent_leaf(const TBOX *key, const TBOX *query,
  * @param[in] query Value being looked up in the index
  * @param[in] strategy Operator of the operator class being applied
  */
-static bool
+bool
 tnumber_gist_consistent(const TBOX *key, const TBOX *query,
   StrategyNumber strategy)
 {
@@ -201,62 +204,40 @@ tnumber_gist_consistent(const TBOX *key, const TBOX *query,
 /**
  * Transform the query argument into a box initializing the dimensions that
  * must not be taken into account by the operators to infinity.
+ *
+ * @param[in] query Query argument, which is not NULL since the index
+ * support functions are strict
+ * @param[in] typid Oid of the type of the query argument
+ * @param[out] result Box
+ * @note This function is used for both GiST and BRIN indexes
  */
-static bool
-tnumber_gist_get_tbox(FunctionCallInfo fcinfo, TBOX *result, Oid typid)
+bool
+tnumber_index_get_tbox(Datum query, Oid typid, TBOX *result)
 {
   CachedType type = oid_type(typid);
   if (tnumber_basetype(type))
-  {
-    Datum value = PG_GETARG_DATUM(1);
-    number_tbox(value, type, result);
-  }
+    number_tbox(query, type, result);
   else if (tnumber_rangetype(type))
   {
-    RangeType *range = PG_GETARG_RANGE_P(1);
-    if (range == NULL)
-      return false;
+    RangeType *range = DatumGetRangeTypeP(query);
     /* Return false on empty range */
     char flags = range_get_flags(range);
     if (flags & RANGE_EMPTY)
       return false;
     range_tbox(range, result);
-    PG_FREE_IF_COPY(range, 1);
   }
   else if (type == T_TIMESTAMPTZ)
-  {
-    TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
-    timestamp_tbox(t, result);
-  }
+    timestamp_tbox(DatumGetTimestampTz(query), result);
   else if (type == T_TIMESTAMPSET)
-  {
-    Datum tsdatum = PG_GETARG_DATUM(1);
-    timestampset_tbox_slice(tsdatum, result);
-  }
+    timestampset_tbox_slice(query, result);
   else if (type == T_PERIOD)
-  {
-    Period *p = PG_GETARG_PERIOD_P(1);
-    period_tbox(p, result);
-  }
+    period_tbox(DatumGetPeriodP(query), result);
   else if (type == T_PERIODSET)
-  {
-    Datum psdatum = PG_GETARG_DATUM(1);
-    periodset_tbox_slice(psdatum, result);
-  }
+    periodset_tbox_slice(query, result);
   else if (type == T_TBOX)
-  {
-    TBOX *box = PG_GETARG_TBOX_P(1);
-    if (box == NULL)
-      return false;
-    memcpy(result, box, sizeof(TBOX));
-  }
+    memcpy(result, DatumGetTboxP(query), sizeof(TBOX));
   else if (tnumber_type(type))
-  {
-    if (PG_ARGISNULL(1))
-      return false;
-    Datum tempdatum = PG_GETARG_DATUM(1);
-    temporal_bbox_slice(tempdatum, result);
-  }
+    temporal_bbox_slice(query, result);
   else
     elog(ERROR, "Unsupported type for indexing: %d", type);
   return true;
@@ -286,7 +267,7 @@ Tnumber_gist_consistent(PG_FUNCTION_ARGS)
     PG_RETURN_BOOL(false);
 
   /* Transform the query into a box */
-  if (! tnumber_gist_get_tbox(fcinfo, &query, typid))
+  if (! tnumber_index_get_tbox(PG_GETARG_DATUM(1), typid, &query))
     PG_RETURN_BOOL(false);
 
   if (GIST_LEAF(entry))
@@ -1057,6 +1038,64 @@ Tbox_gist_same(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+/*****************************************************************************
+ * GiST sortsupport method
+ *****************************************************************************/
+
+/**
+ * Comparator of temporal boxes according to their key in a space-filling
+ * curve
+ */
+static int
+tbox_gist_cmp_full(Datum x, Datum y,
+  SortSupport ssup __attribute__((unused)))
+{
+  TBOX *b1 = DatumGetTboxP(x);
+  TBOX *b2 = DatumGetTboxP(y);
+  uint64 z1 = tbox_zorder_key(b1);
+  uint64 z2 = tbox_zorder_key(b2);
+  if (z1 != z2)
+    return (z1 < z2) ? -1 : 1;
+  return tbox_cmp(b1, b2);
+}
+
+/**
+ * Convert a temporal box into its key in a space-filling curve
+ */
+static Datum
+tbox_gist_abbrev_convert(Datum original,
+  SortSupport ssup __attribute__((unused)))
+{
+  return UInt64GetDatum(tbox_zorder_key(DatumGetTboxP(original)));
+}
+
+PG_FUNCTION_INFO_V1(Tbox_gist_sortsupport);
+/**
+ * GiST sortsupport method for temporal numbers
+ *
+ * The keys are sorted according to a Z-order curve, which enables the
+ * sorted build of the index available since PostgreSQL 14
+ */
+PGDLLEXPORT Datum
+Tbox_gist_sortsupport(PG_FUNCTION_ARGS)
+{
+  SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+#if SIZEOF_DATUM == 8
+  if (ssup->abbreviate)
+  {
+    ssup->comparator = &gist_zorder_cmp_abbrev;
+    ssup->abbrev_converter = &tbox_gist_abbrev_convert;
+    ssup->abbrev_abort = &gist_zorder_abbrev_abort;
+    ssup->abbrev_full_comparator = &tbox_gist_cmp_full;
+  }
+  else
+#endif
+    ssup->comparator = &tbox_gist_cmp_full;
+  PG_RETURN_VOID();
+}
+#endif /* POSTGRESQL_VERSION_NUMBER >= 140000 */
+
 /*****************************************************************************
  * GiST distance method
  *****************************************************************************/
@@ -1084,7 +1123,7 @@ Tbox_gist_distance(PG_FUNCTION_ARGS)
     PG_RETURN_FLOAT8(DBL_MAX);
 
   /* Transform the query into a box */
-  if (! tnumber_gist_get_tbox(fcinfo, &query, typid))
+  if (! tnumber_index_get_tbox(PG_GETARG_DATUM(1), typid, &query))
     PG_RETURN_FLOAT8(DBL_MAX);
 
   /* Since we only have boxes we'll return the minimum possible distance,
@@ -724,7 +724,7 @@ tnumber_const_to_tbox(const Node *other, TBOX *box)
   else if (type == T_TBOX)
     memcpy(box, DatumGetTboxP(((Const *) other)->constvalue), sizeof(TBOX));
   else if (tnumber_type(type))
-    temporal_bbox(DatumGetTemporalP(((Const *) other)->constvalue), box);
+    temporal_bbox_slice(((Const *) other)->constvalue, box);
   else
     return false;
   return true;
@@ -223,13 +223,90 @@ tsequence_bbox(const TSequence *seq, void *box)
 /**
  * Return a pointer to the offsets array of the temporal value
  */
-static size_t *
+size_t *
 tsequence_offsets_ptr(const TSequence *seq)
 {
   return (size_t *)(((char *)seq) + double_pad(sizeof(TSequence)) +
     double_pad(seq->bboxsize));
 }
 
+/**
+ * Return the number of instants for which the temporal value has space
+ *
+ * An expandable sequence with free slots keeps this number in the first
+ * unused entry of its offsets array, so that the header and the layout of
+ * the other sequences are not changed.
+ */
+static int
+tsequence_maxcount(const TSequence *seq)
+{
+  if (! MOBDB_FLAGS_GET_EXPANDABLE(seq->flags))
+    return seq->count;
+  return (int) (tsequence_offsets_ptr(seq))[seq->count];
+}
+
+/**
+ * Set the number of instants for which the temporal value has space
+ */
+static void
+tsequence_set_maxcount(TSequence *seq, int maxcount)
+{
+  assert(maxcount >= seq->count);
+  MOBDB_FLAGS_SET_EXPANDABLE(seq->flags, maxcount > seq->count);
+  if (maxcount > seq->count)
+    (tsequence_offsets_ptr(seq))[seq->count] = (size_t) maxcount;
+  return;
+}
+
+/**
+ * Return a pointer to the time index of the temporal value, which keeps the
+ * timestamp of every `tindexblock`-th instant
+ */
+TimestampTz *
+tsequence_tindex_ptr(const TSequence *seq)
+{
+  return (TimestampTz *)(((char *)seq) + double_pad(sizeof(TSequence)) +
+    seq->bboxsize + tsequence_maxcount(seq) * sizeof(size_t));
+}
+
+/**
+ * Return the number of instants per entry of the time index of a temporal
+ * sequence value with the given number of instants, 0 if no index is built
+ */
+int16
+tsequence_tindex_block(int count)
+{
+  return (count >= MOBDB_TINDEX_MINCOUNT) ? MOBDB_TINDEX_BLOCK : 0;
+}
+
+/**
+ * Return the size of the time index of a temporal sequence value
+ *
+ * @param[in] count Number of instants of the sequence
+ * @param[in] block Number of instants per entry of the index
+ */
+size_t
+tsequence_tindex_size(int count, int16 block)
+{
+  if (block == 0 || count == 0)
+    return 0;
+  return ((count - 1) / block + 1) * sizeof(TimestampTz);
+}
+
+/**
+ * Fill the time index of the temporal value from its composing instants
+ */
+void
+tsequence_tindex_build(TSequence *seq)
+{
+  if (seq->tindexblock == 0)
+    return;
+  TimestampTz *tindex = tsequence_tindex_ptr(seq);
+  for (int i = 0; i < seq->count; i += seq->tindexblock)
+    tindex[i / seq->tindexblock] = tsequence_inst_n(seq, i)->t;
+  return;
+}
+
 /**
  * @ingroup libmeos_temporal_acessor
  * @brief Return the n-th instant of the temporal value.
@@ -237,10 +314,12 @@ tsequence_offsets_ptr(const TSequence *seq)
 const TInstant *
 tsequence_inst_n(const TSequence *seq, int index)
 {
+  int maxcount = tsequence_maxcount(seq);
   return (TInstant *)(
     /* start of data */
     ((char *)seq) + double_pad(sizeof(TSequence)) + seq->bboxsize +
-      seq->count * sizeof(size_t) +
+      maxcount * sizeof(size_t) +
+      tsequence_tindex_size(maxcount, seq->tindexblock) +
       /* offset */
       (tsequence_offsets_ptr(seq))[index]);
 }
@@ -357,19 +436,41 @@ tinstarr_normalize(const TInstant **instants, bool linear, int count,
  * -------------------------------------
  * @endcode
  * where the `X` are unused bytes added for double padding, `offset_0` and
- * `offset_1` are offsets for the corresponding instants
+ * `offset_1` are offsets for the corresponding instants.
+ *
+ * An expandable sequence reserves space for `maxcount` offsets and for
+ * `maxcount - count` additional instants of the same size as the last one,
+ * so that instants can be appended in place without copying the whole value.
+ * It is only used in memory: it has the expandable flag set and keeps
+ * `maxcount` in the first unused offset, while a sequence without free
+ * slots has the same layout as any other sequence.
+ *
+ * A sequence without free slots and with at least `MOBDB_TINDEX_MINCOUNT`
+ * instants stores after the offsets a time index with the timestamp of every
+ * `MOBDB_TINDEX_BLOCK`-th instant, which is used by
+ * #tsequence_find_timestamp to locate a timestamp without touching the
+ * instants outside of a single block.
  *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] maxcount Maximum number of elements in the array
+ * @param[in] lower_inc,upper_inc True when the respective bound is inclusive
+ * @param[in] linear True when the interpolation is linear
+ * @param[in] normalize True when the resulting value should be normalized
  * @pre The validity of the arguments has been tested before
  */
-TSequence *
-tsequence_make1(const TInstant **instants, int count, bool lower_inc,
-  bool upper_inc, bool linear, bool normalize)
+static TSequence *
+tsequence_make_exp1(const TInstant **instants, int count, int maxcount,
+  bool lower_inc, bool upper_inc, bool linear, bool normalize)
 {
+  assert(maxcount >= count);
   /* Normalize the array of instants */
   TInstant **norminsts = (TInstant **) instants;
   int newcount = count;
   if (normalize && count > 1)
     norminsts = tinstarr_normalize(instants, linear, count, &newcount);
+  /* Keep the requested number of free slots after normalization */
+  int newmaxcount = newcount + (maxcount - count);
 
   /* Get the bounding box size */
   size_t bboxsize = double_pad(temporal_bbox_size(instants[0]->temptype));
@@ -380,8 +481,17 @@ tsequence_make1(const TInstant **instants, int count, bool lower_inc,
   /* Size of composing instants */
   for (int i = 0; i < newcount; i++)
     memsize += double_pad(VARSIZE(norminsts[i]));
+  /* Size of the free slots, estimated from the last instant */
+  memsize += (newmaxcount - newcount) *
+    double_pad(VARSIZE(norminsts[newcount - 1]));
+  /* Size of the time index, which is only built when there are no free
+   * slots since in-place appends would invalidate it */
+  int16 tindexblock = (newmaxcount == newcount) ?
+    tsequence_tindex_block(newcount) : 0;
+  size_t tindexsize = tsequence_tindex_size(newcount, tindexblock);
+  memsize += tindexsize;
   /* Size of the struct and the offset array */
-  memsize += double_pad(sizeof(TSequence)) + newcount * sizeof(size_t);
+  memsize += double_pad(sizeof(TSequence)) + newmaxcount * sizeof(size_t);
   /* Create the temporal sequence */
   TSequence *result = palloc0(memsize);
   SET_VARSIZE(result, memsize);
@@ -389,6 +499,7 @@ tsequence_make1(const TInstant **instants, int count, bool lower_inc,
   result->temptype = instants[0]->temptype;
   result->subtype = SEQUENCE;
   result->bboxsize = bboxsize;
+  result->tindexblock = tindexblock;
   period_set(norminsts[0]->t, norminsts[newcount - 1]->t, lower_inc, upper_inc,
     &result->period);
   MOBDB_FLAGS_SET_CONTINUOUS(result->flags,
@@ -415,7 +526,7 @@ tsequence_make1(const TInstant **instants, int count, bool lower_inc,
   }
   /* Store the composing instants */
   size_t pdata = double_pad(sizeof(TSequence)) + double_pad(bboxsize) +
-    newcount * sizeof(size_t);
+    newmaxcount * sizeof(size_t) + tindexsize;
   size_t pos = 0;
   for (int i = 0; i < newcount; i++)
   {
@@ -424,11 +535,55 @@ tsequence_make1(const TInstant **instants, int count, bool lower_inc,
     (tsequence_offsets_ptr(result))[i] = pos;
     pos += double_pad(VARSIZE(norminsts[i]));
   }
+  tsequence_set_maxcount(result, newmaxcount);
+  /* Store the time index */
+  tsequence_tindex_build(result);
   if (normalize && count > 1)
     pfree(norminsts);
   return result;
 }
 
+/**
+ * Construct a temporal sequence value from the array of temporal
+ * instant values
+ *
+ * @pre The validity of the arguments has been tested before
+ */
+TSequence *
+tsequence_make1(const TInstant **instants, int count, bool lower_inc,
+  bool upper_inc, bool linear, bool normalize)
+{
+  return tsequence_make_exp1(instants, count, count, lower_inc, upper_inc,
+    linear, normalize);
+}
+
+/**
+ * @ingroup libmeos_temporal_constructor
+ * @brief Construct an expandable temporal sequence value from the array of
+ * temporal instant values.
+ *
+ * The result has free space for `maxcount - count` additional instants, which
+ * are filled in place by #tsequence_append_tinstant when called with the
+ * `expand` argument set to true.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] maxcount Maximum number of elements in the array
+ * @param[in] lower_inc,upper_inc True when the respective bound is inclusive
+ * @param[in] linear True when the interpolation is linear
+ * @param[in] normalize True when the resulting value should be normalized
+ */
+TSequence *
+tsequence_make_exp(const TInstant **instants, int count, int maxcount,
+  bool lower_inc, bool upper_inc, bool linear, bool normalize)
+{
+  tsequence_make_valid(instants, count, lower_inc, upper_inc, linear);
+  if (maxcount < count)
+    maxcount = count;
+  return tsequence_make_exp1(instants, count, maxcount, lower_inc, upper_inc,
+    linear, normalize);
+}
+
 /**
  * @ingroup libmeos_temporal_constructor
  * @brief Construct a temporal sequence value from the array of temporal
@@ -487,6 +642,24 @@ tsequence_copy(const TSequence *seq)
   return result;
 }
 
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a copy of the temporal value without the free space
+ * reserved for appending instants.
+ */
+TSequence *
+tsequence_compact(const TSequence *seq)
+{
+  const TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  for (int i = 0; i < seq->count; i++)
+    instants[i] = tsequence_inst_n(seq, i);
+  TSequence *result = tsequence_make1(instants, seq->count,
+    seq->period.lower_inc, seq->period.upper_inc,
+    MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE_NO);
+  pfree(instants);
+  return result;
+}
+
 /**
  * Join the two temporal sequence values
  *
@@ -517,9 +690,52 @@ tsequence_join(const TSequence *seq1, const TSequence *seq2,
   return result;
 }
 
+/**
+ * Return the index of the last entry of a time index that is less than or
+ * equal to the timestamp, -1 if the timestamp is before the first entry
+ *
+ * The search alternates interpolation and bisection steps, so that it
+ * usually takes a single probe when the instants are sampled at regular
+ * intervals while keeping a logarithmic worst case.
+ *
+ * @param[in] tindex Time index
+ * @param[in] count Number of entries of the index
+ * @param[in] t Timestamp
+ */
+int
+tsequence_tindex_find(const TimestampTz *tindex, int count, TimestampTz t)
+{
+  int first = 0;
+  int last = count - 1;
+  if (t < tindex[first])
+    return -1;
+  bool interpolate = true;
+  /* Invariant: tindex[first] <= t */
+  while (first < last)
+  {
+    if (t >= tindex[last])
+      return last;
+    /* Here tindex[first] <= t < tindex[last] and thus first <= middle < last */
+    int middle = interpolate ?
+      first + (int) ((double) (t - tindex[first]) /
+        (double) (tindex[last] - tindex[first]) * (last - first)) :
+      (first + last) / 2;
+    middle = Max(first, Min(middle, last - 1));
+    if (t < tindex[middle])
+      last = middle;
+    else if (t >= tindex[middle + 1])
+      first = middle + 1;
+    else
+      return middle;
+    interpolate = ! interpolate;
+  }
+  return first;
+}
+
 /**
  * Return the index of the segment of the temporal sequence value
- * containing the timestamp using binary search
+ * containing the timestamp using binary search, restricted to a single
+ * block of instants when the sequence has a time index
  *
  * If the timestamp is contained in the temporal value, the index of the
  * segment containing the timestamp is returned in the output parameter.
@@ -544,6 +760,16 @@ tsequence_find_timestamp(const TSequence *seq, TimestampTz t)
 {
   int first = 0;
   int last = seq->count - 1;
+  /* Restrict the search to a single block of the time index, if any */
+  if (seq->tindexblock != 0)
+  {
+    int block = tsequence_tindex_find(tsequence_tindex_ptr(seq),
+      (seq->count - 1) / seq->tindexblock + 1, t);
+    if (block < 0)
+      return -1;
+    first = block * seq->tindexblock;
+    last = Min(first + seq->tindexblock, seq->count - 1);
+  }
   int middle = (first + last)/2;
   while (first <= last)
   {
@@ -601,12 +827,91 @@ tseqarr2_to_tseqarr(TSequence ***sequences, int *countseqs,
  * Append and merge functions
  *****************************************************************************/
 
+/**
+ * Expand the bounding box of the temporal sequence value with the last
+ * segment, after the last instant has been appended in place
+ */
+static void
+tsequence_expand_bbox(TSequence *seq)
+{
+  /* Only external types have bounding box */
+  if (seq->bboxsize == 0)
+    return;
+  void *box = tsequence_bbox_ptr(seq);
+  if (talpha_type(seq->temptype))
+  {
+    memcpy(box, &seq->period, sizeof(Period));
+    return;
+  }
+  /* Compute the box of the last segment to take into account the
+   * interpolation of geography and network points */
+  const TInstant *instants[2];
+  instants[0] = tsequence_inst_n(seq, seq->count - 2);
+  instants[1] = tsequence_inst_n(seq, seq->count - 1);
+  bboxunion box1;
+  tsequence_make_bbox(instants, 2, true, true,
+    MOBDB_FLAGS_GET_LINEAR(seq->flags), &box1);
+  if (tnumber_type(seq->temptype))
+    tbox_expand(&box1.b, (TBOX *) box);
+  else /* tspatial_type(seq->temptype) */
+    stbox_expand(&box1.g, (STBOX *) box);
+  return;
+}
+
+/**
+ * Append an instant in place to an expandable temporal sequence value
+ *
+ * @param[in,out] seq Temporal sequence value
+ * @param[in] inst Temporal instant value
+ * @param[in] removelast True when the new instant replaces the last one
+ * @result Return false if there is not enough space in the sequence
+ */
+static bool
+tsequence_append_tinstant_inplace(TSequence *seq, const TInstant *inst,
+  bool removelast)
+{
+  int n = removelast ? seq->count - 1 : seq->count;
+  int maxcount = tsequence_maxcount(seq);
+  if (n >= maxcount || seq->tindexblock != 0)
+    return false;
+  /* Determine whether there is enough free space after the last instant */
+  size_t *offsets = tsequence_offsets_ptr(seq);
+  const TInstant *last = tsequence_inst_n(seq, seq->count - 1);
+  size_t pos = removelast ? offsets[seq->count - 1] :
+    offsets[seq->count - 1] + double_pad(VARSIZE(last));
+  size_t pdata = double_pad(sizeof(TSequence)) + seq->bboxsize +
+    maxcount * sizeof(size_t);
+  if (pdata + pos + double_pad(VARSIZE(inst)) > VARSIZE(seq))
+    return false;
+  /* Store the instant and update the header */
+  memcpy(((char *) seq) + pdata + pos, inst, VARSIZE(inst));
+  offsets[n] = pos;
+  seq->count = n + 1;
+  tsequence_set_maxcount(seq, maxcount);
+  seq->period.upper = inst->t;
+  seq->period.upper_inc = true;
+  tsequence_expand_bbox(seq);
+  return true;
+}
+
 /**
  * @ingroup libmeos_temporal_transf
  * @brief Append an instant to the temporal value.
+ *
+ * When `expand` is true the instant is appended in place if the sequence
+ * has enough free space, and otherwise a new sequence with twice the
+ * capacity is returned, so that successive appends cost amortized
+ * constant time. In both cases only the last two instants are inspected
+ * for normalizing the result.
+ *
+ * @param[in,out] seq Temporal value
+ * @param[in] inst Temporal instant value
+ * @param[in] expand True when the sequence is expanded in place
+ * @note When `expand` is true and the result is not the input sequence, the
+ * input sequence may be freed by the calling function
  */
 Temporal *
-tsequence_append_tinstant(const TSequence *seq, const TInstant *inst)
+tsequence_append_tinstant(TSequence *seq, const TInstant *inst, bool expand)
 {
   /* Ensure validity of the arguments */
   assert(seq->temptype == inst->temptype);
@@ -646,10 +951,14 @@ tsequence_append_tinstant(const TSequence *seq, const TInstant *inst)
       pfree(sequences[1]);
       return (Temporal *) result;
     }
+    /* The instant is already the inclusive upper bound of the sequence */
+    if (seq->period.upper_inc)
+      return expand ? (Temporal *) seq : (Temporal *) tsequence_copy(seq);
   }
 
   /* The result is a sequence */
   int count = seq->count + 1;
+  bool removelast = false;
   if (seq->count > 1)
   {
     /* Normalize the result */
@@ -678,16 +987,27 @@ tsequence_append_tinstant(const TSequence *seq, const TInstant *inst)
     {
       /* The new instant replaces the last instant of the sequence */
       count--;
+      removelast = true;
     }
   }
 
+  /* Try to append the instant in place */
+  int maxcount = count;
+  if (expand)
+  {
+    if (tsequence_append_tinstant_inplace(seq, inst, removelast))
+      return (Temporal *) seq;
+    /* Double the capacity of the sequence */
+    maxcount = Max(count, tsequence_maxcount(seq) * 2);
+  }
+
   const TInstant **instants = palloc(sizeof(TInstant *) * count);
   int k = 0;
   for (int i = 0; i < count - 1; i++)
     instants[k++] = tsequence_inst_n(seq, i);
   instants[k++] = inst;
-  TSequence *result = tsequence_make1(instants, count, seq->period.lower_inc,
-    true, MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE_NO);
+  TSequence *result = tsequence_make_exp1(instants, count, maxcount,
+    seq->period.lower_inc, true, linear, NORMALIZE_NO);
   pfree(instants);
   return (Temporal *) result;
 }
@@ -897,40 +1217,120 @@ tsequence_merge_array(const TSequence **sequences, int count)
  *****************************************************************************/
 
 /**
- * Synchronize two temporal values
+ * Keep track of an instant created by a synchronization iterator
+ */
+static const TInstant *
+tsequence_sync_own(TSequenceSyncIter *iter, TInstant *inst)
+{
+  assert(iter->nowned < SYNC_ITER_MAXOWNED);
+  iter->owned[iter->nowned++] = inst;
+  return inst;
+}
+
+/**
+ * Free the instants created by a synchronization iterator that are no longer
+ * referenced by the iterator
+ */
+static void
+tsequence_sync_release(TSequenceSyncIter *iter)
+{
+  int k = 0;
+  for (int l = 0; l < iter->nowned; l++)
+  {
+    TInstant *inst = iter->owned[l];
+    if (inst == iter->prev1 || inst == iter->prev2 || inst == iter->inst1 ||
+        inst == iter->inst2 || inst == iter->next1 || inst == iter->next2)
+      iter->owned[k++] = inst;
+    else
+      pfree(inst);
+  }
+  iter->nowned = k;
+  return;
+}
+
+/**
+ * Initialize an iterator that walks two temporal sequences in lockstep on
+ * the intersection of their time spans
  *
- * The resulting values are composed of denormalized sequences covering the
- * intersection of their time spans. The argument crossings determines
- * whether potential crossings between successive pair of instants are added.
- * Crossings are only added when at least one of the sequences has linear
- * interpolation.
+ * The iterator does not materialize the synchronized sequences: at any
+ * moment only the previous and the current pair of instants, and the pair
+ * pending after a crossing, are kept. The argument crossings determines
+ * whether potential crossings between successive pair of instants are
+ * yielded. Crossings are only yielded when at least one of the sequences
+ * has linear interpolation.
  *
+ * @param[out] iter Iterator
  * @param[in] seq1,seq2 Input values
- * @param[out] sync1,sync2 Output values
- * @param[in] crossings State whether turning points are added in the segments
+ * @param[in] crossings State whether crossings are yielded
  * @result Return false if the input values do not overlap on time
  */
 bool
-synchronize_tsequence_tsequence(const TSequence *seq1, const TSequence *seq2,
-  TSequence **sync1, TSequence **sync2, bool crossings)
+tsequence_sync_init(TSequenceSyncIter *iter, const TSequence *seq1,
+  const TSequence *seq2, bool crossings)
 {
+  memset(iter, 0, sizeof(TSequenceSyncIter));
   /* Test whether the bounding period of the two temporal values overlap */
-  Period inter;
-  if (! inter_period_period(&seq1->period, &seq2->period, &inter))
+  if (! inter_period_period(&seq1->period, &seq2->period, &iter->inter))
     return false;
 
-  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
-  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
-  TInstant *inst1, *inst2;
+  iter->seq1 = seq1;
+  iter->seq2 = seq2;
+  iter->linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
+  iter->linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  iter->crossings = crossings && (iter->linear1 || iter->linear2);
+  if (iter->inter.lower == iter->inter.upper)
+    return true;
+  /* Position the iterator on the first instant after the lower bound of the
+   * intersection in the sequence that starts before */
+  if (tsequence_inst_n(seq1, 0)->t < iter->inter.lower)
+    iter->i = tsequence_find_timestamp(seq1, iter->inter.lower) + 1;
+  else if (tsequence_inst_n(seq2, 0)->t < iter->inter.lower)
+    iter->j = tsequence_find_timestamp(seq2, iter->inter.lower) + 1;
+  return true;
+}
+
+/**
+ * Advance a synchronization iterator to the next pair of instants
+ *
+ * After the call, the fields inst1 and inst2 of the iterator contain the
+ * current pair of synchronized instants and the fields prev1 and prev2
+ * contain the previous pair, or NULL for the first pair. The field last is
+ * true when the current pair is the last one. As in function
+ * synchronize_tsequence_tsequence, the last two values of a sequence with
+ * step interpolation and exclusive upper bound are equal.
+ *
+ * @result Return false when all the pairs have been yielded
+ */
+bool
+tsequence_sync_next(TSequenceSyncIter *iter)
+{
+  /* Yield the pair pending after a crossing */
+  if (iter->next1 != NULL)
+  {
+    iter->prev1 = iter->inst1; iter->prev2 = iter->inst2;
+    iter->inst1 = iter->next1; iter->inst2 = iter->next2;
+    iter->next1 = iter->next2 = NULL;
+    iter->last = iter->nextlast;
+    tsequence_sync_release(iter);
+    return true;
+  }
+  if (iter->last)
+    return false;
+
+  iter->prev1 = iter->inst1; iter->prev2 = iter->inst2;
+  iter->inst1 = iter->inst2 = NULL;
+  tsequence_sync_release(iter);
 
+  const TSequence *seq1 = iter->seq1;
+  const TSequence *seq2 = iter->seq2;
   /* If the two sequences intersect at an instant */
-  if (inter.lower == inter.upper)
+  if (iter->inter.lower == iter->inter.upper)
   {
-    inst1 = tsequence_at_timestamp(seq1, inter.lower);
-    inst2 = tsequence_at_timestamp(seq2, inter.lower);
-    *sync1 = tinstant_tsequence(inst1, linear1);
-    *sync2 = tinstant_tsequence(inst2, linear2);
-    pfree(inst1); pfree(inst2);
+    iter->inst1 = tsequence_sync_own(iter,
+      tsequence_at_timestamp(seq1, iter->inter.lower));
+    iter->inst2 = tsequence_sync_own(iter,
+      tsequence_at_timestamp(seq2, iter->inter.lower));
+    iter->last = true;
     return true;
   }
 
@@ -940,96 +1340,133 @@ synchronize_tsequence_tsequence(const TSequence *seq1, const TSequence *seq2,
    * seq2 =       <*            *     * ...
    * sync1 =      <X C * C * C X C X C *>
    * sync2 =      <* C X C X C * C * C X>
-   * where X are values added for synchronization and C are values added
-   * for the crossings
+   * where X are values interpolated for synchronization and C are values
+   * computed at the crossings. The interpolation is done on the segment
+   * ending at the next instant, which avoids searching the timestamp in
+   * the sequence.
    */
-  inst1 = (TInstant *) tsequence_inst_n(seq1, 0);
-  inst2 = (TInstant *) tsequence_inst_n(seq2, 0);
-  int i = 0, j = 0, k = 0, l = 0;
-  if (inst1->t < inter.lower)
+  const TInstant *inst1 = tsequence_inst_n(seq1, iter->i);
+  const TInstant *inst2 = tsequence_inst_n(seq2, iter->j);
+  int cmp = timestamp_cmp_internal(inst1->t, inst2->t);
+  if (cmp == 0)
   {
-    i = tsequence_find_timestamp(seq1, inter.lower) + 1;
-    inst1 = (TInstant *) tsequence_inst_n(seq1, i);
+    iter->i++; iter->j++;
   }
-  else if (inst2->t < inter.lower)
+  else if (cmp < 0)
   {
-    j = tsequence_find_timestamp(seq2, inter.lower) + 1;
-    inst2 = (TInstant *) tsequence_inst_n(seq2, j);
+    iter->i++;
+    inst2 = tsequence_sync_own(iter, tsegment_at_timestamp(
+      tsequence_inst_n(seq2, iter->j - 1), inst2, iter->linear2, inst1->t));
   }
-  int count = (seq1->count - i + seq2->count - j) * 2;
-  TInstant **instants1 = palloc(sizeof(TInstant *) * count);
-  TInstant **instants2 = palloc(sizeof(TInstant *) * count);
-  TInstant **tofree = palloc(sizeof(TInstant *) * count * 2);
-  CachedType basetype1 = temptype_basetype(seq1->temptype);
-  CachedType basetype2 = temptype_basetype(seq2->temptype);
-  while (i < seq1->count && j < seq2->count &&
-    (inst1->t <= inter.upper || inst2->t <= inter.upper))
-  {
-    int cmp = timestamp_cmp_internal(inst1->t, inst2->t);
-    if (cmp == 0)
-    {
-      i++; j++;
-    }
-    else if (cmp < 0)
-    {
-      i++;
-      inst2 = tsequence_at_timestamp(seq2, inst1->t);
-      tofree[l++] = inst2;
-    }
-    else
+  else
+  {
+    iter->j++;
+    inst1 = tsequence_sync_own(iter, tsegment_at_timestamp(
+      tsequence_inst_n(seq1, iter->i - 1), inst1, iter->linear1, inst2->t));
+  }
+  bool last = (iter->i == seq1->count || iter->j == seq2->count);
+
+  /* If not the first pair compute the potential crossing before the new
+   * instants */
+  const TInstant *cross1 = NULL, *cross2 = NULL;
+  if (iter->crossings && iter->prev1 != NULL)
+  {
+    TimestampTz crosstime;
+    Datum inter1, inter2;
+    if (tsegment_intersection(iter->prev1, inst1, iter->linear1,
+      iter->prev2, inst2, iter->linear2, &inter1, &inter2, &crosstime))
     {
-      j++;
-      inst1 = tsequence_at_timestamp(seq1, inst2->t);
-      tofree[l++] = inst1;
+      cross1 = tsequence_sync_own(iter, tinstant_make(inter1, crosstime,
+        seq1->temptype));
+      cross2 = tsequence_sync_own(iter, tinstant_make(inter2, crosstime,
+        seq2->temptype));
     }
-    /* If not the first instant add potential crossing before adding
-       the new instants */
-    if (crossings && (linear1 || linear2) && k > 0)
-    {
-      TimestampTz crosstime;
-      Datum inter1, inter2;
-      if (tsegment_intersection(instants1[k - 1], inst1, linear1,
-        instants2[k - 1], inst2, linear2, &inter1, &inter2, &crosstime))
-      {
-        instants1[k] = tofree[l++] = tinstant_make(inter1, crosstime,
-          seq1->temptype);
-        instants2[k++] = tofree[l++] = tinstant_make(inter2, crosstime,
-          seq2->temptype);
-      }
-    }
-    instants1[k] = inst1; instants2[k++] = inst2;
-    if (i == seq1->count || j == seq2->count)
-      break;
-    inst1 = (TInstant *) tsequence_inst_n(seq1, i);
-    inst2 = (TInstant *) tsequence_inst_n(seq2, j);
   }
-  /* We are sure that k != 0 due to the period intersection test above */
+
   /* The last two values of sequences with step interpolation and
      exclusive upper bound must be equal */
-  if (! inter.upper_inc && k > 1 && ! linear1 &&
-      datum_ne(tinstant_value(instants1[k - 2]),
-        tinstant_value(instants1[k - 1]), basetype1))
+  if (last && ! iter->inter.upper_inc && iter->prev1 != NULL)
+  {
+    const TInstant *before1 = (cross1 != NULL) ? cross1 : iter->prev1;
+    const TInstant *before2 = (cross2 != NULL) ? cross2 : iter->prev2;
+    if (! iter->linear1 && datum_ne(tinstant_value(before1),
+        tinstant_value(inst1), temptype_basetype(seq1->temptype)))
+      inst1 = tsequence_sync_own(iter, tinstant_make(tinstant_value(before1),
+        inst1->t, inst1->temptype));
+    if (! iter->linear2 && datum_ne(tinstant_value(before2),
+        tinstant_value(inst2), temptype_basetype(seq2->temptype)))
+      inst2 = tsequence_sync_own(iter, tinstant_make(tinstant_value(before2),
+        inst2->t, inst2->temptype));
+  }
+
+  if (cross1 != NULL)
   {
-    instants1[k - 1] = tinstant_make(tinstant_value(instants1[k - 2]),
-      instants1[k - 1]->t, instants1[k - 1]->temptype);
-    tofree[l++] = instants1[k - 1];
+    iter->inst1 = cross1; iter->inst2 = cross2;
+    iter->next1 = inst1; iter->next2 = inst2;
+    iter->nextlast = last;
+    iter->last = false;
   }
-  if (! inter.upper_inc && k > 1 && ! linear2 &&
-      datum_ne(tinstant_value(instants2[k - 2]),
-        tinstant_value(instants2[k - 1]), basetype2))
+  else
   {
-    instants2[k - 1] = tinstant_make(tinstant_value(instants2[k - 2]),
-      instants2[k - 1]->t, instants2[k - 1]->temptype);
-    tofree[l++] = instants2[k - 1];
+    iter->inst1 = inst1; iter->inst2 = inst2;
+    iter->last = last;
   }
-  *sync1 = tsequence_make((const TInstant **) instants1, k, inter.lower_inc,
-    inter.upper_inc, linear1, NORMALIZE_NO);
-  *sync2 = tsequence_make((const TInstant **) instants2, k, inter.lower_inc,
-    inter.upper_inc, linear2, NORMALIZE_NO);
+  return true;
+}
 
-  pfree_array((void **) tofree, l);
-  pfree(instants1); pfree(instants2);
+/**
+ * Free the instants created by a synchronization iterator
+ */
+void
+tsequence_sync_end(TSequenceSyncIter *iter)
+{
+  iter->prev1 = iter->prev2 = iter->inst1 = iter->inst2 = NULL;
+  iter->next1 = iter->next2 = NULL;
+  tsequence_sync_release(iter);
+  return;
+}
+
+/**
+ * Synchronize two temporal values
+ *
+ * The resulting values are composed of denormalized sequences covering the
+ * intersection of their time spans. The argument crossings determines
+ * whether potential crossings between successive pair of instants are added.
+ * Crossings are only added when at least one of the sequences has linear
+ * interpolation.
+ *
+ * @param[in] seq1,seq2 Input values
+ * @param[out] sync1,sync2 Output values
+ * @param[in] crossings State whether turning points are added in the segments
+ * @result Return false if the input values do not overlap on time
+ * @note Functions that consume the synchronized values segment by segment
+ * should rather use the iterator in function tsequence_sync_next
+ */
+bool
+synchronize_tsequence_tsequence(const TSequence *seq1, const TSequence *seq2,
+  TSequence **sync1, TSequence **sync2, bool crossings)
+{
+  TSequenceSyncIter iter;
+  if (! tsequence_sync_init(&iter, seq1, seq2, crossings))
+    return false;
 
+  int count = (seq1->count + seq2->count) * 2;
+  TInstant **instants1 = palloc(sizeof(TInstant *) * count);
+  TInstant **instants2 = palloc(sizeof(TInstant *) * count);
+  int k = 0;
+  /* The instants are copied since the iterator frees the instants it has
+   * created once they are no longer needed */
+  while (tsequence_sync_next(&iter))
+  {
+    instants1[k] = tinstant_copy(iter.inst1);
+    instants2[k++] = tinstant_copy(iter.inst2);
+  }
+  tsequence_sync_end(&iter);
+  /* We are sure that k != 0 due to the period intersection test above */
+  *sync1 = tsequence_make_free(instants1, k, iter.inter.lower_inc,
+    iter.inter.upper_inc, iter.linear1, NORMALIZE_NO);
+  *sync2 = tsequence_make_free(instants2, k, iter.inter.lower_inc,
+    iter.inter.upper_inc, iter.linear2, NORMALIZE_NO);
   return true;
 }
 
@@ -1667,6 +2104,8 @@ tsequence_shift_tscale(const TSequence *seq, const Interval *start,
     inst = (TInstant *) tsequence_inst_n(result, seq->count - 1);
     inst->t = result->period.upper;
   }
+  /* Update the time index */
+  tsequence_tindex_build(result);
   /* Shift and/or scale bounding box */
   void *bbox = tsequence_bbox_ptr(result);
   temporal_bbox_shift_tscale(bbox, start, duration, seq->temptype);
@@ -2025,7 +2464,8 @@ tsequence_instants(const TSequence *seq)
 TimestampTz
 tsequence_start_timestamp(const TSequence *seq)
 {
-  return (tsequence_inst_n(seq, 0))->t;
+  /* The period is used so that the function works for any storage */
+  return seq->period.lower;
 }
 
 /**
@@ -2035,7 +2475,7 @@ tsequence_start_timestamp(const TSequence *seq)
 TimestampTz
 tsequence_end_timestamp(const TSequence *seq)
 {
-  return (tsequence_inst_n(seq, seq->count - 1))->t;
+  return seq->period.upper;
 }
 
 /**
@@ -423,17 +423,53 @@ tsequenceset_find_timestamp(const TSequenceSet *ts, TimestampTz t, int *loc)
  * Append and merge functions
  *****************************************************************************/
 
+/**
+ * Expand the bounding box of the temporal sequence set value with the one of
+ * its last sequence, after an instant has been appended to it in place
+ */
+static void
+tsequenceset_expand_bbox(TSequenceSet *ts, const TSequence *seq)
+{
+  /* Only external types have bounding box */
+  if (ts->bboxsize == 0)
+    return;
+  void *box = tsequenceset_bbox_ptr(ts);
+  if (talpha_type(ts->temptype))
+    period_expand(&seq->period, (Period *) box);
+  else if (tnumber_type(ts->temptype))
+    tbox_expand((TBOX *) tsequence_bbox_ptr(seq), (TBOX *) box);
+  else /* tspatial_type(ts->temptype) */
+    stbox_expand((STBOX *) tsequence_bbox_ptr(seq), (STBOX *) box);
+  return;
+}
+
 /**
  * @ingroup libmeos_temporal_transf
  * @brief Append an instant to the temporal value.
+ *
+ * When `expand` is true and the last sequence has enough free space, the
+ * instant is appended in place and the input value is returned.
+ *
+ * @param[in,out] ts Temporal value
+ * @param[in] inst Temporal instant value
+ * @param[in] expand True when the sequence set is expanded in place
  */
 TSequenceSet *
-tsequenceset_append_tinstant(const TSequenceSet *ts, const TInstant *inst)
+tsequenceset_append_tinstant(TSequenceSet *ts, const TInstant *inst,
+  bool expand)
 {
   assert(ts->temptype == inst->temptype);
-  const TSequence *seq = tsequenceset_seq_n(ts, ts->count - 1);
-  Temporal *temp = tsequence_append_tinstant(seq, inst);
-  const TSequence **sequences = palloc(sizeof(TSequence *) * ts->count + 1);
+  TSequence *seq = (TSequence *) tsequenceset_seq_n(ts, ts->count - 1);
+  int count = seq->count;
+  Temporal *temp = tsequence_append_tinstant(seq, inst, expand);
+  if (temp == (Temporal *) seq)
+  {
+    /* The instant has been appended in place to the last sequence */
+    ts->totalcount += seq->count - count;
+    tsequenceset_expand_bbox(ts, seq);
+    return ts;
+  }
+  const TSequence **sequences = palloc(sizeof(TSequence *) * (ts->count + 1));
   int k = 0;
   for (int i = 0; i < ts->count - 1; i++)
     sequences[k++] = tsequenceset_seq_n(ts, i);
@@ -446,7 +482,23 @@ tsequenceset_append_tinstant(const TSequenceSet *ts, const TInstant *inst)
     sequences[k++] = tsequenceset_seq_n(ts1, 0);
     sequences[k++] = tsequenceset_seq_n(ts1, 1);
   }
-  return tsequenceset_make(sequences, k, NORMALIZE_NO);
+  TSequenceSet *result = tsequenceset_make(sequences, k, NORMALIZE_NO);
+  pfree(sequences); pfree(temp);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_transf
+ * @brief Return a copy of the temporal value without the free space
+ * reserved for appending instants.
+ */
+TSequenceSet *
+tsequenceset_compact(const TSequenceSet *ts)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_compact(tsequenceset_seq_n(ts, i));
+  return tsequenceset_make_free(sequences, ts->count, NORMALIZE_NO);
 }
 
 /**
@@ -1624,6 +1676,8 @@ tsequenceset_shift_tscale(const TSequenceSet *ts, const Interval *start,
       if (duration != NULL && seq->count > 1)
         inst->t = p2.lower + (inst->t - p2.lower) * scale;
     }
+    /* Update the time index of the sequence */
+    tsequence_tindex_build(seq);
   }
   return result;
 }
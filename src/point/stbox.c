@@ -1543,6 +1543,52 @@ stbox_ne(const STBOX *box1, const STBOX *box2)
   return ! stbox_eq(box1, box2);
 }
 
+/*****************************************************************************
+ * Space-filling curve functions
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_box_accessor
+ * @brief Return the key of a spatiotemporal box in a Z-order curve obtained
+ * by interleaving the bits of the centers of its spatial and time dimensions.
+ *
+ * @note Geodetic boxes are in geocentric coordinates and thus always use
+ * the Z dimension
+ */
+uint64
+stbox_zorder_key(const STBOX *box)
+{
+  uint32 values[4];
+  int ndims = 0;
+  if (MOBDB_FLAGS_GET_X(box->flags))
+  {
+    values[ndims++] = double_sortable_bits((box->xmin + box->xmax) / 2.0);
+    values[ndims++] = double_sortable_bits((box->ymin + box->ymax) / 2.0);
+    if (MOBDB_FLAGS_GET_Z(box->flags) || MOBDB_FLAGS_GET_GEODETIC(box->flags))
+      values[ndims++] = double_sortable_bits((box->zmin + box->zmax) / 2.0);
+  }
+  if (MOBDB_FLAGS_GET_T(box->flags))
+    values[ndims++] = timestamp_sortable_bits(box->tmin +
+      (box->tmax - box->tmin) / 2);
+  return (ndims == 0) ? 0 : zorder_key(values, ndims);
+}
+
+/**
+ * @ingroup libmeos_box_transf
+ * @brief Sort in place an array of spatiotemporal boxes according to their
+ * key in a Z-order curve.
+ *
+ * @note This function can be used for bulk-loading the boxes in an index
+ * structure in an order that preserves their proximity
+ */
+void
+stboxarr_sort_zorder(STBOX *boxes, int count)
+{
+  keyarr_sort(boxes, sizeof(STBOX), count,
+    (uint64 (*)(const void *)) &stbox_zorder_key);
+  return;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -2553,21 +2599,15 @@ Stbox_extent_transfn(PG_FUNCTION_ARGS)
   /* Can't do anything with null inputs */
   if (!box1 && !box2)
     PG_RETURN_NULL();
-  STBOX *result = (STBOX *) palloc0(sizeof(STBOX));
   /* One of the boxes is null, return the other one */
   if (!box1)
-  {
-    memcpy(result, box2, sizeof(STBOX));
-    PG_RETURN_POINTER(result);
-  }
+    PG_RETURN_POINTER(stbox_copy(box2));
   if (!box2)
-  {
-    memcpy(result, box1, sizeof(STBOX));
-    PG_RETURN_POINTER(result);
-  }
+    PG_RETURN_POINTER(box1);
 
-  /* Both boxes are not null */
-  memcpy(result, box1, sizeof(STBOX));
+  /* Both boxes are not null, expand the state in place when called as an
+   * aggregate */
+  STBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : stbox_copy(box1);
   stbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
@@ -2590,7 +2630,7 @@ Stbox_extent_combinefn(PG_FUNCTION_ARGS)
     PG_RETURN_POINTER(box2);
   /* Both boxes are not null */
   ensure_same_dimensionality(box1->flags, box2->flags);
-  STBOX *result = stbox_copy(box1);
+  STBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : stbox_copy(box1);
   stbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
@@ -466,7 +466,8 @@ PG_FUNCTION_INFO_V1(Tpoint_enforce_typmod);
 PGDLLEXPORT Datum
 Tpoint_enforce_typmod(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  /* The storage of the value is kept */
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   int32 typmod = PG_GETARG_INT32(1);
   /* Check if typmod of temporal point is consistent with the supplied one */
   temp = tpoint_valid_typmod(temp, typmod);
@@ -213,37 +213,35 @@ tpoint_transform_tcentroid(const Temporal *temp, int *count)
 PG_FUNCTION_INFO_V1(Tpoint_extent_transfn);
 /**
  * Transition function for temporal extent aggregation of temporal point values
+ *
+ * @note Only the header of the temporal point containing its bounding box is
+ * detoasted and the state is expanded in place when called as an aggregate
  */
 PGDLLEXPORT Datum
 Tpoint_extent_transfn(PG_FUNCTION_ARGS)
 {
   STBOX *box = PG_ARGISNULL(0) ? NULL : PG_GETARG_STBOX_P(0);
-  Temporal *temp = PG_ARGISNULL(1) ? NULL : PG_GETARG_TEMPORAL_P(1);
 
   /* Can't do anything with null inputs */
-  if (! box && ! temp)
+  if (! box && PG_ARGISNULL(1))
     PG_RETURN_NULL();
-  STBOX *result = palloc0(sizeof(STBOX));
-  /* Null box and non-null temporal, return the bbox of the temporal */
-  if (temp && ! box )
-  {
-    temporal_bbox(temp, result);
-    PG_RETURN_POINTER(result);
-  }
   /* Non-null box and null temporal, return the box */
-  if (box && ! temp)
-  {
-    memcpy(result, box, sizeof(STBOX));
-    PG_RETURN_POINTER(result);
-  }
+  if (PG_ARGISNULL(1))
+    PG_RETURN_POINTER(box);
+
+  STBOX box1;
+  memset(&box1, 0, sizeof(STBOX));
+  temporal_bbox_slice(PG_GETARG_DATUM(1), &box1);
+  /* Null box and non-null temporal, return the bbox of the temporal */
+  if (! box)
+    PG_RETURN_POINTER(stbox_copy(&box1));
 
   /* Both box and temporal are not null */
-  ensure_same_srid_tpoint_stbox(temp, box);
-  ensure_same_dimensionality(temp->flags, box->flags);
-  ensure_same_geodetic(temp->flags, box->flags);
-  temporal_bbox(temp, result);
-  stbox_expand(box, result);
-  PG_FREE_IF_COPY(temp, 1);
+  ensure_same_srid_stbox(box, &box1);
+  ensure_same_dimensionality(box->flags, box1.flags);
+  ensure_same_geodetic(box->flags, box1.flags);
+  STBOX *result = AggCheckCallContext(fcinfo, NULL) ? box : stbox_copy(box);
+  stbox_expand(&box1, result);
   PG_RETURN_POINTER(result);
 }
 
@@ -267,7 +265,7 @@ Tpoint_extent_combinefn(PG_FUNCTION_ARGS)
   ensure_same_srid_stbox(box1, box2);
   ensure_same_dimensionality(box1->flags, box2->flags);
   ensure_same_geodetic(box1->flags, box2->flags);
-  STBOX *result = stbox_copy(box1);
+  STBOX *result = AggCheckCallContext(fcinfo, NULL) ? box1 : stbox_copy(box1);
   stbox_expand(box2, result);
   PG_RETURN_POINTER(result);
 }
@@ -447,16 +445,18 @@ Tpoint_tcentroid_finalfn(PG_FUNCTION_ARGS)
   if (state->length == 0)
     PG_RETURN_NULL();
 
-  Temporal **values = (Temporal **) skiplist_values(state);
+  int count;
+  Temporal **values = (Temporal **) skiplist_final_values(fcinfo,
+    state, &count);
   int32_t srid = ((struct GeoAggregateState *) state->extra)->srid;
   Temporal *result = NULL;
   assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
   if (values[0]->subtype == INSTANT)
     result = (Temporal *)tpointinst_tcentroid_finalfn(
-      (TInstant **)values, state->length, srid);
+      (TInstant **)values, count, srid);
   else /* values[0]->subtype == SEQUENCE */
     result = (Temporal *)tpointseq_tcentroid_finalfn(
-      (TSequence **)values, state->length, srid);
+      (TSequence **)values, count, srid);
 
   pfree(values);
 
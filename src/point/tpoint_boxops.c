@@ -46,6 +46,8 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <float.h>
+#include <limits.h>
 #include <utils/builtins.h>
 #include <utils/timestamp.h>
 /* PostGIS */
@@ -85,6 +87,11 @@ tpointinst_stbox(const TInstant *inst, STBOX *box)
 /**
  * Set the spatiotemporal box from the array of temporal point values
  *
+ * The coordinates are gathered by chunks into contiguous buffers whose
+ * extents are computed by #doublearr_extent. As in #geo_stbox, geodetic
+ * points are converted into geocentric coordinates. Since the instants are
+ * ordered, the time extent is given by the first and the last instants.
+ *
  * @param[out] box Spatiotemporal box
  * @param[in] instants Temporal instant values
  * @param[in] count Number of elements in the array
@@ -93,13 +100,49 @@ tpointinst_stbox(const TInstant *inst, STBOX *box)
 void
 tgeompointinstarr_stbox(const TInstant **instants, int count, STBOX *box)
 {
-  tpointinst_stbox(instants[0], box);
-  for (int i = 1; i < count; i++)
+  double x[EXTENT_CHUNK], y[EXTENT_CHUNK], z[EXTENT_CHUNK];
+  double xmin = DBL_MAX, xmax = -DBL_MAX, ymin = DBL_MAX, ymax = -DBL_MAX,
+    zmin = DBL_MAX, zmax = -DBL_MAX;
+  bool hasz = MOBDB_FLAGS_GET_Z(instants[0]->flags);
+  bool geodetic = MOBDB_FLAGS_GET_GEODETIC(instants[0]->flags);
+  for (int i = 0; i < count; i += EXTENT_CHUNK)
   {
-    STBOX box1;
-    tpointinst_stbox(instants[i], &box1);
-    stbox_expand(&box1, box);
+    int n = Min(EXTENT_CHUNK, count - i);
+    if (geodetic)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        POINT3D p;
+        ll2cart(datum_point2d_p(tinstant_value(instants[i + j])), &p);
+        x[j] = p.x; y[j] = p.y; z[j] = p.z;
+      }
+    }
+    else if (hasz)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        const POINT3DZ *p = datum_point3dz_p(tinstant_value(instants[i + j]));
+        x[j] = p->x; y[j] = p->y; z[j] = p->z;
+      }
+    }
+    else
+    {
+      for (int j = 0; j < n; j++)
+      {
+        const POINT2D *p = datum_point2d_p(tinstant_value(instants[i + j]));
+        x[j] = p->x; y[j] = p->y;
+      }
+    }
+    doublearr_extent(x, n, &xmin, &xmax);
+    doublearr_extent(y, n, &ymin, &ymax);
+    if (hasz || geodetic)
+      doublearr_extent(z, n, &zmin, &zmax);
   }
+  if (! hasz && ! geodetic)
+    zmin = zmax = 0;
+  stbox_set(true, hasz, true, geodetic, tpointinst_srid(instants[0]),
+    xmin, xmax, ymin, ymax, zmin, zmax, instants[0]->t,
+    instants[count - 1]->t, box);
   return;
 }
 
@@ -207,7 +250,12 @@ tpointseqarr_stbox(const TSequence **sequences, int count, STBOX *box)
 static int
 tpointseq_stboxes1(const TSequence *seq, STBOX *result)
 {
-  assert(MOBDB_FLAGS_GET_LINEAR(seq->flags));
+  /* With step interpolation or for planar points the box of two consecutive
+   * instants also covers the segment between them. This is not the case for
+   * linear geodetic points since the great-circle arc between two points may
+   * bulge beyond their boxes, e.g., towards the poles */
+  bool geodetic = MOBDB_FLAGS_GET_GEODETIC(seq->flags) &&
+    MOBDB_FLAGS_GET_LINEAR(seq->flags);
   const TInstant *inst1;
 
   /* Instantaneous sequence */
@@ -222,11 +270,21 @@ tpointseq_stboxes1(const TSequence *seq, STBOX *result)
   inst1 = tsequence_inst_n(seq, 0);
   for (int i = 0; i < seq->count - 1; i++)
   {
-    tpointinst_stbox(inst1, &result[i]);
     const TInstant *inst2 = tsequence_inst_n(seq, i + 1);
-    STBOX box;
-    tpointinst_stbox(inst2, &box);
-    stbox_expand(&box, &result[i]);
+    if (geodetic)
+    {
+      const TInstant *instants[2];
+      instants[0] = inst1;
+      instants[1] = inst2;
+      tgeogpointinstarr_stbox(instants, 2, &result[i]);
+    }
+    else
+    {
+      tpointinst_stbox(inst1, &result[i]);
+      STBOX box;
+      tpointinst_stbox(inst2, &box);
+      stbox_expand(&box, &result[i]);
+    }
     inst1 = inst2;
   }
   return seq->count - 1;
@@ -292,6 +350,108 @@ tpoint_stboxes(const Temporal *temp, int *count)
   return result;
 }
 
+/**
+ * @ingroup libmeos_temporal_spatial_accessor
+ * @brief Return an array of at most the given number of spatiotemporal boxes
+ * covering the temporal point.
+ *
+ * The boxes of the segments, or of the instants for instantaneous values,
+ * are computed as in tpoint_stboxes and, if there are more than the maximum,
+ * groups of consecutive boxes of the same size are merged, so that the result
+ * follows the trajectory instead of covering its whole extent.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] maxcount Maximum number of boxes
+ * @param[out] count Number of elements in the output array
+ */
+STBOX *
+tpoint_split_n_stboxes(const Temporal *temp, int maxcount, int *count)
+{
+  assert(maxcount > 0);
+  STBOX *result;
+  int nboxes;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    result = palloc(sizeof(STBOX));
+    tpointinst_stbox((TInstant *) temp, &result[0]);
+    nboxes = 1;
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    result = palloc(sizeof(STBOX) * ti->count);
+    for (int i = 0; i < ti->count; i++)
+      tpointinst_stbox(tinstantset_inst_n(ti, i), &result[i]);
+    nboxes = ti->count;
+  }
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    result = palloc(sizeof(STBOX) * seq->count);
+    nboxes = tpointseq_stboxes1(seq, result);
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    result = palloc(sizeof(STBOX) * ts->totalcount);
+    nboxes = 0;
+    for (int i = 0; i < ts->count; i++)
+      nboxes += tpointseq_stboxes1(tsequenceset_seq_n(ts, i), &result[nboxes]);
+  }
+
+  /* Merge groups of consecutive boxes in place. Since the first box of the
+   * i-th group is at position i or after, the groups not yet merged are
+   * never overwritten */
+  if (nboxes > maxcount)
+  {
+    for (int i = 0; i < maxcount; i++)
+    {
+      int start = (int) (((int64) i * nboxes) / maxcount);
+      int end = (int) (((int64) (i + 1) * nboxes) / maxcount);
+      if (start != i)
+        memcpy(&result[i], &result[start], sizeof(STBOX));
+      for (int j = start + 1; j < end; j++)
+        stbox_expand(&result[j], &result[i]);
+    }
+    nboxes = maxcount;
+  }
+  *count = nboxes;
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_topo
+ * @brief Return true if the spatiotemporal box of a segment of the temporal
+ * point overlaps the spatiotemporal box.
+ *
+ * This is a finer filter than the overlap of the bounding boxes for long
+ * trajectories, whose bounding box is mostly empty space.
+ */
+bool
+overlaps_segments_tpoint_stbox(const Temporal *temp, const STBOX *box)
+{
+  STBOX box1;
+  temporal_bbox(temp, &box1);
+  if (! overlaps_stbox_stbox(&box1, box))
+    return false;
+  if (temp->subtype == INSTANT)
+    return true;
+  int count;
+  STBOX *boxes = tpoint_split_n_stboxes(temp, INT_MAX, &count);
+  bool result = false;
+  for (int i = 0; i < count; i++)
+  {
+    if (overlaps_stbox_stbox(&boxes[i], box))
+    {
+      result = true;
+      break;
+    }
+  }
+  pfree(boxes);
+  return result;
+}
+
 /*****************************************************************************
  * Generic box functions
  *****************************************************************************/
@@ -387,6 +547,7 @@ Tpoint_stboxes(PG_FUNCTION_ARGS)
 
 /*****************************************************************************
  * Generic box functions
+ * The temporal points are not unpacked since only their bounding box is read
  *****************************************************************************/
 
 /**
@@ -400,7 +561,7 @@ boxop_geo_tpoint_ext(FunctionCallInfo fcinfo,
   bool (*func)(const STBOX *, const STBOX *))
 {
   GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   int result = boxop_tpoint_geo(temp, gs, func, true);
   PG_FREE_IF_COPY(gs, 0);
   PG_FREE_IF_COPY(temp, 1);
@@ -419,7 +580,7 @@ Datum
 boxop_tpoint_geo_ext(FunctionCallInfo fcinfo,
   bool (*func)(const STBOX *, const STBOX *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(1);
   int result = boxop_tpoint_geo(temp, gs, func, false);
   PG_FREE_IF_COPY(temp, 0);
@@ -440,7 +601,7 @@ boxop_stbox_tpoint_ext(FunctionCallInfo fcinfo,
   bool (*func)(const STBOX *, const STBOX *))
 {
   STBOX *box = PG_GETARG_STBOX_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_tpoint_stbox(temp, box, func, INVERT);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_BOOL(result);
@@ -456,7 +617,7 @@ Datum
 boxop_tpoint_stbox_ext(FunctionCallInfo fcinfo,
   bool (*func)(const STBOX *, const STBOX *))
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_STORED_P(0);
   STBOX *box = PG_GETARG_STBOX_P(1);
   bool result = boxop_tpoint_stbox(temp, box, func, INVERT_NO);
   PG_FREE_IF_COPY(temp, 0);
@@ -473,8 +634,8 @@ Datum
 boxop_tpoint_tpoint_ext(FunctionCallInfo fcinfo,
   bool (*func)(const STBOX *, const STBOX *))
 {
-  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
-  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp1 = PG_GETARG_TEMPORAL_STORED_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_STORED_P(1);
   bool result = boxop_tpoint_tpoint(temp1, temp2, func);
   PG_FREE_IF_COPY(temp1, 0);
   PG_FREE_IF_COPY(temp2, 1);
@@ -527,6 +688,45 @@ Overlaps_tpoint_stbox(PG_FUNCTION_ARGS)
   return boxop_tpoint_stbox_ext(fcinfo, &overlaps_stbox_stbox);
 }
 
+PG_FUNCTION_INFO_V1(Overlaps_segments_tpoint_geo);
+/**
+ * Return true if the spatiotemporal box of a segment of the temporal point
+ * and the spatiotemporal box of the geometry/geography overlap
+ */
+PGDLLEXPORT Datum
+Overlaps_segments_tpoint_geo(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(1);
+  if (gserialized_is_empty(gs))
+  {
+    PG_FREE_IF_COPY(temp, 0);
+    PG_FREE_IF_COPY(gs, 1);
+    PG_RETURN_NULL();
+  }
+  STBOX box;
+  geo_stbox(gs, &box);
+  bool result = overlaps_segments_tpoint_stbox(temp, &box);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_FREE_IF_COPY(gs, 1);
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Overlaps_segments_tpoint_stbox);
+/**
+ * Return true if the spatiotemporal box of a segment of the temporal point
+ * and the spatiotemporal box overlap
+ */
+PGDLLEXPORT Datum
+Overlaps_segments_tpoint_stbox(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  STBOX *box = PG_GETARG_STBOX_P(1);
+  bool result = overlaps_segments_tpoint_stbox(temp, box);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_BOOL(result);
+}
+
 PG_FUNCTION_INFO_V1(Overlaps_tpoint_tpoint);
 /**
  * Return true if the spatiotemporal boxes of the temporal points overlap
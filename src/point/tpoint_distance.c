@@ -407,6 +407,7 @@ distance_tpoint_geo(const Temporal *temp, const GSERIALIZED *geo)
   lfinfo.tpfunc_base = lfinfo.reslinear ?
     &tpoint_geo_min_dist_at_timestamp : NULL;
   lfinfo.tpfunc = NULL;
+  lfinfo.arena = true;
   Temporal *result = tfunc_temporal_base(temp, PointerGetDatum(geo), &lfinfo);
   return result;
 }
@@ -432,6 +433,7 @@ distance_tpoint_tpoint(const Temporal *temp1, const Temporal *temp2)
   lfinfo.discont = CONTINUOUS;
   lfinfo.tpfunc_base = NULL;
   lfinfo.tpfunc = lfinfo.reslinear ? &tpoint_min_dist_at_timestamp : NULL;
+  lfinfo.arena = true;
   Temporal *result = tfunc_temporal_temporal(temp1, temp2, &lfinfo);
   return result;
 }
@@ -1005,7 +1007,7 @@ PGDLLEXPORT Datum
 Distance_geo_tpoint(PG_FUNCTION_ARGS)
 {
   GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(0);
-  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Temporal *temp = PG_GETARG_TEMPORAL_COLUMNAR_P(1);
   /* Store fcinfo into a global variable */
   store_fcinfo(fcinfo);
   Temporal *result = distance_tpoint_geo(temp, gs);
@@ -1024,7 +1026,7 @@ PG_FUNCTION_INFO_V1(Distance_tpoint_geo);
 PGDLLEXPORT Datum
 Distance_tpoint_geo(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_COLUMNAR_P(0);
   GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(1);
   /* Store fcinfo into a global variable */
   store_fcinfo(fcinfo);
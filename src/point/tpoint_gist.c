@@ -41,6 +41,12 @@
 #if POSTGRESQL_VERSION_NUMBER >= 120000
 #include <utils/float.h>
 #endif
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+#include <access/reloptions.h>
+#endif
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+#include <utils/sortsupport.h>
+#endif
 #include <utils/timestamp.h>
 /* MobilityDB */
 #include "general/time_gist.h"
@@ -163,7 +169,7 @@ stbox_index_consistent_leaf(const STBOX *key, const STBOX *query,
  * @param[in] query Value being looked up in the index
  * @param[in] strategy Operator of the operator class being applied
  */
-static bool
+bool
 stbox_gist_consistent(const STBOX *key, const STBOX *query,
   StrategyNumber strategy)
 {
@@ -272,52 +278,35 @@ tpoint_index_recheck(StrategyNumber strategy)
 /**
  * Transform the query argument into a box initializing the dimensions that
  * must not be taken into account by the operators to infinity.
+ *
+ * @param[in] query Query argument, which is not NULL since the index
+ * support functions are strict
+ * @param[in] type Type of the query argument
+ * @param[out] result Box
+ * @note This function is used for both GiST and BRIN indexes
  */
-static bool
-tpoint_gist_get_stbox(FunctionCallInfo fcinfo, STBOX *result,
-  CachedType type)
+bool
+tpoint_index_get_stbox(Datum query, CachedType type, STBOX *result)
 {
   if (tgeo_basetype(type))
   {
-    GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(1);
-    if (gs == NULL || gserialized_is_empty(gs))
+    GSERIALIZED *gs = (GSERIALIZED *) PG_DETOAST_DATUM(query);
+    if (gserialized_is_empty(gs))
       return false;
     geo_stbox(gs, result);
   }
   else if (type == T_TIMESTAMPTZ)
-  {
-    TimestampTz t = PG_GETARG_TIMESTAMPTZ(1);
-    timestamp_stbox(t, result);
-  }
+    timestamp_stbox(DatumGetTimestampTz(query), result);
   else if (type == T_TIMESTAMPSET)
-  {
-    Datum tsdatum = PG_GETARG_DATUM(1);
-    timestampset_stbox_slice(tsdatum, result);
-  }
+    timestampset_stbox_slice(query, result);
   else if (type == T_PERIOD)
-  {
-    Period *p = PG_GETARG_PERIOD_P(1);
-    period_stbox(p, result);
-  }
+    period_stbox(DatumGetPeriodP(query), result);
   else if (type == T_PERIODSET)
-  {
-    Datum psdatum = PG_GETARG_DATUM(1);
-    periodset_stbox_slice(psdatum, result);
-  }
+    periodset_stbox_slice(query, result);
   else if (type == T_STBOX)
-  {
-    STBOX *box = PG_GETARG_STBOX_P(1);
-    if (box == NULL)
-      return false;
-    memcpy(result, box, sizeof(STBOX));
-  }
+    memcpy(result, DatumGetSTboxP(query), sizeof(STBOX));
   else if (tspatial_type(type))
-  {
-    if (PG_ARGISNULL(1))
-      return false;
-    Datum tempdatum = PG_GETARG_DATUM(1);
-    temporal_bbox_slice(tempdatum, result);
-  }
+    temporal_bbox_slice(query, result);
   else
     elog(ERROR, "Unsupported type for indexing: %d", type);
   return true;
@@ -344,7 +333,8 @@ Stbox_gist_consistent(PG_FUNCTION_ARGS)
     PG_RETURN_BOOL(false);
 
   /* Transform the query into a box */
-  if (! tpoint_gist_get_stbox(fcinfo, &query, oid_type(typid)))
+  if (! tpoint_index_get_stbox(PG_GETARG_DATUM(1), oid_type(typid),
+      &query))
     PG_RETURN_BOOL(false);
 
   if (GIST_LEAF(entry))
@@ -1126,6 +1116,341 @@ Stbox_gist_same(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+/*****************************************************************************
+ * GiST sortsupport method
+ *****************************************************************************/
+
+/**
+ * Comparator of spatiotemporal boxes according to their key in a
+ * space-filling curve
+ */
+static int
+stbox_gist_cmp_full(Datum x, Datum y,
+  SortSupport ssup __attribute__((unused)))
+{
+  STBOX *b1 = DatumGetSTboxP(x);
+  STBOX *b2 = DatumGetSTboxP(y);
+  uint64 z1 = stbox_zorder_key(b1);
+  uint64 z2 = stbox_zorder_key(b2);
+  if (z1 != z2)
+    return (z1 < z2) ? -1 : 1;
+  return stbox_cmp(b1, b2);
+}
+
+/**
+ * Convert a spatiotemporal box into its key in a space-filling curve
+ */
+static Datum
+stbox_gist_abbrev_convert(Datum original,
+  SortSupport ssup __attribute__((unused)))
+{
+  return UInt64GetDatum(stbox_zorder_key(DatumGetSTboxP(original)));
+}
+
+PG_FUNCTION_INFO_V1(Stbox_gist_sortsupport);
+/**
+ * GiST sortsupport method for temporal points
+ *
+ * The keys are sorted according to a Z-order curve, which enables the
+ * sorted build of the index available since PostgreSQL 14
+ */
+PGDLLEXPORT Datum
+Stbox_gist_sortsupport(PG_FUNCTION_ARGS)
+{
+  SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+#if SIZEOF_DATUM == 8
+  if (ssup->abbreviate)
+  {
+    ssup->comparator = &gist_zorder_cmp_abbrev;
+    ssup->abbrev_converter = &stbox_gist_abbrev_convert;
+    ssup->abbrev_abort = &gist_zorder_abbrev_abort;
+    ssup->abbrev_full_comparator = &stbox_gist_cmp_full;
+  }
+  else
+#endif
+    ssup->comparator = &stbox_gist_cmp_full;
+  PG_RETURN_VOID();
+}
+#endif /* POSTGRESQL_VERSION_NUMBER >= 140000 */
+
+/*****************************************************************************
+ * Multi-box GiST index
+ *
+ * The leaf keys of this index keep, in addition to the bounding box of the
+ * temporal point, up to a maximum number of boxes, each one covering a group
+ * of consecutive segments of the temporal point. The boxes are used to filter
+ * the operator ?&& much more precisely than the bounding box alone for long
+ * or winding trajectories, while the other operators only use the bounding
+ * box. The maximum number of boxes is given by the operator class parameter
+ * maxboxes, which is available from PostgreSQL 13.
+ *****************************************************************************/
+
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+/**
+ * Parameters of the multi-box GiST operator class
+ */
+typedef struct
+{
+  int32 vl_len_;       /**< Varlena header (do not touch directly!) */
+  int maxboxes;        /**< Maximum number of boxes per temporal point */
+} TpointMGistOptions;
+
+#define MGIST_GET_MAXBOXES() (PG_HAS_OPCLASS_OPTIONS() ? \
+  ((TpointMGistOptions *) PG_GET_OPCLASS_OPTIONS())->maxboxes : \
+  MGIST_MAXBOXES_DEFAULT)
+#else
+#define MGIST_GET_MAXBOXES() MGIST_MAXBOXES_DEFAULT
+#endif /* POSTGRESQL_VERSION_NUMBER >= 130000 */
+
+/**
+ * Construct a multi-box key from the bounding box and the array of boxes
+ *
+ * @note The key is zeroed so that keys can be compared with memcmp
+ */
+static TpointMGistKey *
+tpoint_mgist_key_make(const STBOX *box, const STBOX *boxes, int count)
+{
+  size_t size = offsetof(TpointMGistKey, boxes) + sizeof(STBOX) * count;
+  TpointMGistKey *result = palloc0(size);
+  SET_VARSIZE(result, size);
+  result->count = count;
+  memcpy(&result->box, box, sizeof(STBOX));
+  if (count > 0)
+    memcpy(result->boxes, boxes, sizeof(STBOX) * count);
+  return result;
+}
+
+/**
+ * Get the bounding box of a multi-box key
+ *
+ * @note The key may be stored in the index page with only integer alignment,
+ * the box is thus copied before accessing its double fields
+ */
+static void
+tpoint_mgist_key_box(const TpointMGistKey *key, STBOX *box)
+{
+  memcpy(box, &key->box, sizeof(STBOX));
+  return;
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_consistent);
+/**
+ * Multi-box GiST consistent method for temporal points
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_consistent(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  StrategyNumber strategy = (StrategyNumber) PG_GETARG_UINT16(2);
+  Oid typid = PG_GETARG_OID(3);
+  bool *recheck = (bool *) PG_GETARG_POINTER(4), result;
+  const TpointMGistKey *key = (TpointMGistKey *) DatumGetPointer(entry->key);
+  STBOX box, query;
+
+  if (key == NULL)
+    PG_RETURN_BOOL(false);
+
+  /* Transform the query into a box */
+  if (! tpoint_index_get_stbox(PG_GETARG_DATUM(1), oid_type(typid),
+      &query))
+    PG_RETURN_BOOL(false);
+
+  tpoint_mgist_key_box(key, &box);
+  if (strategy == RTOverlapsSegmentsStrategyNumber)
+  {
+    /* The boxes cover groups of segments, the index is always lossy */
+    *recheck = true;
+    result = overlaps_stbox_stbox(&box, &query);
+    if (result && GIST_LEAF(entry) && key->count > 0)
+    {
+      result = false;
+      for (int i = 0; i < key->count; i++)
+      {
+        memcpy(&box, &key->boxes[i], sizeof(STBOX));
+        if (overlaps_stbox_stbox(&box, &query))
+        {
+          result = true;
+          break;
+        }
+      }
+    }
+  }
+  else
+  {
+    /* Determine whether the index is lossy depending on the strategy */
+    *recheck = tpoint_index_recheck(strategy);
+    if (GIST_LEAF(entry))
+      result = stbox_index_consistent_leaf(&box, &query, strategy);
+    else
+      result = stbox_gist_consistent(&box, &query, strategy);
+  }
+
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_union);
+/**
+ * Multi-box GiST union method for temporal points
+ *
+ * Return a key with the minimal bounding box that encloses all the entries
+ * in entryvec
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_union(PG_FUNCTION_ARGS)
+{
+  GistEntryVector *entryvec = (GistEntryVector *) PG_GETARG_POINTER(0);
+  GISTENTRY *ent = entryvec->vector;
+  STBOX result, box;
+  tpoint_mgist_key_box((TpointMGistKey *) DatumGetPointer(ent[0].key),
+    &result);
+  for (int i = 1; i < entryvec->n; i++)
+  {
+    tpoint_mgist_key_box((TpointMGistKey *) DatumGetPointer(ent[i].key),
+      &box);
+    stbox_adjust(&result, &box);
+  }
+  PG_RETURN_POINTER(tpoint_mgist_key_make(&result, NULL, 0));
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_compress);
+/**
+ * Multi-box GiST compress method for temporal points
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_compress(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  if (entry->leafkey)
+  {
+    GISTENTRY *retval = (GISTENTRY *) palloc(sizeof(GISTENTRY));
+    Temporal *temp = DatumGetTemporalP(entry->key);
+    STBOX box;
+    int count;
+    temporal_bbox(temp, &box);
+    STBOX *boxes = tpoint_split_n_stboxes(temp, MGIST_GET_MAXBOXES(), &count);
+    /* A single box is equal to the bounding box and is not kept */
+    TpointMGistKey *key = tpoint_mgist_key_make(&box, boxes,
+      count > 1 ? count : 0);
+    pfree(boxes);
+    gistentryinit(*retval, PointerGetDatum(key), entry->rel, entry->page,
+      entry->offset, false);
+    PG_RETURN_POINTER(retval);
+  }
+  PG_RETURN_POINTER(entry);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_decompress);
+/**
+ * Multi-box GiST decompress method for temporal points
+ *
+ * Large keys may be compressed when they are stored in the index
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_decompress(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  struct varlena *key = (struct varlena *) DatumGetPointer(entry->key);
+  struct varlena *detoasted = PG_DETOAST_DATUM(entry->key);
+  if (detoasted == key)
+    PG_RETURN_POINTER(entry);
+  GISTENTRY *retval = (GISTENTRY *) palloc(sizeof(GISTENTRY));
+  gistentryinit(*retval, PointerGetDatum(detoasted), entry->rel, entry->page,
+    entry->offset, entry->leafkey);
+  PG_RETURN_POINTER(retval);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_penalty);
+/**
+ * Multi-box GiST penalty method for temporal points.
+ * The penalty is computed on the bounding boxes of the keys
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_penalty(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *origentry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  GISTENTRY *newentry = (GISTENTRY *) PG_GETARG_POINTER(1);
+  float *result = (float *) PG_GETARG_POINTER(2);
+  STBOX origbox, newbox;
+  tpoint_mgist_key_box((TpointMGistKey *) DatumGetPointer(origentry->key),
+    &origbox);
+  tpoint_mgist_key_box((TpointMGistKey *) DatumGetPointer(newentry->key),
+    &newbox);
+  *result = (float) stbox_penalty(&origbox, &newbox);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_picksplit);
+/**
+ * Multi-box GiST picksplit method for temporal points.
+ *
+ * The entries are split according to their bounding boxes using the
+ * double sorting split algorithm of the box GiST index
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_picksplit(PG_FUNCTION_ARGS)
+{
+  GistEntryVector *entryvec = (GistEntryVector *) PG_GETARG_POINTER(0);
+  GIST_SPLITVEC *v = (GIST_SPLITVEC *) PG_GETARG_POINTER(1);
+  GistEntryVector *boxvec = palloc(GEVHDRSZ +
+    sizeof(GISTENTRY) * entryvec->n);
+  STBOX *boxes = palloc(sizeof(STBOX) * entryvec->n);
+  boxvec->n = entryvec->n;
+  for (OffsetNumber i = FirstOffsetNumber; i < entryvec->n;
+      i = OffsetNumberNext(i))
+  {
+    boxvec->vector[i] = entryvec->vector[i];
+    tpoint_mgist_key_box(
+      (TpointMGistKey *) DatumGetPointer(entryvec->vector[i].key), &boxes[i]);
+    boxvec->vector[i].key = PointerGetDatum(&boxes[i]);
+  }
+  DirectFunctionCall2(Stbox_gist_picksplit, PointerGetDatum(boxvec),
+    PointerGetDatum(v));
+  v->spl_ldatum = PointerGetDatum(tpoint_mgist_key_make(
+    DatumGetSTboxP(v->spl_ldatum), NULL, 0));
+  v->spl_rdatum = PointerGetDatum(tpoint_mgist_key_make(
+    DatumGetSTboxP(v->spl_rdatum), NULL, 0));
+  PG_RETURN_POINTER(v);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_mgist_same);
+/**
+ * Multi-box GiST same method for temporal points.
+ *
+ * Return true only when the keys are exactly the same
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_same(PG_FUNCTION_ARGS)
+{
+  TpointMGistKey *k1 = (TpointMGistKey *) DatumGetPointer(PG_GETARG_DATUM(0));
+  TpointMGistKey *k2 = (TpointMGistKey *) DatumGetPointer(PG_GETARG_DATUM(1));
+  bool *result = (bool *) PG_GETARG_POINTER(2);
+  if (k1 && k2)
+    *result = (VARSIZE(k1) == VARSIZE(k2) &&
+      memcmp(k1, k2, VARSIZE(k1)) == 0);
+  else
+    *result = (k1 == NULL && k2 == NULL);
+  PG_RETURN_POINTER(result);
+}
+
+#if POSTGRESQL_VERSION_NUMBER >= 130000
+PG_FUNCTION_INFO_V1(Tpoint_mgist_options);
+/**
+ * Multi-box GiST options method for temporal points
+ */
+PGDLLEXPORT Datum
+Tpoint_mgist_options(PG_FUNCTION_ARGS)
+{
+  local_relopts *relopts = (local_relopts *) PG_GETARG_POINTER(0);
+  init_local_reloptions(relopts, sizeof(TpointMGistOptions));
+  add_local_int_reloption(relopts, "maxboxes",
+    "maximum number of boxes kept for a temporal point",
+    MGIST_MAXBOXES_DEFAULT, 1, MGIST_MAXBOXES_MAX,
+    offsetof(TpointMGistOptions, maxboxes));
+  PG_RETURN_VOID();
+}
+#endif /* POSTGRESQL_VERSION_NUMBER >= 130000 */
+
 /*****************************************************************************
  * GiST distance method
  *****************************************************************************/
@@ -1153,7 +1478,8 @@ Stbox_gist_distance(PG_FUNCTION_ARGS)
     PG_RETURN_FLOAT8(DBL_MAX);
 
   /* Transform the query into a box */
-  if (! tpoint_gist_get_stbox(fcinfo, &query, oid_type(typid)))
+  if (! tpoint_index_get_stbox(PG_GETARG_DATUM(1), oid_type(typid),
+      &query))
     PG_RETURN_FLOAT8(DBL_MAX);
 
   /* Since we only have boxes we'll return the minimum possible distance,
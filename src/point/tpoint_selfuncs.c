@@ -474,7 +474,7 @@ tpoint_const_stbox(Node *other, STBOX *box)
   else if (type == T_STBOX)
     memcpy(box, DatumGetSTboxP(((Const *) other)->constvalue), sizeof(STBOX));
   else if (tspatial_type(type))
-    temporal_bbox(DatumGetTemporalP(((Const *) other)->constvalue), box);
+    temporal_bbox_slice(((Const *) other)->constvalue, box);
   else
     return false;
   return true;
@@ -55,6 +55,7 @@
 #include "general/rangetypes_ext.h"
 #include "general/temporaltypes.h"
 #include "general/tempcache.h"
+#include "general/temporal_columnar.h"
 #include "general/tnumber_mathfuncs.h"
 #include "point/postgis.h"
 #include "point/stbox.h"
@@ -2820,6 +2821,29 @@ tpointseq_length_3d(const TSequence *seq)
   return result;
 }
 
+/**
+ * Return the length traversed by the temporal sequence point with plannar
+ * coordinates in columnar form, which is computed on the arrays of
+ * coordinates
+ * @pre The temporal point has linear interpolation
+ */
+static double
+tpointseq_columnar_length(const TSequence *seq)
+{
+  double result = 0;
+  const double *x = (double *) tsequence_columnar_values(seq, 0);
+  const double *y = (double *) tsequence_columnar_values(seq, 1);
+  const double *z = MOBDB_FLAGS_GET_Z(seq->flags) ?
+    (double *) tsequence_columnar_values(seq, 2) : NULL;
+  for (int i = 1; i < seq->count; i++)
+  {
+    double dx = x[i] - x[i - 1], dy = y[i] - y[i - 1];
+    double dz = z ? z[i] - z[i - 1] : 0.0;
+    result += sqrt(dx * dx + dy * dy + dz * dz);
+  }
+  return result;
+}
+
 /**
  * @ingroup libmeos_temporal_spatial_accessor
  * @brief Return the length traversed by the temporal sequence point.
@@ -2833,15 +2857,22 @@ tpointseq_length(const TSequence *seq)
 
   if (! MOBDB_FLAGS_GET_GEODETIC(seq->flags))
   {
+    if (MOBDB_FLAGS_GET_COLUMNAR(seq->flags))
+      return tpointseq_columnar_length(seq);
     return MOBDB_FLAGS_GET_Z(seq->flags) ?
       tpointseq_length_3d(seq) : tpointseq_length_2d(seq);
   }
   else
   {
-    Datum traj = tpointseq_trajectory(seq);
+    /* The trajectory is computed on the default storage */
+    TSequence *seq1 = MOBDB_FLAGS_GET_COLUMNAR(seq->flags) ?
+      tsequence_from_columnar(seq) : (TSequence *) seq;
+    Datum traj = tpointseq_trajectory(seq1);
     /* We are sure that the trajectory is a line */
     double result = DatumGetFloat8(call_function2(geography_length, traj,
       BoolGetDatum(true)));
+    if (seq1 != seq)
+      pfree(seq1);
     return result;
   }
 }
@@ -5457,7 +5488,7 @@ PG_FUNCTION_INFO_V1(Tpoint_length);
 PGDLLEXPORT Datum
 Tpoint_length(PG_FUNCTION_ARGS)
 {
-  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_COLUMNAR_P(0);
   double result = tpoint_length(temp);
   PG_FREE_IF_COPY(temp, 0);
   PG_RETURN_FLOAT8(result);
@@ -91,6 +91,13 @@
  * every dimension of every corner of the box on every level of the tree
  * except the root.  For the root node, we are setting the boundaries
  * that we don't yet have as infinity.
+ *
+ * The module also provides a k-d tree over the same 8D space. Each inner
+ * node splits its boxes into two halves according to the median of a single
+ * coordinate, which is chosen in turn according to the level of the node.
+ * The fanout of the inner nodes is thus 2 instead of 256, which avoids large
+ * inner tuples and sparse trees for skewed data. The traversal values are
+ * the same as for the quadtree, only one boundary changes at each level.
  */
 
 #include "point/tpoint_spgist.h"
@@ -131,6 +138,40 @@ typedef struct
   STBOX right;
 } STboxNode;
 
+/**
+ * Enumeration of the SP-GiST index types for spatiotemporal boxes
+ */
+typedef enum
+{
+  SPGIST_QUADTREE,
+  SPGIST_KDTREE,
+} SPGistIndexType;
+
+/**
+ * Enumeration of the coordinates of a spatiotemporal box seen as a point in
+ * 8D space, in the order in which they are used for splitting the k-d tree
+ */
+typedef enum
+{
+  KD_XMIN,
+  KD_YMIN,
+  KD_ZMIN,
+  KD_TMIN,
+  KD_XMAX,
+  KD_YMAX,
+  KD_ZMAX,
+  KD_TMAX,
+} STboxCoord;
+
+/**
+ * Structure to sort the boxes according to one of their coordinates
+ */
+typedef struct
+{
+  double value;     /**< Value of the coordinate */
+  int i;            /**< Position of the box in the input array */
+} SortedSTbox;
+
 /*****************************************************************************
  * General functions
  *****************************************************************************/
@@ -277,6 +318,171 @@ stboxnode_quadtree_next(const STboxNode *nodebox, const STBOX *centroid,
   return;
 }
 
+/**
+ * Return the coordinate used for splitting the k-d tree at a level
+ *
+ * The coordinates are used in turn, skipping those of the dimensions that
+ * the boxes do not have.
+ */
+static STboxCoord
+stbox_kdtree_coord(int16 flags, int level)
+{
+  STboxCoord coords[8];
+  int ncoords = 0;
+  bool hasx = MOBDB_FLAGS_GET_X(flags), hasz = MOBDB_FLAGS_GET_Z(flags),
+    hast = MOBDB_FLAGS_GET_T(flags);
+  for (int i = 0; i < 2; i++)
+  {
+    int shift = (i == 0) ? 0 : KD_XMAX;
+    if (hasx)
+    {
+      coords[ncoords++] = KD_XMIN + shift;
+      coords[ncoords++] = KD_YMIN + shift;
+      if (hasz)
+        coords[ncoords++] = KD_ZMIN + shift;
+    }
+    if (hast)
+      coords[ncoords++] = KD_TMIN + shift;
+  }
+  return (ncoords == 0) ? KD_XMIN : coords[level % ncoords];
+}
+
+/**
+ * Return the value of a coordinate of the box
+ *
+ * The minimum and maximum coordinates of a dimension that the box does not
+ * have are, respectively, minus and plus infinity. Since the boundaries of a
+ * node are only restricted on the side of the centroid, such a box is always
+ * in a node that is visited by the queries on that dimension.
+ */
+static double
+stbox_coord_value(const STBOX *box, STboxCoord coord)
+{
+  double infinity = get_float8_infinity();
+  bool hasx = MOBDB_FLAGS_GET_X(box->flags),
+    hasz = MOBDB_FLAGS_GET_Z(box->flags),
+    hast = MOBDB_FLAGS_GET_T(box->flags);
+  switch (coord)
+  {
+    case KD_XMIN: return hasx ? box->xmin : -infinity;
+    case KD_YMIN: return hasx ? box->ymin : -infinity;
+    case KD_ZMIN: return hasz ? box->zmin : -infinity;
+    case KD_TMIN: return hast ? (double) box->tmin : -infinity;
+    case KD_XMAX: return hasx ? box->xmax : infinity;
+    case KD_YMAX: return hasx ? box->ymax : infinity;
+    case KD_ZMAX: return hasz ? box->zmax : infinity;
+    default: /* KD_TMAX */
+      return hast ? (double) box->tmax : infinity;
+  }
+}
+
+/**
+ * Set the dimensions of the flags that the box does not have to unbounded
+ * values, so that the box has all the dimensions of the flags
+ */
+static void
+stbox_kdtree_unbounded(STBOX *box, int16 flags)
+{
+  double infinity = get_float8_infinity();
+  if (MOBDB_FLAGS_GET_X(flags) && ! MOBDB_FLAGS_GET_X(box->flags))
+  {
+    box->xmin = box->ymin = -infinity;
+    box->xmax = box->ymax = infinity;
+    MOBDB_FLAGS_SET_X(box->flags, true);
+  }
+  if (MOBDB_FLAGS_GET_Z(flags) && ! MOBDB_FLAGS_GET_Z(box->flags))
+  {
+    box->zmin = -infinity;
+    box->zmax = infinity;
+    MOBDB_FLAGS_SET_Z(box->flags, true);
+  }
+  if (MOBDB_FLAGS_GET_T(flags) && ! MOBDB_FLAGS_GET_T(box->flags))
+  {
+    box->tmin = DT_NOBEGIN;
+    box->tmax = DT_NOEND;
+    MOBDB_FLAGS_SET_T(box->flags, true);
+  }
+  return;
+}
+
+/**
+ * Calculate the node of the k-d tree, that is, 1 if the coordinate of the
+ * level of the box is greater than the one of the centroid and 0 otherwise
+ */
+static uint8
+getNodeKD(const STBOX *centroid, const STBOX *inBox, int level)
+{
+  STboxCoord coord = stbox_kdtree_coord(centroid->flags, level);
+  return (stbox_coord_value(inBox, coord) >
+    stbox_coord_value(centroid, coord)) ? 1 : 0;
+}
+
+/**
+ * Calculate the next traversal value for the k-d tree
+ *
+ * Only the boundary of the coordinate of the level is restricted by the
+ * centroid. Both boundaries are inclusive since the boxes whose coordinate
+ * is equal to the one of the centroid may be in any of the two nodes.
+ */
+static void
+stboxnode_kdtree_next(const STboxNode *nodebox, const STBOX *centroid,
+  uint8 node, int level, STboxNode *next_nodebox)
+{
+  memcpy(next_nodebox, nodebox, sizeof(STboxNode));
+  switch (stbox_kdtree_coord(centroid->flags, level))
+  {
+    case KD_XMIN:
+      if (node)
+        next_nodebox->left.xmin = centroid->xmin;
+      else
+        next_nodebox->left.xmax = centroid->xmin;
+      break;
+    case KD_YMIN:
+      if (node)
+        next_nodebox->left.ymin = centroid->ymin;
+      else
+        next_nodebox->left.ymax = centroid->ymin;
+      break;
+    case KD_ZMIN:
+      if (node)
+        next_nodebox->left.zmin = centroid->zmin;
+      else
+        next_nodebox->left.zmax = centroid->zmin;
+      break;
+    case KD_TMIN:
+      if (node)
+        next_nodebox->left.tmin = centroid->tmin;
+      else
+        next_nodebox->left.tmax = centroid->tmin;
+      break;
+    case KD_XMAX:
+      if (node)
+        next_nodebox->right.xmin = centroid->xmax;
+      else
+        next_nodebox->right.xmax = centroid->xmax;
+      break;
+    case KD_YMAX:
+      if (node)
+        next_nodebox->right.ymin = centroid->ymax;
+      else
+        next_nodebox->right.ymax = centroid->ymax;
+      break;
+    case KD_ZMAX:
+      if (node)
+        next_nodebox->right.zmin = centroid->zmax;
+      else
+        next_nodebox->right.zmax = centroid->zmax;
+      break;
+    case KD_TMAX:
+      if (node)
+        next_nodebox->right.tmin = centroid->tmax;
+      else
+        next_nodebox->right.tmax = centroid->tmax;
+      break;
+  }
+  return;
+}
+
 /**
  * Can any box from nodebox overlap with query?
  */
@@ -609,6 +815,30 @@ Stbox_quadtree_choose(PG_FUNCTION_ARGS)
   PG_RETURN_VOID();
 }
 
+PG_FUNCTION_INFO_V1(Stbox_kdtree_choose);
+/**
+ * K-d tree choose function for temporal points
+ */
+PGDLLEXPORT Datum
+Stbox_kdtree_choose(PG_FUNCTION_ARGS)
+{
+  spgChooseIn *in = (spgChooseIn *) PG_GETARG_POINTER(0);
+  spgChooseOut *out = (spgChooseOut *) PG_GETARG_POINTER(1);
+  STBOX *centroid = DatumGetSTboxP(in->prefixDatum),
+    *box = DatumGetSTboxP(in->leafDatum);
+
+  out->resultType = spgMatchNode;
+  out->result.matchNode.restDatum = PointerGetDatum(box);
+  /* The level determines the coordinate used for the split */
+  out->result.matchNode.levelAdd = 1;
+
+  /* nodeN will be set by core, when allTheSame. */
+  if (!in->allTheSame)
+    out->result.matchNode.nodeN = getNodeKD(centroid, box, in->level);
+
+  PG_RETURN_VOID();
+}
+
 /*****************************************************************************
  * SP-GiST pick-split function
  *****************************************************************************/
@@ -719,23 +949,108 @@ Stbox_quadtree_picksplit(PG_FUNCTION_ARGS)
   PG_RETURN_VOID();
 }
 
+/**
+ * Comparator for sorting the boxes according to one of their coordinates
+ */
+static int
+sortedstbox_cmp(const SortedSTbox *s1, const SortedSTbox *s2)
+{
+  if (s1->value == s2->value)
+    return 0;
+  return (s1->value > s2->value) ? 1 : -1;
+}
+
+PG_FUNCTION_INFO_V1(Stbox_kdtree_picksplit);
+/**
+ * K-d tree pick-split function for temporal points
+ *
+ * It splits a list of boxes into two halves according to the median of the
+ * coordinate of the level. The boxes are assigned to the nodes according to
+ * their position in the sort order, so that both nodes are never empty.
+ * The centroid is given all the dimensions of the boxes, so that the
+ * coordinate of the level computed from its flags during the traversal is
+ * the one used for the split, even when boxes of different dimensions are
+ * mixed.
+ */
+PGDLLEXPORT Datum
+Stbox_kdtree_picksplit(PG_FUNCTION_ARGS)
+{
+  spgPickSplitIn *in = (spgPickSplitIn *) PG_GETARG_POINTER(0);
+  spgPickSplitOut *out = (spgPickSplitOut *) PG_GETARG_POINTER(1);
+  SortedSTbox *sorted = palloc(sizeof(SortedSTbox) * in->nTuples);
+  int median, i;
+
+  /* The coordinate of the level is chosen among all the dimensions of the
+   * boxes, which are those of the centroid used by the traversal */
+  int16 flags = 0;
+  for (i = 0; i < in->nTuples; i++)
+  {
+    const STBOX *box = DatumGetSTboxP(in->datums[i]);
+    if (MOBDB_FLAGS_GET_X(box->flags))
+      MOBDB_FLAGS_SET_X(flags, true);
+    if (MOBDB_FLAGS_GET_Z(box->flags))
+      MOBDB_FLAGS_SET_Z(flags, true);
+    if (MOBDB_FLAGS_GET_T(box->flags))
+      MOBDB_FLAGS_SET_T(flags, true);
+  }
+  STboxCoord coord = stbox_kdtree_coord(flags, in->level);
+
+  /* Sort the boxes according to the coordinate of the level */
+  for (i = 0; i < in->nTuples; i++)
+  {
+    sorted[i].value = stbox_coord_value(DatumGetSTboxP(in->datums[i]), coord);
+    sorted[i].i = i;
+  }
+  qsort(sorted, (size_t) in->nTuples, sizeof(SortedSTbox),
+    (qsort_comparator) &sortedstbox_cmp);
+  median = in->nTuples / 2;
+
+  /* The centroid is the median box, only its coordinate of the level is used */
+  STBOX *centroid = palloc(sizeof(STBOX));
+  memcpy(centroid, DatumGetSTboxP(in->datums[sorted[median].i]),
+    sizeof(STBOX));
+  stbox_kdtree_unbounded(centroid, flags);
+
+  /* Fill the output */
+  out->hasPrefix = true;
+  out->prefixDatum = STboxPGetDatum(centroid);
+  out->nNodes = 2;
+  out->nodeLabels = NULL;    /* We don't need node labels. */
+  out->mapTuplesToNodes = palloc(sizeof(int) * in->nTuples);
+  out->leafTupleDatums = palloc(sizeof(Datum) * in->nTuples);
+
+  /* Assign the boxes to the nodes according to their sort position */
+  for (i = 0; i < in->nTuples; i++)
+  {
+    int n = sorted[i].i;
+    out->leafTupleDatums[n] = in->datums[n];
+    out->mapTuplesToNodes[n] = (i < median) ? 0 : 1;
+  }
+
+  pfree(sorted);
+  PG_RETURN_VOID();
+}
+
 /*****************************************************************************
  * SP-GiST inner consistent functions
  *****************************************************************************/
 
-PG_FUNCTION_INFO_V1(Stbox_quadtree_inner_consistent);
 /**
- * SP-GiST inner consistent functions for temporal points
+ * Generic SP-GiST inner consistent function for temporal points
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] idxtype Index type, either quadtree or k-d tree
  */
-PGDLLEXPORT Datum
-Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
+static Datum
+stbox_spgist_inner_consistent(FunctionCallInfo fcinfo,
+  SPGistIndexType idxtype)
 {
   spgInnerConsistentIn *in = (spgInnerConsistentIn *) PG_GETARG_POINTER(0);
   spgInnerConsistentOut *out = (spgInnerConsistentOut *) PG_GETARG_POINTER(1);
   int i;
   MemoryContext old_ctx;
   STboxNode *nodebox, infbox, next_nodebox;
-  uint16 quadrant;
+  uint16 node;
 #if POSTGRESQL_VERSION_NUMBER >= 120000
   STBOX *centroid, *queries, *orderbys;
 #else
@@ -779,28 +1094,39 @@ Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
     /* Report that all nodes should be visited */
     out->nNodes = in->nNodes;
     out->nodeNumbers = (int *) palloc(sizeof(int) * in->nNodes);
+    out->traversalValues = (void **) palloc(sizeof(void *) * in->nNodes);
+    if (idxtype == SPGIST_KDTREE)
+      out->levelAdds = (int *) palloc(sizeof(int) * in->nNodes);
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+    if (in->norderbys > 0)
+      out->distances = (double **) palloc(sizeof(double *) * in->nNodes);
+#endif
     for (i = 0; i < in->nNodes; i++)
     {
       out->nodeNumbers[i] = i;
+      if (idxtype == SPGIST_KDTREE)
+        out->levelAdds[i] = 1;
+
+      /* Use parent quadrant box as traversalValue */
+      old_ctx = MemoryContextSwitchTo(in->traversalMemoryContext);
+      out->traversalValues[i] = cubestbox_copy(nodebox);
+      MemoryContextSwitchTo(old_ctx);
 
 #if POSTGRESQL_VERSION_NUMBER >= 120000
       if (in->norderbys > 0)
       {
-        /* Use parent quadrant box as traversalValue */
-        old_ctx = MemoryContextSwitchTo(in->traversalMemoryContext);
-        out->traversalValues[i] = cubestbox_copy(nodebox);
-        MemoryContextSwitchTo(old_ctx);
-
         /* Compute the distances */
         double *distances = palloc0(sizeof(double) * in->norderbys);
         out->distances[i] = distances;
         for (int j = 0; j < in->norderbys; j++)
-          distances[j] = distance_stbox_nodebox(&orderbys[i], nodebox);
-
-        pfree(orderbys);
+          distances[j] = distance_stbox_nodebox(&orderbys[j], nodebox);
       }
 #endif /* POSTGRESQL_VERSION_NUMBER >= 120000 */
     }
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+    if (in->norderbys > 0)
+      pfree(orderbys);
+#endif /* POSTGRESQL_VERSION_NUMBER >= 120000 */
 
     PG_RETURN_VOID();
   }
@@ -823,14 +1149,20 @@ Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
   out->nNodes = 0;
   out->nodeNumbers = (int *) palloc(sizeof(int) * in->nNodes);
   out->traversalValues = (void **) palloc(sizeof(void *) * in->nNodes);
+  if (idxtype == SPGIST_KDTREE)
+    out->levelAdds = (int *) palloc(sizeof(int) * in->nNodes);
 #if POSTGRESQL_VERSION_NUMBER >= 120000
   if (in->norderbys > 0)
     out->distances = (double **) palloc(sizeof(double *) * in->nNodes);
 #endif
 
-  for (quadrant = 0; quadrant < in->nNodes; quadrant++)
+  for (node = 0; node < in->nNodes; node++)
   {
-    stboxnode_quadtree_next(nodebox, centroid, (uint8) quadrant, &next_nodebox);
+    if (idxtype == SPGIST_QUADTREE)
+      stboxnode_quadtree_next(nodebox, centroid, (uint8) node, &next_nodebox);
+    else
+      stboxnode_kdtree_next(nodebox, centroid, (uint8) node, in->level,
+        &next_nodebox);
     bool flag = true;
     for (i = 0; i < in->nkeys; i++)
     {
@@ -905,11 +1237,13 @@ Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
 
     if (flag)
     {
-      /* Pass traversalValue and quadrant */
+      /* Pass traversalValue and node */
       old_ctx = MemoryContextSwitchTo(in->traversalMemoryContext);
       out->traversalValues[out->nNodes] = cubestbox_copy(&next_nodebox);
       MemoryContextSwitchTo(old_ctx);
-      out->nodeNumbers[out->nNodes] = quadrant;
+      out->nodeNumbers[out->nNodes] = node;
+      if (idxtype == SPGIST_KDTREE)
+        out->levelAdds[out->nNodes] = 1;
 #if POSTGRESQL_VERSION_NUMBER >= 120000
       /* Pass distances */
       if (in->norderbys > 0)
@@ -934,6 +1268,26 @@ Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
   PG_RETURN_VOID();
 }
 
+PG_FUNCTION_INFO_V1(Stbox_quadtree_inner_consistent);
+/**
+ * SP-GiST inner consistent function for quadtrees over temporal points
+ */
+PGDLLEXPORT Datum
+Stbox_quadtree_inner_consistent(PG_FUNCTION_ARGS)
+{
+  return stbox_spgist_inner_consistent(fcinfo, SPGIST_QUADTREE);
+}
+
+PG_FUNCTION_INFO_V1(Stbox_kdtree_inner_consistent);
+/**
+ * SP-GiST inner consistent function for k-d trees over temporal points
+ */
+PGDLLEXPORT Datum
+Stbox_kdtree_inner_consistent(PG_FUNCTION_ARGS)
+{
+  return stbox_spgist_inner_consistent(fcinfo, SPGIST_KDTREE);
+}
+
 /*****************************************************************************
  * SP-GiST leaf-level consistency function
  *****************************************************************************/
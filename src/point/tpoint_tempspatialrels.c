@@ -751,37 +751,45 @@ tdwithin_tpointsegm_tpointsegm(Datum sv1, Datum ev1, Datum sv2, Datum ev2,
  * Return the timestamps at which the segments of two temporal points are
  * within the given distance
  *
+ * The temporal points are synchronized segment by segment with an iterator
+ * rather than materializing synchronized copies of them.
+ *
  * @param[in] seq1,seq2 Temporal points
  * @param[in] dist Distance
  * @param[in] func DWithin function (2D or 3D)
  * @param[out] result Array on which the pointers of the newly constructed
  * sequences are stored
- * @result Number of elements in the resulting array
- * @pre The temporal points must be synchronized.
+ * @result Number of elements in the resulting array, 0 if the temporal
+ * points do not intersect in time
  */
 static int
 tdwithin_tpointseq_tpointseq2(const TSequence *seq1, const TSequence *seq2,
   Datum dist, datum_func3 func, TSequence **result)
 {
-  const TInstant *start1 = tsequence_inst_n(seq1, 0);
-  const TInstant *start2 = tsequence_inst_n(seq2, 0);
-  if (seq1->count == 1)
+  TSequenceSyncIter iter;
+  if (! tsequence_sync_init(&iter, seq1, seq2, false))
+    return 0;
+  tsequence_sync_next(&iter);
+  const TInstant *start1 = iter.inst1;
+  const TInstant *start2 = iter.inst2;
+  if (iter.last)
   {
     TInstant *inst = tinstant_make(func(tinstant_value(start1),
       tinstant_value(start2), dist), start1->t, T_TBOOL);
     result[0] = tinstant_tsequence(inst, STEP);
     pfree(inst);
+    tsequence_sync_end(&iter);
     return 1;
   }
 
   int k = 0;
-  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
-  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  bool linear1 = iter.linear1;
+  bool linear2 = iter.linear2;
   bool hasz = MOBDB_FLAGS_GET_Z(seq1->flags);
   Datum sv1 = tinstant_value(start1);
   Datum sv2 = tinstant_value(start2);
   TimestampTz lower = start1->t;
-  bool lower_inc = seq1->period.lower_inc;
+  bool lower_inc = iter.inter.lower_inc;
   const Datum datum_true = BoolGetDatum(true);
   const Datum datum_false = BoolGetDatum(false);
   /* We create three temporal instants with arbitrary values that are set in
@@ -792,15 +800,14 @@ tdwithin_tpointseq_tpointseq2(const TSequence *seq1, const TSequence *seq2,
   instants[1] = tinstant_copy(instants[0]);
   instants[2] = tinstant_copy(instants[0]);
   double dist_d = DatumGetFloat8(dist);
-  for (int i = 1; i < seq1->count; i++)
+  while (! iter.last)
   {
-    /* Each iteration of the for loop adds between one and three sequences */
-    const TInstant *end1 = tsequence_inst_n(seq1, i);
-    const TInstant *end2 = tsequence_inst_n(seq2, i);
-    Datum ev1 = tinstant_value(end1);
-    Datum ev2 = tinstant_value(end2);
-    TimestampTz upper = end1->t;
-    bool upper_inc = (i == seq1->count - 1) ? seq1->period.upper_inc : false;
+    /* Each iteration of the loop adds between one and three sequences */
+    tsequence_sync_next(&iter);
+    Datum ev1 = tinstant_value(iter.inst1);
+    Datum ev2 = tinstant_value(iter.inst2);
+    TimestampTz upper = iter.inst1->t;
+    bool upper_inc = iter.last ? iter.inter.upper_inc : false;
 
     /* Both segments are constant or have step interpolation */
     if ((datum_point_eq(sv1, ev1) && datum_point_eq(sv2, ev2)) ||
@@ -879,53 +886,55 @@ tdwithin_tpointseq_tpointseq2(const TSequence *seq1, const TSequence *seq2,
     lower = upper;
     lower_inc = true;
   }
+  tsequence_sync_end(&iter);
   pfree(instants[0]); pfree(instants[1]); pfree(instants[2]);
   return k;
 }
 
 /**
- * Return the timestamps at which the segments of two temporal points are
- * within the given distance
- *
- * @param[in] seq1,seq2 Temporal points
- * @param[in] dist Distance
- * @param[in] func DWithin function (2D or 3D)
- * @pre The temporal points must be synchronized.
- */
-static TSequenceSet *
-tdwithin_tpointseq_tpointseq(const TSequence *seq1, const TSequence *seq2,
-  Datum dist, datum_func3 func)
-{
-  TSequence **sequences = palloc(sizeof(TSequence *) * seq1->count * 4);
-  int count = tdwithin_tpointseq_tpointseq2(seq1, seq2, dist, func, sequences);
-  return tsequenceset_make_free(sequences, count, NORMALIZE);
-}
-
-/**
- * Return the timestamps at which the segments of two temporal points are
- * within the given distance
+ * Return the timestamps at which two temporal points are within the given
+ * distance
  *
- * @param[in] ts1,ts2 Temporal points
+ * @param[in] seqs1,seqs2 Arrays of sequences composing the temporal points
+ * @param[in] count1,count2 Number of elements in the arrays
  * @param[in] dist Distance
  * @param[in] func DWithin function (2D or 3D)
- * @pre The temporal points must be synchronized.
+ * @result NULL if the temporal points do not intersect in time
  */
 static TSequenceSet *
-tdwithin_tpointseqset_tpointseqset(const TSequenceSet *ts1,
-  const TSequenceSet *ts2, Datum dist, datum_func3 func)
+tdwithin_tpointseqarr_tpointseqarr(const TSequence **seqs1, int count1,
+  const TSequence **seqs2, int count2, Datum dist, datum_func3 func)
 {
-  /* Singleton sequence set */
-  if (ts1->count == 1)
-    return tdwithin_tpointseq_tpointseq(tsequenceset_seq_n(ts1, 0),
-      tsequenceset_seq_n(ts2, 0), dist, func);
-
-  TSequence **sequences = palloc(sizeof(TSequence *) * ts1->totalcount * 4);
-  int k = 0;
-  for (int i = 0; i < ts1->count; i++)
+  /* Each pair of overlapping sequences adds the sequences of a segment for
+   * at most two synchronization instants more than its input instants */
+  int count = (count1 + count2) * 2;
+  for (int i = 0; i < count1; i++)
+    count += seqs1[i]->count;
+  for (int i = 0; i < count2; i++)
+    count += seqs2[i]->count;
+  TSequence **sequences = palloc(sizeof(TSequence *) * count * 4);
+  int i = 0, j = 0, k = 0;
+  while (i < count1 && j < count2)
   {
-    const TSequence *seq1 = tsequenceset_seq_n(ts1, i);
-    const TSequence *seq2 = tsequenceset_seq_n(ts2, i);
+    const TSequence *seq1 = seqs1[i];
+    const TSequence *seq2 = seqs2[j];
     k += tdwithin_tpointseq_tpointseq2(seq1, seq2, dist, func, &sequences[k]);
+    int cmp = timestamp_cmp_internal(seq1->period.upper, seq2->period.upper);
+    if (cmp == 0)
+    {
+      if (! seq1->period.upper_inc && seq2->period.upper_inc)
+        cmp = -1;
+      else if (seq1->period.upper_inc && !seq2->period.upper_inc)
+        cmp = 1;
+    }
+    if (cmp == 0)
+    {
+      i++; j++;
+    }
+    else if (cmp < 0)
+      i++;
+    else
+      j++;
   }
   return tsequenceset_make_free(sequences, k, NORMALIZE);
 }
@@ -1385,6 +1394,24 @@ tdwithin_tpoint_geo(const Temporal *temp, const GSERIALIZED *gs, Datum dist,
 
 /*****************************************************************************/
 
+/**
+ * Return the array of pointers to the sequences of a temporal sequence or
+ * sequence set
+ */
+static const TSequence **
+temporal_seqarr_p(const Temporal *temp, int *count)
+{
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence **result = palloc(sizeof(TSequence *));
+    result[0] = (const TSequence *) temp;
+    *count = 1;
+    return result;
+  }
+  *count = ((TSequenceSet *) temp)->count;
+  return tsequenceset_sequences_p((TSequenceSet *) temp);
+}
+
 /**
  * @ingroup libmeos_temporal_spatial_rel
  * @brief Return a temporal Boolean that states whether the temporal points
@@ -1395,34 +1422,44 @@ tdwithin_tpoint_tpoint(const Temporal *temp1, const Temporal *temp2,
   Datum dist, bool restr, Datum atvalue)
 {
   ensure_same_srid(tpoint_srid(temp1), tpoint_srid(temp2));
-  Temporal *sync1, *sync2;
-  /* Return false if the temporal points do not intersect in time
-   * The operation is synchronization without adding crossings */
-  if (!intersection_temporal_temporal(temp1, temp2, SYNCHRONIZE_NOCROSS,
-    &sync1, &sync2))
-    return NULL;
-
   datum_func3 func = get_dwithin_fn(temp1->flags, temp2->flags);
-  LiftedFunctionInfo lfinfo;
-  memset(&lfinfo, 0, sizeof(LiftedFunctionInfo));
-  lfinfo.func = (varfunc) func;
-  lfinfo.numparam = 1;
-  lfinfo.param[0] = dist;
-  lfinfo.restype = T_TBOOL;
   Temporal *result;
-  ensure_valid_tempsubtype(sync1->subtype);
-  if (sync1->subtype == INSTANT)
-    result = (Temporal *) tfunc_tinstant_tinstant(
-      (TInstant *) sync1, (TInstant *) sync2, &lfinfo);
-  else if (sync1->subtype == INSTANTSET)
-    result = (Temporal *) tfunc_tinstantset_tinstantset(
-      (TInstantSet *) sync1, (TInstantSet *) sync2, &lfinfo);
-  else if (sync1->subtype == SEQUENCE)
-    result = (Temporal *) tdwithin_tpointseq_tpointseq(
-      (TSequence *) sync1, (TSequence *) sync2, dist, func);
-  else /* sync1->subtype == SEQUENCESET */
-    result = (Temporal *) tdwithin_tpointseqset_tpointseqset(
-      (TSequenceSet *) sync1, (TSequenceSet *) sync2, dist, func);
+  /* Temporal points with continuous time are synchronized segment by
+   * segment while computing the result */
+  if ((temp1->subtype == SEQUENCE || temp1->subtype == SEQUENCESET) &&
+    (temp2->subtype == SEQUENCE || temp2->subtype == SEQUENCESET))
+  {
+    int count1, count2;
+    const TSequence **seqs1 = temporal_seqarr_p(temp1, &count1);
+    const TSequence **seqs2 = temporal_seqarr_p(temp2, &count2);
+    result = (Temporal *) tdwithin_tpointseqarr_tpointseqarr(seqs1, count1,
+      seqs2, count2, dist, func);
+    pfree(seqs1); pfree(seqs2);
+  }
+  else
+  {
+    Temporal *sync1, *sync2;
+    /* Return false if the temporal points do not intersect in time
+     * The operation is synchronization without adding crossings */
+    if (!intersection_temporal_temporal(temp1, temp2, SYNCHRONIZE_NOCROSS,
+      &sync1, &sync2))
+      return NULL;
+
+    LiftedFunctionInfo lfinfo;
+    memset(&lfinfo, 0, sizeof(LiftedFunctionInfo));
+    lfinfo.func = (varfunc) func;
+    lfinfo.numparam = 1;
+    lfinfo.param[0] = dist;
+    lfinfo.restype = T_TBOOL;
+    ensure_valid_tempsubtype(sync1->subtype);
+    if (sync1->subtype == INSTANT)
+      result = (Temporal *) tfunc_tinstant_tinstant(
+        (TInstant *) sync1, (TInstant *) sync2, &lfinfo);
+    else /* sync1->subtype == INSTANTSET */
+      result = (Temporal *) tfunc_tinstantset_tinstantset(
+        (TInstantSet *) sync1, (TInstantSet *) sync2, &lfinfo);
+    pfree(sync1); pfree(sync2);
+  }
   /* Restrict the result to the Boolean value in the fourth argument if any */
   if (result != NULL && restr)
   {
@@ -1430,7 +1467,6 @@ tdwithin_tpoint_tpoint(const Temporal *temp1, const Temporal *temp2,
     pfree(result);
     result = at_result;
   }
-  pfree(sync1); pfree(sync2);
   return result;
 }
 
@@ -35,6 +35,7 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <assert.h>
+#include <math.h>
 #include <funcapi.h>
 #if POSTGRESQL_VERSION_NUMBER < 120000
 #include <access/htup_details.h>
@@ -51,341 +52,6 @@
 #include "point/tpoint.h"
 #include "point/tpoint_spatialfuncs.h"
 
-/*****************************************************************************
- * Bit Matrix implementation based on
- * https://www.pvladov.com/2012/05/bit-matrix-in-c-sharp.html
- *****************************************************************************/
-
-/**
- * Create a bit matrix
- */
-static BitMatrix *
-bitmatrix_make(int *count, int numdims)
-{
-  /* Calculate the needed number of bits and bytes */
-  int i, bitCount = 1;
-  for (i = 0; i < numdims; i++)
-    bitCount *= count[i];
-  int byteCount = bitCount >> 3;
-  if (bitCount % 8 != 0)
-    byteCount++;
-  /* Allocate the needed number of bytes taking into account that there is
-   * already one byte allocated in the struct */
-  size_t size = sizeof(BitMatrix) + byteCount - 1;
-  /* palloc0 to set all bits to 0 */
-  BitMatrix *result = (BitMatrix *) palloc0(size);
-  /* Fill the structure */
-  result->numdims = numdims;
-  for (i = 0; i < numdims; i++)
-    result->count[i] = count[i];
-  return result;
-}
-
-/**
- * Get the value of the bit in the bit matrix
- */
-static bool
-bitmatrix_get(const BitMatrix *bm, int *coords)
-{
-  int i, j;
-  for (i = 0; i < bm->numdims; i++)
-    assert(coords[i] <= bm->count[i]);
-  int pos = 0;
-  for (i = 0; i < bm->numdims; i++)
-  {
-    int offset = coords[i];
-    for (j = i + 1; j < bm->numdims; j++)
-    {
-      offset *= bm->count[j];
-    }
-    pos += offset;
-  }
-  int index = pos % 8;
-  pos >>= 3;
-  return (bm->byte[pos] & (((uint8_t)1) << index)) != 0;
-}
-
-/**
- * Set the value of the bit in the bit matrix
- */
-static void
-bitmatrix_set_cell(BitMatrix *bm, int *coords, bool value)
-{
-  int i, j, pos = 0;
-  for (i = 0; i < bm->numdims; i++)
-    assert(coords[i] <= bm->count[i]);
-  for (i = 0; i < bm->numdims - 1; i++)
-  {
-    int offset = coords[i];
-    for (j = i + 1; j < bm->numdims; j++)
-      offset *= bm->count[j];
-    pos += offset;
-  }
-  pos += coords[bm->numdims - 1];
-  int index = pos % 8;
-  pos >>= 3;
-  bm->byte[pos] &= (unsigned char)(~(1 << index));
-  if (value)
-    bm->byte[pos] |= (uint8_t)(1 << index);
-  return;
-}
-
-#ifdef DEBUG_BUILD
-/**
- * Print a 2D bit matrix
- * @note This function is only used for debugging purposes
- */
-void
-bitmatrix_print2D(const BitMatrix *bm, int *coords)
-{
-  int i, j;
-  int dim = bm->numdims - 2;
-  /* Print the 2D matrix */
-  if (bm->count[dim + 1] / 10 > 0)
-  {
-    printf("\n      ");
-    for (j = 0; j < bm->count[dim + 1] / 10; j++)
-    {
-      printf("         %1d", j + 1);
-    }
-  }
-  printf("\n     ");
-  for (j = 0; j < bm->count[dim + 1]; j++)
-  {
-    printf("%1d", j % 10);
-  }
-  printf("\n-----");
-  for (j = 0; j < bm->count[dim + 1]; j++)
-    printf("-");
-  printf("\n");
-  for (i = 0; i < bm->count[dim + 0]; i++)
-  {
-    if (i / 10 > 0 && i % 10 == 0)
-      printf("%1d", i / 10);
-    else
-      printf(" ");
-    printf("%1d | ", i % 10);
-    coords[dim + 0] = i;
-    for (j = 0; j < bm->count[dim + 1]; j++)
-    {
-      coords[dim + 1] = j;
-      if (bitmatrix_get(bm, coords))
-        printf("1");
-      else
-        printf(".");
-    }
-    printf("\n");
-  }
-  printf("-----");
-  for (j = 0; j < bm->count[dim + 1]; j++)
-    printf("-");
-  if (bm->count[dim + 1] / 10 > 0)
-  {
-    printf("\n      ");
-    for (j = 0; j < bm->count[dim + 1] / 10; j++)
-    {
-      printf("         %1d", j + 1);
-    }
-  }
-  printf("\n     ");
-  for (j = 0; j < bm->count[dim + 1]; j++)
-    printf("%1d", j % 10);
-  printf("\n");
-  return;
-}
-
-/**
- * Print the bit matrix
- * @note This function is only used while debugging
- */
-void
-bitmatrix_print(const BitMatrix *bm)
-{
-  int i, j, k, l, coords[MAXDIMS];
-  memset(&coords, 0, sizeof(coords));
-  int totalcount = 1;
-  for (i = 0; i < bm->numdims; i++)
-    totalcount *= bm->count[i];
-  int count = 0;
-  for (i = 0; i < bm->count[0]; i++)
-  {
-    coords[0] = i;
-    for (j = 0; j < bm->count[1]; j++)
-    {
-      coords[1] = j;
-      if (bm->numdims >= 3)
-      {
-        for (k = 0; k < bm->count[2]; k++)
-        {
-          coords[2] = k;
-          if (bm->numdims >= 4)
-          {
-            for (l = 0; l < bm->count[3]; l++)
-            {
-              coords[3] = l;
-              if (bitmatrix_get(bm, coords))
-              {
-                printf("%d %d %d %d: %c\n", i, j, k, l, '1');
-                count++;
-              }
-            }
-          }
-          else
-          {
-            if (bitmatrix_get(bm, coords))
-            {
-              printf("%d %d %d: %c\n", i, j, k, '1');
-              count++;
-            }
-          }
-        }
-      }
-      else
-      {
-        if (bitmatrix_get(bm, coords))
-        {
-          printf("%d %d: %c\n", i, j, '1');
-          count++;
-        }
-      }
-    }
-  }
-  printf("Total tiles: %d, Tiles set: %d\n", totalcount, count);
-}
-#endif
-
-/*****************************************************************************
- * N-dimensional version of Bresenham's line algorithm
- * https://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
- * setting in the bit array all the tiles connecting the two given tiles
- *****************************************************************************/
-
-#ifdef DEBUG_BUILD
-/**
- * Print the coordinates of a tile
- * @note This function is only used for debugging purposes
- */
-void
-coord_print(int *coords, int numdims)
-{
-  printf("(");
-  for (int i = 0; i < numdims; i++)
-  {
-    if (i > 0) printf(", ");
-    printf("%d", coords[i]);
-  }
-  printf(")\n");
-}
-#endif
-
-/**
- * Set in the bit matrix the bits of the tiles connecting with a line the
- * two input tiles
- *
- * @param[out] bm Bit matrix
- * @param[in] coords1, coords2 Coordinates of the input tiles
- * @param[in] numdims Number of dimensions of the grid
- */
-static void
-bresenham_bm(BitMatrix *bm, int *coords1, int *coords2, int numdims)
-{
-  int i, j, delta[MAXDIMS], next[MAXDIMS], p[MAXDIMS], coords[MAXDIMS],
-    neighbors[MAXDIMS];
-  memset(delta, 0, sizeof(delta));
-  memset(next, 0, sizeof(next));
-  memset(p, 0, sizeof(p));
-  memset(coords, 0, sizeof(coords));
-  memset(neighbors, 0, sizeof(neighbors));
-  /* Compute the delta and next values for every dimension */
-  for (i = 0; i < numdims; i++)
-  {
-    delta[i] = abs(coords2[i] - coords1[i]);
-    if (coords2[i] > coords1[i])
-      next[i] = 1;
-    else
-      next[i] = -1;
-  }
-  /* Compute the driving axis
-   * At the end, the driving axis is the one in variable axis */
-  int axis;
-  for (i = 0; i < numdims; i++)
-  {
-    /* We bet on the current i axis */
-    bool found = true;
-    axis = i;
-    for (j = 0; j < numdims; j++)
-    {
-      if (i == j) continue;
-      if (delta[i] < delta[j])
-      {
-        found = false;
-        break;
-      }
-    }
-    if (found)
-      break;
-  }
-  for (i = 0; i < numdims; i++)
-  {
-    if (i == axis) continue;
-    p[i] = 2 * delta[i] - delta[axis];
-  }
-  /* Make a copy of the start coordinates */
-  memcpy(coords, coords1, sizeof(neighbors));
-  /* Loop from start to end tile
-   * The end of the loop is after printing the last element */
-  while (true)
-  {
-    /* Set the current Bresenham diagonal tile */
-    // coord_print(coords, numdims);
-    bitmatrix_set_cell(bm, coords, true);
-    /* Exit the loop when finished */
-    if (coords[axis] == coords2[axis])
-      break;
-    /* Find neighbors of the Bresenham diagonal tile */
-    memcpy(neighbors, coords, sizeof(neighbors));
-    // printf("Neighbors\n");
-    for (i = 1; i < numdims; i++)
-    {
-      if (next[i] == 0) continue;
-      /* Bottom of the Bresenham diagonal cell for 2D */
-      neighbors[i] -= 1;
-      int min = Min(coords1[i], coords2[i]);
-      int max = Max(coords1[i], coords2[i]);
-      if (neighbors[i] >= min)
-      {
-        // coord_print(neighbors, numdims);
-        bitmatrix_set_cell(bm, coords, true);
-      }
-      /* Top of the Bresenham diagonal cell for 2D */
-      neighbors[i] += 2;
-      if (neighbors[i] <= max)
-      {
-        // coord_print(neighbors, numdims);
-        bitmatrix_set_cell(bm, coords, true);
-      }
-    }
-    // printf("-------\n");
-    /* Advance state */
-    coords[axis] += next[axis];
-    for (i = 0; i < numdims; i++)
-    {
-      if (i == axis) continue;
-      if (p[i] >= 0)
-      {
-        coords[i] += next[i];
-        p[i] -= 2 * delta[axis];
-      }
-    }
-    for (i = 0; i < numdims; i++)
-    {
-      if (i == axis) continue;
-      p[i] += 2 * delta[i];
-    }
-  }
-  return;
-}
-
 /*****************************************************************************
  * Grid functions
  *****************************************************************************/
@@ -428,7 +94,6 @@ stbox_tile_set(STBOX *result, double x, double y, double z, TimestampTz t,
 /**
  * Create the initial state that persists across multiple calls of the function
  *
- * @param[in] temp Optional temporal point to split
  * @param[in] box Bounds for generating the multidimensional grid
  * @param[in] size Tile size for the spatial dimensions in the units of the SRID
  * @param[in] tunits Tile size for the temporal dimension in PostgreSQL time units
@@ -440,7 +105,7 @@ stbox_tile_set(STBOX *result, double x, double y, double z, TimestampTz t,
  * dimension is tiled.
  */
 static STboxGridState *
-stbox_tile_state_make(Temporal *temp, STBOX *box, double size, int64 tunits,
+stbox_tile_state_make(const STBOX *box, double size, int64 tunits,
   POINT3DZ sorigin, TimestampTz torigin)
 {
   assert(size > 0);
@@ -469,7 +134,6 @@ stbox_tile_state_make(Temporal *temp, STBOX *box, double size, int64 tunits,
   state->y = state->box.ymin;
   state->z = state->box.zmin;
   state->t = state->box.tmin;
-  state->temp = temp;
   return state;
 }
 
@@ -568,18 +232,6 @@ stbox_tile_state_get(STboxGridState *state, STBOX *box)
 {
   if (!state || state->done)
     return false;
-  /* Get the box of the current tile.
-   * If there is a bit matrix for speeding up the computation, the while loop
-     finds the next tile that is set in the matrix, if any */
-  if (state->bm != NULL)
-  {
-    while (! bitmatrix_get(state->bm, state->coords))
-    {
-      stbox_tile_state_next(state);
-      if (state->done)
-        return false;
-    }
-  }
   bool hasz = MOBDB_FLAGS_GET_Z(state->box.flags);
   bool hast = MOBDB_FLAGS_GET_T(state->box.flags);
   stbox_tile_set(box, state->x, state->y, state->z, state->t, state->size,
@@ -652,7 +304,7 @@ Stbox_multidim_grid(PG_FUNCTION_ARGS)
     MemoryContext oldcontext =
       MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
     /* Create function state */
-    funcctx->user_fctx = stbox_tile_state_make(NULL, bounds, size, tunits, pt,
+    funcctx->user_fctx = stbox_tile_state_make(bounds, size, tunits, pt,
       torigin);
     /* Build a tuple description for a multidim_grid tuple */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
@@ -677,9 +329,7 @@ Stbox_multidim_grid(PG_FUNCTION_ARGS)
 
   /* Allocate box */
   STBOX *box = (STBOX *) palloc(sizeof(STBOX));
-  /* Get current tile and advance state
-   * There is no need to test if the tile is found since all tiles should be
-   * generated and thus there is no associated bit matrix */
+  /* Get current tile and advance state */
   stbox_tile_state_get(state, box);
   stbox_tile_state_next(state);
   /* Form tuple and return
@@ -764,180 +414,629 @@ Stbox_multidim_tile(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+
 /*****************************************************************************
  * Split functions
+ *
+ * The temporal point is traversed only once. Each segment is clipped at the
+ * grid lines it crosses, in the same way as the digital differential analyzer
+ * (DDA) of Amanatides and Woo walks through the voxels traversed by a ray,
+ * and the pieces obtained are accumulated into fragments that are each
+ * contained in a single tile. The cost of the split is thus linear in the
+ * number of instants plus the number of grid lines crossed, instead of the
+ * number of tiles in the bounding box times the number of instants.
  *****************************************************************************/
 
 /**
- * Transform the minimum values of a tile into matrix coordinates
+ * Structure for storing a fragment of a temporal point contained in a tile
+ */
+typedef struct
+{
+  int coords[MAXDIMS];  /**< Coordinates of the tile in the order x, y, z, t */
+  int seqno;            /**< Position of the fragment in the traversal */
+  Temporal *temp;       /**< Instant or sequence contained in the tile */
+} TileFragment;
+
+/**
+ * Structure for accumulating the fragments of a temporal point
+ */
+typedef struct
+{
+  const STboxGridState *grid; /**< Grid definition */
+  bool hasz;                  /**< Whether the grid has Z dimension */
+  bool hast;                  /**< Whether the grid has T dimension */
+  int count;                  /**< Number of fragments */
+  int maxcount;               /**< Number of fragments allocated */
+  TileFragment *fragments;    /**< Array of fragments */
+} TileFragmentList;
+
+/**
+ * Structure for storing the crossing of a segment with a grid line
+ */
+typedef struct
+{
+  TimestampTz t;        /**< Timestamp of the crossing */
+  int dim;              /**< Dimension of the grid line */
+  int index;            /**< Position of the grid line in the dimension */
+} GridCrossing;
+
+/**
+ * Structure for storing a breakpoint of a sequence, that is, either an
+ * instant of the sequence or the crossing of a segment with a grid line
+ */
+typedef struct
+{
+  const TInstant *inst; /**< Instant at the breakpoint */
+  bool isnew;           /**< True when the instant must be freed */
+  int coords[MAXDIMS];  /**< Tile containing the instant */
+  int next[MAXDIMS];    /**< Tile containing the segment after the instant */
+} TileBreakpoint;
+
+/**
+ * Compute the coordinates of the tile containing a point
  *
- * @param[out] coords Matrix coordinates
- * @param[in] x,y,z,t Minimum values of the tile
- * @param[in] state Grid information
+ * @param[out] coords Tile coordinates
+ * @param[in] p Point
+ * @param[in] t Timestamp
+ * @param[in] list Grid information
  */
 static void
-tile_get_coords(int *coords, double x, double y, double z, TimestampTz t,
-  const STboxGridState *state)
+tile_point_coords(int *coords, const POINT4D *p, TimestampTz t,
+  const TileFragmentList *list)
 {
-  /* Transform the minimum values of the tile into matrix coordinates */
-  int k = 0;
-  coords[k++] = (x - state->box.xmin) / state->size;
-  coords[k++] = (y - state->box.ymin) / state->size;
-  if (MOBDB_FLAGS_GET_Z(state->box.flags))
-    coords[k++] = (z - state->box.zmin) / state->size;
-  if (MOBDB_FLAGS_GET_T(state->box.flags))
-    coords[k++] = (t - state->box.tmin) / state->tunits;
+  const STboxGridState *grid = list->grid;
+  coords[0] = (int) floor((p->x - grid->box.xmin) / grid->size);
+  coords[1] = (int) floor((p->y - grid->box.ymin) / grid->size);
+  coords[2] = list->hasz ?
+    (int) floor((p->z - grid->box.zmin) / grid->size) : 0;
+  coords[3] = list->hast ? (int) ((t - grid->box.tmin) / grid->tunits) : 0;
   return;
 }
 
 /**
- * Get the coordinates of the tile corresponding the temporal instant point
- *
- * @param[out] coords Tile coordinates
- * @param[in] inst Temporal point
- * @param[in] hasz Whether the tile has Z dimension
- * @param[in] hast Whether the tile has T dimension
- * @param[in] state Grid definition
+ * Return the lower bound of the tiles of a dimension
+ */
+static double
+tile_dim_min(const STboxGridState *grid, int dim)
+{
+  if (dim == 0)
+    return grid->box.xmin;
+  if (dim == 1)
+    return grid->box.ymin;
+  return grid->box.zmin;
+}
+
+/**
+ * Return the value of a coordinate of a point
+ */
+static double
+point4d_get_coord(const POINT4D *p, int dim)
+{
+  if (dim == 0)
+    return p->x;
+  if (dim == 1)
+    return p->y;
+  return p->z;
+}
+
+/**
+ * Set the value of a coordinate of a point
  */
 static void
-tpointinst_get_coords(int *coords, const TInstant *inst, bool hasz, bool hast,
-  const STboxGridState *state)
+point4d_set_coord(POINT4D *p, int dim, double value)
 {
-  /* Read the point and compute the minimum values of the tile */
-  POINT4D p;
-  datum_point4d(tinstant_value(inst), &p);
-  double x = float_bucket(p.x, state->size, state->box.xmin);
-  double y = float_bucket(p.y, state->size, state->box.ymin);
-  double z = 0;
-  TimestampTz t = 0;
-  if (hasz)
-    z = float_bucket(p.z, state->size, state->box.zmin);
-  if (hast)
-    t = timestamptz_bucket(inst->t, state->tunits, state->box.ymin);
-  /* Transform the minimum values of the tile into matrix coordinates */
-  tile_get_coords(coords, x, y, z, t, state);
+  if (dim == 0)
+    p->x = value;
+  else if (dim == 1)
+    p->y = value;
+  else
+    p->z = value;
   return;
 }
 
 /**
- * Set the bit corresponding to the tiles intersecting the temporal point
- *
- * @param[out] bm Bit matrix
- * @param[in] inst Temporal point
- * @param[in] hasz Whether the tile has Z dimension
- * @param[in] hast Whether the tile has T dimension
- * @param[in] state Grid definition
+ * Add a fragment to the list
  */
 static void
-tpointinst_set_tiles(BitMatrix *bm, const TInstant *inst, bool hasz,
-  bool hast, const STboxGridState *state)
+tile_fragments_add(TileFragmentList *list, const int *coords, Temporal *temp)
 {
-  /* Transform the point into tile coordinates */
-  int coords[MAXDIMS];
-  memset(coords, 0, sizeof(coords));
-  tpointinst_get_coords(coords, inst, hasz, hast, state);
-  /* Set the corresponding bit in the matix */
-  bitmatrix_set_cell(bm, coords, true);
+  if (list->count == list->maxcount)
+  {
+    list->maxcount *= 2;
+    list->fragments = repalloc(list->fragments,
+      sizeof(TileFragment) * list->maxcount);
+  }
+  TileFragment *frag = &list->fragments[list->count];
+  memcpy(frag->coords, coords, sizeof(frag->coords));
+  frag->seqno = list->count++;
+  frag->temp = temp;
   return;
 }
 
 /**
- * Set the bit corresponding to the tiles intersecting the temporal point
+ * Add a sequence fragment to the list
+ */
+static void
+tile_fragments_add_seq(TileFragmentList *list, const int *coords,
+  const TInstant **instants, int count, bool lower_inc, bool upper_inc,
+  bool linear)
+{
+  TSequence *seq = tsequence_make(instants, count, lower_inc, upper_inc,
+    linear, NORMALIZE);
+  tile_fragments_add(list, coords, (Temporal *) seq);
+  return;
+}
+
+/**
+ * Comparator function for grid crossings
+ */
+static int
+grid_crossing_cmp(const void *a, const void *b)
+{
+  TimestampTz t1 = ((const GridCrossing *) a)->t;
+  TimestampTz t2 = ((const GridCrossing *) b)->t;
+  return (t1 < t2) ? -1 : ((t1 > t2) ? 1 : 0);
+}
+
+/**
+ * Comparator function for fragments. The tiles are sorted with the x
+ * coordinate varying fastest, which is the order in which the tiles of the
+ * multidimensional grid are enumerated, and the fragments of a tile are
+ * sorted in the order of the traversal.
+ */
+static int
+tile_fragment_cmp(const void *a, const void *b)
+{
+  const TileFragment *frag1 = (const TileFragment *) a;
+  const TileFragment *frag2 = (const TileFragment *) b;
+  for (int i = MAXDIMS - 1; i >= 0; i--)
+  {
+    if (frag1->coords[i] != frag2->coords[i])
+      return (frag1->coords[i] < frag2->coords[i]) ? -1 : 1;
+  }
+  return (frag1->seqno < frag2->seqno) ? -1 :
+    ((frag1->seqno > frag2->seqno) ? 1 : 0);
+}
+
+/**
+ * Compute the crossings of a segment with the grid lines, sorted by time
  *
- * @param[out] bm Bit matrix
- * @param[in] ti Temporal point
- * @param[in] hasz Whether the tile has Z dimension
- * @param[in] hast Whether the tile has T dimension
- * @param[in] state Grid definition
+ * @param[in] inst1,inst2 Instants defining the segment
+ * @param[in] linear True when the segment has linear interpolation
+ * @param[in] list Grid information
+ * @param[in,out] crossings Array of crossings, enlarged if needed
+ * @param[in,out] maxcount Size of the array of crossings
+ * @result Number of crossings
+ */
+static int
+tpointsegm_grid_crossings(const TInstant *inst1, const TInstant *inst2,
+  bool linear, const TileFragmentList *list, GridCrossing **crossings,
+  int *maxcount)
+{
+  const STboxGridState *grid = list->grid;
+  POINT4D p1, p2;
+  datum_point4d(tinstant_value(inst1), &p1);
+  datum_point4d(tinstant_value(inst2), &p2);
+  int coords1[MAXDIMS], coords2[MAXDIMS];
+  tile_point_coords(coords1, &p1, inst1->t, list);
+  tile_point_coords(coords2, &p2, inst2->t, list);
+
+  /* Compute an upper bound of the number of crossings */
+  int numdims = list->hasz ? 3 : 2;
+  int total = 0, dim;
+  if (linear)
+  {
+    for (dim = 0; dim < numdims; dim++)
+      total += abs(coords2[dim] - coords1[dim]);
+  }
+  if (list->hast)
+    total += coords2[3] - coords1[3];
+  if (total == 0)
+    return 0;
+  if (total > *maxcount)
+  {
+    *maxcount = total;
+    *crossings = repalloc(*crossings, sizeof(GridCrossing) * total);
+  }
+
+  int count = 0;
+  double duration = (double) (inst2->t - inst1->t);
+  /* Crossings with the spatial grid lines, which only occur for linear
+   * interpolation since otherwise the point jumps at the end instant */
+  for (dim = 0; linear && dim < numdims; dim++)
+  {
+    if (coords1[dim] == coords2[dim])
+      continue;
+    double v1 = point4d_get_coord(&p1, dim);
+    double v2 = point4d_get_coord(&p2, dim);
+    int step = (coords2[dim] > coords1[dim]) ? 1 : -1;
+    /* When moving upwards the first grid line is the lower bound of the next
+     * tile, when moving downwards it is the lower bound of the current tile */
+    int first = (step > 0) ? coords1[dim] + 1 : coords1[dim];
+    int last = (step > 0) ? coords2[dim] : coords2[dim] + 1;
+    for (int k = first; step > 0 ? k <= last : k >= last; k += step)
+    {
+      double line = tile_dim_min(grid, dim) + k * grid->size;
+      double ratio = (line - v1) / (v2 - v1);
+      if (ratio <= 0.0 || ratio >= 1.0)
+        continue;
+      TimestampTz t = inst1->t + (TimestampTz) (duration * ratio);
+      if (t <= inst1->t || t >= inst2->t)
+        continue;
+      (*crossings)[count].t = t;
+      (*crossings)[count].dim = dim;
+      (*crossings)[count++].index = k;
+    }
+  }
+  /* Crossings with the temporal grid lines */
+  if (list->hast)
+  {
+    for (int k = coords1[3] + 1; k <= coords2[3]; k++)
+    {
+      TimestampTz t = grid->box.tmin + k * grid->tunits;
+      if (t <= inst1->t || t >= inst2->t)
+        continue;
+      (*crossings)[count].t = t;
+      (*crossings)[count].dim = 3;
+      (*crossings)[count++].index = k;
+    }
+  }
+  if (count > 1)
+    qsort(*crossings, (size_t) count, sizeof(GridCrossing), grid_crossing_cmp);
+  return count;
+}
+
+/**
+ * Compute the value of a segment at a timestamp
+ *
+ * @param[out] p Value of the segment
+ * @param[in] p1,p2 Values at the start and the end of the segment
+ * @param[in] t1,t2 Timestamps at the start and the end of the segment
+ * @param[in] linear True when the segment has linear interpolation
+ * @param[in] t Timestamp
  */
 static void
-tpointinstset_set_tiles(BitMatrix *bm, const TInstantSet *ti, bool hasz,
-  bool hast, const STboxGridState *state)
+tpointsegm_point_at_timestamp(POINT4D *p, const POINT4D *p1,
+  const POINT4D *p2, TimestampTz t1, TimestampTz t2, bool linear,
+  TimestampTz t)
 {
-  /* Transform the point into tile coordinates */
-  int coords[MAXDIMS];
-  memset(coords, 0, sizeof(coords));
-  for (int i = 0; i < ti->count; i++)
+  if (! linear)
   {
-    const TInstant *inst = tinstantset_inst_n(ti, i);
-    tpointinst_get_coords(coords, inst, hasz, hast, state);
-    bitmatrix_set_cell(bm, coords, true);
+    *p = *p1;
+    return;
   }
+  double ratio = (double) (t - t1) / (double) (t2 - t1);
+  p->x = p1->x + (p2->x - p1->x) * ratio;
+  p->y = p1->y + (p2->y - p1->y) * ratio;
+  p->z = p1->z + (p2->z - p1->z) * ratio;
+  p->m = 0;
+  return;
+}
+
+/**
+ * Add to the list the fragments of the temporal point
+ */
+static void
+tpointinst_split_tiles(TileFragmentList *list, const TInstant *inst)
+{
+  POINT4D p;
+  int coords[MAXDIMS];
+  datum_point4d(tinstant_value(inst), &p);
+  tile_point_coords(coords, &p, inst->t, list);
+  tile_fragments_add(list, coords, (Temporal *) inst);
   return;
 }
 
 /**
- * Set the bit corresponding to the tiles intersecting the temporal point
+ * Add to the list the fragments of the temporal point
+ */
+static void
+tpointinstset_split_tiles(TileFragmentList *list, const TInstantSet *ti)
+{
+  for (int i = 0; i < ti->count; i++)
+    tpointinst_split_tiles(list, tinstantset_inst_n(ti, i));
+  return;
+}
+
+/**
+ * Compute the breakpoints of the temporal point, that is, its instants and
+ * the crossings of its segments with the grid lines, together with the tiles
+ * containing each breakpoint and each piece between two breakpoints
  *
- * @param[out] bm Bit matrix
  * @param[in] seq Temporal point
- * @param[in] hasz Whether the tile has Z dimension
- * @param[in] hast Whether the tile has T dimension
- * @param[in] state Grid definition
+ * @param[in] list Grid information
+ * @param[out] count Number of breakpoints
  */
-static void
-tpointseq_set_tiles(BitMatrix *bm, const TSequence *seq, bool hasz,
-  bool hast, const STboxGridState *state)
+static TileBreakpoint *
+tpointseq_breakpoints(const TSequence *seq, const TileFragmentList *list,
+  int *count)
 {
-  int numdims = 2 + (hasz ? 1 : 0) + (hast ? 1 : 0);
-  int coords1[MAXDIMS], coords2[MAXDIMS];
-  memset(coords1, 0, sizeof(coords1));
-  memset(coords2, 0, sizeof(coords2));
+  const STboxGridState *grid = list->grid;
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  bool hasz = MOBDB_FLAGS_GET_Z(seq->flags);
+  int maxbreaks = seq->count * 2;
+  TileBreakpoint *breaks = palloc(sizeof(TileBreakpoint) * maxbreaks);
+  int maxcross = 16;
+  GridCrossing *crossings = palloc(sizeof(GridCrossing) * maxcross);
+  POINT4D p1, p2, p;
+  int nbreaks = 0;
+
   const TInstant *inst1 = tsequence_inst_n(seq, 0);
-  tpointinst_get_coords(coords1, inst1, hasz, hast, state);
-  for (int i = 1; i < seq->count; i++)
+  datum_point4d(tinstant_value(inst1), &p1);
+  for (int i = 0; i < seq->count; i++)
   {
-    const TInstant *inst2 = tsequence_inst_n(seq, i);
-    tpointinst_get_coords(coords2, inst2, hasz, hast, state);
-    bresenham_bm(bm, coords1, coords2, numdims);
+    /* Add the instant as a breakpoint */
+    TileBreakpoint *brk = &breaks[nbreaks++];
+    brk->inst = inst1;
+    brk->isnew = false;
+    tile_point_coords(brk->coords, &p1, inst1->t, list);
+    if (i == seq->count - 1)
+      break;
+
+    /* Add the crossings of the segment with the grid lines as breakpoints */
+    const TInstant *inst2 = tsequence_inst_n(seq, i + 1);
+    datum_point4d(tinstant_value(inst2), &p2);
+    int ncross = tpointsegm_grid_crossings(inst1, inst2, linear, list,
+      &crossings, &maxcross);
+    if (nbreaks + ncross + 1 > maxbreaks)
+    {
+      maxbreaks = (nbreaks + ncross + 1) * 2;
+      breaks = repalloc(breaks, sizeof(TileBreakpoint) * maxbreaks);
+    }
+    int j = 0;
+    while (j < ncross)
+    {
+      TimestampTz t = crossings[j].t;
+      tpointsegm_point_at_timestamp(&p, &p1, &p2, inst1->t, inst2->t, linear,
+        t);
+      brk = &breaks[nbreaks++];
+      /* Snap the point to the grid lines crossed at the same timestamp and
+       * assign it to the tile above each of these lines */
+      int k;
+      int snapped[MAXDIMS] = {-1, -1, -1, -1};
+      for (k = j; k < ncross && crossings[k].t == t; k++)
+      {
+        int dim = crossings[k].dim;
+        snapped[dim] = crossings[k].index;
+        if (dim < 3)
+          point4d_set_coord(&p, dim, tile_dim_min(grid, dim) +
+            crossings[k].index * grid->size);
+      }
+      tile_point_coords(brk->coords, &p, t, list);
+      for (int dim = 0; dim < MAXDIMS; dim++)
+      {
+        if (snapped[dim] >= 0)
+          brk->coords[dim] = snapped[dim];
+      }
+      Datum value = linear ?
+        point_make(p.x, p.y, p.z, hasz, false, grid->box.srid) :
+        tinstant_value(inst1);
+      brk->inst = tinstant_make(value, t, seq->temptype);
+      brk->isnew = true;
+      if (linear)
+        pfree(DatumGetPointer(value));
+      j = k;
+    }
+    inst1 = inst2;
+    p1 = p2;
   }
-  return;
+
+  /* Compute the tiles containing the pieces between two breakpoints from
+   * their middle point, which is not located on a grid line */
+  inst1 = tsequence_inst_n(seq, 0);
+  datum_point4d(tinstant_value(inst1), &p1);
+  int next = 1;
+  const TInstant *inst2 = (seq->count > 1) ? tsequence_inst_n(seq, 1) : NULL;
+  if (inst2)
+    datum_point4d(tinstant_value(inst2), &p2);
+  for (int i = 0; i < nbreaks - 1; i++)
+  {
+    /* Advance to the segment containing the piece */
+    while (breaks[i].inst->t >= inst2->t)
+    {
+      inst1 = inst2;
+      p1 = p2;
+      inst2 = tsequence_inst_n(seq, ++next);
+      datum_point4d(tinstant_value(inst2), &p2);
+    }
+    TimestampTz t = breaks[i].inst->t +
+      (breaks[i + 1].inst->t - breaks[i].inst->t) / 2;
+    tpointsegm_point_at_timestamp(&p, &p1, &p2, inst1->t, inst2->t, linear,
+      t);
+    tile_point_coords(breaks[i].next, &p, t, list);
+  }
+  pfree(crossings);
+  *count = nbreaks;
+  return breaks;
 }
 
 /**
- * Set the bit corresponding to the tiles intersecting the temporal point
+ * Add to the list the fragments of the temporal point
  *
- * @param[out] bm Bit matrix
- * @param[in] ts Temporal point
- * @param[in] hasz Whether the tile has Z dimension
- * @param[in] hast Whether the tile has T dimension
- * @param[in] state Grid definition
+ * @note The breakpoints of the sequence are traversed in order, and a
+ * fragment is closed each time the point leaves a tile. A breakpoint
+ * located on the boundary of a tile belongs to the tile above the boundary,
+ * as is the case for the half-open tiles used by the restriction functions.
+ * When such a breakpoint belongs neither to the tile before nor to the tile
+ * after it, e.g., when the point crosses the corner of a tile, it is added
+ * as an instantaneous sequence of its own tile.
  */
 static void
-tpointseqset_set_tiles(BitMatrix *bm, const TSequenceSet *ts, bool hasz,
-  bool hast, const STboxGridState *state)
+tpointseq_split_tiles(TileFragmentList *list, const TSequence *seq)
 {
-  for (int i = 0; i < ts->count; i++)
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  int nbreaks;
+  TileBreakpoint *breaks = tpointseq_breakpoints(seq, list, &nbreaks);
+  const TInstant **instants = palloc(sizeof(TInstant *) * (nbreaks + 1));
+  int start = 0;
+  bool lower_inc = false;
+  for (int i = 0; i < nbreaks; i++)
+  {
+    const TileBreakpoint *brk = &breaks[i];
+    bool last = (i == nbreaks - 1);
+    bool included = (i > 0 || seq->period.lower_inc) &&
+      (! last || seq->period.upper_inc);
+    bool consumed = false;
+    if (i > 0)
+    {
+      /* There is an open fragment in the tile of the previous piece */
+      const int *coords = breaks[i - 1].next;
+      consumed = included &&
+        memcmp(brk->coords, coords, sizeof(brk->coords)) == 0;
+      /* The point does not leave the tile at this breakpoint */
+      if (consumed && ! last &&
+          memcmp(brk->next, coords, sizeof(brk->next)) == 0)
+        continue;
+      int count = 0;
+      for (int j = start; j < i; j++)
+        instants[count++] = breaks[j].inst;
+      if (consumed)
+      {
+        instants[count++] = brk->inst;
+        tile_fragments_add_seq(list, coords, instants, count, lower_inc,
+          true, linear);
+      }
+      else
+      {
+        /* The fragment ends with the value at the left of the breakpoint */
+        TInstant *inst = linear ? (TInstant *) brk->inst :
+          tinstant_make(tinstant_value(breaks[i - 1].inst), brk->inst->t,
+            seq->temptype);
+        instants[count++] = inst;
+        tile_fragments_add_seq(list, coords, instants, count, lower_inc,
+          false, linear);
+        if (! linear)
+          pfree(inst);
+      }
+    }
+    /* Open a new fragment in the tile of the next piece */
+    lower_inc = ! last && included &&
+      memcmp(brk->coords, brk->next, sizeof(brk->coords)) == 0;
+    if (included && ! consumed && ! lower_inc)
+    {
+      instants[0] = brk->inst;
+      tile_fragments_add_seq(list, brk->coords, instants, 1, true, true,
+        linear);
+    }
+    start = i;
+  }
+  for (int i = 0; i < nbreaks; i++)
   {
-    const TSequence *seq = tsequenceset_seq_n(ts, i);
-    tpointseq_set_tiles(bm, seq, hasz, hast, state);
+    if (breaks[i].isnew)
+      pfree((TInstant *) breaks[i].inst);
   }
+  pfree(breaks); pfree(instants);
+  return;
+}
+
+/**
+ * Add to the list the fragments of the temporal point
+ */
+static void
+tpointseqset_split_tiles(TileFragmentList *list, const TSequenceSet *ts)
+{
+  for (int i = 0; i < ts->count; i++)
+    tpointseq_split_tiles(list, tsequenceset_seq_n(ts, i));
   return;
 }
 
 /**
- * Set the bit corresponding to the tiles intersecting the temporal point
- * (dispatch function)
+ * Compute the fragments of a temporal point with respect to a
+ * multidimensional grid in a single traversal
  *
- * @param[out] bm Bit matrix
+ * @param[out] list List of fragments
  * @param[in] temp Temporal point
- * @param[in] state Grid definition
+ * @param[in] grid Grid definition
  */
 static void
-tpoint_set_tiles(BitMatrix *bm, const Temporal *temp,
-  const STboxGridState *state)
+tpoint_split_tiles(TileFragmentList *list, const Temporal *temp,
+  const STboxGridState *grid)
 {
-  bool hasz = MOBDB_FLAGS_GET_Z(state->box.flags);
-  bool hast = (state->tunits > 0);
+  list->grid = grid;
+  list->hasz = MOBDB_FLAGS_GET_Z(grid->box.flags);
+  list->hast = (grid->tunits > 0);
+  list->count = 0;
+  list->maxcount = 64;
+  list->fragments = palloc(sizeof(TileFragment) * list->maxcount);
   ensure_valid_tempsubtype(temp->subtype);
   if (temp->subtype == INSTANT)
-    tpointinst_set_tiles(bm, (TInstant *) temp, hasz, hast, state);
+    tpointinst_split_tiles(list, (TInstant *) temp);
   else if (temp->subtype == INSTANTSET)
-    tpointinstset_set_tiles(bm, (TInstantSet *) temp, hasz, hast, state);
+    tpointinstset_split_tiles(list, (TInstantSet *) temp);
   else if (temp->subtype == SEQUENCE)
-    tpointseq_set_tiles(bm, (TSequence *) temp, hasz, hast, state);
+    tpointseq_split_tiles(list, (TSequence *) temp);
   else /* temp->subtype == SEQUENCESET */
-    tpointseqset_set_tiles(bm, (TSequenceSet *) temp, hasz, hast, state);
+    tpointseqset_split_tiles(list, (TSequenceSet *) temp);
+  return;
+}
+
+/**
+ * Create the state for splitting a temporal point with respect to a
+ * multidimensional grid, that is, the tiles traversed by the temporal point
+ * and the fragments of the temporal point in each of these tiles.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] grid Grid definition
+ */
+static STboxSplitState *
+tpoint_split_state_make(const Temporal *temp, const STboxGridState *grid)
+{
+  /* Compute the fragments of the temporal point in a single traversal */
+  TileFragmentList list;
+  tpoint_split_tiles(&list, temp, grid);
+  if (list.count > 1)
+    qsort(list.fragments, (size_t) list.count, sizeof(TileFragment),
+      tile_fragment_cmp);
+
+  /* Assemble the fragments of each tile */
+  STboxSplitState *state = palloc0(sizeof(STboxSplitState));
+  state->tiles = palloc(sizeof(STBOX) * list.count);
+  state->fragments = palloc(sizeof(Temporal *) * list.count);
+  Temporal **group = palloc(sizeof(Temporal *) * list.count);
+  int i = 0;
+  while (i < list.count)
+  {
+    const int *coords = list.fragments[i].coords;
+    int count = 0;
+    int j = i;
+    while (j < list.count &&
+      memcmp(list.fragments[j].coords, coords, sizeof(int) * MAXDIMS) == 0)
+      group[count++] = list.fragments[j++].temp;
+    Temporal *result;
+    if (temp->subtype == INSTANT)
+      result = (Temporal *) tinstant_copy((TInstant *) group[0]);
+    else if (temp->subtype == INSTANTSET)
+      result = (Temporal *) tinstantset_make((const TInstant **) group, count,
+        MERGE_NO);
+    else
+    {
+      result = (Temporal *) tsequenceset_make((const TSequence **) group,
+        count, NORMALIZE);
+      for (int k = 0; k < count; k++)
+        pfree(group[k]);
+    }
+    stbox_tile_set(&state->tiles[state->count],
+      grid->box.xmin + coords[0] * grid->size,
+      grid->box.ymin + coords[1] * grid->size,
+      grid->box.zmin + coords[2] * grid->size,
+      grid->box.tmin + coords[3] * grid->tunits, grid->size, grid->tunits,
+      list.hasz, list.hast, grid->box.srid);
+    state->fragments[state->count++] = result;
+    i = j;
+  }
+  pfree(group); pfree(list.fragments);
+  return state;
+}
+
+/**
+ * Free the state for splitting a temporal point
+ */
+static void
+tpoint_split_state_free(STboxSplitState *state)
+{
+  pfree(state->tiles);
+  pfree(state->fragments);
+  pfree(state);
   return;
 }
 
@@ -946,13 +1045,16 @@ tpoint_set_tiles(BitMatrix *bm, const Temporal *temp,
 PG_FUNCTION_INFO_V1(Tpoint_space_split);
 /**
  * Split a temporal point with respect to a spatial grid.
+ *
+ * @note The last argument, which stated whether a bit matrix is used for
+ * speeding up the computation, is ignored since the temporal point is
+ * traversed only once.
  */
 PGDLLEXPORT Datum
 Tpoint_space_split(PG_FUNCTION_ARGS)
 {
   FuncCallContext *funcctx;
-  STboxGridState *state;
-  bool hasz;
+  STboxSplitState *state;
   bool isnull[2] = {0,0}; /* needed to say no value is null */
   Datum tuple_arr[2]; /* used to construct the composite return value */
   HeapTuple tuple;
@@ -971,7 +1073,6 @@ Tpoint_space_split(PG_FUNCTION_ARGS)
     Temporal *temp = PG_GETARG_TEMPORAL_P(0);
     double size = PG_GETARG_FLOAT8(1);
     GSERIALIZED *sorigin = PG_GETARG_GSERIALIZED_P(2);
-    bool bitmatrix = PG_GETARG_BOOL(3);
 
     /* Ensure parameter validity */
     ensure_positive_datum(Float8GetDatum(size), T_FLOAT8);
@@ -997,27 +1098,11 @@ Tpoint_space_split(PG_FUNCTION_ARGS)
       pt.x = p2d->x;
       pt.y = p2d->y;
     }
-    hasz = MOBDB_FLAGS_GET_Z(temp->flags);
 
     /* Create function state */
-    STboxGridState *state = stbox_tile_state_make(temp, &bounds, size, 0, pt, 0);
-    /* If a bit matrix is used to speed up the process */
-    if (bitmatrix)
-    {
-      /* Create the bit matrix and set the tiles traversed by the temporal point */
-      int count[MAXDIMS];
-      memset(&count, 0, sizeof(count));
-      int numdims = 2;
-      /* We need to add 1 to take into account the last bucket for each dimension */
-      count[0] = ( (state->box.xmax - state->box.xmin) / state->size ) + 1;
-      count[1] = ( (state->box.ymax - state->box.ymin) / state->size ) + 1;
-      if (MOBDB_FLAGS_GET_Z(state->box.flags))
-        count[numdims++] = ( (state->box.zmax - state->box.zmin) / state->size ) + 1;
-      /* We are sure that there is no additional time dimension */
-      state->bm = bitmatrix_make(count, numdims);
-      tpoint_set_tiles(state->bm, temp, state);
-    }
-    funcctx->user_fctx = state;
+    STboxGridState *grid = stbox_tile_state_make(&bounds, size, 0, pt, 0);
+    funcctx->user_fctx = tpoint_split_state_make(temp, grid);
+    pfree(grid);
 
     /* Build a tuple description for a multidimensional grid tuple */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
@@ -1029,50 +1114,25 @@ Tpoint_space_split(PG_FUNCTION_ARGS)
   funcctx = SRF_PERCALL_SETUP();
   /* Get state */
   state = funcctx->user_fctx;
-  /* We need to loop since atStbox may be NULL */
-  while (true)
+  /* Stop when we have output all the tiles */
+  if (state->i == state->count)
   {
-    /* Stop when we have used up all the grid tiles */
-    if (state->done)
-    {
-      /* Switch to memory context appropriate for multiple function calls */
-      MemoryContext oldcontext =
-        MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-      if (state->bm) pfree(state->bm);
-      pfree(state);
-      MemoryContextSwitchTo(oldcontext);
-      SRF_RETURN_DONE(funcctx);
-    }
-
-    /* Get current tile (if any) and advance state
-     * It is necessary to test if we found a tile since the previous tile
-     * may be the last one set in the associated bit matrix */
-    STBOX box;
-    bool found = stbox_tile_state_get(state, &box);
-    if (! found)
-    {
-      /* Switch to memory context appropriate for multiple function calls */
-      MemoryContext oldcontext =
-        MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-      if (state->bm) pfree(state->bm);
-      pfree(state);
-      MemoryContextSwitchTo(oldcontext);
-      SRF_RETURN_DONE(funcctx);
-    }
-    stbox_tile_state_next(state);
-    /* Restrict the temporal point to the box */
-    Temporal *atstbox = tpoint_at_stbox(state->temp, &box, UPPER_EXC);
-    if (atstbox == NULL)
-      continue;
-    /* Form tuple and return */
-    hasz = MOBDB_FLAGS_GET_Z(state->temp->flags);
-    tuple_arr[0] = point_make(box.xmin, box.ymin, box.zmin, hasz, false,
-      box.srid);
-    tuple_arr[1] = PointerGetDatum(atstbox);
-    tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
-    result = HeapTupleGetDatum(tuple);
-    SRF_RETURN_NEXT(funcctx, result);
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    tpoint_split_state_free(state);
+    MemoryContextSwitchTo(oldcontext);
+    SRF_RETURN_DONE(funcctx);
   }
+
+  /* Form tuple and return */
+  STBOX *box = &state->tiles[state->i];
+  tuple_arr[0] = point_make(box->xmin, box->ymin, box->zmin,
+    MOBDB_FLAGS_GET_Z(box->flags), false, box->srid);
+  tuple_arr[1] = PointerGetDatum(state->fragments[state->i++]);
+  tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
+  result = HeapTupleGetDatum(tuple);
+  SRF_RETURN_NEXT(funcctx, result);
 }
 
 /*****************************************************************************/
@@ -1080,13 +1140,16 @@ Tpoint_space_split(PG_FUNCTION_ARGS)
 PG_FUNCTION_INFO_V1(Tpoint_space_time_split);
 /**
  * Split a temporal point with respect to a spatiotemporal grid.
+ *
+ * @note The last argument, which stated whether a bit matrix is used for
+ * speeding up the computation, is ignored since the temporal point is
+ * traversed only once.
  */
 PGDLLEXPORT Datum
 Tpoint_space_time_split(PG_FUNCTION_ARGS)
 {
   FuncCallContext *funcctx;
-  STboxGridState *state;
-  bool hasz;
+  STboxSplitState *state;
   bool isnull[3] = {0,0,0}; /* needed to say no value is null */
   Datum tuple_arr[3]; /* used to construct the composite return value */
   HeapTuple tuple;
@@ -1107,7 +1170,6 @@ Tpoint_space_time_split(PG_FUNCTION_ARGS)
     Interval *duration = PG_GETARG_INTERVAL_P(2);
     GSERIALIZED *sorigin = PG_GETARG_GSERIALIZED_P(3);
     TimestampTz torigin = PG_GETARG_TIMESTAMPTZ(4);
-    bool bitmatrix = PG_GETARG_BOOL(5);
 
     /* Ensure parameter validity */
     ensure_positive_datum(Float8GetDatum(size), T_FLOAT8);
@@ -1133,28 +1195,12 @@ Tpoint_space_time_split(PG_FUNCTION_ARGS)
       pt.x = p2d->x;
       pt.y = p2d->y;
     }
-    hasz = MOBDB_FLAGS_GET_Z(temp->flags);
 
     /* Create function state */
-    STboxGridState *state = stbox_tile_state_make(temp, &bounds, size, tunits,
-      pt, torigin);
-    /* If a bit matrix is used to speed up the process */
-    if (bitmatrix)
-    {
-      /* Create the bit matrix and set the tiles traversed by the temporal point */
-      int count[MAXDIMS];
-      memset(&count, 0, sizeof(count));
-      int numdims = 2;
-      count[0] = ( (state->box.xmax - state->box.xmin) / state->size ) + 1;
-      count[1] = ( (state->box.ymax - state->box.ymin) / state->size ) + 1;
-      if (MOBDB_FLAGS_GET_Z(state->box.flags))
-        count[numdims++] = ( (state->box.zmax - state->box.zmin) / state->size ) + 1;
-      if (state->tunits)
-        count[numdims++] = ( (state->box.tmax - state->box.tmin) / state->tunits ) + 1;
-      state->bm = bitmatrix_make(count, numdims);
-      tpoint_set_tiles(state->bm, temp, state);
-    }
-    funcctx->user_fctx = state;
+    STboxGridState *grid = stbox_tile_state_make(&bounds, size, tunits, pt,
+      torigin);
+    funcctx->user_fctx = tpoint_split_state_make(temp, grid);
+    pfree(grid);
 
     /* Build a tuple description for a multidimensional grid tuple */
     get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
@@ -1166,51 +1212,460 @@ Tpoint_space_time_split(PG_FUNCTION_ARGS)
   funcctx = SRF_PERCALL_SETUP();
   /* Get state */
   state = funcctx->user_fctx;
-  /* We need to loop since atstbox may be NULL */
-  while (true)
+  /* Stop when we have output all the tiles */
+  if (state->i == state->count)
+  {
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    tpoint_split_state_free(state);
+    MemoryContextSwitchTo(oldcontext);
+    SRF_RETURN_DONE(funcctx);
+  }
+
+  /* Form tuple and return */
+  STBOX *box = &state->tiles[state->i];
+  tuple_arr[0] = point_make(box->xmin, box->ymin, box->zmin,
+    MOBDB_FLAGS_GET_Z(box->flags), false, box->srid);
+  tuple_arr[1] = TimestampTzGetDatum(box->tmin);
+  tuple_arr[2] = PointerGetDatum(state->fragments[state->i++]);
+  tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
+  result = HeapTupleGetDatum(tuple);
+  SRF_RETURN_NEXT(funcctx, result);
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************
+ * Multiresolution split functions
+ *
+ * The tiles of a level of the hierarchy are the quadrants of the tiles of the
+ * level above. Level 0 is composed of a single square tile whose lower left
+ * corner is the spatial origin, and level n is a grid of 2^n x 2^n tiles. A
+ * tile is identified by a 64-bit quadkey composed of a leading bit set to 1
+ * followed by the interleaved bits of the row and column numbers of the tile.
+ * The key of the parent of a tile is thus obtained by shifting its key two
+ * bits to the right, so that the tiles of the finest level contained in a
+ * tile of an upper level have consecutive keys.
+ *****************************************************************************/
+
+/**
+ * Ensure that a level of the tile hierarchy is valid
+ */
+static void
+ensure_valid_quadkey_level(int level)
+{
+  if (level < 0 || level > MAX_QUADKEY_LEVEL)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The level must be between 0 and %d", MAX_QUADKEY_LEVEL)));
+  return;
+}
+
+/**
+ * Return the quadkey of a tile
+ *
+ * @param[in] col,row Column and row numbers of the tile in its level
+ * @param[in] level Level of the tile
+ */
+static uint64
+quadkey_make(uint32 col, uint32 row, int level)
+{
+  uint64 result = 1;
+  for (int i = level - 1; i >= 0; i--)
+    result = (result << 2) | ((uint64) ((row >> i) & 1) << 1) |
+      (uint64) ((col >> i) & 1);
+  return result;
+}
+
+/**
+ * Return the column or row number of the tile of a level containing a
+ * coordinate
+ *
+ * @param[in] value Coordinate
+ * @param[in] origin Coordinate of the origin of the tile hierarchy
+ * @param[in] size Size of the tile of level 0
+ * @param[in] level Level
+ * @param[in] upper True when the coordinate is an exclusive upper bound
+ */
+static uint32
+quadkey_tile_index(double value, double origin, double size, int level,
+  bool upper)
+{
+  double pos = (value - origin) / ldexp(size, -level);
+  double index = upper ? ceil(pos) - 1 : floor(pos);
+  if (index < 0 || index >= ldexp(1.0, level))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The spatial extent must be contained in the tile of level 0")));
+  return (uint32) index;
+}
+
+/**
+ * Return the quadkey of the smallest tile of the hierarchy up to a level that
+ * contains a spatiotemporal box
+ *
+ * @param[in] box Spatiotemporal box, whose upper bounds are considered as
+ * exclusive as for the tiles
+ * @param[in] size Size of the tile of level 0
+ * @param[in] level Maximum level
+ * @param[in] origin Origin of the tile hierarchy
+ */
+static uint64
+stbox_quadkey(const STBOX *box, double size, int level, const POINT2D *origin)
+{
+  uint32 col1 = quadkey_tile_index(box->xmin, origin->x, size, level, false);
+  uint32 row1 = quadkey_tile_index(box->ymin, origin->y, size, level, false);
+  uint32 col2 = (box->xmax > box->xmin) ?
+    quadkey_tile_index(box->xmax, origin->x, size, level, true) : col1;
+  uint32 row2 = (box->ymax > box->ymin) ?
+    quadkey_tile_index(box->ymax, origin->y, size, level, true) : row1;
+  /* Move up in the hierarchy until the box is contained in a single tile */
+  while (col1 != col2 || row1 != row2)
   {
-    /* Stop when we have used up all the grid tiles */
-    if (state->done)
+    col1 >>= 1; col2 >>= 1;
+    row1 >>= 1; row2 >>= 1;
+    level--;
+  }
+  return quadkey_make(col1, row1, level);
+}
+
+PG_FUNCTION_INFO_V1(Stbox_quadkey);
+/**
+ * Return the quadkey of the smallest tile of the hierarchy up to a level that
+ * contains a spatiotemporal box
+ */
+PGDLLEXPORT Datum
+Stbox_quadkey(PG_FUNCTION_ARGS)
+{
+  STBOX *box = PG_GETARG_STBOX_P(0);
+  double size = PG_GETARG_FLOAT8(1);
+  int level = PG_GETARG_INT32(2);
+  GSERIALIZED *sorigin = PG_GETARG_GSERIALIZED_P(3);
+  ensure_has_X_stbox(box);
+  ensure_not_geodetic(box->flags);
+  ensure_positive_datum(Float8GetDatum(size), T_FLOAT8);
+  ensure_valid_quadkey_level(level);
+  ensure_non_empty(sorigin);
+  ensure_point_type(sorigin);
+  int32 gs_srid = gserialized_get_srid(sorigin);
+  if (gs_srid != SRID_UNKNOWN)
+    ensure_same_srid(box->srid, gs_srid);
+  uint64 result = stbox_quadkey(box, size, level,
+    gserialized_point2d_p(sorigin));
+  PG_RETURN_INT64((int64) result);
+}
+
+/*****************************************************************************/
+
+/**
+ * Comparator function for fragments, which are sorted by quadkey and then in
+ * the order of the traversal
+ */
+static int
+quadkey_fragment_cmp(const void *a, const void *b)
+{
+  const QuadkeyFragment *frag1 = (const QuadkeyFragment *) a;
+  const QuadkeyFragment *frag2 = (const QuadkeyFragment *) b;
+  if (frag1->key != frag2->key)
+    return (frag1->key < frag2->key) ? -1 : 1;
+  return (frag1->seqno < frag2->seqno) ? -1 :
+    ((frag1->seqno > frag2->seqno) ? 1 : 0);
+}
+
+/**
+ * Comparator function for fragments, which are sorted in the order of the
+ * traversal
+ */
+static int
+quadkey_fragment_seqno_cmp(const void *a, const void *b)
+{
+  int seqno1 = ((const QuadkeyFragment *) a)->seqno;
+  int seqno2 = ((const QuadkeyFragment *) b)->seqno;
+  return (seqno1 < seqno2) ? -1 : ((seqno1 > seqno2) ? 1 : 0);
+}
+
+/**
+ * Merge the fragments of the children of a tile into the fragment of the tile
+ *
+ * @param[in] group Fragments sorted in the order of the traversal
+ * @param[in] count Number of fragments
+ * @param[in] subtype Subtype of the temporal point
+ * @note Consecutive fragments that share their bounding instant, as is the
+ * case when the temporal point crosses the boundary between two children,
+ * are joined into a single sequence.
+ */
+static Temporal *
+quadkey_fragments_merge(const QuadkeyFragment *group, int count,
+  int16 subtype)
+{
+  if (subtype == INSTANT)
+    return (Temporal *) tinstant_copy((const TInstant *) group[0].temp);
+
+  int i, totalcount = 0;
+  if (subtype == INSTANTSET)
+  {
+    const TInstant **instants = palloc(sizeof(TInstant *) * count);
+    for (i = 0; i < count; i++)
+      instants[i] = (const TInstant *) group[i].temp;
+    TInstantSet *result = tinstantset_make(instants, count, MERGE_NO);
+    pfree(instants);
+    return (Temporal *) result;
+  }
+
+  for (i = 0; i < count; i++)
+    totalcount += ((const TSequence *) group[i].temp)->count;
+  const TInstant **instants = palloc(sizeof(TInstant *) * totalcount);
+  TSequence **sequences = palloc(sizeof(TSequence *) * count);
+  bool linear = MOBDB_FLAGS_GET_LINEAR(group[0].temp->flags);
+  bool lower_inc = false, upper_inc = false;
+  int k = 0, l = 0;
+  for (i = 0; i < count; i++)
+  {
+    const TSequence *seq = (const TSequence *) group[i].temp;
+    bool join = k > 0 && instants[k - 1]->t == seq->period.lower &&
+      (upper_inc || seq->period.lower_inc);
+    int start = 0;
+    if (join)
     {
-      /* Switch to memory context appropriate for multiple function calls */
-      MemoryContext oldcontext =
-        MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-      if (state->bm) pfree(state->bm);
-      pfree(state);
-      MemoryContextSwitchTo(oldcontext);
-      SRF_RETURN_DONE(funcctx);
+      /* The value at the common instant is taken from the fragment that
+       * includes it */
+      if (upper_inc)
+        start = 1;
+      else
+        k--;
     }
-
-    /* Get current tile (if any) and advance state
-     * It is necessary to test if we found a tile since the previous tile
-     * may be the last one set in the associated bit matrix */
-    STBOX box;
-    bool found = stbox_tile_state_get(state, &box);
-    if (! found)
+    else
     {
-      /* Switch to memory context appropriate for multiple function calls */
-      MemoryContext oldcontext =
-        MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
-      if (state->bm) pfree(state->bm);
-      pfree(state);
-      MemoryContextSwitchTo(oldcontext);
-      SRF_RETURN_DONE(funcctx);
+      if (k > 0)
+        sequences[l++] = tsequence_make(instants, k, lower_inc, upper_inc,
+          linear, NORMALIZE);
+      k = 0;
+      lower_inc = seq->period.lower_inc;
     }
-    stbox_tile_state_next(state);
-    /* Restrict the temporal point to the box */
-    Temporal *atstbox = tpoint_at_stbox(state->temp, &box, UPPER_EXC);
-    if (atstbox == NULL)
-      continue;
-    /* Form tuple and return */
-    hasz = MOBDB_FLAGS_GET_Z(state->temp->flags);
-    tuple_arr[0] = point_make(box.xmin, box.ymin, box.zmin, hasz, false,
-      box.srid);
-    tuple_arr[1] = TimestampTzGetDatum(box.tmin);
-    tuple_arr[2] = PointerGetDatum(atstbox);
-    tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
-    result = HeapTupleGetDatum(tuple);
-    SRF_RETURN_NEXT(funcctx, result);
+    for (int j = start; j < seq->count; j++)
+      instants[k++] = tsequence_inst_n(seq, j);
+    upper_inc = seq->period.upper_inc;
+  }
+  sequences[l++] = tsequence_make(instants, k, lower_inc, upper_inc, linear,
+    NORMALIZE);
+  TSequenceSet *result = tsequenceset_make_free(sequences, l, NORMALIZE);
+  pfree(instants);
+  return (Temporal *) result;
+}
+
+/**
+ * Create the state for splitting a temporal point with respect to several
+ * levels of a tile hierarchy
+ *
+ * @param[in] temp Temporal point
+ * @param[in] size Size of the tile of level 0
+ * @param[in] minlevel,maxlevel Levels of the split
+ * @param[in] origin Origin of the tile hierarchy
+ *
+ * @note The temporal point is traversed once for splitting it with respect to
+ * the tiles of the finest level. The fragments of the upper levels are
+ * obtained by merging the fragments of the children tiles.
+ */
+static MultiresSplitState *
+tpoint_multires_state_make(const Temporal *temp, double size, int minlevel,
+  int maxlevel, const POINT2D *origin)
+{
+  STBOX bounds;
+  temporal_bbox(temp, &bounds);
+  /* Ensure that the temporal point is contained in the tile of level 0,
+   * points located on its upper boundary are assigned to the last tiles */
+  quadkey_tile_index(bounds.xmin, origin->x, size, 0, false);
+  quadkey_tile_index(bounds.ymin, origin->y, size, 0, false);
+  if (bounds.xmax > bounds.xmin)
+    quadkey_tile_index(bounds.xmax, origin->x, size, 0, true);
+  if (bounds.ymax > bounds.ymin)
+    quadkey_tile_index(bounds.ymax, origin->y, size, 0, true);
+
+  /* Split the temporal point with respect to the X and Y dimensions of the
+   * tiles of the finest level */
+  MOBDB_FLAGS_SET_Z(bounds.flags, false);
+  MOBDB_FLAGS_SET_T(bounds.flags, false);
+  double fsize = ldexp(size, -maxlevel);
+  POINT3DZ pt;
+  memset(&pt, 0, sizeof(POINT3DZ));
+  pt.x = origin->x;
+  pt.y = origin->y;
+  STboxGridState *grid = stbox_tile_state_make(&bounds, fsize, 0, pt, 0);
+  TileFragmentList list;
+  tpoint_split_tiles(&list, temp, grid);
+
+  /* Compute the quadkeys of the tiles of the fragments */
+  double maxindex = ldexp(1.0, maxlevel);
+  double col0 = round((grid->box.xmin - origin->x) / fsize);
+  double row0 = round((grid->box.ymin - origin->y) / fsize);
+  MultiresSplitState *state = palloc0(sizeof(MultiresSplitState));
+  state->fragments = palloc(sizeof(QuadkeyFragment) * list.count);
+  for (int i = 0; i < list.count; i++)
+  {
+    double col = col0 + list.fragments[i].coords[0];
+    double row = row0 + list.fragments[i].coords[1];
+    /* Points located on the upper boundary of the tile of level 0 */
+    col = Min(col, maxindex - 1);
+    row = Min(row, maxindex - 1);
+    state->fragments[i].key = quadkey_make((uint32) col, (uint32) row,
+      maxlevel);
+    state->fragments[i].seqno = list.fragments[i].seqno;
+    state->fragments[i].temp = list.fragments[i].temp;
+  }
+  if (list.count > 1)
+    qsort(state->fragments, (size_t) list.count, sizeof(QuadkeyFragment),
+      quadkey_fragment_cmp);
+  pfree(list.fragments);
+  pfree(grid);
+
+  /* Fill in state */
+  state->level = minlevel;
+  state->maxlevel = maxlevel;
+  state->i = 0;
+  state->count = list.count;
+  state->subtype = temp->subtype;
+  state->group = palloc(sizeof(QuadkeyFragment) * list.count);
+  return state;
+}
+
+/**
+ * Return the fragment of the temporal point in the next tile and advance the
+ * state
+ *
+ * @param[inout] state State of the split
+ * @param[out] level Level of the tile containing the fragment
+ * @param[out] key Quadkey of the tile containing the fragment
+ * @result Fragment of the temporal point, or NULL when all the fragments have
+ * been returned
+ */
+static Temporal *
+tpoint_multires_state_next(MultiresSplitState *state, int *level,
+  uint64 *key)
+{
+  /* Move to the next level */
+  if (state->i == state->count)
+  {
+    state->level++;
+    state->i = 0;
+  }
+  if (state->count == 0 || state->level > state->maxlevel)
+    return NULL;
+  /* Collect the fragments of the children of the tile, which have
+   * consecutive keys at the finest level */
+  int shift = 2 * (state->maxlevel - state->level);
+  uint64 tilekey = state->fragments[state->i].key >> shift;
+  int count = 0;
+  while (state->i < state->count &&
+    (state->fragments[state->i].key >> shift) == tilekey)
+    state->group[count++] = state->fragments[state->i++];
+  if (count > 1)
+    qsort(state->group, (size_t) count, sizeof(QuadkeyFragment),
+      quadkey_fragment_seqno_cmp);
+  *level = state->level;
+  *key = tilekey;
+  return quadkey_fragments_merge(state->group, count, state->subtype);
+}
+
+/**
+ * Free the state for splitting a temporal point
+ */
+static void
+tpoint_multires_state_free(MultiresSplitState *state)
+{
+  /* The fragments of instants point to the instants of the temporal point */
+  if (state->subtype == SEQUENCE || state->subtype == SEQUENCESET)
+  {
+    for (int i = 0; i < state->count; i++)
+      pfree(state->fragments[i].temp);
+  }
+  pfree(state->fragments);
+  pfree(state->group);
+  pfree(state);
+  return;
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_multires_split);
+/**
+ * Split a temporal point with respect to several levels of a tile hierarchy.
+ */
+PGDLLEXPORT Datum
+Tpoint_multires_split(PG_FUNCTION_ARGS)
+{
+  FuncCallContext *funcctx;
+  MultiresSplitState *state;
+  bool isnull[3] = {0,0,0}; /* needed to say no value is null */
+  Datum tuple_arr[3]; /* used to construct the composite return value */
+  HeapTuple tuple;
+  Datum result; /* the actual composite return value */
+
+  /* If the function is being called for the first time */
+  if (SRF_IS_FIRSTCALL())
+  {
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+    /* Get input parameters */
+    Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+    double size = PG_GETARG_FLOAT8(1);
+    int minlevel = PG_GETARG_INT32(2);
+    int maxlevel = PG_GETARG_INT32(3);
+    GSERIALIZED *sorigin = PG_GETARG_GSERIALIZED_P(4);
+
+    /* Ensure parameter validity */
+    ensure_not_geodetic(temp->flags);
+    ensure_positive_datum(Float8GetDatum(size), T_FLOAT8);
+    ensure_valid_quadkey_level(minlevel);
+    ensure_valid_quadkey_level(maxlevel);
+    if (minlevel > maxlevel)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The minimum level must be less than or equal to the maximum level")));
+    ensure_non_empty(sorigin);
+    ensure_point_type(sorigin);
+    ensure_same_geodetic(temp->flags, GS_FLAGS(sorigin));
+    int32 srid = tpoint_srid(temp);
+    int32 gs_srid = gserialized_get_srid(sorigin);
+    if (gs_srid != SRID_UNKNOWN)
+      ensure_same_srid(srid, gs_srid);
+
+    /* Create function state */
+    funcctx->user_fctx = tpoint_multires_state_make(temp, size, minlevel,
+      maxlevel, gserialized_point2d_p(sorigin));
+
+    /* Build a tuple description for the function output */
+    get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
+    BlessTupleDesc(funcctx->tuple_desc);
+    MemoryContextSwitchTo(oldcontext);
   }
+
+  /* Stuff done on every call of the function */
+  funcctx = SRF_PERCALL_SETUP();
+  /* Get state */
+  state = funcctx->user_fctx;
+  int level;
+  uint64 key;
+  Temporal *fragment = tpoint_multires_state_next(state, &level, &key);
+  /* Stop when we have output all the tiles */
+  if (fragment == NULL)
+  {
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    tpoint_multires_state_free(state);
+    MemoryContextSwitchTo(oldcontext);
+    SRF_RETURN_DONE(funcctx);
+  }
+
+  /* Form tuple and return */
+  tuple_arr[0] = Int32GetDatum(level);
+  tuple_arr[1] = Int64GetDatum((int64) key);
+  tuple_arr[2] = PointerGetDatum(fragment);
+  tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
+  result = HeapTupleGetDatum(tuple);
+  /* The fragment has been copied into the tuple */
+  pfree(fragment);
+  SRF_RETURN_NEXT(funcctx, result);
 }
 
 /*****************************************************************************/
@@ -39,6 +39,15 @@ SELECT p |=| periodset '{[2001-01-01, 2001-01-15], [2001-02-01, 2001-02-15]}' FR
 
 DROP INDEX tbl_period_big_quadtree_idx;
 
+CREATE INDEX tbl_period_big_rtree_idx ON tbl_period_big USING GIST(p);
+
+-- EXPLAIN ANALYZE
+SELECT p |=| timestamptz '2001-06-01' FROM tbl_period_big ORDER BY 1 LIMIT 3;
+SELECT p |=| period '[2001-06-01, 2001-07-01]' FROM tbl_period_big ORDER BY 1 LIMIT 3;
+SELECT p |=| periodset '{[2001-01-01, 2001-01-15], [2001-02-01, 2001-02-15]}' FROM tbl_period_big ORDER BY 1 LIMIT 3;
+
+DROP INDEX tbl_period_big_rtree_idx;
+
 -------------------------------------------------------------------------------
 
 -- RESTRICTION SELECTIVITY
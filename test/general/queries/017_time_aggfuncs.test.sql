@@ -154,3 +154,37 @@ SELECT numPeriods(tunion(p)) FROM tbl_period;
 SELECT numPeriods(tunion(ps)) FROM tbl_periodset;
 
 -------------------------------------------------------------------------------
+-- Size of the aggregate state
+
+SELECT tcount_memsize(temp) FROM (VALUES
+(NULL::period),(NULL::period)) t(temp);
+SELECT tcount_memsize(temp) BETWEEN 20480 AND 24576 FROM (VALUES
+('{2000-01-01, 2000-01-03}'::timestampset),('{2000-01-02}'::timestampset)) t(temp);
+SELECT tcount_memsize(temp) BETWEEN 20480 AND 24576 FROM (VALUES
+('[2000-01-01, 2000-01-02]'::period),('[2000-01-03, 2000-01-04]'::period)) t(temp);
+SELECT tcount_memsize(temp) BETWEEN 20480 AND 24576 FROM (VALUES
+('{[2000-01-01, 2000-01-02]}'::periodset),('{[2000-01-03, 2000-01-04]}'::periodset)) t(temp);
+SELECT tcount_memsize(p) > 2048 * 16 FROM (
+  SELECT period(t, t + interval '30 minutes') AS p
+  FROM generate_series(timestamptz '2000-01-01', '2000-03-31', interval '1 hour') t) t;
+
+-- Spilling of the aggregate state to disk
+SELECT tcount_spillstats(temp) FROM (VALUES
+('[2000-01-01, 2000-01-02]'::period),('[2000-01-03, 2000-01-04]'::period)) t(temp);
+CREATE TABLE tbl_tcount_spill AS
+SELECT k, tcount(p) AS temp FROM (SELECT i % 3 AS k, period(t, t + interval '30 minutes') AS p
+  FROM generate_series(timestamptz '2000-01-01', '2000-03-31', interval '5 minutes') WITH ORDINALITY AS s(t, i)) t
+GROUP BY k;
+SET work_mem = '64kB';
+SELECT COUNT(*) FROM tbl_tcount_spill t1, (
+  SELECT k, tcount(p) AS temp FROM (SELECT i % 3 AS k, period(t, t + interval '30 minutes') AS p
+  FROM generate_series(timestamptz '2000-01-01', '2000-03-31', interval '5 minutes') WITH ORDINALITY AS s(t, i)) t
+  GROUP BY k) t2
+WHERE t1.k = t2.k AND t1.temp = t2.temp;
+SELECT s[1] > 0 AND s[2] > 0 FROM (
+  SELECT tcount_spillstats(p) AS s FROM (SELECT i % 3 AS k, period(t, t + interval '30 minutes') AS p
+  FROM generate_series(timestamptz '2000-01-01', '2000-03-31', interval '5 minutes') WITH ORDINALITY AS s(t, i)) t) t1;
+RESET work_mem;
+DROP TABLE tbl_tcount_spill;
+
+-------------------------------------------------------------------------------
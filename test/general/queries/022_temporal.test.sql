@@ -790,6 +790,36 @@ SELECT memSize(ttext '{AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03}');
 SELECT memSize(ttext '[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03]');
 SELECT memSize(ttext '{[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03],[CCC@2000-01-04, CCC@2000-01-05]}');
 
+SELECT isColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]');
+SELECT isColumnar(toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]'));
+SELECT toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]');
+SELECT toColumnar(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}');
+SELECT memSize(toColumnar(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]')) < memSize(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]');
+SELECT valueAtTimestamp(toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]'), '2000-01-02 12:00:00');
+SELECT valueAtTimestamp(toColumnar(tfloat '{[1@2000-01-01, 3@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}'), '2000-01-02');
+SELECT valueAtTimestamp(toColumnar(tfloat '[1@2000-01-01, 3@2000-01-03)'), '2000-01-03');
+SELECT startValue(toColumnar(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02],[3.5@2000-01-04, 4.5@2000-01-05]}'));
+SELECT endValue(toColumnar(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02],[3.5@2000-01-04, 4.5@2000-01-05]}'));
+SELECT numInstants(toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]'));
+SELECT timestampN(toColumnar(tint '{[1@2000-01-01, 2@2000-01-02), [2@2000-01-02, 1@2000-01-03]}'), 3);
+SELECT startTimestamp(toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]')), endTimestamp(toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]'));
+SELECT toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]') && tbox 'TBOX((2.0, 2000-01-02), (3.0, 2000-01-04))';
+SELECT (toColumnar(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]') <-> 3) = (tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]' <-> 3);
+SELECT (toColumnar(tfloat '{[1@2000-01-01, 3@2000-01-03],[3.5@2000-01-04, 1.5@2000-01-05]}') <-> 2.0) = (tfloat '{[1@2000-01-01, 3@2000-01-03],[3.5@2000-01-04, 1.5@2000-01-05]}' <-> 2.0);
+SELECT isCompressed(compress(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]'));
+SELECT compress(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]');
+SELECT compress(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}');
+SELECT compress(tfloat '[1.234@2000-01-01, 2.36@2000-01-02]', 1);
+SELECT memSize(compress(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]')) < memSize(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]');
+SELECT valueAtTimestamp(compress(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]'), '2000-01-02 12:00:00');
+SELECT valueAtTimestamp(compress(tfloat '{[1@2000-01-01, 3@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}'), '2000-01-02');
+SELECT compress(tfloat '[1.5@2000-01-01, 2.5@2000-01-02]', -2);
+WITH temp AS (SELECT tint_seq(array_agg(tint_inst(i % 7, timestamptz '2000-01-01' + i * interval '1 min' + (i % 3) * interval '1 sec') ORDER BY i)) AS seq FROM generate_series(1, 200) i) SELECT COUNT(*) FROM temp, generate_series(timestamptz '2000-01-01', '2000-01-01 03:30:00', interval '37 sec') t WHERE valueAtTimestamp(compress(seq), t) IS DISTINCT FROM valueAtTimestamp(seq, t);
+WITH temp AS (SELECT tint_seq(array_agg(tint_inst(i % 7, timestamptz '2000-01-01' + i * interval '1 min' + (i % 3) * interval '1 sec') ORDER BY i)) AS seq FROM generate_series(1, 200) i) SELECT COUNT(*) FROM temp, generate_series(1, 201) n WHERE timestampN(compress(seq), n) IS DISTINCT FROM timestampN(seq, n);
+WITH temp AS (SELECT tint_seq(array_agg(tint_inst(i % 7, timestamptz '2000-01-01' + i * interval '1 min' + (i % 3) * interval '1 sec') ORDER BY i)) AS seq FROM generate_series(1, 200) i) SELECT startValue(compress(seq)), endValue(compress(seq)) FROM temp;
+SELECT startValue(compress(tfloat '{[1.25@2000-01-01, 2.5@2000-01-02],[3.75@2000-01-04, 4.125@2000-01-05]}', 2)), endValue(compress(tfloat '{[1.25@2000-01-01, 2.5@2000-01-02],[3.75@2000-01-04, 4.125@2000-01-05]}', 2));
+SELECT compress(tfloat '[1e300@2000-01-01, 1.234@2000-01-02]', 2) = tfloat '[1e300@2000-01-01, 1.234@2000-01-02]';
+
 /*
 SELECT tbox(tint '1@2000-01-01');
 SELECT tbox(tfloat '1.5@2000-01-01');
@@ -2023,6 +2053,10 @@ SELECT valueAtTimestamp(ttext 'AAA@2000-01-01', timestamptz '2000-01-01');
 SELECT valueAtTimestamp(ttext '{AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03}', timestamptz '2000-01-01');
 SELECT valueAtTimestamp(ttext '[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03]', timestamptz '2000-01-01');
 SELECT valueAtTimestamp(ttext '{[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03],[CCC@2000-01-04, CCC@2000-01-05]}', timestamptz '2000-01-01');
+SELECT valueAtTimestamp(tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)), timestamptz '2000-01-01 10:00:30') FROM generate_series(1, 1000) i;
+SELECT valueAtTimestamp(tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)), timestamptz '2000-01-01 01:05:00') FROM generate_series(1, 1000) i;
+SELECT valueAtTimestamp(tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * i * interval '1 second') ORDER BY i)), timestamptz '2000-01-06 16:06:40') FROM generate_series(1, 1000) i;
+SELECT numInstants(atPeriod(tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)), period '[2000-01-01 05:00:00, 2000-01-01 06:00:00]')) FROM generate_series(1, 1000) i;
 
 SELECT minusTimestamp(tbool 't@2000-01-01', timestamptz '2000-01-01');
 SELECT minusTimestamp(tbool '{t@2000-01-01}', timestamptz '2000-01-01');
@@ -595,3 +595,35 @@ SELECT COUNT(*) FROM tbl_ttext t1, tbl_ttext t2
 WHERE t1.temp >= t2.temp;
 
 ------------------------------------------------------------------------------
+-- Restriction functions on large values stored out of line
+-------------------------------------------------------------------------------
+
+DROP TABLE IF EXISTS tbl_tfloat_big;
+CREATE TABLE tbl_tfloat_big(k int, temp tfloat);
+ALTER TABLE tbl_tfloat_big ALTER COLUMN temp SET STORAGE EXTERNAL;
+INSERT INTO tbl_tfloat_big SELECT 1, tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)) FROM generate_series(1, 5000) i;
+INSERT INTO tbl_tfloat_big SELECT 2, tfloat_seqset(array_agg(tfloat_seq(ARRAY[tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 hour'), tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 hour' + interval '30 minutes')]) ORDER BY i)) FROM generate_series(1, 2000) i;
+
+SELECT k, valueAtTimestamp(temp, timestamptz '2000-01-02 10:00:30') FROM tbl_tfloat_big ORDER BY k;
+SELECT k, valueAtTimestamp(temp, timestamptz '2000-01-02 10:45:00') IS NULL FROM tbl_tfloat_big ORDER BY k;
+SELECT k, getValue(atTimestamp(temp, timestamptz '2000-01-03 05:15:00')) FROM tbl_tfloat_big ORDER BY k;
+SELECT k, numInstants(atPeriod(temp, period '[2000-01-02 10:00:00, 2000-01-02 11:00:00]')) FROM tbl_tfloat_big ORDER BY k;
+SELECT k, startValue(temp) FROM tbl_tfloat_big ORDER BY k;
+
+DROP TABLE tbl_tfloat_big;
+
+-- With the default storage the values are compressed before being stored
+-- out of line and are detoasted completely
+CREATE TABLE tbl_tfloat_big(k int, temp tfloat);
+INSERT INTO tbl_tfloat_big SELECT 1, tfloat_seq(array_agg(tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)) FROM generate_series(1, 5000) i;
+INSERT INTO tbl_tfloat_big SELECT 2, tfloat_seqset(array_agg(tfloat_seq(ARRAY[tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 hour'), tfloat_inst(i, timestamptz '2000-01-01' + i * interval '1 hour' + interval '30 minutes')]) ORDER BY i)) FROM generate_series(1, 2000) i;
+
+SELECT k, valueAtTimestamp(temp, timestamptz '2000-01-02 10:00:30') FROM tbl_tfloat_big ORDER BY k;
+SELECT k, valueAtTimestamp(temp, timestamptz '2000-01-02 10:45:00') IS NULL FROM tbl_tfloat_big ORDER BY k;
+SELECT k, getValue(atTimestamp(temp, timestamptz '2000-01-03 05:15:00')) FROM tbl_tfloat_big ORDER BY k;
+SELECT k, numInstants(atPeriod(temp, period '[2000-01-02 10:00:00, 2000-01-02 11:00:00]')) FROM tbl_tfloat_big ORDER BY k;
+SELECT k, startValue(temp) FROM tbl_tfloat_big ORDER BY k;
+
+DROP TABLE tbl_tfloat_big;
+
+-------------------------------------------------------------------------------
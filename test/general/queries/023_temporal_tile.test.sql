@@ -98,6 +98,7 @@ SELECT valueSplit(tfloat '[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]', 0.5
 SELECT valueSplit(tfloat 'Interp=Stepwise;[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03]', 0.5);
 SELECT valueSplit(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}', 0.5);
 SELECT valueSplit(tfloat 'Interp=Stepwise;{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}', 0.5);
+SELECT COUNT(*) FROM (SELECT valueSplit(tfloat '[1@2000-01-01, 1000@2000-01-02]', 1.0) LIMIT 3) t;
 
 -------------------------------------------------------------------------------
 -- timeSplit
@@ -121,6 +122,7 @@ SELECT timeSplit(ttext 'AAA@2000-01-01', '1 week');
 SELECT timeSplit(ttext '{AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03}', '1 week');
 SELECT timeSplit(ttext '[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03]', '1 week');
 SELECT timeSplit(ttext '{[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03],[CCC@2000-01-04, CCC@2000-01-05]}', '1 week');
+SELECT COUNT(*) FROM (SELECT timeSplit(tint '[1@2000-01-01, 1@2001-01-01]', '1 hour') LIMIT 3) t;
 
 -------------------------------------------------------------------------------
 -- valueTimeSplit
@@ -552,6 +552,9 @@ SELECT 1.5 / tfloat '[-1@2000-01-01, 1@2000-01-02]';
 SELECT tint '[-1@2000-01-01, 1@2000-01-02]' / tint '[0@2000-01-01, 1@2000-01-02]';
 SELECT tint '[-1@2000-01-01, 1@2000-01-02]' / tfloat '[-1@2000-01-01, 1@2000-01-02]';
 SELECT tfloat '[-1@2000-01-01, 1@2000-01-02]' / tfloat '[-1@2000-01-01, 1@2000-01-02]';
+SELECT numInstants(a - b) FROM (SELECT tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT valueAtTimestamp(a - b, timestamptz '2000-01-01 00:00:03') FROM (SELECT tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT getValues(a #< b) FROM (SELECT tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tfloat_seq(array_agg(tfloat_inst(i % 2, timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
 
 -------------------------------------------------------------------------------
 
@@ -0,0 +1,45 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2022, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+--
+
+-------------------------------------------------------------------------------
+-- Scratch memory context of the temporal distance
+-------------------------------------------------------------------------------
+
+SELECT lifting_arena_bytes();
+
+SELECT (tfloat '[1@2000-01-01, 3@2000-01-03]' <-> tfloat '[3@2000-01-01, 1@2000-01-03]') IS NOT NULL;
+SELECT lifting_arena_bytes() > 0;
+
+WITH seqs AS (
+  SELECT tfloat_seq(array_agg(tfloat_inst((i % 2)::float, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)) AS seq1,
+    tfloat_seq(array_agg(tfloat_inst(((i + 1) % 2)::float, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)) AS seq2
+  FROM generate_series(1, 10000) i )
+SELECT numInstants(seq1 <-> seq2) > 10000 FROM seqs;
+SELECT lifting_arena_bytes() > 100000;
+
+-------------------------------------------------------------------------------
@@ -704,3 +704,15 @@ WITH Temp AS (
 SELECT COUNT(*) FROM Temp;
 
 -------------------------------------------------------------------------------
+-- Warping window and maximum distance
+-------------------------------------------------------------------------------
+
+SELECT frechetDistance(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 0);
+SELECT frechetDistance(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 1);
+SELECT frechetDistance(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 0, 0.5);
+SELECT dynamicTimeWarp(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 0);
+SELECT dynamicTimeWarp(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 1);
+SELECT dynamicTimeWarp(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', 0, 0.5);
+SELECT dynamicTimeWarp(tfloat '[0@2000-01-01, 1@2000-01-02, 0@2000-01-03, 0@2000-01-04, 0@2000-01-05]', tfloat '[0@2000-01-01, 0@2000-01-02, 1@2000-01-03, 0@2000-01-04, 0@2000-01-05]', maxdist := 0.5);
+
+-------------------------------------------------------------------------------
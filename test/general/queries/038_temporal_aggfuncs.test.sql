@@ -211,6 +211,25 @@ SELECT round(tavg(temp), 6) FROM (VALUES
 
 -------------------------------------------------------------------------------
 
+SELECT appendInstant(inst) FROM (VALUES
+(tint '1@2000-01-01'), (tint '2@2000-01-02'), (tint '2@2000-01-03')) t(inst);
+SELECT appendInstant(inst) FROM (VALUES
+(tfloat '1@2000-01-01'), (tfloat '2@2000-01-02'), (tfloat '3@2000-01-03')) t(inst);
+SELECT memSize(appendInstant(inst)) = memSize(tint '[1@2000-01-01, 2@2000-01-02, 2@2000-01-03]') FROM (VALUES
+(tint '1@2000-01-01'), (tint '2@2000-01-02'), (tint '2@2000-01-03')) t(inst);
+SELECT memSize(appendInstant(inst ORDER BY k)) = memSize(tint_seq(array_agg(inst ORDER BY k))) FROM (SELECT k, tint_inst(k % 3, timestamptz '2000-01-01' + k * interval '1 minute') AS inst FROM generate_series(1, 100) k) t;
+SELECT numInstants(tcount(inst ORDER BY k)) FROM (SELECT k, tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500) * interval '1 minute') AS inst FROM generate_series(1, 1000) k) t;
+SELECT getValues(tcount(inst ORDER BY k)) FROM (SELECT k, tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500) * interval '1 minute') AS inst FROM generate_series(1, 1000) k) t;
+SELECT getValues(tcount(seq ORDER BY k)) FROM (SELECT k, tint_seq(ARRAY[tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500) * interval '1 minute'), tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500 + 1) * interval '1 minute')], true, false) AS seq FROM generate_series(1, 1000) k) t;
+SELECT duration(tcount(seq ORDER BY k)) FROM (SELECT k, tint_seq(ARRAY[tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500) * interval '1 minute'), tint_inst(1, timestamptz '2000-01-01' + ((k - 1) % 500 + 1) * interval '1 minute')], true, false) AS seq FROM generate_series(1, 1000) k) t;
+SELECT set_config('work_mem', '64kB', false);
+SELECT numInstants(tcount(inst)) FROM (SELECT tint_inst(1, timestamptz '2000-01-01' + ((k * 7919) % 10000) * interval '1 minute') AS inst FROM generate_series(1, 20000) k) t;
+SELECT getValues(tcount(inst)) FROM (SELECT tint_inst(1, timestamptz '2000-01-01' + ((k * 7919) % 10000) * interval '1 minute') AS inst FROM generate_series(1, 20000) k) t;
+SELECT duration(tcount(seq)) FROM (SELECT tint_seq(ARRAY[tint_inst(1, timestamptz '2000-01-01' + ((k * 7919) % 10000) * interval '1 minute'), tint_inst(1, timestamptz '2000-01-01' + ((k * 7919) % 10000 + 1) * interval '1 minute')], true, false) AS seq FROM generate_series(1, 20000) k) t;
+RESET work_mem;
+
+-------------------------------------------------------------------------------
+
 /* Errors */
 SELECT tsum(temp) FROM ( VALUES
 (tfloat '[1@2000-01-01, 2@2000-01-02]'),
@@ -0,0 +1,45 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2022, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+--
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+
+SELECT approxCountDistinct(id, temp, interval '1 hour') FROM (VALUES (1, NULL::tint), (NULL, tint '1@2000-01-01')) t(id, temp);
+SELECT approxCountDistinct(id, temp, interval '1 hour') FROM (VALUES (1, tint '1@2000-01-01 00:10'), (2, tint '2@2000-01-01 00:20'), (1, tint '3@2000-01-01 00:30'), (3, tint '[1@2000-01-01 00:50, 1@2000-01-01 01:10]')) t(id, temp);
+SELECT approxCountDistinct(id, temp, interval '1 hour', '2000-01-01 00:30') FROM (VALUES (1, tint '1@2000-01-01 00:10'), (2, tint '2@2000-01-01 00:20'), (1, tint '3@2000-01-01 00:30'), (3, tint '[1@2000-01-01 00:50, 1@2000-01-01 01:10]')) t(id, temp);
+SELECT approxCountDistinct(id, temp, interval '1 hour') FROM (VALUES ('a', tfloat '1.5@2000-01-01 00:10'), ('b', tfloat '{2.5@2000-01-01 00:20, 1@2000-01-01 03:30}')) t(id, temp);
+SELECT abs(maxValue(approxCountDistinct(i, tint_inst(i, '2000-01-01'), interval '1 day')) - 10000) < 500 FROM generate_series(1, 10000) i;
+
+SELECT approxPercentile(temp, 0.5, interval '1 hour') FROM (VALUES (tfloat '1@2000-01-01 00:10'), (tfloat '[2@2000-01-01 00:20, 4@2000-01-01 00:40]'), (tfloat '3@2000-01-01 00:30'), (tfloat '10@2000-01-01 01:30')) t(temp);
+SELECT approxPercentile(temp, 0.25, interval '1 hour') FROM (VALUES (tint '{1@2000-01-01, 2@2000-01-01 00:15, 3@2000-01-01 00:30, 4@2000-01-01 00:45}')) t(temp);
+SELECT abs(maxValue(approxPercentile(tfloat_inst(i, '2000-01-01'), 0.5, interval '1 day')) - 5000.5) < 50 FROM generate_series(1, 10000) i;
+
+/* Errors */
+SELECT approxPercentile(temp, 2, interval '1 hour') FROM (VALUES (tfloat '1@2000-01-01')) t(temp);
+
+-------------------------------------------------------------------------------
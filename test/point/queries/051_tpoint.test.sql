@@ -691,6 +691,20 @@ SELECT memSize(tgeogpoint '{Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02
 SELECT memSize(tgeogpoint '[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03]') > 0;
 SELECT memSize(tgeogpoint '{[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03],[Point(3.5 3.5)@2000-01-04, Point(3.5 3.5)@2000-01-05]}') > 0;
 
+SELECT isColumnar(toColumnar(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03]'));
+SELECT asEWKT(toColumnar(tgeompoint 'SRID=5676;[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]'));
+SELECT toColumnar(tgeogpoint '{[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03],[Point(3.5 3.5)@2000-01-04, Point(3.5 3.5)@2000-01-05]}') = tgeogpoint '{[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03],[Point(3.5 3.5)@2000-01-04, Point(3.5 3.5)@2000-01-05]}';
+SELECT st_asewkt(valueAtTimestamp(toColumnar(tgeompoint '[Point(1 1)@2000-01-01, Point(3 3)@2000-01-03]'), '2000-01-02'));
+SELECT length(toColumnar(tgeompoint '{[Point(0 0)@2000-01-01, Point(3 4)@2000-01-02],[Point(0 0)@2000-01-03, Point(6 8)@2000-01-04]}')) = 15;
+SELECT length(toColumnar(tgeompoint '[Point(0 0 0)@2000-01-01, Point(3 4 0)@2000-01-02, Point(3 4 12)@2000-01-03]')) = 17;
+SELECT length(toColumnar(tgeogpoint '[Point(1 1)@2000-01-01, Point(3 3)@2000-01-03]')) = length(tgeogpoint '[Point(1 1)@2000-01-01, Point(3 3)@2000-01-03]');
+SELECT (toColumnar(tgeompoint '[Point(0 0)@2000-01-01, Point(2 2)@2000-01-02, Point(0 0)@2000-01-03]') <-> geometry 'Point(2 0)') = (tgeompoint '[Point(0 0)@2000-01-01, Point(2 2)@2000-01-02, Point(0 0)@2000-01-03]' <-> geometry 'Point(2 0)');
+SELECT isCompressed(compress(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03]'));
+SELECT asEWKT(compress(tgeompoint 'SRID=5676;[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]'));
+SELECT compress(tgeogpoint '{[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03],[Point(3.5 3.5)@2000-01-04, Point(3.5 3.5)@2000-01-05]}') = tgeogpoint '{[Point(1.5 1.5)@2000-01-01, Point(2.5 2.5)@2000-01-02, Point(1.5 1.5)@2000-01-03],[Point(3.5 3.5)@2000-01-04, Point(3.5 3.5)@2000-01-05]}';
+SELECT asText(compress(tgeompoint '[Point(1.234 5.678)@2000-01-01, Point(2.5 2.5)@2000-01-02]', 1));
+SELECT st_asewkt(valueAtTimestamp(compress(tgeompoint '[Point(1 1)@2000-01-01, Point(3 3)@2000-01-03]'), '2000-01-02'));
+
 SELECT stbox(tgeompoint 'Point(1 1)@2000-01-01');
 SELECT round(stbox(tgeogpoint 'Point(1.5 1.5)@2000-01-01'), 13);
 
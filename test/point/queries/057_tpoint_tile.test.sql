@@ -111,6 +111,10 @@ FROM (SELECT spaceSplit(tgeompoint 'Interp=Stepwise;[Point(1 1 1)@2000-01-01, Po
 SELECT ST_AsText((sp).point) AS point, astext((sp).tpoint) AS tpoint
 FROM (SELECT spaceSplit(tgeompoint 'Interp=Stepwise;{[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03],[Point(3 3 3)@2000-01-04, Point(3 3 3)@2000-01-05]}', 2.0, 'Point(0.5 0.5 0.5)') AS sp) t;
 
+-- Long trips crossing many tiles
+SELECT COUNT(*) FROM (SELECT spaceSplit(tgeompoint '[Point(0.5 0.5)@2000-01-01, Point(99.5 0.5)@2000-01-02]', 1.0) AS sp) t;
+SELECT COUNT(*) FROM (SELECT spaceSplit(tgeompoint '[Point(0.5 0.25)@2000-01-01, Point(10.5 10.25)@2000-01-02]', 1.0) AS sp) t;
+
 /* Errors */
 SELECT spaceSplit(tgeompoint 'SRID=5676;Point(1 1 1)@2000-01-01', 2.0, 'SRID=3812;Point(0.5 0.5 0.5)');
 
@@ -177,3 +181,22 @@ FROM (SELECT spaceTimeSplit(tgeompoint 'Interp=Stepwise;{[Point(1 1 1)@2000-01-0
 SELECT spaceTimeSplit(tgeompoint 'SRID=5676;Point(1 1 1)@2000-01-01', 2.0, '2 days', 'SRID=3812;Point(0.5 0.5 0.5)');
 
 -------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- Multiresolution split
+-------------------------------------------------------------------------------
+
+SELECT level, key, astext(tpoint) AS tpoint
+FROM multiresSplit(tgeompoint '[Point(1 1)@2000-01-01, Point(3 1)@2000-01-02]', 4.0, 0, 1);
+SELECT level, key, astext(tpoint) AS tpoint
+FROM multiresSplit(tgeompoint '{Point(1 1)@2000-01-01, Point(3 3)@2000-01-02, Point(1 1)@2000-01-03}', 4.0, 0, 1);
+SELECT level, key, astext(tpoint) AS tpoint
+FROM multiresSplit(tgeompoint '[Point(1 1)@2000-01-01, Point(4 1)@2000-01-02]', 4.0, 0, 1);
+SELECT quadkey(stbox 'STBOX((2,0),(4,2))', 4.0, 1);
+SELECT quadkey(stbox 'STBOX((1,1),(3,3))', 4.0, 1);
+/* Errors */
+SELECT multiresSplit(tgeompoint 'Point(5 5)@2000-01-01', 4.0, 0, 1);
+SELECT multiresSplit(tgeompoint 'Point(1 1)@2000-01-01', 4.0, 2, 1);
+SELECT quadkey(stbox 'STBOX((1,1),(3,3))', 4.0, 31);
+
+-------------------------------------------------------------------------------
@@ -1631,3 +1631,21 @@ SELECT tgeompoint 'Point(1 1)@2000-01-01' ~= geometry 'SRID=5676;Point(1 1)';
 SELECT tgeompoint 'SRID=5676;Point(1 1)@2000-01-01' ~= tgeompoint 'Point(1 1)@2000-01-01';
 
 -------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- Overlaps segments
+-------------------------------------------------------------------------------
+
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' && geometry 'Polygon((1 5,1 8,4 8,4 5,1 5))';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' ?&& geometry 'Polygon((1 5,1 8,4 8,4 5,1 5))';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' ?&& geometry 'Point(10 5)';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' ?&& stbox 'STBOX T((1,5,2000-01-01),(4,8,2000-01-03))';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' ?&& stbox 'STBOX T((9,4,2000-01-02),(11,6,2000-01-03))';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02, Point(10 10)@2000-01-03]' ?&& stbox 'STBOX T((9,4,2000-01-01),(11,6,2000-01-01))';
+SELECT tgeompoint '{[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02], [Point(10 10)@2000-01-03, Point(0 10)@2000-01-04]}' && geometry 'Point(10 5)';
+SELECT tgeompoint '{[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02], [Point(10 10)@2000-01-03, Point(0 10)@2000-01-04]}' ?&& geometry 'Point(10 5)';
+SELECT tgeompoint 'Point(1 1)@2000-01-01' ?&& geometry 'Point(1 1)';
+SELECT tgeompoint '{Point(0 0)@2000-01-01, Point(10 10)@2000-01-02}' ?&& geometry 'Point(5 5)';
+SELECT tgeompoint '[Point(0 0)@2000-01-01, Point(10 10)@2000-01-02]' ?&& geometry 'Point empty';
+
+-------------------------------------------------------------------------------
@@ -587,4 +587,15 @@ WITH Temp AS (
   SELECT dynamicTimeWarpPath(tgeogpoint '{[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03],[Point(3.5 3.5 3.5)@2000-01-04, Point(3.5 3.5 3.5)@2000-01-05]}', tgeogpoint '{[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03],[Point(3.5 3.5 3.5)@2000-01-04, Point(3.5 3.5 3.5)@2000-01-05]}') )
 SELECT COUNT(*) FROM Temp;
 
+-------------------------------------------------------------------------------
+-- Warping window and maximum distance
+-------------------------------------------------------------------------------
+
+SELECT round(frechetDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 0)::numeric, 6);
+SELECT frechetDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 1);
+SELECT frechetDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 0, 1);
+SELECT round(dynamicTimeWarp(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 0)::numeric, 6);
+SELECT dynamicTimeWarp(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 1);
+SELECT dynamicTimeWarp(tgeompoint '[Point(0 0)@2000-01-01, Point(1 1)@2000-01-02, Point(0 0)@2000-01-03, Point(0 0)@2000-01-04]', tgeompoint '[Point(0 0)@2000-01-01, Point(0 0)@2000-01-02, Point(1 1)@2000-01-03, Point(0 0)@2000-01-04]', 0, 2);
+
 --------------------------------------------------------
@@ -337,6 +337,11 @@ SELECT tdwithin(tgeompoint '{[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02,
 SELECT tdwithin(tgeompoint 'Point(1 1 1)@2000-01-01', tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]', 2);
 SELECT tdwithin(tgeompoint '{Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03}', tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]', 2);
 SELECT tdwithin(tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]', tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]', 2);
+SELECT getValues(tdwithin(a, b, 1.2)) FROM (SELECT tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 0), timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 1), timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT getValues(tdwithin(a, b, 1.05)) FROM (SELECT tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 0), timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 1), timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT getValues(tdwithin(a, tgeompoint_seqset(b), 1.2)) FROM (SELECT tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 0), timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 1), timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT minValue(distance(a, b)) FROM (SELECT tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 0), timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 1), timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
+SELECT round(maxValue(distance(a, b))::numeric, 6) FROM (SELECT tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 0), timestamptz '2000-01-01' + 2 * i * interval '1 second') ORDER BY i)) AS a, tgeompoint_seq(array_agg(tgeompoint_inst(ST_Point(i % 2, 1), timestamptz '2000-01-01' + (2 * i + 1) * interval '1 second') ORDER BY i)) AS b FROM generate_series(0, 999) i) t;
 SELECT tdwithin(tgeompoint '{[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03], [Point(3 3 3)@2000-01-04, Point(3 3 3)@2000-01-05]}', tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03]', 2);
 SELECT tdwithin(tgeompoint 'Point(1 1 1)@2000-01-01', tgeompoint '{[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03], [Point(3 3 3)@2000-01-04, Point(3 3 3)@2000-01-05]}', 2);
 SELECT tdwithin(tgeompoint '{Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03}', tgeompoint '{[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02, Point(1 1 1)@2000-01-03], [Point(3 3 3)@2000-01-04, Point(3 3 3)@2000-01-05]}', 2);
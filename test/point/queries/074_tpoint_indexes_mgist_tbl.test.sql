@@ -0,0 +1,117 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2022, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+--
+
+DROP INDEX IF EXISTS tbl_tgeompoint_mgist_idx;
+
+-------------------------------------------------------------------------------
+
+DROP TABLE IF EXISTS test_mgist;
+CREATE TABLE test_mgist(
+  op CHAR(10),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx BIGINT,
+  mgist_idx BIGINT
+);
+
+-------------------------------------------------------------------------------
+
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tgeompoint', 'geometry', COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE temp && g;
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT '?&&', 'tgeompoint', 'geometry', COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE temp ?&& g;
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT 'intersects', 'tgeompoint', 'geometry', COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE intersects(temp, g);
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT 'intersects', 'geometry', 'tgeompoint', COUNT(*) FROM tbl_geometry, tbl_tgeompoint WHERE intersects(g, temp);
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT 'dwithin', 'tgeompoint', 'geometry', COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE dwithin(temp, g, 5);
+
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_tgeompoint_mgist_idx ON tbl_tgeompoint USING GIST(temp tgeompoint_mgist_ops);
+SET enable_seqscan = off;
+
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE temp && g )
+WHERE op = '&&' AND leftarg = 'tgeompoint' AND rightarg = 'geometry';
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE temp ?&& g )
+WHERE op = '?&&' AND leftarg = 'tgeompoint' AND rightarg = 'geometry';
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE intersects(temp, g) )
+WHERE op = 'intersects' AND leftarg = 'tgeompoint' AND rightarg = 'geometry';
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_geometry, tbl_tgeompoint WHERE intersects(g, temp) )
+WHERE op = 'intersects' AND leftarg = 'geometry' AND rightarg = 'tgeompoint';
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint, tbl_geometry WHERE dwithin(temp, g, 5) )
+WHERE op = 'dwithin' AND leftarg = 'tgeompoint' AND rightarg = 'geometry';
+
+RESET enable_seqscan;
+DROP INDEX tbl_tgeompoint_mgist_idx;
+
+-------------------------------------------------------------------------------
+
+-- The great-circle arc between the two points reaches latitude 73.9 at
+-- longitude 0, far beyond the boxes of its end points
+DROP TABLE IF EXISTS tbl_tgeogpoint_arc;
+CREATE TABLE tbl_tgeogpoint_arc(k int, temp tgeogpoint);
+INSERT INTO tbl_tgeogpoint_arc VALUES
+(1, tgeogpoint '[Point(-60 60)@2000-01-01, Point(60 60)@2000-01-02]'),
+(2, tgeogpoint '[Point(-60 -60)@2000-01-01, Point(60 -60)@2000-01-02]');
+
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT 'intersects', 'tgeogpoint', 'geography', COUNT(*) FROM tbl_tgeogpoint_arc WHERE intersects(temp, geography 'Linestring(0 70,0 80)');
+INSERT INTO test_mgist(op, leftarg, rightarg, no_idx)
+SELECT 'intersects', 'geography', 'tgeogpoint', COUNT(*) FROM tbl_tgeogpoint_arc WHERE intersects(geography 'Linestring(0 70,0 80)', temp);
+
+CREATE INDEX tbl_tgeogpoint_arc_mgist_idx ON tbl_tgeogpoint_arc USING GIST(temp tgeogpoint_mgist_ops);
+SET enable_seqscan = off;
+
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint_arc WHERE intersects(temp, geography 'Linestring(0 70,0 80)') )
+WHERE op = 'intersects' AND leftarg = 'tgeogpoint' AND rightarg = 'geography';
+UPDATE test_mgist
+SET mgist_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint_arc WHERE intersects(geography 'Linestring(0 70,0 80)', temp) )
+WHERE op = 'intersects' AND leftarg = 'geography' AND rightarg = 'tgeogpoint';
+
+RESET enable_seqscan;
+SELECT mgist_idx = 1 FROM test_mgist WHERE leftarg = 'tgeogpoint';
+
+DROP TABLE tbl_tgeogpoint_arc;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_mgist
+WHERE no_idx <> mgist_idx OR mgist_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_mgist;
+
+-------------------------------------------------------------------------------